@@ -22,7 +22,7 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/matrix_sparse.hpp>
 
-#include <boost/timer.hpp>
+#include "../harness.hpp"
 
 
 #define BOOST_UBLAS_NOT_USED(x) (void)(x)
@@ -30,17 +30,8 @@
 
 namespace ublas = boost::numeric::ublas;
 
-void header (std::string text);
-
-template<class T>
-struct footer {
-    void operator () (int multiplies, int plus, int runs, double elapsed) {
-        std::cout << "elapsed: " << elapsed << " s, "
-                  << (multiplies * ublas::type_traits<T>::multiplies_complexity +
-                      plus * ublas::type_traits<T>::plus_complexity) * runs /
-                     (1024 * 1024 * elapsed) << " Mflops" << std::endl;
-    }
-};
+using bench::header;
+using bench::section;
 
 template<class T, int N>
 struct c_vector_traits {
@@ -141,22 +132,22 @@ void sink_matrix (const M &m) {
 
 template<class T>
 struct peak {
-    void operator () (int runs);
+    void operator () ();
 };
 
 template<class T, int N>
 struct bench_1 {
-    void operator () (int runs);
+    void operator () ();
 };
 
 template<class T, int N>
 struct bench_2 {
-    void operator () (int runs);
+    void operator () ();
 };
 
 template<class T, int N>
 struct bench_3 {
-    void operator () (int runs);
+    void operator () ();
 };
 
 struct safe_tag {};
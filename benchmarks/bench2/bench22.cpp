@@ -16,14 +16,13 @@ template<class T, int N>
 struct bench_c_outer_prod {
     typedef T value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static typename c_matrix_traits<T, N, N>::type m;
             static typename c_vector_traits<T, N>::type v1, v2;
             initialize_c_vector<T, N> () (v1);
             initialize_c_vector<T, N> () (v2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * N, N * N + 2 * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     for (int k = 0; k < N; ++ k) {
                         m [j] [k] = - v1 [j] * v2 [k];
@@ -31,8 +30,7 @@ struct bench_c_outer_prod {
                 }
 //                sink_c_matrix<T, N, N> () (m);
                 BOOST_UBLAS_NOT_USED(m);
-            }
-            footer<value_type> () (N * N, N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -43,37 +41,33 @@ template<class M, class V, int N>
 struct bench_my_outer_prod {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs, safe_tag) const {
+    void operator () (safe_tag) const {
         try {
             static M m (N, N, N * N);
             static V v1 (N, N), v2 (N, N);
             initialize_vector (v1);
             initialize_vector (v2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * N, N * N + 2 * N, [&] () {
                 m = - ublas::outer_prod (v1, v2);
 //                sink_matrix (m);
                 BOOST_UBLAS_NOT_USED(m);
-            }
-            footer<value_type> () (N * N, N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
         }
     }
-    void operator () (int runs, fast_tag) const {
+    void operator () (fast_tag) const {
         try {
             static M m (N, N, N * N);
             static V v1 (N, N), v2 (N, N);
             initialize_vector (v1);
             initialize_vector (v2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * N, N * N + 2 * N, [&] () {
                 m.assign (- ublas::outer_prod (v1, v2));
 //                sink_matrix (m);
                 BOOST_UBLAS_NOT_USED(m);
-            }
-            footer<value_type> () (N * N, N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -84,22 +78,20 @@ template<class M, class V, int N>
 struct bench_cpp_outer_prod {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static M m (N * N);
             static V v1 (N), v2 (N);
             initialize_vector (v1);
             initialize_vector (v2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * N, N * N + 2 * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     for (int k = 0; k < N; ++ k) {
                         m [N * j + k] = - v1 [j] * v2 [k];
                     }
                 }
 //                sink_vector (m);
-            }
-            footer<value_type> () (N * N, N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -111,14 +103,13 @@ template<class T, int N>
 struct bench_c_matrix_vector_prod {
     typedef T value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static typename c_matrix_traits<T, N, N>::type m;
             static typename c_vector_traits<T, N>::type v1, v2;
             initialize_c_matrix<T, N, N> () (m);
             initialize_c_vector<T, N> () (v1);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * (N - 1), N * N + 2 * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     v2 [j] = 0;
                     for (int k = 0; k < N; ++ k) {
@@ -126,8 +117,7 @@ struct bench_c_matrix_vector_prod {
                     }
                 }
 //                sink_c_vector<T, N> () (v2);
-            }
-            footer<value_type> () (N * N, N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -138,35 +128,31 @@ template<class M, class V, int N>
 struct bench_my_matrix_vector_prod {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs, safe_tag) const {
+    void operator () (safe_tag) const {
         try {
             static M m (N, N, N * N);
             static V v1 (N, N), v2 (N, N);
             initialize_matrix (m);
             initialize_vector (v1);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * (N - 1), N * N + 2 * N, [&] () {
                 v2 = ublas::prod (m, v1);
 //                sink_vector (v2);
-            }
-            footer<value_type> () (N * N, N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
         }
     }
-    void operator () (int runs, fast_tag) const {
+    void operator () (fast_tag) const {
         try {
             static M m (N, N, N * N);
             static V v1 (N, N), v2 (N, N);
             initialize_matrix (m);
             initialize_vector (v1);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * (N - 1), N * N + 2 * N, [&] () {
                 v2.assign (ublas::prod (m, v1));
 //                sink_vector (v2);
-            }
-            footer<value_type> () (N * N, N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -177,21 +163,19 @@ template<class M, class V, int N>
 struct bench_cpp_matrix_vector_prod {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static M m (N * N);
             static V v1 (N), v2 (N);
             initialize_vector (m);
             initialize_vector (v1);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N, N * (N - 1), N * N + 2 * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     std::valarray<value_type> row (m [std::slice (N * j, N, 1)]);
                     v2 [j] = (row * v1).sum ();
                 }
 //                sink_vector (v2);
-            }
-            footer<value_type> () (N * N, N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -203,13 +187,12 @@ template<class T, int N>
 struct bench_c_matrix_add {
     typedef T value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static typename c_matrix_traits<T, N, N>::type m1, m2, m3;
             initialize_c_matrix<T, N, N> () (m1);
             initialize_c_matrix<T, N, N> () (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, 0, 2 * N * N, 3 * N * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     for (int k = 0; k < N; ++ k) {
                         m3 [j] [k] = - (m1 [j] [k] + m2 [j] [k]);
@@ -217,8 +200,7 @@ struct bench_c_matrix_add {
                 }
 //                sink_c_matrix<T, N, N> () (m3);
                 BOOST_UBLAS_NOT_USED(m3);
-            }
-            footer<value_type> () (0, 2 * N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -229,33 +211,29 @@ template<class M, int N>
 struct bench_my_matrix_add {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs, safe_tag) const {
+    void operator () (safe_tag) const {
         try {
             static M m1 (N, N, N * N), m2 (N, N, N * N), m3 (N, N, N * N);
             initialize_matrix (m1);
             initialize_matrix (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, 0, 2 * N * N, 3 * N * N, [&] () {
                 m3 = - (m1 + m2);
 //                sink_matrix (m3);
-            }
-            footer<value_type> () (0, 2 * N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
         }
     }
-    void operator () (int runs, fast_tag) const {
+    void operator () (fast_tag) const {
         try {
             static M m1 (N, N, N * N), m2 (N, N, N * N), m3 (N, N, N * N);
             initialize_matrix (m1);
             initialize_matrix (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, 0, 2 * N * N, 3 * N * N, [&] () {
                 m3.assign (- (m1 + m2));
 //                sink_matrix (m3);
-            }
-            footer<value_type> () (0, 2 * N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -266,17 +244,15 @@ template<class M, int N>
 struct bench_cpp_matrix_add {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static M m1 (N * N), m2 (N * N), m3 (N * N);
             initialize_vector (m1);
             initialize_vector (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, 0, 2 * N * N, 3 * N * N, [&] () {
                 m3 = - (m1 + m2);
 //                sink_vector (m3);
-            }
-            footer<value_type> () (0, 2 * N * N, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -286,155 +262,155 @@ struct bench_cpp_matrix_add {
 
 // Benchmark O (n ^ 2)
 template<class T, int N>
-void bench_2<T, N>::operator () (int runs) {
-    header ("bench_2");
+void bench_2<T, N>::operator () () {
+    section ("bench_2");
 
-    header ("outer_prod");
+    section ("outer_prod");
 
     header ("C array");
-    bench_c_outer_prod<T, N> () (runs);
+    bench_c_outer_prod<T, N> () ();
 
 #ifdef USE_SPARSE_MATRIX
 #ifdef USE_MAP_ARRAY
     header ("sparse_matrix<map_array>, sparse_vector<map_array> safe");
     bench_my_outer_prod<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >,
-                        ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (runs, safe_tag ());
+                        ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<map_array>, sparse_vector<map_array> fast");
     bench_my_outer_prod<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >,
-                        ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (runs, fast_tag ());
+                        ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_MAP
     header ("sparse_matrix<std::map>, sparse_vector<std::map> safe");
     bench_my_outer_prod<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >,
-                        ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (runs, safe_tag ());
+                        ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<std::map>, sparse_vector<std::map> fast");
     bench_my_outer_prod<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >,
-                        ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (runs, fast_tag ());
+                        ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (fast_tag ());
 #endif
 #endif
 
 #ifdef USE_COMPRESSED_MATRIX
     header ("compressed_matrix, compressed_vector safe");
     bench_my_outer_prod<ublas::compressed_matrix<T, ublas::row_major>,
-                        ublas::compressed_vector<T>, N> () (runs, safe_tag ());
+                        ublas::compressed_vector<T>, N> () (safe_tag ());
 
     header ("compressed_matrix, compressed_vector fast");
     bench_my_outer_prod<ublas::compressed_matrix<T, ublas::row_major>,
-                        ublas::compressed_vector<T>, N> () (runs, fast_tag ());
+                        ublas::compressed_vector<T>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_COORDINATE_MATRIX
     header ("coordinate_matrix, coordinate_vector safe");
     bench_my_outer_prod<ublas::coordinate_matrix<T, ublas::row_major>,
-                        ublas::coordinate_vector<T>, N> () (runs, safe_tag ());
+                        ublas::coordinate_vector<T>, N> () (safe_tag ());
 
     header ("coordinate_matrix, coordinate_vector fast");
     bench_my_outer_prod<ublas::coordinate_matrix<T, ublas::row_major>,
-                        ublas::coordinate_vector<T>, N> () (runs, fast_tag ());
+                        ublas::coordinate_vector<T>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_VALARRAY
     header ("std::valarray");
-    bench_cpp_outer_prod<std::valarray<T>, std::valarray<T>, N> () (runs);
+    bench_cpp_outer_prod<std::valarray<T>, std::valarray<T>, N> () ();
 #endif
 
-    header ("prod (matrix, vector)");
+    section ("prod (matrix, vector)");
 
     header ("C array");
-    bench_c_matrix_vector_prod<T, N> () (runs);
+    bench_c_matrix_vector_prod<T, N> () ();
 
 #ifdef USE_SPARSE_MATRIX
 #ifdef USE_MAP_ARRAY
     header ("sparse_matrix<map_array>, sparse_vector<map_array> safe");
     bench_my_matrix_vector_prod<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >,
-                                ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (runs, safe_tag ());
+                                ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<map_array>, sparse_vector<map_array> fast");
     bench_my_matrix_vector_prod<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >,
-                                ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (runs, fast_tag ());
+                                ublas::sparse_vector<T, ublas::map_array<std::size_t, T> >, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_MAP
     header ("sparse_matrix<std::map>, sparse_vector<std::map> safe");
     bench_my_matrix_vector_prod<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >,
-                                ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (runs, safe_tag ());
+                                ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<std::map>, sparse_vector<std::map> fast");
     bench_my_matrix_vector_prod<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >,
-                                ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (runs, fast_tag ());
+                                ublas::sparse_vector<T, std::map<std::size_t, T> >, N> () (fast_tag ());
 #endif
 #endif
 
 #ifdef USE_COMPRESSED_MATRIX
     header ("compressed_matrix, compressed_vector safe");
     bench_my_matrix_vector_prod<ublas::compressed_matrix<T, ublas::row_major>,
-                                ublas::compressed_vector<T>, N> () (runs, safe_tag ());
+                                ublas::compressed_vector<T>, N> () (safe_tag ());
 
     header ("compressed_matrix, compressed_vector fast");
     bench_my_matrix_vector_prod<ublas::compressed_matrix<T, ublas::row_major>,
-                                ublas::compressed_vector<T>, N> () (runs, fast_tag ());
+                                ublas::compressed_vector<T>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_COORDINATE_MATRIX
     header ("coordinate_matrix, coordinate_vector safe");
     bench_my_matrix_vector_prod<ublas::coordinate_matrix<T, ublas::row_major>,
-                                ublas::coordinate_vector<T>, N> () (runs, safe_tag ());
+                                ublas::coordinate_vector<T>, N> () (safe_tag ());
 
     header ("coordinate_matrix, coordinate_vector fast");
     bench_my_matrix_vector_prod<ublas::coordinate_matrix<T, ublas::row_major>,
-                                ublas::coordinate_vector<T>, N> () (runs, fast_tag ());
+                                ublas::coordinate_vector<T>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_VALARRAY
     header ("std::valarray");
-    bench_cpp_matrix_vector_prod<std::valarray<T>, std::valarray<T>, N> () (runs);
+    bench_cpp_matrix_vector_prod<std::valarray<T>, std::valarray<T>, N> () ();
 #endif
 
-    header ("matrix + matrix");
+    section ("matrix + matrix");
 
     header ("C array");
-    bench_c_matrix_add<T, N> () (runs);
+    bench_c_matrix_add<T, N> () ();
 
 #ifdef USE_SPARSE_MATRIX
 #ifdef USE_MAP_ARRAY
     header ("sparse_matrix<map_array> safe");
-    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >, N> () (runs, safe_tag ());
+    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<map_array> fast");
-    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >, N> () (runs, fast_tag ());
+    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_MAP
     header ("sparse_matrix<std::map> safe");
-    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >, N> () (runs, safe_tag ());
+    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<std::map> fast");
-    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >, N> () (runs, fast_tag ());
+    bench_my_matrix_add<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >, N> () (fast_tag ());
 #endif
 #endif
 
 #ifdef USE_COMPRESSED_MATRIX
     header ("compressed_matrix safe");
-    bench_my_matrix_add<ublas::compressed_matrix<T, ublas::row_major>, N> () (runs, safe_tag ());
+    bench_my_matrix_add<ublas::compressed_matrix<T, ublas::row_major>, N> () (safe_tag ());
 
     header ("compressed_matrix fast");
-    bench_my_matrix_add<ublas::compressed_matrix<T, ublas::row_major>, N> () (runs, fast_tag ());
+    bench_my_matrix_add<ublas::compressed_matrix<T, ublas::row_major>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_COORDINATE_MATRIX
     header ("coordinate_matrix safe");
-    bench_my_matrix_add<ublas::coordinate_matrix<T, ublas::row_major>, N> () (runs, safe_tag ());
+    bench_my_matrix_add<ublas::coordinate_matrix<T, ublas::row_major>, N> () (safe_tag ());
 
     header ("coordinate_matrix fast");
-    bench_my_matrix_add<ublas::coordinate_matrix<T, ublas::row_major>, N> () (runs, fast_tag ());
+    bench_my_matrix_add<ublas::coordinate_matrix<T, ublas::row_major>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_VALARRAY
     header ("std::valarray");
-    bench_cpp_matrix_add<std::valarray<T>, N> () (runs);
+    bench_cpp_matrix_add<std::valarray<T>, N> () ();
 #endif
 }
 
@@ -443,6 +419,7 @@ template struct bench_2<float, 3>;
 template struct bench_2<float, 10>;
 template struct bench_2<float, 30>;
 template struct bench_2<float, 100>;
+template struct bench_2<float, 300>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -450,6 +427,7 @@ template struct bench_2<double, 3>;
 template struct bench_2<double, 10>;
 template struct bench_2<double, 30>;
 template struct bench_2<double, 100>;
+template struct bench_2<double, 300>;
 #endif
 
 #ifdef USE_STD_COMPLEX
@@ -458,6 +436,7 @@ template struct bench_2<std::complex<float>, 3>;
 template struct bench_2<std::complex<float>, 10>;
 template struct bench_2<std::complex<float>, 30>;
 template struct bench_2<std::complex<float>, 100>;
+template struct bench_2<std::complex<float>, 300>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -465,5 +444,6 @@ template struct bench_2<std::complex<double>, 3>;
 template struct bench_2<std::complex<double>, 10>;
 template struct bench_2<std::complex<double>, 30>;
 template struct bench_2<std::complex<double>, 100>;
+template struct bench_2<std::complex<double>, 300>;
 #endif
 #endif
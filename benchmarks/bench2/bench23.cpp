@@ -16,13 +16,12 @@ template<class T, int N>
 struct bench_c_matrix_prod {
     typedef T value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static typename c_matrix_traits<T, N, N>::type m1, m2, m3;
             initialize_c_matrix<T, N, N> () (m1);
             initialize_c_matrix<T, N, N> () (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N * N, N * N * (N - 1), 3 * N * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     for (int k = 0; k < N; ++ k) {
                         m3 [j] [k] = 0;
@@ -32,8 +31,7 @@ struct bench_c_matrix_prod {
                     }
                 }
 //                sink_c_matrix<T, N, N> () (m3);
-            }
-            footer<value_type> () (N * N * N, N * N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -44,35 +42,31 @@ template<class M1, class M2, int N>
 struct bench_my_matrix_prod {
     typedef typename M1::value_type value_type;
 
-    void operator () (int runs, safe_tag) const {
+    void operator () (safe_tag) const {
         try {
             static M1 m1 (N, N, N * N), m3 (N, N, N * N);
             static M2 m2 (N, N, N * N);
             initialize_matrix (m1);
             initialize_matrix (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N * N, N * N * (N - 1), 3 * N * N, [&] () {
                 m3 = ublas::prod (m1, m2);
 //                sink_matrix (m3);
-            }
-            footer<value_type> () (N * N * N, N * N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
         }
     }
-    void operator () (int runs, fast_tag) const {
+    void operator () (fast_tag) const {
         try {
             static M1 m1 (N, N, N * N), m3 (N, N, N * N);
             static M2 m2 (N, N, N * N);
             initialize_matrix (m1);
             initialize_matrix (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N * N, N * N * (N - 1), 3 * N * N, [&] () {
                 m3.assign (ublas::prod (m1, m2));
 //                sink_matrix (m3);
-            }
-            footer<value_type> () (N * N * N, N * N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -83,13 +77,12 @@ template<class M, int N>
 struct bench_cpp_matrix_prod {
     typedef typename M::value_type value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static M m1 (N * N), m2 (N * N), m3 (N * N);
             initialize_vector (m1);
             initialize_vector (m2);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (N, N * N * N, N * N * (N - 1), 3 * N * N, [&] () {
                 for (int j = 0; j < N; ++ j) {
                     std::valarray<value_type> row (m1 [std::slice (N * j, N, 1)]);
                     for (int k = 0; k < N; ++ k) {
@@ -98,8 +91,7 @@ struct bench_cpp_matrix_prod {
                     }
                 }
 //                sink_vector (m3);
-            }
-            footer<value_type> () (N * N * N, N * N * (N - 1), runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -109,59 +101,59 @@ struct bench_cpp_matrix_prod {
 
 // Benchmark O (n ^ 3)
 template<class T, int N>
-void bench_3<T, N>::operator () (int runs) {
-    header ("bench_3");
+void bench_3<T, N>::operator () () {
+    section ("bench_3");
 
-    header ("prod (matrix, matrix)");
+    section ("prod (matrix, matrix)");
 
     header ("C array");
-    bench_c_matrix_prod<T, N> () (runs);
+    bench_c_matrix_prod<T, N> () ();
 
 #ifdef USE_SPARSE_MATRIX
 #ifdef USE_MAP_ARRAY
     header ("sparse_matrix<row_major, map_array>, sparse_matrix<column_major, map_array> safe");
     bench_my_matrix_prod<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >,
-                         ublas::sparse_matrix<T, ublas::column_major, ublas::map_array<std::size_t, T> >, N> () (runs, safe_tag ());
+                         ublas::sparse_matrix<T, ublas::column_major, ublas::map_array<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<row_major, map_array>, sparse_matrix<column_major, map_array> fast");
     bench_my_matrix_prod<ublas::sparse_matrix<T, ublas::row_major, ublas::map_array<std::size_t, T> >,
-                         ublas::sparse_matrix<T, ublas::column_major, ublas::map_array<std::size_t, T> >, N> () (runs, fast_tag ());
+                         ublas::sparse_matrix<T, ublas::column_major, ublas::map_array<std::size_t, T> >, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_MAP
     header ("sparse_matrix<row_major, std::map>, sparse_matrix<column_major, std::map> safe");
     bench_my_matrix_prod<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >,
-                         ublas::sparse_matrix<T, ublas::column_major, std::map<std::size_t, T> >, N> () (runs, safe_tag ());
+                         ublas::sparse_matrix<T, ublas::column_major, std::map<std::size_t, T> >, N> () (safe_tag ());
 
     header ("sparse_matrix<row_major, std::map>, sparse_matrix<column_major, std::map> fast");
     bench_my_matrix_prod<ublas::sparse_matrix<T, ublas::row_major, std::map<std::size_t, T> >,
-                         ublas::sparse_matrix<T, ublas::column_major, std::map<std::size_t, T> >, N> () (runs, fast_tag ());
+                         ublas::sparse_matrix<T, ublas::column_major, std::map<std::size_t, T> >, N> () (fast_tag ());
 #endif
 #endif
 
 #ifdef USE_COMPRESSED_MATRIX
     header ("compressed_matrix<row_major>, compressed_matrix<column_major> safe");
     bench_my_matrix_prod<ublas::compressed_matrix<T, ublas::row_major>,
-                         ublas::compressed_matrix<T, ublas::column_major>, N> () (runs, safe_tag ());
+                         ublas::compressed_matrix<T, ublas::column_major>, N> () (safe_tag ());
 
     header ("compressed_matrix<row_major>, compressed_matrix<column_major> fast");
     bench_my_matrix_prod<ublas::compressed_matrix<T, ublas::row_major>,
-                         ublas::compressed_matrix<T, ublas::column_major>, N> () (runs, fast_tag ());
+                         ublas::compressed_matrix<T, ublas::column_major>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_COORDINATE_MATRIX
     header ("coordinate_matrix<row_major>, coordinate_matrix<column_major> safe");
     bench_my_matrix_prod<ublas::coordinate_matrix<T, ublas::row_major>,
-                         ublas::coordinate_matrix<T, ublas::column_major>, N> () (runs, safe_tag ());
+                         ublas::coordinate_matrix<T, ublas::column_major>, N> () (safe_tag ());
 
     header ("coordinate_matrix<row_major>, coordinate_matrix<column_major> fast");
     bench_my_matrix_prod<ublas::coordinate_matrix<T, ublas::row_major>,
-                         ublas::coordinate_matrix<T, ublas::column_major>, N> () (runs, fast_tag ());
+                         ublas::coordinate_matrix<T, ublas::column_major>, N> () (fast_tag ());
 #endif
 
 #ifdef USE_STD_VALARRAY
     header ("std::valarray");
-    bench_cpp_matrix_prod<std::valarray<T>, N> () (runs);
+    bench_cpp_matrix_prod<std::valarray<T>, N> () ();
 #endif
 }
 
@@ -22,7 +22,7 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 
-#include <boost/timer.hpp>
+#include "../harness.hpp"
 
 
 #define BOOST_UBLAS_NOT_USED(x) (void)(x)
@@ -30,17 +30,12 @@
 
 namespace ublas = boost::numeric::ublas;
 
-void header (std::string text);
+using bench::header;
+using bench::section;
 
-template<class T>
-struct footer {
-    void operator () (int multiplies, int plus, int runs, double elapsed) {
-        std::cout << "elapsed: " << elapsed << " s, "
-                  << (multiplies * ublas::type_traits<T>::multiplies_complexity +
-                      plus * ublas::type_traits<T>::plus_complexity) * runs /
-                     (1024 * 1024 * elapsed) << " Mflops" << std::endl;
-    }
-};
+// c_vector, c_matrix and bounded_array keep their temporaries on the stack, so these
+// variants are only run up to bounded_limit elements
+const int bounded_limit = 100000;
 
 template<class T, int N>
 struct c_vector_traits {
@@ -125,22 +120,22 @@ void sink_matrix (const M &m) {
 
 template<class T>
 struct peak {
-    void operator () (int runs);
+    void operator () ();
 };
 
 template<class T, int N>
 struct bench_1 {
-    void operator () (int runs);
+    void operator () ();
 };
 
 template<class T, int N>
 struct bench_2 {
-    void operator () (int runs);
+    void operator () ();
 };
 
 template<class T, int N>
 struct bench_3 {
-    void operator () (int runs);
+    void operator () ();
 };
 
 struct safe_tag {};
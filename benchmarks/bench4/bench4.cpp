@@ -14,23 +14,17 @@
 #include <boost/numeric/interval/io.hpp>
 #include "../bench1/bench1.hpp"
 
-void header (std::string text) {
-    std::cout << text << std::endl;
-}
-
 template<class T>
 struct peak_c_plus {
     typedef T value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static T s (0);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (1, 0, 1, 0, [&] () {
                 s += T (0);
 //                sink_scalar (s);
-            }
-            footer<value_type> () (0, 1, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -41,15 +35,13 @@ template<class T>
 struct peak_c_multiplies {
     typedef T value_type;
 
-    void operator () (int runs) const {
+    void operator () () const {
         try {
             static T s (1);
-            boost::timer t;
-            for (int i = 0; i < runs; ++ i) {
+            bench::measure<value_type> (1, 1, 0, 0, [&] () {
                 s *= T (1);
 //                sink_scalar (s);
-            }
-            footer<value_type> () (0, 1, runs, t.elapsed ());
+            });
         }
         catch (std::exception &e) {
             std::cout << e.what () << std::endl;
@@ -58,14 +50,14 @@ struct peak_c_multiplies {
 };
 
 template<class T>
-void peak<T>::operator () (int runs) {
-    header ("peak");
+void peak<T>::operator () () {
+    section ("peak");
 
     header ("plus");
-    peak_c_plus<T> () (runs);
+    peak_c_plus<T> () ();
 
     header ("multiplies");
-    peak_c_multiplies<T> () (runs);
+    peak_c_multiplies<T> () ();
 }
 
 template struct peak<boost::numeric::interval<float> >;
@@ -81,55 +73,91 @@ template struct peak<boost::complex<boost::numeric::interval<double> > >;
 
 
 template <typename scalar> 
-void do_bench (std::string type_string, int scale)
+void do_bench (std::string type_string)
 {
-    header (type_string);
-    peak<scalar> () (1000000 * scale);
-
-    header (type_string + ", 3");
-    bench_1<scalar, 3> () (1000000 * scale);
-    bench_2<scalar, 3> () (300000 * scale);
-    bench_3<scalar, 3> () (100000 * scale);
-
-    header (type_string + ", 10");
-    bench_1<scalar, 10> () (300000 * scale);
-    bench_2<scalar, 10> () (30000 * scale);
-    bench_3<scalar, 10> () (3000 * scale);
-
-    header (type_string + ", 30");
-    bench_1<scalar, 30> () (100000 * scale);
-    bench_2<scalar, 30> () (3000 * scale);
-    bench_3<scalar, 30> () (100 * scale);
-
-    header (type_string + ", 100");
-    bench_1<scalar, 100> () (30000 * scale);
-    bench_2<scalar, 100> () (300 * scale);
-    bench_3<scalar, 100> () (3 * scale);
+    bench::scalar (type_string);
+    peak<scalar> () ();
+
+    // from sizes held in registers and the first level cache to sizes exceeding the last
+    // level cache; the O(N^3) products stop earlier
+    if (bench::size_enabled (3)) {
+        section ("size 3");
+        bench_1<scalar, 3> () ();
+        bench_2<scalar, 3> () ();
+        bench_3<scalar, 3> () ();
+    }
+
+    if (bench::size_enabled (10)) {
+        section ("size 10");
+        bench_1<scalar, 10> () ();
+        bench_2<scalar, 10> () ();
+        bench_3<scalar, 10> () ();
+    }
+
+    if (bench::size_enabled (30)) {
+        section ("size 30");
+        bench_1<scalar, 30> () ();
+        bench_2<scalar, 30> () ();
+        bench_3<scalar, 30> () ();
+    }
+
+    if (bench::size_enabled (100)) {
+        section ("size 100");
+        bench_1<scalar, 100> () ();
+        bench_2<scalar, 100> () ();
+        bench_3<scalar, 100> () ();
+    }
+
+    if (bench::size_enabled (300)) {
+        section ("size 300");
+        bench_1<scalar, 300> () ();
+        bench_2<scalar, 300> () ();
+        bench_3<scalar, 300> () ();
+    }
+
+    if (bench::size_enabled (1000)) {
+        section ("size 1000");
+        bench_1<scalar, 1000> () ();
+        bench_2<scalar, 1000> () ();
+    }
+
+    if (bench::size_enabled (10000)) {
+        section ("size 10000");
+        bench_1<scalar, 10000> () ();
+    }
+
+    if (bench::size_enabled (100000)) {
+        section ("size 100000");
+        bench_1<scalar, 100000> () ();
+    }
+
+    if (bench::size_enabled (1000000)) {
+        section ("size 1000000");
+        bench_1<scalar, 1000000> () ();
+    }
 }
 
 int main (int argc, char *argv []) {
 
-    int scale = 1;
-    if (argc > 1)
-        scale = std::atoi (argv [1]);
+    bench::start ("bench4", argc, argv);
 
 #ifdef USE_FLOAT
-    do_bench<boost::numeric::interval<float> > ("boost::numeric::interval<FLOAT>", scale);
+    do_bench<boost::numeric::interval<float> > ("boost::numeric::interval<FLOAT>");
 #endif
 
 #ifdef USE_DOUBLE
-    do_bench<boost::numeric::interval<double> > ("boost::numeric::interval<DOUBLE>", scale);
+    do_bench<boost::numeric::interval<double> > ("boost::numeric::interval<DOUBLE>");
 #endif
 
 #ifdef USE_STD_COMPLEX
 #ifdef USE_FLOAT
-    do_bench<std::complex<boost::numeric::interval<float> > > ("boost::numeric::interval<COMPLEX<FLOAT>>", scale);
+    do_bench<std::complex<boost::numeric::interval<float> > > ("boost::numeric::interval<COMPLEX<FLOAT>>");
 #endif
 
 #ifdef USE_DOUBLE
-    do_bench<std::complex<doublboost::numeric::interval<double> > > ("boost::numeric::interval<COMPLEX<DOUBLE>>", scale);
+    do_bench<std::complex<doublboost::numeric::interval<double> > > ("boost::numeric::interval<COMPLEX<DOUBLE>>");
 #endif
 #endif
 
-    return 0;
+    return bench::finish ();
 }
@@ -20,6 +20,11 @@ template struct bench_1<boost::numeric::interval<float>, 3>;
 template struct bench_1<boost::numeric::interval<float>, 10>;
 template struct bench_1<boost::numeric::interval<float>, 30>;
 template struct bench_1<boost::numeric::interval<float>, 100>;
+template struct bench_1<boost::numeric::interval<float>, 300>;
+template struct bench_1<boost::numeric::interval<float>, 1000>;
+template struct bench_1<boost::numeric::interval<float>, 10000>;
+template struct bench_1<boost::numeric::interval<float>, 100000>;
+template struct bench_1<boost::numeric::interval<float>, 1000000>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -27,6 +32,11 @@ template struct bench_1<boost::numeric::interval<double>, 3>;
 template struct bench_1<boost::numeric::interval<double>, 10>;
 template struct bench_1<boost::numeric::interval<double>, 30>;
 template struct bench_1<boost::numeric::interval<double>, 100>;
+template struct bench_1<boost::numeric::interval<double>, 300>;
+template struct bench_1<boost::numeric::interval<double>, 1000>;
+template struct bench_1<boost::numeric::interval<double>, 10000>;
+template struct bench_1<boost::numeric::interval<double>, 100000>;
+template struct bench_1<boost::numeric::interval<double>, 1000000>;
 #endif
 
 #ifdef USE_BOOST_COMPLEX
@@ -35,6 +45,11 @@ template struct bench_1<boost::complex<boost::numeric::interval<float> >, 3>;
 template struct bench_1<boost::complex<boost::numeric::interval<float> >, 10>;
 template struct bench_1<boost::complex<boost::numeric::interval<float> >, 30>;
 template struct bench_1<boost::complex<boost::numeric::interval<float> >, 100>;
+template struct bench_1<boost::complex<boost::numeric::interval<float> >, 300>;
+template struct bench_1<boost::complex<boost::numeric::interval<float> >, 1000>;
+template struct bench_1<boost::complex<boost::numeric::interval<float> >, 10000>;
+template struct bench_1<boost::complex<boost::numeric::interval<float> >, 100000>;
+template struct bench_1<boost::complex<boost::numeric::interval<float> >, 1000000>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -42,5 +57,10 @@ template struct bench_1<boost::complex<boost::numeric::interval<double> >, 3>;
 template struct bench_1<boost::complex<boost::numeric::interval<double> >, 10>;
 template struct bench_1<boost::complex<boost::numeric::interval<double> >, 30>;
 template struct bench_1<boost::complex<boost::numeric::interval<double> >, 100>;
+template struct bench_1<boost::complex<boost::numeric::interval<double> >, 300>;
+template struct bench_1<boost::complex<boost::numeric::interval<double> >, 1000>;
+template struct bench_1<boost::complex<boost::numeric::interval<double> >, 10000>;
+template struct bench_1<boost::complex<boost::numeric::interval<double> >, 100000>;
+template struct bench_1<boost::complex<boost::numeric::interval<double> >, 1000000>;
 #endif
 #endif
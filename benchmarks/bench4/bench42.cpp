@@ -20,6 +20,8 @@ template struct bench_2<boost::numeric::interval<float>, 3>;
 template struct bench_2<boost::numeric::interval<float>, 10>;
 template struct bench_2<boost::numeric::interval<float>, 30>;
 template struct bench_2<boost::numeric::interval<float>, 100>;
+template struct bench_2<boost::numeric::interval<float>, 300>;
+template struct bench_2<boost::numeric::interval<float>, 1000>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -27,6 +29,8 @@ template struct bench_2<boost::numeric::interval<double>, 3>;
 template struct bench_2<boost::numeric::interval<double>, 10>;
 template struct bench_2<boost::numeric::interval<double>, 30>;
 template struct bench_2<boost::numeric::interval<double>, 100>;
+template struct bench_2<boost::numeric::interval<double>, 300>;
+template struct bench_2<boost::numeric::interval<double>, 1000>;
 #endif
 
 #ifdef USE_BOOST_COMPLEX
@@ -35,6 +39,8 @@ template struct bench_2<boost::complex<boost::numeric::interval<float> >, 3>;
 template struct bench_2<boost::complex<boost::numeric::interval<float> >, 10>;
 template struct bench_2<boost::complex<boost::numeric::interval<float> >, 30>;
 template struct bench_2<boost::complex<boost::numeric::interval<float> >, 100>;
+template struct bench_2<boost::complex<boost::numeric::interval<float> >, 300>;
+template struct bench_2<boost::complex<boost::numeric::interval<float> >, 1000>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -42,5 +48,7 @@ template struct bench_2<boost::complex<boost::numeric::interval<double> >, 3>;
 template struct bench_2<boost::complex<boost::numeric::interval<double> >, 10>;
 template struct bench_2<boost::complex<boost::numeric::interval<double> >, 30>;
 template struct bench_2<boost::complex<boost::numeric::interval<double> >, 100>;
+template struct bench_2<boost::complex<boost::numeric::interval<double> >, 300>;
+template struct bench_2<boost::complex<boost::numeric::interval<double> >, 1000>;
 #endif
 #endif
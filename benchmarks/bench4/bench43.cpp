@@ -20,6 +20,7 @@ template struct bench_3<boost::numeric::interval<float>, 3>;
 template struct bench_3<boost::numeric::interval<float>, 10>;
 template struct bench_3<boost::numeric::interval<float>, 30>;
 template struct bench_3<boost::numeric::interval<float>, 100>;
+template struct bench_3<boost::numeric::interval<float>, 300>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -27,6 +28,7 @@ template struct bench_3<boost::numeric::interval<double>, 3>;
 template struct bench_3<boost::numeric::interval<double>, 10>;
 template struct bench_3<boost::numeric::interval<double>, 30>;
 template struct bench_3<boost::numeric::interval<double>, 100>;
+template struct bench_3<boost::numeric::interval<double>, 300>;
 #endif
 
 #ifdef USE_BOOST_COMPLEX
@@ -35,6 +37,7 @@ template struct bench_3<boost::complex<boost::numeric::interval<float> >, 3>;
 template struct bench_3<boost::complex<boost::numeric::interval<float> >, 10>;
 template struct bench_3<boost::complex<boost::numeric::interval<float> >, 30>;
 template struct bench_3<boost::complex<boost::numeric::interval<float> >, 100>;
+template struct bench_3<boost::complex<boost::numeric::interval<float> >, 300>;
 #endif
 
 #ifdef USE_DOUBLE
@@ -42,5 +45,6 @@ template struct bench_3<boost::complex<boost::numeric::interval<double> >, 3>;
 template struct bench_3<boost::complex<boost::numeric::interval<double> >, 10>;
 template struct bench_3<boost::complex<boost::numeric::interval<double> >, 30>;
 template struct bench_3<boost::complex<boost::numeric::interval<double> >, 100>;
+template struct bench_3<boost::complex<boost::numeric::interval<double> >, 300>;
 #endif
 #endif
@@ -0,0 +1,228 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <complex>
+#include <random>
+#include "../harness.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+typedef ublas::permutation_matrix<std::size_t> pmatrix;
+
+// Right hand sides of the multiple right hand side solves
+const std::size_t multiple_rhs = 32;
+
+template<class T>
+struct random_value {
+    T operator () (std::mt19937 &g) const {
+        return std::uniform_real_distribution<T> (-1, 1) (g);
+    }
+};
+template<class T>
+struct random_value<std::complex<T> > {
+    std::complex<T> operator () (std::mt19937 &g) const {
+        std::uniform_real_distribution<T> u (-1, 1);
+        const T re (u (g));
+        return std::complex<T> (re, u (g));
+    }
+};
+
+template<class M>
+void initialize (M &m, std::mt19937 &g) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = random_value<typename M::value_type> () (g);
+}
+template<class T>
+void initialize (ublas::vector<T> &v, std::mt19937 &g) {
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        v (i) = random_value<T> () (g);
+}
+
+// Normwise backward error of a solution X of A X = B: ||B - A X|| / (||A|| ||X|| + ||B||)
+template<class M, class X, class B>
+double backward_error (const M &a, const X &x, const B &b) {
+    return double (ublas::norm_inf (b - ublas::prod (a, x))) /
+           (double (ublas::norm_inf (a)) * double (ublas::norm_inf (x)) + double (ublas::norm_inf (b)));
+}
+
+// The rate of the last case as a fraction of the GEMM peak
+void annotate_peak (double peak) {
+    const bench::result &res (bench::current ().results.back ());
+    bench::annotate ("peak_fraction", res.flops / res.median / peak);
+}
+
+// GEMM by axpy_prod, the fastest dense product of the library
+template<class T, class L>
+double gemm_rate (std::size_t n, std::mt19937 &g) {
+    ublas::matrix<T, L> a (n, n), b (n, n), c (n, n);
+    initialize (a, g);
+    initialize (b, g);
+    const double nnn (double (n) * n * n);
+    const double t (bench::measure<T> (n, nnn, nnn, 3.0 * n * n, [&] () {
+        ublas::axpy_prod (a, b, c, true);
+    }));
+    return bench::current ().results.back ().flops / t;
+}
+
+// Factorizations and solves of one size and orientation. Every iteration copies its
+// operands, which costs a fraction 1/n of the work or less.
+template<class T, class L>
+void bench_size (std::size_t n, double peak, std::mt19937 &g) {
+    typedef ublas::matrix<T, L> matrix_type;
+    typedef ublas::vector<T> vector_type;
+
+    matrix_type a (n, n), f (n, n), b (n, multiple_rhs), x (n, multiple_rhs);
+    vector_type bv (n), xv (n);
+    initialize (a, g);
+    initialize (b, g);
+    initialize (bv, g);
+    const double nn (double (n) * n), nnn (nn * n);
+
+    // LU: n^3 / 3 multiplications and as many additions, to leading order
+    bench::header ("lu_factorize");
+    bench::measure<T> (n, nnn / 3, nnn / 3, 2 * nn, [&] () {
+        f = a;
+        pmatrix pm (n);
+        ublas::lu_factorize (f, pm);
+    });
+    f = a;
+    pmatrix pm (n);
+    ublas::lu_factorize (f, pm);
+    xv = bv;
+    ublas::lu_substitute (f, pm, xv);
+    bench::annotate ("backward_error", backward_error (a, xv, bv));
+    annotate_peak (peak);
+
+    bench::header ("axpy_lu_factorize");
+    bench::measure<T> (n, nnn / 3, nnn / 3, 2 * nn, [&] () {
+        f = a;
+        pmatrix pm (n);
+        ublas::axpy_lu_factorize (f, pm);
+    });
+    f = a;
+    pmatrix apm (n);
+    ublas::axpy_lu_factorize (f, apm);
+    xv = bv;
+    ublas::lu_substitute (f, apm, xv);
+    bench::annotate ("backward_error", backward_error (a, xv, bv));
+    annotate_peak (peak);
+
+    // Solves with the factors of lu_factorize: n^2 multiplications and additions per
+    // right hand side
+    f = a;
+    ublas::lu_factorize (f, pm);
+
+    bench::header ("lu_substitute, vector");
+    bench::measure<T> (n, nn, nn, nn + 3 * n, [&] () {
+        xv = bv;
+        ublas::lu_substitute (f, pm, xv);
+    });
+    bench::annotate ("backward_error", backward_error (a, xv, bv));
+    annotate_peak (peak);
+
+    bench::header ("lu_substitute, matrix");
+    bench::measure<T> (n, nn * multiple_rhs, nn * multiple_rhs, nn + 3.0 * n * multiple_rhs, [&] () {
+        x = b;
+        ublas::lu_substitute (f, pm, x);
+    });
+    bench::annotate ("backward_error", backward_error (a, x, b));
+    annotate_peak (peak);
+
+    bench::header ("lu_substitute, transposed vector");
+    bench::measure<T> (n, nn, nn, nn + 3 * n, [&] () {
+        xv = bv;
+        ublas::lu_substitute (xv, f, pm);
+    });
+    bench::annotate ("backward_error", backward_error (ublas::trans (a), xv, bv));
+    annotate_peak (peak);
+
+    // Triangular solves with the factors: n^2 / 2 multiplications and additions per
+    // right hand side
+    const ublas::triangular_adaptor<const matrix_type, ublas::unit_lower> lower (f);
+    const ublas::triangular_adaptor<const matrix_type, ublas::upper> upper (f);
+
+    bench::header ("inplace_solve, unit lower, vector");
+    bench::measure<T> (n, nn / 2, nn / 2, nn / 2 + 3 * n, [&] () {
+        xv = bv;
+        ublas::inplace_solve (f, xv, ublas::unit_lower_tag ());
+    });
+    bench::annotate ("backward_error", backward_error (lower, xv, bv));
+    annotate_peak (peak);
+
+    bench::header ("inplace_solve, upper, vector");
+    bench::measure<T> (n, nn / 2, nn / 2, nn / 2 + 3 * n, [&] () {
+        xv = bv;
+        ublas::inplace_solve (f, xv, ublas::upper_tag ());
+    });
+    bench::annotate ("backward_error", backward_error (upper, xv, bv));
+    annotate_peak (peak);
+
+    bench::header ("inplace_solve, unit lower, matrix");
+    bench::measure<T> (n, nn / 2 * multiple_rhs, nn / 2 * multiple_rhs, nn / 2 + 3.0 * n * multiple_rhs, [&] () {
+        x = b;
+        ublas::inplace_solve (f, x, ublas::unit_lower_tag ());
+    });
+    bench::annotate ("backward_error", backward_error (lower, x, b));
+    annotate_peak (peak);
+
+    bench::header ("inplace_solve, upper, matrix");
+    bench::measure<T> (n, nn / 2 * multiple_rhs, nn / 2 * multiple_rhs, nn / 2 + 3.0 * n * multiple_rhs, [&] () {
+        x = b;
+        ublas::inplace_solve (f, x, ublas::upper_tag ());
+    });
+    bench::annotate ("backward_error", backward_error (upper, x, b));
+    annotate_peak (peak);
+}
+
+template<class T>
+void do_bench (const std::string &type_string) {
+    bench::scalar (type_string);
+    std::mt19937 g (1);
+
+    // The peak is the best GEMM rate of both orientations up to n = 512
+    bench::section ("gemm");
+    double peak (0);
+    for (std::size_t n = 64; n <= 512; n *= 2) {
+        if (! bench::size_enabled (n))
+            break;
+        bench::header ("axpy_prod, row_major");
+        peak = (std::max) (peak, gemm_rate<T, ublas::row_major> (n, g));
+        bench::header ("axpy_prod, column_major");
+        peak = (std::max) (peak, gemm_rate<T, ublas::column_major> (n, g));
+    }
+    if (peak == 0) {
+        bench::header ("axpy_prod, row_major");
+        peak = gemm_rate<T, ublas::row_major> (16, g);
+    }
+    bench::log () << "    peak " << peak * 1.0e-9 << " GFLOP/s" << std::endl;
+
+    for (std::size_t n = 16; n <= 4096; n *= 2) {
+        if (! bench::size_enabled (n))
+            break;
+        bench::section ("row_major");
+        bench_size<T, ublas::row_major> (n, peak, g);
+        bench::section ("column_major");
+        bench_size<T, ublas::column_major> (n, peak, g);
+    }
+}
+
+int main (int argc, char *argv []) {
+
+    bench::start ("bench6", argc, argv);
+
+    do_bench<float> ("FLOAT");
+    do_bench<double> ("DOUBLE");
+    do_bench<std::complex<float> > ("COMPLEX<FLOAT>");
+    do_bench<std::complex<double> > ("COMPLEX<DOUBLE>");
+
+    return bench::finish ();
+}
@@ -0,0 +1,372 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <boost/numeric/ublas/vector_of_vector.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <random>
+#include <utility>
+#include "../harness.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+typedef double value_type;
+typedef std::size_t size_type;
+
+typedef ublas::compressed_matrix<value_type> compressed_type;
+typedef ublas::coordinate_matrix<value_type> coordinate_type;
+typedef ublas::mapped_matrix<value_type> mapped_type;
+typedef ublas::generalized_vector_of_vector<value_type, ublas::row_major,
+                                            ublas::vector<ublas::compressed_vector<value_type> > > vector_of_vector_type;
+
+// mapped_matrix and generalized_vector_of_vector allocate per element or per row and
+// take seconds per operation beyond this number of rows
+const size_type node_limit = 100000;
+
+struct entry {
+    size_type i, j;
+    value_type v;
+};
+typedef std::vector<entry> entries;
+
+bool operator < (const entry &e1, const entry &e2) {
+    return e1.i < e2.i || (e1.i == e2.i && e1.j < e2.j);
+}
+
+// A generated matrix: its entries as generated, duplicates included, and sorted by rows
+// with the duplicates summed
+struct sparse_case {
+    size_type size;
+    entries raw, sorted;
+};
+
+void sort_entries (const entries &raw, entries &sorted) {
+    sorted = raw;
+    std::sort (sorted.begin (), sorted.end ());
+    size_type filled (0);
+    for (size_type k = 1; k < sorted.size (); ++ k) {
+        if (sorted [k].i == sorted [filled].i && sorted [k].j == sorted [filled].j)
+            sorted [filled].v += sorted [k].v;
+        else
+            sorted [++ filled] = sorted [k];
+    }
+    sorted.resize (sorted.empty () ? 0 : filled + 1);
+}
+
+void add (entries &e, size_type i, size_type j, value_type v) {
+    entry t = { i, j, v };
+    e.push_back (t);
+}
+
+// Matrix families, generated for about the given number of rows
+
+// Five point Laplacian on a k x k grid
+size_type laplace_2d (size_type rows, std::mt19937 &, entries &e) {
+    const size_type k ((std::max) (size_type (2), size_type (std::sqrt (double (rows)) + 0.5)));
+    for (size_type y = 0; y < k; ++ y) {
+        for (size_type x = 0; x < k; ++ x) {
+            const size_type i (y * k + x);
+            if (y > 0)
+                add (e, i, i - k, -1);
+            if (x > 0)
+                add (e, i, i - 1, -1);
+            add (e, i, i, 4);
+            if (x + 1 < k)
+                add (e, i, i + 1, -1);
+            if (y + 1 < k)
+                add (e, i, i + k, -1);
+        }
+    }
+    return k * k;
+}
+
+// Seven point Laplacian on a k x k x k grid
+size_type laplace_3d (size_type rows, std::mt19937 &, entries &e) {
+    const size_type k ((std::max) (size_type (2), size_type (std::pow (double (rows), 1.0 / 3) + 0.5)));
+    for (size_type z = 0; z < k; ++ z) {
+        for (size_type y = 0; y < k; ++ y) {
+            for (size_type x = 0; x < k; ++ x) {
+                const size_type i ((z * k + y) * k + x);
+                if (z > 0)
+                    add (e, i, i - k * k, -1);
+                if (y > 0)
+                    add (e, i, i - k, -1);
+                if (x > 0)
+                    add (e, i, i - 1, -1);
+                add (e, i, i, 6);
+                if (x + 1 < k)
+                    add (e, i, i + 1, -1);
+                if (y + 1 < k)
+                    add (e, i, i + k, -1);
+                if (z + 1 < k)
+                    add (e, i, i + k * k, -1);
+            }
+        }
+    }
+    return k * k * k;
+}
+
+// Finite element like pattern: elements of four nodes with three degrees of freedom,
+// visited in random order, each adding a dense 12 x 12 block. The nodes of an element
+// are close in the numbering, as after a bandwidth reducing ordering.
+size_type fem_blocks (size_type rows, std::mt19937 &g, entries &e) {
+    const size_type dofs (3), nodes ((std::max) (size_type (8), rows / dofs)), window (32);
+    std::uniform_int_distribution<size_type> first (0, nodes - 1), offset (1, window);
+    std::uniform_real_distribution<value_type> value (-0.5, 0.5);
+    for (size_type element = 0; element < nodes; ++ element) {
+        size_type node [4];
+        node [0] = first (g);
+        for (size_type k = 1; k < 4; ++ k)
+            node [k] = (std::min) (nodes - 1, node [0] + offset (g));
+        for (size_type a = 0; a < 4; ++ a)
+            for (size_type da = 0; da < dofs; ++ da)
+                for (size_type b = 0; b < 4; ++ b)
+                    for (size_type db = 0; db < dofs; ++ db)
+                        add (e, node [a] * dofs + da, node [b] * dofs + db,
+                             a == b && da == db ? 4 : value (g));
+    }
+    return nodes * dofs;
+}
+
+// Power law graph: recursive matrix (R-MAT) generator with the Graph500 probabilities
+// 0.57, 0.19, 0.19 and 0.05, 8 edges per row and randomly relabelled vertices, plus
+// the diagonal
+size_type rmat (size_type rows, std::mt19937 &g, entries &e) {
+    const size_type n ((std::max) (size_type (2), rows));
+    size_type scale (0);
+    while ((size_type (1) << scale) < n)
+        ++ scale;
+    std::vector<size_type> label (n);
+    for (size_type i = 0; i < n; ++ i)
+        label [i] = i;
+    std::shuffle (label.begin (), label.end (), g);
+    std::uniform_real_distribution<double> u (0, 1);
+    std::uniform_real_distribution<value_type> value (-1, 1);
+    for (size_type edge = 0; edge < 8 * n; ++ edge) {
+        size_type i, j;
+        do {
+            i = j = 0;
+            for (size_type bit = 0; bit < scale; ++ bit) {
+                const double r (u (g));
+                if (r >= 0.57 + 0.19 + 0.19)
+                    i |= size_type (1) << bit, j |= size_type (1) << bit;
+                else if (r >= 0.57 + 0.19)
+                    i |= size_type (1) << bit;
+                else if (r >= 0.57)
+                    j |= size_type (1) << bit;
+            }
+        } while (i >= n || j >= n);
+        add (e, label [i], label [j], value (g));
+    }
+    for (size_type i = 0; i < n; ++ i)
+        add (e, i, i, 8);
+    return n;
+}
+
+// Assembly the way each format is filled: compressed_matrix appends the sorted
+// entries, coordinate_matrix appends the entries as generated and sums the duplicates
+// when sorted, and the other formats insert the entries as generated
+void assemble (compressed_type &m, const entries &/*raw*/, const entries &sorted) {
+    for (size_type k = 0; k < sorted.size (); ++ k)
+        m.push_back (sorted [k].i, sorted [k].j, sorted [k].v);
+}
+void assemble (coordinate_type &m, const entries &raw, const entries &/*sorted*/) {
+    for (size_type k = 0; k < raw.size (); ++ k)
+        m.append_element (raw [k].i, raw [k].j, raw [k].v);
+    m.sort ();
+}
+template<class M>
+void assemble (M &m, const entries &raw, const entries &/*sorted*/) {
+    for (size_type k = 0; k < raw.size (); ++ k)
+        m (raw [k].i, raw [k].j) += raw [k].v;
+}
+
+// Products of coordinate matrices are formed in compressed storage, since every
+// element assignment looks the element up and so merges the appended entries first
+template<class M>
+struct product_matrix {
+    typedef M type;
+};
+template<>
+struct product_matrix<coordinate_type> {
+    typedef compressed_type type;
+};
+
+// Cases of a single format
+template<class M>
+void format_specific (const std::string &/*format*/, const sparse_case &/*c*/, const M &/*a*/) {}
+
+void format_specific (const std::string &format, const sparse_case &c, const coordinate_type &a) {
+    const size_type n (c.size), nnz (c.sorted.size ());
+    const double raw_bytes (c.raw.size () * (sizeof (value_type) + 2 * sizeof (size_type)));
+    const double bytes (nnz * (sizeof (value_type) + 2 * sizeof (size_type)));
+
+    bench::header (format + ", append unsorted");
+    bench::measure_rates (n, 0, 2 * raw_bytes, [&] () {
+        coordinate_type m (n, n, c.raw.size ());
+        for (size_type k = 0; k < c.raw.size (); ++ k)
+            m.append_element (c.raw [k].i, c.raw [k].j, c.raw [k].v);
+    });
+
+    const compressed_type converted (a);
+    bench::header (format + ", conversion to compressed");
+    bench::measure_rates (n, 0, bytes + nnz * (sizeof (value_type) + sizeof (size_type)) + (n + 1) * sizeof (size_type), [&] () {
+        compressed_type m (a);
+        bench::clobber (&m);
+    });
+    bench::header (format + ", conversion from compressed");
+    bench::measure_rates (n, 0, bytes + nnz * (sizeof (value_type) + sizeof (size_type)) + (n + 1) * sizeof (size_type), [&] () {
+        coordinate_type m (converted);
+        bench::clobber (&m);
+    });
+}
+
+// Bandwidths are effective ones: the bytes of the compressed (CSR) form of the matrices
+// and of the dense vectors read or written, whatever the format
+template<class M>
+void bench_format (const std::string &format, const sparse_case &c, size_type product_limit) {
+    const size_type n (c.size), nnz (c.sorted.size ());
+    const double matrix_bytes (nnz * (sizeof (value_type) + sizeof (size_type)) + (n + 1) * sizeof (size_type));
+    const double vector_bytes (n * sizeof (value_type));
+    const double raw_bytes (c.raw.size () * (sizeof (value_type) + 2 * sizeof (size_type)));
+
+    bench::header (format + ", assembly");
+    bench::measure_rates (n, 0, raw_bytes + matrix_bytes, [&] () {
+        M m (n, n, nnz);
+        assemble (m, c.raw, c.sorted);
+        bench::clobber (&m);
+    });
+    M a (n, n, nnz);
+    assemble (a, c.raw, c.sorted);
+    format_specific (format, c, a);
+
+    std::mt19937 g (1);
+    std::uniform_real_distribution<value_type> value (-1, 1);
+    ublas::vector<value_type> x (n), y (n), b (n);
+    for (size_type i = 0; i < n; ++ i)
+        x (i) = value (g);
+
+    bench::header (format + ", spmv");
+    bench::measure_rates (n, 2.0 * nnz, matrix_bytes + 2 * vector_bytes, [&] () {
+        ublas::axpy_prod (a, x, y, true);
+    });
+    bench::header (format + ", transposed spmv");
+    bench::measure_rates (n, 2.0 * nnz, matrix_bytes + 3 * vector_bytes, [&] () {
+        ublas::axpy_prod (x, a, y, true);
+    });
+
+    // A A: the multiplications are the row lengths of A summed over its entries
+    if (n <= product_limit) {
+        std::vector<size_type> row_length (n, 0);
+        for (size_type k = 0; k < nnz; ++ k)
+            ++ row_length [c.sorted [k].i];
+        double multiplies (0);
+        for (size_type k = 0; k < nnz; ++ k)
+            multiplies += row_length [c.sorted [k].j];
+        typedef typename product_matrix<M>::type product_type;
+        product_type p (n, n);
+        ublas::sparse_prod (a, a, p);
+        const size_type product_nnz (p.nnz ());
+        bench::header (format + ", spgemm");
+        bench::measure_rates (n, 2 * multiplies, 2 * matrix_bytes + product_nnz * (sizeof (value_type) + sizeof (size_type)) + (n + 1) * sizeof (size_type), [&] () {
+            product_type m (n, n, product_nnz);
+            ublas::sparse_prod (a, a, m, false);
+            bench::clobber (&m);
+        });
+    }
+
+    // The lower triangle with a dominant diagonal
+    entries lower;
+    std::vector<value_type> diagonal (n, 1);
+    for (size_type k = 0; k < nnz; ++ k) {
+        const entry &e (c.sorted [k]);
+        if (e.j < e.i) {
+            lower.push_back (e);
+            diagonal [e.i] += std::abs (e.v);
+        }
+        else if (e.j == e.i) {
+            entry d = { e.i, e.i, 0 };
+            lower.push_back (d);
+        }
+    }
+    for (size_type k = 0; k < lower.size (); ++ k)
+        if (lower [k].i == lower [k].j)
+            lower [k].v = diagonal [lower [k].i];
+    M l (n, n, lower.size ());
+    assemble (l, lower, lower);
+    for (size_type i = 0; i < n; ++ i)
+        b (i) = value (g);
+    bench::header (format + ", lower triangular solve");
+    bench::measure_rates (n, 2.0 * lower.size () - n, lower.size () * (sizeof (value_type) + sizeof (size_type)) + (n + 1) * sizeof (size_type) + 3 * vector_bytes, [&] () {
+        y = b;
+        ublas::inplace_solve (l, y, ublas::lower_tag ());
+    });
+
+    // Lookups of stored entries in random order
+    std::vector<std::pair<size_type, size_type> > probes;
+    for (size_type k = 0; k < nnz; ++ k)
+        probes.push_back (std::make_pair (c.sorted [k].i, c.sorted [k].j));
+    std::shuffle (probes.begin (), probes.end (), g);
+    probes.resize ((std::min) (probes.size (), size_type (100000)));
+    const M &ca (a);
+    bench::header (format + ", element access");
+    bench::measure_rates (n, 0, probes.size () * sizeof (value_type), [&] () {
+        value_type s (0);
+        for (size_type k = 0; k < probes.size (); ++ k)
+            s += ca (probes [k].first, probes [k].second);
+        bench::clobber (&s);
+    });
+}
+
+typedef size_type (*generator) (size_type rows, std::mt19937 &g, entries &e);
+
+// The row count limits of the products: the sparse product scans a dense accumulator
+// over the column range of each row, which spans all columns for the R-MAT graphs, and
+// the finite element products have about ten times the entries of the stencil ones
+struct family {
+    const char *name;
+    generator generate;
+    size_type product_limit;
+};
+
+int main (int argc, char *argv []) {
+
+    bench::start ("bench7", argc, argv);
+    bench::scalar ("DOUBLE");
+
+    const family families [] = {
+        { "laplace 2d", laplace_2d, 100000 },
+        { "laplace 3d", laplace_3d, 100000 },
+        { "fem blocks", fem_blocks, 10000 },
+        { "rmat", rmat, 10000 }
+    };
+    const size_type sizes [] = { 10000, 100000, 1000000, 10000000 };
+
+    for (size_type f = 0; f < sizeof (families) / sizeof (families [0]); ++ f) {
+        for (size_type s = 0; s < sizeof (sizes) / sizeof (sizes [0]); ++ s) {
+            if (! bench::size_enabled (sizes [s]))
+                continue;
+            sparse_case c;
+            std::mt19937 g (sizes [s]);
+            c.size = families [f].generate (sizes [s], g, c.raw);
+            sort_entries (c.raw, c.sorted);
+            bench::section (families [f].name);
+            bench::log () << "    " << c.size << " rows, " << c.sorted.size () << " entries" << std::endl;
+
+            bench_format<compressed_type> ("compressed_matrix", c, families [f].product_limit);
+            bench_format<coordinate_type> ("coordinate_matrix", c, families [f].product_limit);
+            if (c.size <= node_limit) {
+                bench_format<mapped_type> ("mapped_matrix", c, families [f].product_limit);
+                bench_format<vector_of_vector_type> ("generalized_vector_of_vector", c, families [f].product_limit);
+            }
+        }
+    }
+
+    return bench::finish ();
+}
@@ -0,0 +1,329 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+// Runner shared by the benchmarks: wall clock (steady clock) timings with a calibrated
+// number of iterations per sample, warm-ups and repeated samples summarized by their
+// median and median absolute deviation, operation and memory traffic rates, and a JSON
+// report that can be compared between builds.
+//
+// Command line of the benchmark programs:
+//   --samples N       timed samples per case (default 15)
+//   --warmups N       untimed samples before them (default 2)
+//   --min-time S      minimum duration of a sample in seconds (default 0.01)
+//   --max-size N      skip the sizes above N
+//   --json FILE       write the report to FILE, - for the standard output (the progress
+//                     lines then go to the standard error)
+
+#include <boost/config.hpp>
+
+#if defined (BOOST_NO_CXX11_HDR_CHRONO) || defined (BOOST_NO_CXX11_LAMBDAS)
+#error The benchmark harness needs <chrono> and lambdas (C++11)
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/numeric/ublas/traits.hpp>
+
+namespace bench {
+
+    struct options {
+        options ():
+            samples (15), warmups (2), min_time (0.01), max_size (std::size_t (-1)) {}
+
+        int samples;
+        int warmups;
+        double min_time;
+        std::size_t max_size;
+        std::string json;
+    };
+
+    // One case: times are per iteration, in seconds
+    struct result {
+        std::string section, name, type;
+        std::size_t size;
+        long iterations;
+        int samples;
+        double median, mad, min;
+        double flops, bytes;
+        // values attached by annotate, e.g. an accuracy measure
+        std::vector<std::pair<std::string, double> > notes;
+    };
+
+    struct report {
+        options settings;
+        std::string suite, section, name, type;
+        std::vector<result> results;
+    };
+
+    inline report &current () {
+        static report r;
+        return r;
+    }
+
+    // The progress lines; the standard error when the report goes to the standard output
+    inline std::ostream &log () {
+        return current ().settings.json == "-" ? std::cerr : std::cout;
+    }
+
+    inline void usage (const char *program) {
+        std::cerr << "usage: " << program
+                  << " [--samples N] [--warmups N] [--min-time SECONDS] [--max-size N] [--json FILE]" << std::endl;
+        std::exit (1);
+    }
+
+    /** Parses the command line and starts the report of a benchmark program */
+    inline void start (const std::string &suite, int argc, char *argv []) {
+        report &r (current ());
+        r.suite = suite;
+        for (int i = 1; i < argc; ++ i) {
+            const std::string arg (argv [i]);
+            if (i + 1 >= argc)
+                usage (argv [0]);
+            const char *value (argv [++ i]);
+            if (arg == "--samples")
+                r.settings.samples = std::atoi (value);
+            else if (arg == "--warmups")
+                r.settings.warmups = std::atoi (value);
+            else if (arg == "--min-time")
+                r.settings.min_time = std::atof (value);
+            else if (arg == "--max-size")
+                r.settings.max_size = std::strtoul (value, 0, 10);
+            else if (arg == "--json")
+                r.settings.json = value;
+            else
+                usage (argv [0]);
+        }
+        if (r.settings.samples < 1 || r.settings.warmups < 0 || ! (r.settings.min_time >= 0))
+            usage (argv [0]);
+        log () << suite << std::endl;
+    }
+
+    /** Labels the following cases: the value type, the operation and the variant */
+    inline void scalar (const std::string &type) {
+        current ().type = type;
+        log () << type << std::endl;
+    }
+    inline void section (const std::string &text) {
+        current ().section = text;
+        log () << "  " << text << std::endl;
+    }
+    inline void header (const std::string &text) {
+        current ().name = text;
+    }
+
+    inline bool size_enabled (std::size_t size) {
+        return size <= current ().settings.max_size;
+    }
+
+    typedef std::chrono::steady_clock clock;
+
+    // Makes the compiler assume that the memory reachable from p is read and written,
+    // so that an iteration whose result is not used is neither removed nor hoisted
+    inline void clobber (const void *p) {
+#if defined (__GNUC__) || defined (__clang__)
+        __asm__ __volatile__ ("" : : "r" (p) : "memory");
+#else
+        static const void *volatile sink;
+        sink = p;
+#endif
+    }
+
+    template<class F>
+    double time_iterations (F &f, long iterations) {
+        const clock::time_point t0 (clock::now ());
+        for (long i = 0; i < iterations; ++ i) {
+            f ();
+            clobber (&f);
+        }
+        return std::chrono::duration<double> (clock::now () - t0).count ();
+    }
+
+    // Median of a sample, which is reordered
+    inline double median (std::vector<double> &x) {
+        const std::size_t n (x.size ());
+        std::sort (x.begin (), x.end ());
+        return n % 2 ? x [n / 2] : (x [n / 2 - 1] + x [n / 2]) / 2;
+    }
+
+    /** Times f, one iteration of a case of size \c size doing \c flops floating point
+     *  operations and moving \c bytes to or from memory. Returns the median time of an
+     *  iteration.
+     */
+    template<class F>
+    double measure_rates (std::size_t size, double flops, double bytes, F f) {
+        report &r (current ());
+        // the iterations per sample are doubled until a sample lasts min_time, which is
+        // the first warm-up as well
+        long iterations (1);
+        while (time_iterations (f, iterations) < r.settings.min_time && iterations < (1L << 30))
+            iterations *= 2;
+        for (int i = 0; i < r.settings.warmups; ++ i)
+            time_iterations (f, iterations);
+        std::vector<double> times (r.settings.samples), deviations (r.settings.samples);
+        for (int i = 0; i < r.settings.samples; ++ i)
+            times [i] = time_iterations (f, iterations) / double (iterations);
+
+        result res;
+        res.section = r.section;
+        res.name = r.name;
+        res.type = r.type;
+        res.size = size;
+        res.iterations = iterations;
+        res.samples = r.settings.samples;
+        res.min = *std::min_element (times.begin (), times.end ());
+        res.median = median (times);
+        for (int i = 0; i < r.settings.samples; ++ i)
+            deviations [i] = std::abs (times [i] - res.median);
+        res.mad = median (deviations);
+        res.flops = flops;
+        res.bytes = bytes;
+        r.results.push_back (res);
+
+        std::ostringstream line;
+        line << "    " << std::left << std::setw (48) << res.name << std::right
+             << " n = " << std::setw (7) << size
+             << std::setprecision (4)
+             << std::setw (12) << res.median * 1.0e9 << " ns"
+             << " +- " << std::setw (5) << (res.median > 0 ? 100 * res.mad / res.median : 0.0) << " %";
+        if (res.flops > 0)
+            line << std::setw (10) << res.flops / res.median * 1.0e-9 << " GFLOP/s";
+        if (res.bytes > 0)
+            line << std::setw (10) << res.bytes / res.median * 1.0e-9 << " GB/s";
+        log () << line.str () << std::endl;
+        return res.median;
+    }
+
+    /** Times f, one iteration of a case of size \c size doing the given numbers of
+     *  multiplications and additions of T and moving \c elements values of T to or
+     *  from memory; complex operations are counted in real floating point
+     *  operations. Returns the median time of an iteration.
+     */
+    template<class T, class F>
+    double measure (std::size_t size, double multiplies, double plus, double elements, F f) {
+        return measure_rates (size,
+                              multiplies * boost::numeric::ublas::type_traits<T>::multiplies_complexity +
+                              plus * boost::numeric::ublas::type_traits<T>::plus_complexity,
+                              elements * sizeof (T), f);
+    }
+
+    /** Attaches a named value to the last case, e.g. the error of its result */
+    inline void annotate (const std::string &key, double value) {
+        report &r (current ());
+        if (r.results.empty ())
+            return;
+        r.results.back ().notes.push_back (std::make_pair (key, value));
+        log () << "      " << key << " = " << std::setprecision (4) << value << std::endl;
+    }
+
+    inline std::string json_string (const std::string &s) {
+        std::ostringstream out;
+        out << '"';
+        for (std::size_t i = 0; i < s.size (); ++ i) {
+            const unsigned char c (s [i]);
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if (c < 0x20)
+                out << "\\u" << std::hex << std::setw (4) << std::setfill ('0') << int (c) << std::dec << std::setfill (' ');
+            else
+                out << c;
+        }
+        out << '"';
+        return out.str ();
+    }
+
+    inline std::string json_number (double x) {
+        if (! (std::abs (x) <= 1.0e300))
+            return "null";
+        std::ostringstream out;
+        out << std::setprecision (6) << x;
+        return out.str ();
+    }
+
+    inline void write_json (std::ostream &out) {
+        const report &r (current ());
+        char date [32] = "";
+        const std::time_t now (std::time (0));
+        std::strftime (date, sizeof (date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime (&now));
+        out << "{\n"
+            << "  \"suite\": " << json_string (r.suite) << ",\n"
+            << "  \"context\": {\n"
+            << "    \"date\": " << json_string (date) << ",\n"
+            << "    \"compiler\": " << json_string (BOOST_COMPILER) << ",\n"
+            << "    \"platform\": " << json_string (BOOST_PLATFORM) << ",\n"
+#ifdef NDEBUG
+            << "    \"ndebug\": true,\n"
+#else
+            << "    \"ndebug\": false,\n"
+#endif
+#ifdef BOOST_UBLAS_USE_OPENMP
+            << "    \"openmp\": true,\n"
+#else
+            << "    \"openmp\": false,\n"
+#endif
+            << "    \"samples\": " << r.settings.samples << ",\n"
+            << "    \"warmups\": " << r.settings.warmups << ",\n"
+            << "    \"min_time\": " << json_number (r.settings.min_time) << "\n"
+            << "  },\n"
+            << "  \"results\": [";
+        for (std::size_t i = 0; i < r.results.size (); ++ i) {
+            const result &res (r.results [i]);
+            out << (i ? ",\n" : "\n")
+                << "    {\"section\": " << json_string (res.section)
+                << ", \"name\": " << json_string (res.name)
+                << ", \"type\": " << json_string (res.type)
+                << ", \"size\": " << res.size
+                << ", \"iterations\": " << res.iterations
+                << ", \"samples\": " << res.samples
+                << ", \"median_ns\": " << json_number (res.median * 1.0e9)
+                << ", \"mad_ns\": " << json_number (res.mad * 1.0e9)
+                << ", \"min_ns\": " << json_number (res.min * 1.0e9)
+                << ", \"flops\": " << json_number (res.flops)
+                << ", \"bytes\": " << json_number (res.bytes)
+                << ", \"gflops\": " << json_number (res.flops / res.median * 1.0e-9)
+                << ", \"gbytes_per_s\": " << json_number (res.bytes / res.median * 1.0e-9);
+            for (std::size_t k = 0; k < res.notes.size (); ++ k)
+                out << ", " << json_string (res.notes [k].first) << ": " << json_number (res.notes [k].second);
+            out << "}";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    /** Writes the JSON report if requested; the exit status of the program */
+    inline int finish () {
+        const report &r (current ());
+        if (r.settings.json.empty ())
+            return 0;
+        if (r.settings.json == "-") {
+            write_json (std::cout);
+            return 0;
+        }
+        std::ofstream out (r.settings.json.c_str ());
+        write_json (out);
+        if (! out) {
+            std::cerr << "cannot write " << r.settings.json << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+}
+
+#endif
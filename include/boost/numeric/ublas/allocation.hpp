@@ -0,0 +1,284 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_ALLOCATION_
+#define _BOOST_UBLAS_ALLOCATION_
+
+#include <boost/config.hpp>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+
+// Tracking of the heap allocations of the storage arrays of uBLAS (unbounded_array and
+// map_array, and so the dense, compressed, coordinate and mapped containers using
+// them): the number and bytes of the allocations by category, the deallocations, and
+// the live and peak bytes. Define BOOST_UBLAS_TRACK_ALLOCATIONS before including any
+// uBLAS header to enable it (C++11 is needed then). Otherwise the hooks in the storage
+// arrays expand to nothing, and the statistics below stay empty.
+//
+// The counters are shared by all threads. Observers added with add_observer () are
+// called on every allocation and deallocation, from the allocating thread; they must
+// not allocate uBLAS storage themselves.
+
+#ifdef BOOST_UBLAS_TRACK_ALLOCATIONS
+#if defined (BOOST_NO_CXX11_THREAD_LOCAL) || defined (BOOST_NO_CXX11_HDR_ATOMIC) || \
+    defined (BOOST_NO_CXX11_HDR_MUTEX)
+#error BOOST_UBLAS_TRACK_ALLOCATIONS needs thread_local, <atomic> and <mutex> (C++11)
+#endif
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace allocation {
+
+    /** \brief Why a storage array allocates
+     *
+     * An allocation made while a container assignment without noalias builds its
+     * temporary is a temporary, whatever the storage array does; an assignment of a
+     * storage array is a copy.
+     */
+    enum category {
+        construction,   // constructors with a size
+        copy,           // copy constructors and assignments
+        resize,         // resize and reserve, e.g. the growth of a compressed_matrix
+        temporary,      // temporaries of container assignments without noalias
+        category_count
+    };
+
+    inline const char *category_name (category c) {
+        static const char *const names [category_count] = {
+            "construction", "copy", "resize", "temporary"
+        };
+        return names [c];
+    }
+
+    /** \brief Totals since the start or the last reset () */
+    struct statistics {
+        statistics ():
+            deallocations (0), live_bytes (0), peak_bytes (0) {
+            for (std::size_t c = 0; c < category_count; ++ c)
+                allocations [c] = bytes [c] = 0;
+        }
+
+        unsigned long long total_allocations () const {
+            unsigned long long n (0);
+            for (std::size_t c = 0; c < category_count; ++ c)
+                n += allocations [c];
+            return n;
+        }
+        unsigned long long total_bytes () const {
+            unsigned long long n (0);
+            for (std::size_t c = 0; c < category_count; ++ c)
+                n += bytes [c];
+            return n;
+        }
+
+        unsigned long long allocations [category_count];
+        unsigned long long bytes [category_count];
+        unsigned long long deallocations;
+        unsigned long long live_bytes;
+        unsigned long long peak_bytes;
+    };
+
+    /** \brief Called on every allocation and deallocation of a storage array */
+    class observer {
+    public:
+        virtual ~observer () {}
+
+        virtual void allocated (category c, std::size_t bytes) = 0;
+        virtual void deallocated (std::size_t bytes) = 0;
+    };
+
+#ifdef BOOST_UBLAS_TRACK_ALLOCATIONS
+
+namespace detail {
+
+    typedef std::atomic<unsigned long long> counter;
+
+    struct registry {
+        registry ():
+            deallocations (0), live_bytes (0), peak_bytes (0), observed (false) {
+            for (std::size_t c = 0; c < category_count; ++ c) {
+                allocations [c].store (0, std::memory_order_relaxed);
+                bytes [c].store (0, std::memory_order_relaxed);
+            }
+        }
+
+        counter allocations [category_count];
+        counter bytes [category_count];
+        counter deallocations;
+        counter live_bytes;
+        counter peak_bytes;
+
+        std::atomic<bool> observed;
+        std::mutex mutex;
+        std::vector<observer *> observers;
+    };
+
+    inline registry &totals () {
+        static registry r;
+        return r;
+    }
+
+    // The category of the outermost scope active in this thread, if any
+    struct thread_scope {
+        thread_scope ():
+            active (false), kind (construction) {}
+
+        bool active;
+        category kind;
+    };
+
+    inline thread_scope &local () {
+        static thread_local thread_scope s;
+        return s;
+    }
+
+}
+
+    /** \brief Counts the allocations of the storage arrays, from its construction to
+     * its destruction, in the given category
+     */
+    class scope {
+    public:
+        explicit scope (category c):
+            local_ (detail::local ()), outermost_ (! local_.active) {
+            if (outermost_) {
+                local_.active = true;
+                local_.kind = c;
+            }
+        }
+        ~scope () {
+            if (outermost_)
+                local_.active = false;
+        }
+
+    private:
+        scope (const scope &);
+        scope &operator = (const scope &);
+
+        detail::thread_scope &local_;
+        bool outermost_;
+    };
+
+    /** \brief Records an allocation; the category of an enclosing scope takes precedence */
+    inline void allocated (category c, std::size_t n) {
+        const detail::thread_scope &s (detail::local ());
+        if (s.active)
+            c = s.kind;
+        detail::registry &r (detail::totals ());
+        r.allocations [c].fetch_add (1, std::memory_order_relaxed);
+        r.bytes [c].fetch_add (n, std::memory_order_relaxed);
+        const unsigned long long live (r.live_bytes.fetch_add (n, std::memory_order_relaxed) + n);
+        unsigned long long peak (r.peak_bytes.load (std::memory_order_relaxed));
+        while (live > peak && ! r.peak_bytes.compare_exchange_weak (peak, live, std::memory_order_relaxed))
+            ;
+        if (r.observed.load (std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock (r.mutex);
+            for (std::size_t o = 0; o < r.observers.size (); ++ o)
+                r.observers [o]->allocated (c, n);
+        }
+    }
+
+    /** \brief Records a deallocation */
+    inline void deallocated (std::size_t n) {
+        detail::registry &r (detail::totals ());
+        r.deallocations.fetch_add (1, std::memory_order_relaxed);
+        r.live_bytes.fetch_sub (n, std::memory_order_relaxed);
+        if (r.observed.load (std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock (r.mutex);
+            for (std::size_t o = 0; o < r.observers.size (); ++ o)
+                r.observers [o]->deallocated (n);
+        }
+    }
+
+    inline void add_observer (observer &o) {
+        detail::registry &r (detail::totals ());
+        std::lock_guard<std::mutex> lock (r.mutex);
+        r.observers.push_back (&o);
+        r.observed.store (true, std::memory_order_release);
+    }
+
+    inline void remove_observer (observer &o) {
+        detail::registry &r (detail::totals ());
+        std::lock_guard<std::mutex> lock (r.mutex);
+        r.observers.erase (std::remove (r.observers.begin (), r.observers.end (), &o), r.observers.end ());
+        r.observed.store (! r.observers.empty (), std::memory_order_release);
+    }
+
+    inline statistics collect () {
+        const detail::registry &r (detail::totals ());
+        statistics s;
+        for (std::size_t c = 0; c < category_count; ++ c) {
+            s.allocations [c] = r.allocations [c].load (std::memory_order_relaxed);
+            s.bytes [c] = r.bytes [c].load (std::memory_order_relaxed);
+        }
+        s.deallocations = r.deallocations.load (std::memory_order_relaxed);
+        s.live_bytes = r.live_bytes.load (std::memory_order_relaxed);
+        s.peak_bytes = r.peak_bytes.load (std::memory_order_relaxed);
+        return s;
+    }
+
+    /** \brief Clears the counts; the live bytes are kept, and become the peak */
+    inline void reset () {
+        detail::registry &r (detail::totals ());
+        for (std::size_t c = 0; c < category_count; ++ c) {
+            r.allocations [c].store (0, std::memory_order_relaxed);
+            r.bytes [c].store (0, std::memory_order_relaxed);
+        }
+        r.deallocations.store (0, std::memory_order_relaxed);
+        r.peak_bytes.store (r.live_bytes.load (std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+#else
+
+    inline void add_observer (observer &) {}
+
+    inline void remove_observer (observer &) {}
+
+    inline statistics collect () {
+        return statistics ();
+    }
+
+    inline void reset () {}
+
+#endif
+
+    /** \brief Writes the allocations by category, and the live and peak bytes */
+    inline void dump (std::ostream &out, const statistics &s) {
+#ifndef BOOST_UBLAS_TRACK_ALLOCATIONS
+        out << "uBLAS allocation tracking is disabled, define BOOST_UBLAS_TRACK_ALLOCATIONS to enable it" << std::endl;
+#endif
+        const std::ios_base::fmtflags flags (out.flags ());
+        out << std::left << std::setw (14) << "category" << std::right
+            << std::setw (14) << "allocations" << std::setw (16) << "bytes" << std::endl;
+        for (std::size_t c = 0; c < category_count; ++ c)
+            out << std::left << std::setw (14) << category_name (category (c)) << std::right
+                << std::setw (14) << s.allocations [c] << std::setw (16) << s.bytes [c] << std::endl;
+        out << "deallocations " << s.deallocations << ", live bytes " << s.live_bytes
+            << ", peak bytes " << s.peak_bytes << std::endl;
+        out.flags (flags);
+    }
+    inline void dump (std::ostream &out) {
+        dump (out, collect ());
+    }
+
+}}}}
+
+#ifdef BOOST_UBLAS_TRACK_ALLOCATIONS
+// Hooks of the storage arrays; BOOST_UBLAS_ALLOCATION_SCOPE sets the category of the
+// allocations until the end of the enclosing block.
+#define BOOST_UBLAS_ALLOCATED(kind, bytes) \
+    boost::numeric::ublas::allocation::allocated (boost::numeric::ublas::allocation::kind, (bytes))
+#define BOOST_UBLAS_DEALLOCATED(bytes) \
+    boost::numeric::ublas::allocation::deallocated ((bytes))
+#define BOOST_UBLAS_ALLOCATION_SCOPE(kind) \
+    boost::numeric::ublas::allocation::scope boost_ublas_allocation_scope (boost::numeric::ublas::allocation::kind)
+#endif
+
+#endif
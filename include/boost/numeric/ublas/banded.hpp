@@ -15,6 +15,7 @@
 
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
+#include <boost/numeric/ublas/detail/banded_prod.hpp>
 
 // Iterators based on ideas of Jeremy Siek
 
@@ -345,7 +346,9 @@ public:
         template<class AE>
         BOOST_UBLAS_INLINE
         banded_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, lower_, upper_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -357,7 +360,9 @@ public:
         template<class AE>
         BOOST_UBLAS_INLINE
         banded_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, lower_, upper_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -369,7 +374,9 @@ public:
         template<class AE>
         BOOST_UBLAS_INLINE
         banded_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, lower_, upper_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -0,0 +1,628 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_BATCHED_
+#define _BOOST_UBLAS_BATCHED_
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+/** \file batched.hpp
+ *  \brief Batches of small matrices of the same size with lane interleaved storage.
+ *
+ *  Element \f$(i, j)\f$ of the \f$K\f$ matrices of a pack are stored next to each
+ *  other, so every kernel below runs its innermost loop across the matrices of a
+ *  pack. These loops have no dependencies between iterations and are vectorised
+ *  by the compiler, each SIMD lane processing a different matrix.
+ */
+
+// Number of matrices interleaved in a pack, 8 fills the widest SIMD registers for double
+#ifndef BOOST_UBLAS_BATCH_LANES
+#define BOOST_UBLAS_BATCH_LANES 8
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief A batch of \c size() dense \f$M \times N\f$ matrices of type \c T.
+     *
+     * The matrices are grouped in packs of \c K. Element \f$(i, j)\f$ of matrix \f$b\f$ is mapped to the
+     * \f$((p.M.N + i.N + j).K + l)\f$-th element of the storage, where \f$p = b / K\f$ and \f$l = b \bmod K\f$.
+     * The last pack is padded with zero matrices, which are ignored by all operations.
+     *
+     * \tparam T the type of object stored in the matrices (like double, float, complex, etc...)
+     * \tparam M the number of rows of every matrix
+     * \tparam N the number of columns of every matrix
+     * \tparam K the number of interleaved matrices. Default is \c BOOST_UBLAS_BATCH_LANES
+     * \tparam A the type of Storage array. Default is \c unbounded_array
+     */
+    template<class T, std::size_t M, std::size_t N, std::size_t K = BOOST_UBLAS_BATCH_LANES, class A = unbounded_array<T> >
+    class batched_matrix {
+
+        typedef batched_matrix<T, M, N, K, A> self_type;
+    public:
+        typedef typename A::size_type size_type;
+        typedef typename A::difference_type difference_type;
+        typedef T value_type;
+        typedef const T &const_reference;
+        typedef T &reference;
+        typedef const T *const_pointer;
+        typedef T *pointer;
+        typedef A array_type;
+
+        static const size_type lanes = K;
+        static const size_type pack_size = M * N * K;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        batched_matrix ():
+            size_ (0), data_ () {}
+        explicit BOOST_UBLAS_INLINE
+        batched_matrix (size_type size):
+            size_ (size), data_ (packs (size) * pack_size, value_type/*zero*/()) {}
+        /** Construct from a range of matrices (for example \c fixed_matrix or \c bounded_matrix)
+         */
+        template<class I>
+        BOOST_UBLAS_INLINE
+        batched_matrix (I first, I last):
+            size_ (std::distance (first, last)), data_ (packs (size_) * pack_size, value_type/*zero*/()) {
+            for (size_type b = 0; first != last; ++ first, ++ b)
+                set (b, *first);
+        }
+        BOOST_UBLAS_INLINE
+        batched_matrix (const batched_matrix &m):
+            size_ (m.size_), data_ (m.data_) {}
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            return size_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type packs () const {
+            return packs (size_);
+        }
+        static BOOST_UBLAS_INLINE
+        size_type packs (size_type size) {
+            return (size + K - 1) / K;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return M;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return N;
+        }
+
+        // Storage accessors
+        BOOST_UBLAS_INLINE
+        const array_type &data () const {
+            return data_;
+        }
+        BOOST_UBLAS_INLINE
+        array_type &data () {
+            return data_;
+        }
+        BOOST_UBLAS_INLINE
+        const_pointer pack (size_type p) const {
+            BOOST_UBLAS_CHECK (p < packs (), bad_index ());
+            return &data_ [p * pack_size];
+        }
+        BOOST_UBLAS_INLINE
+        pointer pack (size_type p) {
+            BOOST_UBLAS_CHECK (p < packs (), bad_index ());
+            return &data_ [p * pack_size];
+        }
+
+        // Resizing
+        BOOST_UBLAS_INLINE
+        void resize (size_type size) {
+            data_.resize (packs (size) * pack_size, value_type/*zero*/());
+            // Keep the padding zero
+            for (size_type b = size; b < size_ && b < packs (size) * K; ++ b)
+                for (size_type i = 0; i < M; ++ i)
+                    for (size_type j = 0; j < N; ++ j)
+                        (*this) (b, i, j) = value_type/*zero*/();
+            size_ = size;
+        }
+
+        // Element access
+        BOOST_UBLAS_INLINE
+        const_reference operator () (size_type b, size_type i, size_type j) const {
+            BOOST_UBLAS_CHECK (b < size_, bad_index ());
+            BOOST_UBLAS_CHECK (i < M, bad_index ());
+            BOOST_UBLAS_CHECK (j < N, bad_index ());
+            return data_ [((b / K) * M * N + i * N + j) * K + b % K];
+        }
+        BOOST_UBLAS_INLINE
+        reference operator () (size_type b, size_type i, size_type j) {
+            BOOST_UBLAS_CHECK (b < size_, bad_index ());
+            BOOST_UBLAS_CHECK (i < M, bad_index ());
+            BOOST_UBLAS_CHECK (j < N, bad_index ());
+            return data_ [((b / K) * M * N + i * N + j) * K + b % K];
+        }
+
+        // Conversion from and to single matrices
+        /** Copy the matrix expression \c ae into matrix \c b of the batch
+         */
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        void set (size_type b, const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_CHECK (ae ().size1 () == M && ae ().size2 () == N, bad_size ());
+            for (size_type i = 0; i < M; ++ i)
+                for (size_type j = 0; j < N; ++ j)
+                    (*this) (b, i, j) = ae () (i, j);
+        }
+        /** Copy matrix \c b of the batch into \c m, which must have the size \f$M \times N\f$
+         */
+        template<class C>
+        BOOST_UBLAS_INLINE
+        void get (size_type b, C &m) const {
+            BOOST_UBLAS_CHECK (m.size1 () == M && m.size2 () == N, bad_size ());
+            for (size_type i = 0; i < M; ++ i)
+                for (size_type j = 0; j < N; ++ j)
+                    m (i, j) = (*this) (b, i, j);
+        }
+        /** Copy all matrices of the batch into the range starting at \c first
+         */
+        template<class I>
+        BOOST_UBLAS_INLINE
+        I copy_to (I first) const {
+            for (size_type b = 0; b < size_; ++ b, ++ first)
+                get (b, *first);
+            return first;
+        }
+
+        // Zeroing
+        BOOST_UBLAS_INLINE
+        void clear () {
+            std::fill (data_.begin (), data_.end (), value_type/*zero*/());
+        }
+
+        // Assignment
+        BOOST_UBLAS_INLINE
+        batched_matrix &operator = (const batched_matrix &m) {
+            size_ = m.size_;
+            data_ = m.data_;
+            return *this;
+        }
+
+        // Swapping
+        BOOST_UBLAS_INLINE
+        void swap (batched_matrix &m) {
+            if (this != &m) {
+                std::swap (size_, m.size_);
+                data_.swap (m.data_);
+            }
+        }
+        BOOST_UBLAS_INLINE
+        friend void swap (batched_matrix &m1, batched_matrix &m2) {
+            m1.swap (m2);
+        }
+
+    private:
+        size_type size_;
+        array_type data_;
+    };
+
+namespace detail {
+
+    // Number of matrices of the batch in pack p
+    template<std::size_t K>
+    BOOST_UBLAS_INLINE
+    std::size_t batch_lanes_used (std::size_t size, std::size_t p) {
+        return (std::min) (K, size - p * K);
+    }
+
+}
+
+    /** \brief Computes <tt>C<sub>b</sub> = A<sub>b</sub> B<sub>b</sub></tt> for every matrix of the batch.
+     *
+     * \c c is resized to the size of the batch and must not alias \c a or \c b.
+     */
+    template<class T, std::size_t M, std::size_t L, std::size_t N, std::size_t K, class A1, class A2, class A3>
+    void batched_prod (const batched_matrix<T, M, L, K, A1> &a,
+                       const batched_matrix<T, L, N, K, A2> &b,
+                       batched_matrix<T, M, N, K, A3> &c) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size (), bad_size ());
+        if (c.size () != a.size ())
+            c.resize (a.size ());
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            const T *pb = b.pack (p);
+            T *pc = c.pack (p);
+            for (size_type i = 0; i < M; ++ i) {
+                for (size_type j = 0; j < N; ++ j) {
+                    T t [K];
+                    for (size_type l = 0; l < K; ++ l)
+                        t [l] = T/*zero*/();
+                    for (size_type k = 0; k < L; ++ k) {
+                        const T *aik = pa + (i * L + k) * K;
+                        const T *bkj = pb + (k * N + j) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            t [l] += aik [l] * bkj [l];
+                    }
+                    T *cij = pc + (i * N + j) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        cij [l] = t [l];
+                }
+            }
+        }
+    }
+
+    /** \brief LU factorization with partial pivoting of every matrix of the batch.
+     *
+     * Equivalent to calling <tt>lu_factorize (a<sub>b</sub>, pm<sub>b</sub>)</tt> for every matrix, with the
+     * pivot sequence of matrix \c b stored in <tt>pm (b, i, 0)</tt>.
+     * \return the number of singular matrices in the batch
+     */
+    template<class T, std::size_t N, std::size_t K, class A1, class A2>
+    std::size_t batched_lu_factorize (batched_matrix<T, N, N, K, A1> &a,
+                                      batched_matrix<std::size_t, N, 1, K, A2> &pm) {
+        typedef std::size_t size_type;
+        typedef typename type_traits<T>::real_type real_type;
+
+        if (pm.size () != a.size ())
+            pm.resize (a.size ());
+        size_type singular = 0;
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            T *pa = a.pack (p);
+            size_type *pp = pm.pack (p);
+            bool is_singular [K];
+            for (size_type l = 0; l < K; ++ l)
+                is_singular [l] = false;
+            for (size_type i = 0; i < N; ++ i) {
+                // Pivot search, first maximum like index_norm_inf
+                size_type *piv = pp + i * K;
+                real_type t [K];
+                for (size_type l = 0; l < K; ++ l) {
+                    piv [l] = i;
+                    t [l] = real_type ();
+                }
+                for (size_type k = i; k < N; ++ k) {
+                    const T *aki = pa + (k * N + i) * K;
+                    for (size_type l = 0; l < K; ++ l) {
+                        const real_type u = type_traits<T>::norm_inf (aki [l]);
+                        piv [l] = u > t [l] ? k : piv [l];
+                        t [l] = u > t [l] ? u : t [l];
+                    }
+                }
+                // Row interchange, a no-op in lanes where piv == i
+                for (size_type j = 0; j < N; ++ j) {
+                    T *aij = pa + (i * N + j) * K;
+                    for (size_type l = 0; l < K; ++ l) {
+                        T *apj = pa + (piv [l] * N + j) * K + l;
+                        const T s = aij [l];
+                        aij [l] = *apj;
+                        *apj = s;
+                    }
+                }
+                // Scale the column, zero pivots leave it unchanged (it is zero)
+                const T *aii = pa + (i * N + i) * K;
+                T inv [K];
+                for (size_type l = 0; l < K; ++ l) {
+                    is_singular [l] = is_singular [l] || aii [l] == T/*zero*/();
+                    inv [l] = aii [l] != T/*zero*/() ? T (1) / aii [l] : T/*zero*/();
+                }
+                for (size_type k = i + 1; k < N; ++ k) {
+                    T *aki = pa + (k * N + i) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        aki [l] *= inv [l];
+                }
+                // Rank one update of the trailing matrix
+                for (size_type k = i + 1; k < N; ++ k) {
+                    const T *aki = pa + (k * N + i) * K;
+                    for (size_type j = i + 1; j < N; ++ j) {
+                        const T *aij = pa + (i * N + j) * K;
+                        T *akj = pa + (k * N + j) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            akj [l] -= aki [l] * aij [l];
+                    }
+                }
+            }
+            const size_type used = detail::batch_lanes_used<K> (a.size (), p);
+            for (size_type l = 0; l < used; ++ l)
+                if (is_singular [l])
+                    ++ singular;
+        }
+        return singular;
+    }
+
+    /** \brief Solves <tt>T<sub>b</sub> X<sub>b</sub> = B<sub>b</sub></tt> in place for every matrix of the batch.
+     *
+     * \c TRI is one of \c lower_tag, \c unit_lower_tag, \c upper_tag or \c unit_upper_tag.
+     */
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2>
+    void batched_inplace_solve (const batched_matrix<T, N, N, K, A1> &a,
+                                batched_matrix<T, N, R, K, A2> &b, lower_tag) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size (), bad_size ());
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            T *pb = b.pack (p);
+            for (size_type i = 0; i < N; ++ i) {
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    for (size_type k = 0; k < i; ++ k) {
+                        const T *aik = pa + (i * N + k) * K;
+                        const T *bkr = pb + (k * R + r) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] -= aik [l] * bkr [l];
+                    }
+                    const T *aii = pa + (i * N + i) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        bir [l] = aii [l] != T/*zero*/() ? bir [l] / aii [l] : bir [l];
+                }
+            }
+        }
+    }
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2>
+    void batched_inplace_solve (const batched_matrix<T, N, N, K, A1> &a,
+                                batched_matrix<T, N, R, K, A2> &b, unit_lower_tag) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size (), bad_size ());
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            T *pb = b.pack (p);
+            for (size_type i = 0; i < N; ++ i) {
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    for (size_type k = 0; k < i; ++ k) {
+                        const T *aik = pa + (i * N + k) * K;
+                        const T *bkr = pb + (k * R + r) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] -= aik [l] * bkr [l];
+                    }
+                }
+            }
+        }
+    }
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2>
+    void batched_inplace_solve (const batched_matrix<T, N, N, K, A1> &a,
+                                batched_matrix<T, N, R, K, A2> &b, upper_tag) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size (), bad_size ());
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            T *pb = b.pack (p);
+            for (size_type n = N; n > 0; -- n) {
+                const size_type i = n - 1;
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    for (size_type k = i + 1; k < N; ++ k) {
+                        const T *aik = pa + (i * N + k) * K;
+                        const T *bkr = pb + (k * R + r) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] -= aik [l] * bkr [l];
+                    }
+                    const T *aii = pa + (i * N + i) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        bir [l] = aii [l] != T/*zero*/() ? bir [l] / aii [l] : bir [l];
+                }
+            }
+        }
+    }
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2>
+    void batched_inplace_solve (const batched_matrix<T, N, N, K, A1> &a,
+                                batched_matrix<T, N, R, K, A2> &b, unit_upper_tag) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size (), bad_size ());
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            T *pb = b.pack (p);
+            for (size_type n = N; n > 0; -- n) {
+                const size_type i = n - 1;
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    for (size_type k = i + 1; k < N; ++ k) {
+                        const T *aik = pa + (i * N + k) * K;
+                        const T *bkr = pb + (k * R + r) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] -= aik [l] * bkr [l];
+                    }
+                }
+            }
+        }
+    }
+
+    /** \brief Solves <tt>A<sub>b</sub> X<sub>b</sub> = B<sub>b</sub></tt> in place from the factors computed
+     * by \c batched_lu_factorize.
+     */
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2, class A3>
+    void batched_lu_substitute (const batched_matrix<T, N, N, K, A1> &a,
+                                const batched_matrix<std::size_t, N, 1, K, A2> &pm,
+                                batched_matrix<T, N, R, K, A3> &b) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size () && pm.size () == b.size (), bad_size ());
+        const size_type packs = b.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const size_type *pp = pm.pack (p);
+            T *pb = b.pack (p);
+            for (size_type i = 0; i < N; ++ i) {
+                const size_type *piv = pp + i * K;
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    for (size_type l = 0; l < K; ++ l) {
+                        T *bpr = pb + (piv [l] * R + r) * K + l;
+                        const T s = bir [l];
+                        bir [l] = *bpr;
+                        *bpr = s;
+                    }
+                }
+            }
+        }
+        batched_inplace_solve (a, b, unit_lower_tag ());
+        batched_inplace_solve (a, b, upper_tag ());
+    }
+
+    /** \brief Cholesky factorization <tt>A<sub>b</sub> = L<sub>b</sub> L<sub>b</sub><sup>H</sup></tt> of every
+     * matrix of the batch.
+     *
+     * Only the lower triangles are referenced and they are overwritten by the factors.
+     * \return the number of matrices which are not positive definite, their factors are unspecified
+     */
+    template<class T, std::size_t N, std::size_t K, class A1>
+    std::size_t batched_cholesky_factorize (batched_matrix<T, N, N, K, A1> &a) {
+        typedef std::size_t size_type;
+        typedef typename type_traits<T>::real_type real_type;
+
+        size_type failed = 0;
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            T *pa = a.pack (p);
+            bool not_definite [K];
+            for (size_type l = 0; l < K; ++ l)
+                not_definite [l] = false;
+            for (size_type j = 0; j < N; ++ j) {
+                T *ajj = pa + (j * N + j) * K;
+                real_type d [K];
+                for (size_type l = 0; l < K; ++ l)
+                    d [l] = type_traits<T>::real (ajj [l]);
+                for (size_type k = 0; k < j; ++ k) {
+                    const T *ajk = pa + (j * N + k) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        d [l] -= type_traits<T>::real (ajk [l] * type_traits<T>::conj (ajk [l]));
+                }
+                for (size_type l = 0; l < K; ++ l) {
+                    not_definite [l] = not_definite [l] || ! (d [l] > real_type/*zero*/());
+                    d [l] = d [l] > real_type/*zero*/() ? type_traits<real_type>::type_sqrt (d [l]) : real_type (1);
+                    ajj [l] = T (d [l]);
+                }
+                for (size_type i = j + 1; i < N; ++ i) {
+                    T *aij = pa + (i * N + j) * K;
+                    for (size_type k = 0; k < j; ++ k) {
+                        const T *aik = pa + (i * N + k) * K;
+                        const T *ajk = pa + (j * N + k) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            aij [l] -= aik [l] * type_traits<T>::conj (ajk [l]);
+                    }
+                    for (size_type l = 0; l < K; ++ l)
+                        aij [l] /= d [l];
+                }
+            }
+            const size_type used = detail::batch_lanes_used<K> (a.size (), p);
+            for (size_type l = 0; l < used; ++ l)
+                if (not_definite [l])
+                    ++ failed;
+        }
+        return failed;
+    }
+
+    /** \brief Solves <tt>A<sub>b</sub> X<sub>b</sub> = B<sub>b</sub></tt> in place from the factors computed
+     * by \c batched_cholesky_factorize.
+     */
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2>
+    void batched_cholesky_substitute (const batched_matrix<T, N, N, K, A1> &a,
+                                      batched_matrix<T, N, R, K, A2> &b) {
+        typedef std::size_t size_type;
+
+        batched_inplace_solve (a, b, lower_tag ());
+        // L^H X = Y, L^H (i, k) = conj (L (k, i))
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            T *pb = b.pack (p);
+            for (size_type n = N; n > 0; -- n) {
+                const size_type i = n - 1;
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    for (size_type k = i + 1; k < N; ++ k) {
+                        const T *aki = pa + (k * N + i) * K;
+                        const T *bkr = pb + (k * R + r) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] -= type_traits<T>::conj (aki [l]) * bkr [l];
+                    }
+                    const T *aii = pa + (i * N + i) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        bir [l] /= aii [l];
+                }
+            }
+        }
+    }
+
+    /** \brief Solves the tridiagonal systems <tt>A<sub>b</sub> X<sub>b</sub> = B<sub>b</sub></tt> in place
+     * with the Thomas algorithm.
+     *
+     * Row \c i of matrix \c b of \c a holds the sub-diagonal, diagonal and super-diagonal
+     * elements <tt>(A<sub>b</sub> (i, i - 1), A<sub>b</sub> (i, i), A<sub>b</sub> (i, i + 1))</tt>;
+     * <tt>a (b, 0, 0)</tt> and <tt>a (b, N - 1, 2)</tt> do not affect the result. \c a is not modified.
+     * There is no pivoting, see \c tridiagonal_solve.
+     * \return the number of systems with a zero pivot, their solutions are unspecified
+     */
+    template<class T, std::size_t N, std::size_t R, std::size_t K, class A1, class A2>
+    std::size_t batched_tridiagonal_solve (const batched_matrix<T, N, 3, K, A1> &a,
+                                           batched_matrix<T, N, R, K, A2> &b) {
+        typedef std::size_t size_type;
+
+        BOOST_UBLAS_CHECK (a.size () == b.size (), bad_size ());
+        size_type singular = 0;
+        // Upper diagonal of the eliminated systems
+        unbounded_array<T> w (N * K);
+        const size_type packs = a.packs ();
+        for (size_type p = 0; p < packs; ++ p) {
+            const T *pa = a.pack (p);
+            T *pb = b.pack (p);
+            bool is_singular [K];
+            for (size_type l = 0; l < K; ++ l)
+                is_singular [l] = false;
+            for (size_type i = 0; i < N; ++ i) {
+                const T *sub = pa + (i * 3) * K;
+                const T *diag = pa + (i * 3 + 1) * K;
+                const T *super = pa + (i * 3 + 2) * K;
+                T *wi = &w [i * K];
+                const T *wp = i > 0 ? &w [(i - 1) * K] : 0;
+                // Zero pivots give zero inverses, which keeps the padding finite
+                T inv [K];
+                for (size_type l = 0; l < K; ++ l) {
+                    const T d = i > 0 ? diag [l] - sub [l] * wp [l] : diag [l];
+                    is_singular [l] = is_singular [l] || d == T/*zero*/();
+                    inv [l] = d != T/*zero*/() ? T (1) / d : T/*zero*/();
+                    wi [l] = super [l] * inv [l];
+                }
+                for (size_type r = 0; r < R; ++ r) {
+                    T *bir = pb + (i * R + r) * K;
+                    if (i > 0) {
+                        const T *bpr = pb + ((i - 1) * R + r) * K;
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] = (bir [l] - sub [l] * bpr [l]) * inv [l];
+                    } else {
+                        for (size_type l = 0; l < K; ++ l)
+                            bir [l] *= inv [l];
+                    }
+                }
+            }
+            for (size_type i = N - 1; i > 0; -- i) {
+                const T *wp = &w [(i - 1) * K];
+                for (size_type r = 0; r < R; ++ r) {
+                    const T *bir = pb + (i * R + r) * K;
+                    T *bpr = pb + ((i - 1) * R + r) * K;
+                    for (size_type l = 0; l < K; ++ l)
+                        bpr [l] -= wp [l] * bir [l];
+                }
+            }
+            const size_type used = detail::batch_lanes_used<K> (a.size (), p);
+            for (size_type l = 0; l < used; ++ l)
+                if (is_singular [l])
+                    ++ singular;
+        }
+        return singular;
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,303 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_CHOLESKY_
+#define _BOOST_UBLAS_CHOLESKY_
+
+#include <boost/numeric/ublas/lu.hpp>
+
+// Cholesky factorization A = L L^H of hermitian positive definite matrices and its
+// rank one modifications in the spirit of LAPACK (xPOTRF, xPOTRS) and LINPACK
+// (xCHUD, xCHDD)
+//
+// Only the lower triangle is referenced, through m (i, j) with i >= j, and holds L on
+// return; m may be dense or a lower triangular or symmetric (packed) matrix. The inverse
+// is returned in the lower triangle as well, and in the full matrix for dense storage.
+
+namespace boost { namespace numeric { namespace ublas {
+
+    /** \brief Cholesky factorization A = L L^H, L lower triangular (xPOTRF).
+     *
+     *  Right looking by columns; the update of the rest of the matrix by each column
+     *  is threaded over its columns.
+     *
+     *  \return 0, or the index plus one of the column where A turned out not to be
+     *  positive definite; the factorization stops there
+     */
+    template<class M>
+    typename M::size_type cholesky_factorize (M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n, bad_size ());
+        for (size_type k = 0; k < n; ++ k) {
+            const real_type d (type_traits<value_type>::real (m (k, k)));
+            if (! (d > real_type/*zero*/()))
+                return k + 1;
+            const real_type l (type_traits<real_type>::type_sqrt (d));
+            m (k, k) = value_type (l);
+            for (size_type i = k + 1; i < n; ++ i)
+                m (i, k) /= l;
+            // A (k + 1:n, k + 1:n) -= l l^H, lower triangle
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 16) if ((n - k) * (n - k) / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type j = difference_type (k + 1); j < difference_type (n); ++ j) {
+                const value_type ljk (type_traits<value_type>::conj (m (j, k)));
+                for (size_type i = j; i < n; ++ i)
+                    m (i, j) -= m (i, k) * ljk;
+            }
+        }
+        return 0;
+    }
+
+    /** \brief Solves A x = mv in place from the factor L of \c cholesky_factorize
+     *  (xPOTRS); \c mv is a vector or a matrix.
+     */
+    template<class M, class MV>
+    void cholesky_substitute (const M &m, MV &mv) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename MV::value_type value_type;
+        typedef typename MV::type_category type_category;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (detail::rhs_rows (mv, type_category ()) == n, bad_size ());
+        const size_type cols (detail::rhs_columns (mv, type_category ()));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (n * n * cols >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type q = 0; q < difference_type (cols); ++ q) {
+            // L y = b
+            for (size_type i = 0; i < n; ++ i) {
+                value_type s (detail::rhs_element (mv, i, q, type_category ()));
+                for (size_type p = 0; p < i; ++ p)
+                    s -= m (i, p) * detail::rhs_element (mv, p, q, type_category ());
+                detail::rhs_element (mv, i, q, type_category ()) = s / m (i, i);
+            }
+            // L^H x = y
+            for (size_type i = n; i-- > 0; ) {
+                value_type s (detail::rhs_element (mv, i, q, type_category ()));
+                for (size_type p = i + 1; p < n; ++ p)
+                    s -= type_traits<value_type>::conj (m (p, i)) * detail::rhs_element (mv, p, q, type_category ());
+                detail::rhs_element (mv, i, q, type_category ()) = s / m (i, i);
+            }
+        }
+    }
+
+    /** \brief Rank one update: L becomes the factor of L L^H + x x^H, in O(n^2) by
+     *  plane rotations (xCHUD). \c x is destroyed.
+     */
+    template<class M, class V>
+    void cholesky_update (M &m, V &x) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (x.size () == n, bad_size ());
+        for (size_type k = 0; k < n; ++ k) {
+            const real_type l (type_traits<value_type>::real (m (k, k)));
+            const real_type xk (type_traits<value_type>::type_abs (x (k)));
+            const real_type r (type_traits<real_type>::type_sqrt (l * l + xk * xk));
+            const real_type c (r / l);
+            const value_type s (x (k) / value_type (l));
+            m (k, k) = value_type (r);
+            for (size_type i = k + 1; i < n; ++ i) {
+                const value_type li (m (i, k));
+                m (i, k) = (li + type_traits<value_type>::conj (s) * x (i)) / c;
+                x (i) = (x (i) - s * li) / c;
+            }
+        }
+    }
+
+    /** \brief Rank one downdate: L becomes the factor of L L^H - x x^H, in O(n^2) by
+     *  hyperbolic rotations (xCHDD). \c x is destroyed.
+     *
+     *  \return 0, or the index plus one of the column where L L^H - x x^H turned out
+     *  not to be positive definite; L is then partially modified and has to be
+     *  computed anew
+     */
+    template<class M, class V>
+    typename M::size_type cholesky_downdate (M &m, V &x) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (x.size () == n, bad_size ());
+        for (size_type k = 0; k < n; ++ k) {
+            const real_type l (type_traits<value_type>::real (m (k, k)));
+            const real_type xk (type_traits<value_type>::type_abs (x (k)));
+            const real_type d ((l - xk) * (l + xk));
+            if (! (d > real_type/*zero*/()))
+                return k + 1;
+            const real_type r (type_traits<real_type>::type_sqrt (d));
+            const real_type c (r / l);
+            const value_type s (x (k) / value_type (l));
+            m (k, k) = value_type (r);
+            for (size_type i = k + 1; i < n; ++ i) {
+                const value_type li ((m (i, k) - type_traits<value_type>::conj (s) * x (i)) / c);
+                m (i, k) = li;
+                x (i) = c * x (i) - s * li;
+            }
+        }
+        return 0;
+    }
+
+namespace detail {
+
+    // L := L^-1 in place for the lower triangle of m, by blocks of columns from right to
+    // left (xTRTRI). The block is copied first, so that the rows, independent of each
+    // other, are split between the threads.
+    template<class M>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void lower_triangular_invert (M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        for (size_type b = (n + block - 1) / block; b-- > 0; ) {
+            const size_type j0 (b * block);
+            const size_type j1 ((std::min) (n, j0 + block));
+            const size_type jb (j1 - j0);
+            matrix<value_type> l (n - j0, jb, value_type/*zero*/());
+            for (size_type q = 0; q < jb; ++ q)
+                for (size_type p = q; p < n - j0; ++ p)
+                    l (p, q) = m (j0 + p, j0 + q);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if ((n - j0) * (n - j1 + 1) * jb >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            {
+                std::vector<value_type> s (jb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for schedule (dynamic, 16)
+#endif
+                for (difference_type r = difference_type (j0); r < difference_type (n); ++ r) {
+                    const size_type i (r);
+                    // X (i, j1:i + 1) L (j1:i + 1, j0:j1) from the columns already inverted
+                    std::fill (s.begin (), s.end (), value_type/*zero*/());
+                    for (size_type p = j1; p <= i; ++ p) {
+                        const value_type x (m (i, p));
+                        for (size_type q = 0; q < jb; ++ q)
+                            s [q] += x * l (p - j0, q);
+                    }
+                    // the block itself, right to left
+                    for (size_type q = (std::min) (jb, i - j0 + 1); q-- > 0; ) {
+                        const size_type c (j0 + q);
+                        if (c == i) {
+                            m (i, i) = value_type (1) / l (q, q);
+                            continue;
+                        }
+                        value_type t (s [q]);
+                        for (size_type p = c + 1; p < j1 && p <= i; ++ p)
+                            t += m (i, p) * l (p - j0, q);
+                        m (i, c) = - t / l (q, q);
+                    }
+                }
+            }
+        }
+    }
+
+    // The lower triangle of X^H X in place for lower triangular X (xLAUUM), by blocks of
+    // rows from top to bottom: the rows of a block only read the rows of X from the
+    // block down, and are computed by the threads into a copy.
+    template<class M>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void lower_triangular_gram (M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        for (size_type i0 = 0; i0 < n; i0 += block) {
+            const size_type i1 ((std::min) (n, i0 + block));
+            matrix<value_type> g (i1 - i0, i1, value_type/*zero*/());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 1) if ((i1 - i0) * i1 * (n - i0) >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type r = difference_type (i0); r < difference_type (i1); ++ r) {
+                const size_type i (r);
+                for (size_type p = i; p < n; ++ p) {
+                    const value_type x (type_traits<value_type>::conj (m (p, i)));
+                    for (size_type j = 0; j <= i; ++ j)
+                        g (i - i0, j) += x * m (p, j);
+                }
+            }
+            for (size_type i = i0; i < i1; ++ i)
+                for (size_type j = 0; j <= i; ++ j)
+                    m (i, j) = g (i - i0, j);
+        }
+    }
+
+    // The strict upper triangle of a dense hermitian matrix from its lower triangle
+    template<class M>
+    void hermitian_complete (M &m, dense_proxy_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        for (size_type i = 0; i < m.size1 (); ++ i)
+            for (size_type j = 0; j < i; ++ j)
+                m (j, i) = type_traits<value_type>::conj (m (i, j));
+    }
+    template<class M>
+    void hermitian_complete (M &/*m*/, unknown_storage_tag) {}
+
+}
+
+    /** \brief Inverse of A in place from the factor L of \c cholesky_factorize
+     *  (xPOTRI): A^-1 = L^-H L^-1, with L inverted by blocks of columns and the product
+     *  formed by blocks of rows, both threaded over the rows.
+     */
+    template<class M>
+    void cholesky_invert (M &m) {
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        detail::lower_triangular_invert (m);
+        detail::lower_triangular_gram (m);
+        detail::hermitian_complete (m, typename M::storage_category ());
+    }
+
+    /** \brief Inverts a hermitian positive definite matrix in place by
+     *  \c cholesky_factorize and \c cholesky_invert, half the work of \c invert.
+     *
+     *  \return 0, or the index plus one of the column where A turned out not to be
+     *  positive definite; \c m then holds the partial factor
+     */
+    template<class M>
+    typename M::size_type spd_invert (M &m) {
+        typedef typename M::size_type size_type;
+
+        const size_type singular (cholesky_factorize (m));
+        if (singular != 0)
+            return singular;
+        cholesky_invert (m);
+        return 0;
+    }
+
+    /** \brief log det A from the factor L of \c cholesky_factorize, twice the sum of
+     *  the logarithms of the diagonal of L; it neither overflows nor underflows.
+     */
+    template<class M>
+    typename type_traits<typename M::value_type>::real_type cholesky_log_determinant (const M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        real_type l = real_type/*zero*/();
+        for (size_type i = 0; i < m.size1 (); ++ i)
+            l += std::log (type_traits<value_type>::real (m (i, i)));
+        return real_type (2) * l;
+    }
+
+}}}
+
+#endif
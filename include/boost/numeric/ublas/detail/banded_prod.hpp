@@ -0,0 +1,387 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_BANDED_PROD_
+#define _BOOST_UBLAS_BANDED_PROD_
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+// Products with banded matrices in band storage (GBMV, GBMM).
+// Only the stored band is visited; with the netlib layout every row (row major)
+// or column (column major) of the band is contiguous in storage. Diagonal
+// matrices, including diagonal_matrix, scale the rows or columns of the other
+// operand in place of a product.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    template<class M>
+    struct banded_operand;
+
+    template<class T, class L, class A>
+    struct banded_operand<banded_matrix<T, L, A> > {
+        typedef banded_matrix<T, L, A> matrix_type;
+        typedef typename matrix_type::size_type size_type;
+        static const bool row_major = boost::is_same<typename L::orientation_category, row_major_tag>::value;
+
+        static
+        BOOST_UBLAS_INLINE
+        const matrix_type &get (const matrix_type &m) {
+            return m;
+        }
+
+        // Band lines are the rows (row major) or columns (column major) of the matrix
+        static
+        BOOST_UBLAS_INLINE
+        size_type lines (const matrix_type &m) {
+            return row_major ? m.size1 () : m.size2 ();
+        }
+        // Minor indices [begin, end) of the band in line o
+        static
+        BOOST_UBLAS_INLINE
+        size_type begin (const matrix_type &m, size_type o) {
+            const size_type before (row_major ? m.lower () : m.upper ());
+            return o > before ? o - before : 0;
+        }
+        static
+        BOOST_UBLAS_INLINE
+        size_type end (const matrix_type &m, size_type o) {
+            const size_type after (row_major ? m.upper () : m.lower ());
+            return (std::min) (row_major ? m.size2 () : m.size1 (), o + after + 1);
+        }
+        // Storage position of the element (o, q) of line o
+        static
+        BOOST_UBLAS_INLINE
+        size_type element (const matrix_type &m, size_type o, size_type q) {
+            const size_type before (row_major ? m.lower () : m.upper ());
+            return o * (m.lower () + 1 + m.upper ()) + before + q - o;
+        }
+    };
+    // Containers appear as references in product expressions
+    template<class E>
+    struct banded_operand<matrix_reference<E> >:
+        public banded_operand<typename boost::remove_const<E>::type> {
+        typedef typename banded_operand<typename boost::remove_const<E>::type>::matrix_type matrix_type;
+
+        static
+        BOOST_UBLAS_INLINE
+        const matrix_type &get (const matrix_reference<E> &m) {
+            return m.expression ();
+        }
+    };
+
+    // Columns of row k of the right operand that may be non zero
+    template<class E>
+    struct banded_prod_columns {
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        void range (const E &, Z /* k */, Z &/* first */, Z &/* last */) {}
+    };
+#if !defined (BOOST_UBLAS_OWN_BANDED) && !(BOOST_UBLAS_LEGACY_BANDED)
+    template<class T, class L, class A>
+    struct banded_prod_columns<banded_matrix<T, L, A> > {
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        void range (const banded_matrix<T, L, A> &e, Z k, Z &first, Z &last) {
+            first = (std::max) (first, k > e.lower () ? k - e.lower () : Z (0));
+            last = (std::min) (last, k + e.upper () + 1);
+        }
+    };
+    template<class E>
+    struct banded_prod_columns<matrix_reference<E> > {
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        void range (const matrix_reference<E> &e, Z k, Z &first, Z &last) {
+            banded_prod_columns<typename boost::remove_const<E>::type>::range (e.expression (), k, first, last);
+        }
+    };
+
+    // The kernels below depend on the netlib band layout
+    template<class T, class L, class A>
+    struct prod_operand_traits<banded_matrix<T, L, A> > {
+        typedef banded_operand_tag category;
+    };
+#endif
+
+    // y += B x for the band lines [first, last). Unless FLIP line o holds the
+    // coefficients of y (o), otherwise those of x (o).
+    template<bool FLIP, class TV, class S, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_prod_lines (const S &s, const V1 &x, V2 &y,
+                            typename S::size_type first, typename S::size_type last) {
+        typedef typename S::size_type size_type;
+        typedef banded_operand<S> operand;
+        typedef typename S::array_type::const_iterator const_iterator_type;
+
+        const_iterator_type data (s.data ().begin ());
+        for (size_type o = first; o < last; ++ o) {
+            const size_type q_end (operand::end (s, o));
+            size_type q (operand::begin (s, o));
+            const_iterator_type it (data + operand::element (s, o, q));
+            if (FLIP) {
+                const TV xo (x (o));
+                for (; q < q_end; ++ q, ++ it)
+                    y (q) += *it * xo;
+            } else {
+                TV t = TV/*zero*/();
+                for (; q < q_end; ++ q, ++ it)
+                    t += *it * x (q);
+                y (o) += t;
+            }
+        }
+    }
+
+    // GBMV: y += B x, or y += B^T x
+    template<class TV, class E, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_prod (const E &e, const V1 &x, V2 &y, bool transposed) {
+        typedef banded_operand<E> operand;
+        typedef typename operand::matrix_type matrix_type;
+        typedef typename matrix_type::size_type size_type;
+#ifdef BOOST_UBLAS_USE_OPENMP
+        typedef typename matrix_type::difference_type difference_type;
+#endif
+
+        const matrix_type &s (operand::get (e));
+        BOOST_UBLAS_CHECK ((transposed ? s.size1 () : s.size2 ()) == x.size (), bad_size ());
+        BOOST_UBLAS_CHECK ((transposed ? s.size2 () : s.size1 ()) == y.size (), bad_size ());
+        const size_type lines (operand::lines (s));
+        if (operand::row_major == transposed) {
+#ifdef BOOST_UBLAS_USE_OPENMP
+            if (lines * (s.lower () + 1 + s.upper ()) >= BOOST_UBLAS_OPENMP_THRESHOLD) {
+#pragma omp parallel
+                {
+                    vector<TV> w (y.size (), TV/*zero*/());
+#pragma omp for
+                    for (difference_type o = 0; o < difference_type (lines); ++ o)
+                        banded_prod_lines<true, TV> (s, x, w, size_type (o), size_type (o + 1));
+#pragma omp critical (boost_ublas_gbmv)
+                    for (size_type i = 0; i < y.size (); ++ i)
+                        y (i) += w (i);
+                }
+                return;
+            }
+#endif
+            banded_prod_lines<true, TV> (s, x, y, size_type (0), lines);
+        } else {
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (lines * (s.lower () + 1 + s.upper ()) >= BOOST_UBLAS_OPENMP_THRESHOLD)
+            for (difference_type o = 0; o < difference_type (lines); ++ o)
+                banded_prod_lines<false, TV> (s, x, y, size_type (o), size_type (o + 1));
+#else
+            banded_prod_lines<false, TV> (s, x, y, size_type (0), lines);
+#endif
+        }
+    }
+
+    // r += B E (or B^T E when FLIP disagrees with the layout) for the columns
+    // [first, last) of E and r. Rows of E that are banded only touch their band.
+    template<bool FLIP, class TV, class S, class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_prod_panel (const S &s, const E &e, R &r,
+                            typename S::size_type first, typename S::size_type last) {
+        typedef typename S::size_type size_type;
+        typedef banded_operand<S> operand;
+        typedef typename S::array_type::const_iterator const_iterator_type;
+
+        const_iterator_type data (s.data ().begin ());
+        const size_type lines (operand::lines (s));
+        for (size_type o = 0; o < lines; ++ o) {
+            const size_type q_end (operand::end (s, o));
+            size_type q (operand::begin (s, o));
+            const_iterator_type it (data + operand::element (s, o, q));
+            for (; q < q_end; ++ q, ++ it) {
+                const TV a (*it);
+                const size_type i (FLIP ? q : o), k (FLIP ? o : q);
+                size_type c_begin (first), c_end (last);
+                banded_prod_columns<E>::range (e, k, c_begin, c_end);
+                for (size_type c = c_begin; c < c_end; ++ c)
+                    r (i, c) += a * e (k, c);
+            }
+        }
+    }
+
+    // GBMM: r += B E, or r += B^T E. The columns of E are processed in panels of
+    // BOOST_UBLAS_RANK_UPDATE_BLOCK, each reusing every stored element of B.
+    template<class TV, class S, class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_prod_matrix (const S &s, const E &e, R &r, bool transposed) {
+        typedef banded_operand<S> operand;
+        typedef typename operand::matrix_type matrix_type;
+        typedef typename R::size_type size_type;
+        typedef typename R::difference_type difference_type;
+
+        const matrix_type &b (operand::get (s));
+        const size_type size2 (e.size2 ());
+        BOOST_UBLAS_CHECK ((transposed ? b.size1 () : b.size2 ()) == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK ((transposed ? b.size2 () : b.size1 ()) == r.size1 () && size2 == r.size2 (), bad_size ());
+        const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+        const difference_type panels ((size2 + block - 1) / block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (operand::lines (b) * (b.lower () + 1 + b.upper ()) * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type k = 0; k < panels; ++ k) {
+            const size_type first (k * block), last ((std::min) (first + block, size2));
+            if (operand::row_major == transposed)
+                banded_prod_panel<true, TV> (b, e, r, first, last);
+            else
+                banded_prod_panel<false, TV> (b, e, r, first, last);
+        }
+    }
+
+    // Diagonal matrices (no lower and upper diagonals) only scale rows or columns.
+    // The result is assigned directly, element i of the diagonal is stored at i.
+    template<template <class T1, class T2> class F, class TV, class V, class S, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void diagonal_prod (V &v, const S &s, const E &e) {
+        typedef F<typename V::reference, TV> functor_type;
+        typedef typename V::size_type size_type;
+        typedef typename S::array_type::const_iterator const_iterator_type;
+
+        const_iterator_type d (s.data ().begin ());
+        const size_type size ((std::min) (s.size1 (), s.size2 ()));
+        for (size_type i = 0; i < size; ++ i)
+            functor_type::apply (v (i), TV (d [i] * e (i)));
+        for (size_type i = size; i < v.size (); ++ i)
+            functor_type::apply (v (i), TV/*zero*/());
+    }
+
+    // m op= D E (ROWS) or m op= E D
+    template<template <class T1, class T2> class F, bool ROWS, class TV, class M, class S, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void diagonal_prod (M &m, const S &s, const E &e) {
+        typedef F<typename M::reference, TV> functor_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename S::array_type::const_iterator const_iterator_type;
+        const bool row_major = boost::is_same<typename M::orientation_category, row_major_tag>::value;
+
+        const_iterator_type d (s.data ().begin ());
+        const size_type size ((std::min) (s.size1 (), s.size2 ()));
+        const size_type size1 (m.size1 ()), size2 (m.size2 ());
+        const size_type major (row_major ? size1 : size2), minor (row_major ? size2 : size1);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size1 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type o = 0; o < difference_type (major); ++ o) {
+            for (size_type q = 0; q < minor; ++ q) {
+                const size_type i (row_major ? o : q), j (row_major ? q : o);
+                const size_type k (ROWS ? i : j);
+                functor_type::apply (m (i, j), k < size ? TV (ROWS ? d [k] * e (i, j) : e (i, j) * d [k]) : TV/*zero*/());
+            }
+        }
+    }
+
+}
+
+    // Products with a banded_matrix assigned to dense vectors, accumulated into the
+    // vector itself for = and +=
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const E &e, TV, detail::banded_operand_tag, detail::prod_left_tag) {
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        typedef detail::banded_operand<typename boost::remove_const<typename E::expression1_closure_type>::type> operand;
+        const typename operand::matrix_type &s (operand::get (e.expression1 ()));
+        if (s.lower () == 0 && s.upper () == 0) {
+            detail::diagonal_prod<F, TV> (v, s, e.expression2 ());
+            return;
+        }
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_vector_assign_scalar<scalar_assign> (v, typename V::value_type/*zero*/());
+            detail::banded_prod<TV> (s, e.expression2 (), v, false);
+            return;
+        }
+        vector<TV> r (e.size (), TV/*zero*/());
+        detail::banded_prod<TV> (s, e.expression2 (), r, false);
+        indexing_vector_assign<F> (v, r);
+    }
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const E &e, TV, detail::banded_operand_tag, detail::prod_right_tag) {
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        typedef detail::banded_operand<typename boost::remove_const<typename E::expression2_closure_type>::type> operand;
+        const typename operand::matrix_type &s (operand::get (e.expression2 ()));
+        if (s.lower () == 0 && s.upper () == 0) {
+            detail::diagonal_prod<F, TV> (v, s, e.expression1 ());
+            return;
+        }
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_vector_assign_scalar<scalar_assign> (v, typename V::value_type/*zero*/());
+            detail::banded_prod<TV> (s, e.expression1 (), v, true);
+            return;
+        }
+        vector<TV> r (e.size (), TV/*zero*/());
+        // x^T B = (B^T x)^T
+        detail::banded_prod<TV> (s, e.expression1 (), r, true);
+        indexing_vector_assign<F> (v, r);
+    }
+
+    // Products with a banded_matrix assigned to dense matrices, accumulated into the
+    // matrix itself for = and +=
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::banded_operand_tag, detail::prod_left_tag) {
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        typedef detail::banded_operand<typename boost::remove_const<typename E::expression1_closure_type>::type> operand;
+        const typename operand::matrix_type &s (operand::get (e.expression1 ()));
+        if (s.lower () == 0 && s.upper () == 0) {
+            detail::diagonal_prod<F, true, TV> (m, s, e.expression2 ());
+            return;
+        }
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_matrix_assign_scalar<scalar_assign> (m, typename M::value_type/*zero*/(), orientation_category ());
+            detail::banded_prod_matrix<TV> (s, e.expression2 (), m, false);
+            return;
+        }
+        matrix<TV, row_major> r (e.size1 (), e.size2 ());
+        r.clear ();
+        detail::banded_prod_matrix<TV> (s, e.expression2 (), r, false);
+        indexing_matrix_assign<F> (m, r, orientation_category ());
+    }
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::banded_operand_tag, detail::prod_right_tag) {
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        typedef detail::banded_operand<typename boost::remove_const<typename E::expression2_closure_type>::type> operand;
+        const typename operand::matrix_type &s (operand::get (e.expression2 ()));
+        if (s.lower () == 0 && s.upper () == 0) {
+            detail::diagonal_prod<F, false, TV> (m, s, e.expression1 ());
+            return;
+        }
+        // E B = (B^T E^T)^T
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_matrix_assign_scalar<scalar_assign> (m, typename M::value_type/*zero*/(), orientation_category ());
+            matrix_unary2<M, scalar_identity<typename M::value_type> > mt (m);
+            detail::banded_prod_matrix<TV> (s, trans (e.expression1 ()), mt, true);
+            return;
+        }
+        matrix<TV, row_major> r (e.size2 (), e.size1 ());
+        r.clear ();
+        detail::banded_prod_matrix<TV> (s, trans (e.expression1 ()), r, true);
+        indexing_matrix_assign<F> (m, trans (r), orientation_category ());
+    }
+
+}}}
+
+#endif
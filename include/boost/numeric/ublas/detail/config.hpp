@@ -279,6 +279,59 @@ bool disable_type_check<Dummy>::value = false;
 #define BOOST_UBLAS_BOUNDED_ARRAY_ALIGN
 #endif
 
+// Use OpenMP to thread the dense level 2 and 3 kernels.
+// Opt-in, and only honoured when the compiler itself has OpenMP enabled.
+#if defined(BOOST_UBLAS_USE_OPENMP) && !defined(_OPENMP)
+#undef BOOST_UBLAS_USE_OPENMP
+#endif
+#ifdef BOOST_UBLAS_USE_OPENMP
+#include <omp.h>
+#endif
+// Minimum number of multiply-adds before a kernel forks threads
+#ifndef BOOST_UBLAS_OPENMP_THRESHOLD
+#define BOOST_UBLAS_OPENMP_THRESHOLD 65536
+#endif
+
+// Tile size of the blocked symmetric rank-k update kernels
+#ifndef BOOST_UBLAS_RANK_UPDATE_BLOCK
+#define BOOST_UBLAS_RANK_UPDATE_BLOCK 32
+#endif
+
+// Tile size of the blocked transpose kernels
+#ifndef BOOST_UBLAS_TRANSPOSE_BLOCK
+#define BOOST_UBLAS_TRANSPOSE_BLOCK 32
+#endif
+
+// Panel width of the blocked factorizations
+#ifndef BOOST_UBLAS_FACTORIZATION_BLOCK
+#define BOOST_UBLAS_FACTORIZATION_BLOCK 32
+#endif
+
+// Column block width of the row permutation kernels
+#ifndef BOOST_UBLAS_PERMUTATION_BLOCK
+#define BOOST_UBLAS_PERMUTATION_BLOCK 64
+#endif
+
+// Counters of calls, operations and time of the kernels, see profile.hpp.
+// Opt-in; the hooks expand to nothing otherwise.
+#ifdef BOOST_UBLAS_PROFILE
+#include <boost/numeric/ublas/profile.hpp>
+#else
+#define BOOST_UBLAS_PROFILE_SCOPE(kernel, elements, flops, bytes)
+#define BOOST_UBLAS_PROFILE_ADD(elements, flops, bytes)
+#define BOOST_UBLAS_PROFILE_TEMPORARY(kind, elements)
+#endif
+
+// Tracking of the allocations of the storage arrays, see allocation.hpp.
+// Opt-in; the hooks expand to nothing otherwise.
+#ifdef BOOST_UBLAS_TRACK_ALLOCATIONS
+#include <boost/numeric/ublas/allocation.hpp>
+#else
+#define BOOST_UBLAS_ALLOCATED(kind, bytes)
+#define BOOST_UBLAS_DEALLOCATED(bytes)
+#define BOOST_UBLAS_ALLOCATION_SCOPE(kind)
+#endif
+
 // Enable different sparse element proxies
 #ifndef BOOST_UBLAS_NO_ELEMENT_PROXIES
 // Sparse proxies prevent reference invalidation problems in expressions such as:
@@ -0,0 +1,203 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_IMPLICIT_PROD_
+#define _BOOST_UBLAS_IMPLICIT_PROD_
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+// Products with implicit operands (identity_matrix, zero_matrix, scalar_matrix,
+// zero_vector, scalar_vector, unit_vector). The operand categories are given by
+// detail::prod_operand_traits; on assignment the product is rewritten to a copy of
+// the other operand, a zero, a column or row of it or a scaling of its row or
+// column sums, so none of them costs more than reading the other operand once.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Row sums (rows) or column sums of a matrix expression
+    template<class TV, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    vector<TV> line_sums (const E &e, bool rows) {
+        typedef typename E::size_type size_type;
+        vector<TV> s (rows ? e.size1 () : e.size2 (), TV/*zero*/());
+        if (boost::is_same<typename E::orientation_category, column_major_tag>::value) {
+            for (size_type j = 0; j < e.size2 (); ++ j)
+                for (size_type i = 0; i < e.size1 (); ++ i)
+                    s (rows ? i : j) += e (i, j);
+        } else {
+            for (size_type i = 0; i < e.size1 (); ++ i)
+                for (size_type j = 0; j < e.size2 (); ++ j)
+                    s (rows ? i : j) += e (i, j);
+        }
+        return s;
+    }
+
+}
+
+    // Products with an identity_matrix assign the other operand; a rectangular identity
+    // picks its leading rows (I A) or columns (A I) and pads them with zeros
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    BOOST_UBLAS_INLINE
+    void structured_matrix_assign (M &m, const E &e, TV, detail::identity_operand_tag, detail::prod_left_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename E::expression2_closure_type expression_type;
+        BOOST_UBLAS_CHECK (e.expression1 ().size2 () == e.expression2 ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 () && m.size2 () == e.size2 (), bad_size ());
+        const size_type common ((std::min) (e.expression1 ().size1 (), e.expression1 ().size2 ()));
+        if (common == e.size1 () && common == e.expression2 ().size1 ()) {
+            matrix_assign<F, basic_full<size_type> > (m, e.expression2 ());
+            return;
+        }
+        matrix_range<M> head (m, range (0, common), range (0, m.size2 ()));
+        matrix_assign<F, basic_full<size_type> > (head, matrix_range<const expression_type> (e.expression2 (), range (0, common), range (0, m.size2 ())));
+        matrix_range<M> tail (m, range (common, m.size1 ()), range (0, m.size2 ()));
+        matrix_assign<F, basic_full<size_type> > (tail, zero_matrix<TV> (tail.size1 (), tail.size2 ()));
+    }
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    BOOST_UBLAS_INLINE
+    void structured_matrix_assign (M &m, const E &e, TV, detail::identity_operand_tag, detail::prod_right_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename E::expression1_closure_type expression_type;
+        BOOST_UBLAS_CHECK (e.expression1 ().size2 () == e.expression2 ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 () && m.size2 () == e.size2 (), bad_size ());
+        const size_type common ((std::min) (e.expression2 ().size1 (), e.expression2 ().size2 ()));
+        if (common == e.size2 () && common == e.expression1 ().size2 ()) {
+            matrix_assign<F, basic_full<size_type> > (m, e.expression1 ());
+            return;
+        }
+        matrix_range<M> head (m, range (0, m.size1 ()), range (0, common));
+        matrix_assign<F, basic_full<size_type> > (head, matrix_range<const expression_type> (e.expression1 (), range (0, m.size1 ()), range (0, common)));
+        matrix_range<M> tail (m, range (0, m.size1 ()), range (common, m.size2 ()));
+        matrix_assign<F, basic_full<size_type> > (tail, zero_matrix<TV> (tail.size1 (), tail.size2 ()));
+    }
+
+namespace detail {
+
+    // v op= the leading common elements of x, followed by zeros
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    BOOST_UBLAS_INLINE
+    void identity_vector_assign (V &v, const E &x, typename V::size_type common, TV) {
+        if (common == x.size () && common == v.size ()) {
+            vector_assign<F> (v, x);
+            return;
+        }
+        vector_range<V> head (v, range (0, common));
+        vector_assign<F> (head, vector_range<const E> (x, range (0, common)));
+        vector_range<V> tail (v, range (common, v.size ()));
+        vector_assign<F> (tail, zero_vector<TV> (v.size () - common));
+    }
+
+}
+
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const E &e, TV, detail::identity_operand_tag, detail::prod_left_tag) {
+        BOOST_UBLAS_CHECK (v.size () == e.expression1 ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (e.expression2 ().size () == e.expression1 ().size2 (), bad_size ());
+        detail::identity_vector_assign<F> (v, e.expression2 (), (std::min) (e.expression1 ().size1 (), e.expression1 ().size2 ()), TV ());
+    }
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const E &e, TV, detail::identity_operand_tag, detail::prod_right_tag) {
+        BOOST_UBLAS_CHECK (v.size () == e.expression2 ().size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (e.expression1 ().size () == e.expression2 ().size1 (), bad_size ());
+        detail::identity_vector_assign<F> (v, e.expression1 (), (std::min) (e.expression2 ().size1 (), e.expression2 ().size2 ()), TV ());
+    }
+
+    // Products with a zero_matrix or zero_vector are zero
+    template<template <class T1, class T2> class F, class M, class E, class TV, class S>
+    BOOST_UBLAS_INLINE
+    void structured_matrix_assign (M &m, const E &e, TV, detail::zero_operand_tag, S) {
+        matrix_assign<F, basic_full<typename M::size_type> > (m, zero_matrix<TV> (e.size1 (), e.size2 ()));
+    }
+    template<template <class T1, class T2> class F, class V, class E, class TV, class S>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const E &e, TV, detail::zero_operand_tag, S) {
+        vector_assign<F> (v, zero_vector<TV> (e.size ()));
+    }
+
+    // Every row of S A is s times the column sums of A, and every column of A S
+    // s times the row sums of A
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::scalar_operand_tag, detail::prod_left_tag) {
+        vector<TV> s (detail::line_sums<TV> (e.expression2 (), false));
+        if (e.expression1 ().size2 () > 0)
+            s *= TV (e.expression1 () (0, 0));
+        matrix_assign<F, basic_full<typename M::size_type> > (m, outer_prod (scalar_vector<TV> (e.size1 ()), s));
+    }
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::scalar_operand_tag, detail::prod_right_tag) {
+        vector<TV> s (detail::line_sums<TV> (e.expression1 (), true));
+        if (e.expression2 ().size1 () > 0)
+            s *= TV (e.expression2 () (0, 0));
+        matrix_assign<F, basic_full<typename M::size_type> > (m, outer_prod (s, scalar_vector<TV> (e.size2 ())));
+    }
+
+    // S x and x S are constant, A s and s A scale the row and column sums of A
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> > &e, TV, detail::scalar_operand_tag, detail::prod_left_tag) {
+        TV t = TV/*zero*/();
+        if (e.expression2 ().size () > 0)
+            t = TV (e.expression1 () (0, 0)) * TV (sum (e.expression2 ()));
+        vector_assign<F> (v, scalar_vector<TV> (e.size (), t));
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> > &e, TV, detail::scalar_operand_tag, detail::prod_right_tag) {
+        vector<TV> s (detail::line_sums<TV> (e.expression1 (), true));
+        if (e.expression2 ().size () > 0)
+            s *= TV (e.expression2 () (0));
+        vector_assign<F> (v, s);
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> > &e, TV, detail::scalar_operand_tag, detail::prod_left_tag) {
+        vector<TV> s (detail::line_sums<TV> (e.expression2 (), false));
+        if (e.expression1 ().size () > 0)
+            s *= TV (e.expression1 () (0));
+        vector_assign<F> (v, s);
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> > &e, TV, detail::scalar_operand_tag, detail::prod_right_tag) {
+        TV t = TV/*zero*/();
+        if (e.expression1 ().size () > 0)
+            t = TV (sum (e.expression1 ())) * TV (e.expression2 () (0, 0));
+        vector_assign<F> (v, scalar_vector<TV> (e.size (), t));
+    }
+
+    // A e_k is column k and e_k A row k of A
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> > &e, TV, detail::unit_operand_tag, detail::prod_right_tag) {
+        typedef typename E1::size_type size_type;
+        const size_type k (e.expression2 ().expression ().index ());
+        vector<TV> c (e.size ());
+        for (size_type i = 0; i < c.size (); ++ i)
+            c (i) = e.expression1 () (i, k);
+        vector_assign<F> (v, c);
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> > &e, TV, detail::unit_operand_tag, detail::prod_left_tag) {
+        typedef typename E2::size_type size_type;
+        const size_type k (e.expression1 ().expression ().index ());
+        vector<TV> r (e.size ());
+        for (size_type j = 0; j < r.size (); ++ j)
+            r (j) = e.expression2 () (k, j);
+        vector_assign<F> (v, r);
+    }
+
+}}}
+
+#endif
@@ -452,6 +452,9 @@ namespace detail {
     template<template <class T1, class T2> class F, class M, class T>
     BOOST_UBLAS_INLINE
     void matrix_assign_scalar (M &m, const T &t) {
+        BOOST_UBLAS_PROFILE_SCOPE (matrix_assign_kernel, m.size1 () * m.size2 (),
+                                   (F<typename M::reference, T>::computed ? m.size1 () * m.size2 () : 0),
+                                   ((F<typename M::reference, T>::computed ? 2 : 1) * m.size1 () * m.size2 () * sizeof (typename M::value_type)));
         typedef typename M::storage_category storage_category;
         typedef typename M::orientation_category orientation_category;
         matrix_assign_scalar<F> (m, t, storage_category (), orientation_category ());
@@ -1208,10 +1211,394 @@ namespace detail {
 #endif
     }
 
+namespace detail {
+
+    // Rank-1 update (GER): m op= x y^T, one scalar of the outer vector hoisted per row (column)
+    template<class F, class M, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void rank_one_update (M &m, const V1 &x, const V2 &y, row_major_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type size1 (m.size1 ());
+        const size_type size2 (m.size2 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size1 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type i = 0; i < difference_type (size1); ++ i) {
+            const typename V1::value_type t (x (i));
+            for (size_type j = 0; j < size2; ++ j)
+                F::apply (m (i, j), t * y (j));
+        }
+    }
+    template<class F, class M, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void rank_one_update (M &m, const V1 &x, const V2 &y, column_major_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type size1 (m.size1 ());
+        const size_type size2 (m.size2 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size1 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type j = 0; j < difference_type (size2); ++ j) {
+            const typename V2::value_type t (y (j));
+            for (size_type i = 0; i < size1; ++ i)
+                F::apply (m (i, j), x (i) * t);
+        }
+    }
+    template<class F, class M, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    void rank_one_update (M &m, const V1 &x, const V2 &y, unknown_orientation_tag) {
+        rank_one_update<F> (m, x, y, row_major_tag ());
+    }
+
+    // Operands of outer products read in place: dense vectors, and ranges, slices, rows
+    // and columns of dense containers. Other expressions are evaluated once first.
+    template<class E>
+    struct stored_vector_operand {
+        static const bool value = boost::is_base_of<vector_container<E>, E>::value;
+    };
+    template<class E>
+    struct stored_matrix_operand {
+        static const bool value = boost::is_base_of<matrix_container<E>, E>::value;
+    };
+    template<class E>
+    struct stored_vector_operand<const E>: stored_vector_operand<E> {};
+    template<class E>
+    struct stored_matrix_operand<const E>: stored_matrix_operand<E> {};
+    template<class E>
+    struct stored_vector_operand<vector_reference<E> >: stored_vector_operand<E> {};
+    template<class E>
+    struct stored_matrix_operand<matrix_reference<E> >: stored_matrix_operand<E> {};
+    template<class V>
+    struct stored_vector_operand<vector_range<V> >: stored_vector_operand<V> {};
+    template<class V>
+    struct stored_vector_operand<vector_slice<V> >: stored_vector_operand<V> {};
+    template<class M>
+    struct stored_vector_operand<matrix_row<M> >: stored_matrix_operand<M> {};
+    template<class M>
+    struct stored_vector_operand<matrix_column<M> >: stored_matrix_operand<M> {};
+
+    template<class E, class T>
+    struct outer_operand {
+        typedef typename boost::mpl::if_c<stored_vector_operand<E>::value &&
+                                          boost::is_convertible<typename E::storage_category, dense_proxy_tag>::value,
+                                          typename E::const_closure_type,
+                                          const vector<T> >::type type;
+    };
+
+    // Symmetric rank-1 update (SYR, HER): only the stored triangle of m is computed
+    template<class F, class M, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void symmetric_rank_one_update (M &m, const V1 &x, const V2 &y, bool lower) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type size (m.size1 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 16) if (size * size / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type p = 0; p < difference_type (size); ++ p) {
+            if (lower) {
+                const typename V1::value_type t (x (p));
+                for (size_type j = 0; j <= size_type (p); ++ j)
+                    F::apply (m.at_element (p, j), t * y (j));
+            } else {
+                const typename V2::value_type t (y (p));
+                for (size_type i = 0; i <= size_type (p); ++ i)
+                    F::apply (m.at_element (i, p), x (i) * t);
+            }
+        }
+    }
+
+    // Symmetric rank-k update (SYRK, HERK): the stored triangle of m op= e1 e2, computed
+    // in square tiles accumulated over the inner dimension before being applied to m
+    template<class F, class T, class M, class E1, class E2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void symmetric_rank_k_update (M &m, const E1 &e1, const E2 &e2, bool lower) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+        const size_type size (m.size1 ());
+        const size_type inner (BOOST_UBLAS_SAME (e1.size2 (), e2.size1 ()));
+        const size_type blocks ((size + block - 1) / block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if (size * size / 2 * inner >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        {
+        std::vector<T> t (block * block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for schedule (dynamic)
+#endif
+        for (difference_type pb = 0; pb < difference_type (blocks); ++ pb) {
+            const size_type p0 (pb * block), p1 ((std::min) (p0 + block, size));
+            for (size_type q0 = 0; q0 <= p0; q0 += block) {
+                const size_type q1 ((std::min) (q0 + block, size));
+                std::fill (t.begin (), t.end (), T/*zero*/());
+                for (size_type k = 0; k < inner; ++ k) {
+                    for (size_type p = p0; p < p1; ++ p) {
+                        const size_type q_end (q0 == p0 ? p + 1 : q1);
+                        T *tp (&t [(p - p0) * block]);
+                        if (lower) {
+                            const T a (e1 (p, k));
+                            for (size_type q = q0; q < q_end; ++ q)
+                                tp [q - q0] += a * e2 (k, q);
+                        } else {
+                            const T b (e2 (k, p));
+                            for (size_type q = q0; q < q_end; ++ q)
+                                tp [q - q0] += e1 (q, k) * b;
+                        }
+                    }
+                }
+                for (size_type p = p0; p < p1; ++ p) {
+                    const size_type q_end (q0 == p0 ? p + 1 : q1);
+                    for (size_type q = q0; q < q_end; ++ q) {
+                        if (lower)
+                            F::apply (m.at_element (p, q), t [(p - p0) * block + q - q0]);
+                        else
+                            F::apply (m.at_element (q, p), t [(p - p0) * block + q - q0]);
+                    }
+                }
+            }
+        }
+        }
+    }
+
+}
+
+    // Outer product into a dense (proxy) matrix
+    template<template <class T1, class T2> class F, class R, class M, class E1, class E2, class T1, class T2, class C>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void matrix_assign (M &m, const matrix_expression<vector_matrix_binary<E1, E2, scalar_multiplies<T1, T2> > > &e, dense_proxy_tag, C) {
+        // R unnecessary, make_conformant not required
+        typedef typename scalar_multiplies<T1, T2>::result_type expr_value_type;
+        typedef F<typename M::reference, expr_value_type> functor_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+        // Like any assignment to m, the operands must not alias it
+        const typename detail::outer_operand<E1, T1>::type x (e ().expression1 ());
+        const typename detail::outer_operand<E2, T2>::type y (e ().expression2 ());
+        detail::rank_one_update<functor_type> (m, x, y, C ());
+    }
+
+    // Outer product into the stored triangle of a symmetric or hermitian matrix
+    template<template <class T1, class T2> class F, class TRI, class M, class E1, class E2, class T1, class T2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void symmetric_matrix_assign (M &m, const matrix_expression<vector_matrix_binary<E1, E2, scalar_multiplies<T1, T2> > > &e) {
+        typedef typename scalar_multiplies<T1, T2>::result_type expr_value_type;
+        typedef F<typename M::value_type &, expr_value_type> functor_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+#if BOOST_UBLAS_TYPE_CHECK
+        typedef typename M::value_type value_type;
+        matrix<value_type, row_major> cm (m.size1 (), m.size2 ());
+        indexing_matrix_assign<scalar_assign> (cm, m, row_major_tag ());
+        indexing_matrix_assign<F> (cm, e, row_major_tag ());
+#endif
+        const typename detail::outer_operand<E1, T1>::type x (e ().expression1 ());
+        const typename detail::outer_operand<E2, T2>::type y (e ().expression2 ());
+        detail::symmetric_rank_one_update<functor_type> (m, x, y,
+            boost::is_convertible<typename TRI::triangular_type, lower_tag>::value);
+#if BOOST_UBLAS_TYPE_CHECK
+        if (! disable_type_check<bool>::value)
+            BOOST_UBLAS_CHECK (detail::expression_type_check (m, cm), external_logic ());
+#endif
+    }
+
+    // Matrix product into the stored triangle of a symmetric or hermitian matrix
+    template<template <class T1, class T2> class F, class TRI, class M, class E1, class E2, class M1, class M2, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void symmetric_matrix_assign (M &m, const matrix_expression<matrix_matrix_binary<E1, E2, matrix_matrix_prod<M1, M2, TV> > > &e) {
+        typedef F<typename M::value_type &, TV> functor_type;
+        BOOST_UBLAS_CHECK (m.size1 () == e ().size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e ().size2 (), bad_size ());
+#if BOOST_UBLAS_TYPE_CHECK
+        typedef typename M::value_type value_type;
+        matrix<value_type, row_major> cm (m.size1 (), m.size2 ());
+        indexing_matrix_assign<scalar_assign> (cm, m, row_major_tag ());
+        indexing_matrix_assign<F> (cm, e, row_major_tag ());
+#endif
+        detail::symmetric_rank_k_update<functor_type, TV> (m, e ().expression1 (), e ().expression2 (),
+            boost::is_convertible<typename TRI::triangular_type, lower_tag>::value);
+#if BOOST_UBLAS_TYPE_CHECK
+        if (! disable_type_check<bool>::value)
+            BOOST_UBLAS_CHECK (detail::expression_type_check (m, cm), external_logic ());
+#endif
+    }
+
+    // Symmetric and hermitian targets of outer products (SYR, HER) and products (SYRK, HERK)
+    template<template <class T1, class T2> class F, class R, class T, class TRI, class L, class A, class E1, class E2, class T1, class T2, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (symmetric_matrix<T, TRI, L, A> &m, const matrix_expression<vector_matrix_binary<E1, E2, scalar_multiplies<T1, T2> > > &e, packed_tag, C) {
+        symmetric_matrix_assign<F, TRI> (m, e);
+    }
+    template<template <class T1, class T2> class F, class R, class T, class TRI, class L, class A, class E1, class E2, class M1, class M2, class TV, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (symmetric_matrix<T, TRI, L, A> &m, const matrix_expression<matrix_matrix_binary<E1, E2, matrix_matrix_prod<M1, M2, TV> > > &e, packed_tag, C) {
+        symmetric_matrix_assign<F, TRI> (m, e);
+    }
+    template<template <class T1, class T2> class F, class R, class T, class TRI, class L, class A, class E1, class E2, class T1, class T2, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (hermitian_matrix<T, TRI, L, A> &m, const matrix_expression<vector_matrix_binary<E1, E2, scalar_multiplies<T1, T2> > > &e, packed_tag, C) {
+        symmetric_matrix_assign<F, TRI> (m, e);
+    }
+    template<template <class T1, class T2> class F, class R, class T, class TRI, class L, class A, class E1, class E2, class M1, class M2, class TV, class C>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (hermitian_matrix<T, TRI, L, A> &m, const matrix_expression<matrix_matrix_binary<E1, E2, matrix_matrix_prod<M1, M2, TV> > > &e, packed_tag, C) {
+        symmetric_matrix_assign<F, TRI> (m, e);
+    }
+
+    // Products of general operands take the usual path
+    template<template <class T1, class T2> class F, class M, class E, class TV, class S>
+    BOOST_UBLAS_INLINE
+    void structured_matrix_assign (M &m, const E &e, TV, detail::general_operand_tag, S) {
+        matrix_assign<F, basic_full<typename M::size_type> > (m, e);
+    }
+
+    // Products assigned to dense matrices are routed to the kernels for structured
+    // (triangular, symmetric, hermitian) operands, see detail::prod_operand_traits.
+    // Products with implicit (identity, zero, scalar) operands are rewritten for any target.
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class M1, class M2, class TV>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_matrix_binary<E1, E2, matrix_matrix_prod<M1, M2, TV> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (prod_kernel, m.size1 () * m.size2 (),
+                                   2 * m.size1 () * m.size2 () * e ().expression1 ().size2 (),
+                                   (m.size1 () * e ().expression1 ().size2 () + e ().expression1 ().size2 () * m.size2 () +
+                                    m.size1 () * m.size2 ()) * sizeof (typename M::value_type));
+        typedef detail::prod_assign_traits<E1, E2, boost::is_convertible<typename M::storage_category, dense_proxy_tag>::value> traits;
+        structured_matrix_assign<F> (m, e (), TV (), typename traits::category (), typename traits::side ());
+    }
+
+namespace detail {
+
+    // Blocked transpose: m op= e, e being the transpose of a dense matrix stored in the
+    // orientation of m. The tiles keep the strided reads of e within a few cache lines.
+    template<class F, class M, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void transpose_assign (M &m, const E &e, row_major_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type block (BOOST_UBLAS_TRANSPOSE_BLOCK);
+        const size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e.size1 ()));
+        const size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e.size2 ()));
+        const size_type blocks ((size1 + block - 1) / block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size1 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type ib = 0; ib < difference_type (blocks); ++ ib) {
+            const size_type i0 (ib * block), i1 ((std::min) (i0 + block, size1));
+            for (size_type j0 = 0; j0 < size2; j0 += block) {
+                const size_type j1 ((std::min) (j0 + block, size2));
+                for (size_type i = i0; i < i1; ++ i)
+                    for (size_type j = j0; j < j1; ++ j)
+                        F::apply (m (i, j), e (i, j));
+            }
+        }
+    }
+    template<class F, class M, class E>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void transpose_assign (M &m, const E &e, column_major_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        const size_type block (BOOST_UBLAS_TRANSPOSE_BLOCK);
+        const size_type size1 (BOOST_UBLAS_SAME (m.size1 (), e.size1 ()));
+        const size_type size2 (BOOST_UBLAS_SAME (m.size2 (), e.size2 ()));
+        const size_type blocks ((size2 + block - 1) / block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size1 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type jb = 0; jb < difference_type (blocks); ++ jb) {
+            const size_type j0 (jb * block), j1 ((std::min) (j0 + block, size2));
+            for (size_type i0 = 0; i0 < size1; i0 += block) {
+                const size_type i1 ((std::min) (i0 + block, size1));
+                for (size_type j = j0; j < j1; ++ j)
+                    for (size_type i = i0; i < i1; ++ i)
+                        F::apply (m (i, j), e (i, j));
+            }
+        }
+    }
+
+}
+
+    // Transposed matrices take the usual path unless both sides are dense with
+    // the same storage orientation
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    void transpose_matrix_assign (M &m, const E &e, unknown_orientation_tag) {
+        matrix_assign<F, basic_full<typename M::size_type> > (m, e);
+    }
+    template<template <class T1, class T2> class F, class M, class E, class C>
+    BOOST_UBLAS_INLINE
+    void transpose_matrix_assign (M &m, const E &e, C) {
+        typedef F<typename M::reference, typename E::value_type> functor_type;
+        detail::transpose_assign<functor_type> (m, e, C ());
+    }
+    template<template <class T1, class T2> class F, class M, class E, class F1>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_unary2<E, F1> > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (matrix_assign_kernel, m.size1 () * m.size2 (),
+                                   (profile::assign_flops<F> (m, e (), m.size1 () * m.size2 ())),
+                                   (profile::assign_bytes<F> (m, e (), m.size1 () * m.size2 ())));
+        typedef typename boost::remove_const<E>::type expression_type;
+        typedef typename M::orientation_category orientation_category;
+        typedef typename boost::mpl::if_c<boost::is_convertible<typename M::storage_category, dense_proxy_tag>::value &&
+                                          boost::is_convertible<typename expression_type::storage_category, dense_proxy_tag>::value &&
+                                          boost::is_same<typename expression_type::orientation_category, orientation_category>::value &&
+                                          ! boost::is_same<orientation_category, unknown_orientation_tag>::value,
+                                          orientation_category, unknown_orientation_tag>::type category;
+        transpose_matrix_assign<F> (m, e (), category ());
+    }
+
+    // Sums and differences with a zero_matrix only assign the other operand, after
+    // checking the size of the zero_matrix
+    template<template <class T1, class T2> class F, class M, class E, class S>
+    BOOST_UBLAS_INLINE
+    void sum_matrix_assign (M &m, const E &e, detail::general_operand_tag, S) {
+        matrix_assign<F, basic_full<typename M::size_type> > (m, e);
+    }
+    template<template <class T1, class T2> class F, class M, class E>
+    BOOST_UBLAS_INLINE
+    void sum_matrix_assign (M &m, const E &e, detail::zero_operand_tag, detail::prod_right_tag) {
+        BOOST_UBLAS_CHECK (e.expression2 ().size1 () == m.size1 () && e.expression2 ().size2 () == m.size2 (), bad_size ());
+        matrix_assign<F, basic_full<typename M::size_type> > (m, e.expression1 ());
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void sum_matrix_assign (M &m, const matrix_binary<E1, E2, scalar_plus<T1, T2> > &e, detail::zero_operand_tag, detail::prod_left_tag) {
+        BOOST_UBLAS_CHECK (e.expression1 ().size1 () == m.size1 () && e.expression1 ().size2 () == m.size2 (), bad_size ());
+        matrix_assign<F, basic_full<typename M::size_type> > (m, e.expression2 ());
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void sum_matrix_assign (M &m, const matrix_binary<E1, E2, scalar_minus<T1, T2> > &e, detail::zero_operand_tag, detail::prod_left_tag) {
+        BOOST_UBLAS_CHECK (e.expression1 ().size1 () == m.size1 () && e.expression1 ().size2 () == m.size2 (), bad_size ());
+        matrix_assign<F, basic_full<typename M::size_type> > (m, - e.expression2 ());
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_binary<E1, E2, scalar_plus<T1, T2> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (matrix_assign_kernel, m.size1 () * m.size2 (),
+                                   (profile::assign_flops<F> (m, e (), m.size1 () * m.size2 ())),
+                                   (profile::assign_bytes<F> (m, e (), m.size1 () * m.size2 ())));
+        typedef detail::sum_operand_traits<E1, E2> traits;
+        sum_matrix_assign<F> (m, e (), typename traits::category (), typename traits::side ());
+    }
+    template<template <class T1, class T2> class F, class M, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void matrix_assign (M &m, const matrix_expression<matrix_binary<E1, E2, scalar_minus<T1, T2> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (matrix_assign_kernel, m.size1 () * m.size2 (),
+                                   (profile::assign_flops<F> (m, e (), m.size1 () * m.size2 ())),
+                                   (profile::assign_bytes<F> (m, e (), m.size1 () * m.size2 ())));
+        typedef detail::sum_operand_traits<E1, E2> traits;
+        sum_matrix_assign<F> (m, e (), typename traits::category (), typename traits::side ());
+    }
+
     // Dispatcher
     template<template <class T1, class T2> class F, class M, class E>
     BOOST_UBLAS_INLINE
     void matrix_assign (M &m, const matrix_expression<E> &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (matrix_assign_kernel, m.size1 () * m.size2 (),
+                                   (profile::assign_flops<F> (m, e (), m.size1 () * m.size2 ())),
+                                   (profile::assign_bytes<F> (m, e (), m.size1 () * m.size2 ())));
         typedef typename matrix_assign_traits<typename M::storage_category,
                                               F<typename M::reference, typename E::value_type>::computed,
                                               typename E::const_iterator1::iterator_category,
@@ -1226,6 +1613,9 @@ namespace detail {
     template<template <class T1, class T2> class F, class R, class M, class E>
     BOOST_UBLAS_INLINE
     void matrix_assign (M &m, const matrix_expression<E> &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (matrix_assign_kernel, m.size1 () * m.size2 (),
+                                   (profile::assign_flops<F> (m, e (), m.size1 () * m.size2 ())),
+                                   (profile::assign_bytes<F> (m, e (), m.size1 () * m.size2 ())));
         typedef R conformant_restrict_type;
         typedef typename matrix_assign_traits<typename M::storage_category,
                                               F<typename M::reference, typename E::value_type>::computed,
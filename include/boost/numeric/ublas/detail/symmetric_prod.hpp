@@ -0,0 +1,334 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SYMMETRIC_PROD_
+#define _BOOST_UBLAS_SYMMETRIC_PROD_
+
+#include <boost/numeric/ublas/matrix.hpp>
+
+// Products with packed symmetric and hermitian matrices (SYMV, HEMV, SYMM, HEMM).
+// The packed triangle is streamed once in storage order and every off diagonal
+// element is applied to both of its mirrored positions.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Element of the other triangle
+    struct symmetric_mirror {
+        template<class T>
+        static
+        BOOST_UBLAS_INLINE
+        T apply (const T &t) {
+            return t;
+        }
+    };
+    struct hermitian_mirror {
+        template<class T>
+        static
+        BOOST_UBLAS_INLINE
+        T apply (const T &t) {
+            return type_traits<T>::conj (t);
+        }
+    };
+
+    template<class M>
+    struct packed_symmetric_operand;
+
+    template<class T, class TRI, class L, class A>
+    struct packed_symmetric_operand<symmetric_matrix<T, TRI, L, A> > {
+        typedef symmetric_matrix<T, TRI, L, A> matrix_type;
+        typedef symmetric_mirror mirror_type;
+        typedef TRI triangular_type;
+        typedef L layout_type;
+        typedef A array_type;
+
+        static
+        BOOST_UBLAS_INLINE
+        const matrix_type &get (const matrix_type &m) {
+            return m;
+        }
+    };
+    template<class T, class TRI, class L, class A>
+    struct packed_symmetric_operand<hermitian_matrix<T, TRI, L, A> > {
+        typedef hermitian_matrix<T, TRI, L, A> matrix_type;
+        typedef hermitian_mirror mirror_type;
+        typedef TRI triangular_type;
+        typedef L layout_type;
+        typedef A array_type;
+
+        static
+        BOOST_UBLAS_INLINE
+        const matrix_type &get (const matrix_type &m) {
+            return m;
+        }
+    };
+    // Containers appear as references in product expressions
+    template<class E>
+    struct packed_symmetric_operand<matrix_reference<E> >:
+        public packed_symmetric_operand<typename boost::remove_const<E>::type> {
+        typedef typename packed_symmetric_operand<typename boost::remove_const<E>::type>::matrix_type matrix_type;
+
+        static
+        BOOST_UBLAS_INLINE
+        const matrix_type &get (const matrix_reference<E> &m) {
+            return m.expression ();
+        }
+    };
+
+    template<class T, class TRI, class L, class A>
+    struct prod_operand_traits<symmetric_matrix<T, TRI, L, A> > {
+        typedef symmetric_operand_tag category;
+    };
+    template<class T, class TRI, class L, class A>
+    struct prod_operand_traits<hermitian_matrix<T, TRI, L, A> > {
+        typedef symmetric_operand_tag category;
+    };
+
+    // Traversal of the packed triangle: line o of the storage holds the elements
+    // (o, q) of a row (row major) or (q, o) of a column (column major). Lines of the
+    // leading kind run from q = 0 to the diagonal, the others from the diagonal to n.
+    template<class TRI, class L>
+    struct packed_symmetric_lines {
+        static const bool row_major = boost::is_same<typename L::orientation_category, row_major_tag>::value;
+        static const bool leading = boost::is_convertible<typename TRI::triangular_type, lower_tag>::value == row_major;
+
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        Z diagonal (Z o, Z size) {
+            return TRI::element (L (), o, size, o, size);
+        }
+        // Storage position of the first off diagonal element of line o
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        Z first (Z o, Z size) {
+            return leading ? diagonal (o, size) - o : diagonal (o, size) + 1;
+        }
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        Z begin (Z o, Z /* size */) {
+            return leading ? 0 : o + 1;
+        }
+        template<class Z>
+        static
+        BOOST_UBLAS_INLINE
+        Z end (Z o, Z size) {
+            return leading ? o : size;
+        }
+    };
+
+    // y += S x (or S^T x when TRANS), lines [first, last) of the packed triangle.
+    // For a stored element a of line o the element on the same side of the diagonal
+    // as the line (o, q) multiplies as f, its mirror as g.
+    template<class MIR, class TRI, class L, bool FLIP, class TV, class A, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void packed_symmetric_prod_lines (const A &data, typename A::size_type size,
+                                      const V1 &x, V2 &y,
+                                      typename A::size_type first, typename A::size_type last) {
+        typedef typename A::size_type size_type;
+        typedef packed_symmetric_lines<TRI, L> lines;
+
+        for (size_type o = first; o < last; ++ o) {
+            const TV xo (x (o));
+            TV t (data [lines::diagonal (o, size)] * xo);
+            size_type p (lines::first (o, size));
+            const size_type q_end (lines::end (o, size));
+            for (size_type q = lines::begin (o, size); q < q_end; ++ q, ++ p) {
+                const TV a (data [p]);
+                const TV f (FLIP ? MIR::apply (a) : a);
+                const TV g (FLIP ? a : MIR::apply (a));
+                t += f * x (q);
+                y (q) += g * xo;
+            }
+            y (o) += t;
+        }
+    }
+
+    template<class MIR, class TRI, class L, bool FLIP, class TV, class A, class V1, class V2>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void packed_symmetric_prod (const A &data, typename A::size_type size, const V1 &x, V2 &y) {
+        typedef typename A::size_type size_type;
+
+#ifdef BOOST_UBLAS_USE_OPENMP
+        typedef typename A::difference_type difference_type;
+        if (size * size / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD) {
+#pragma omp parallel
+            {
+                vector<TV> w (size, TV/*zero*/());
+#pragma omp for schedule (dynamic, 16)
+                for (difference_type o = 0; o < difference_type (size); ++ o)
+                    packed_symmetric_prod_lines<MIR, TRI, L, FLIP, TV> (data, size, x, w, size_type (o), size_type (o + 1));
+#pragma omp critical (boost_ublas_symv)
+                for (size_type i = 0; i < size; ++ i)
+                    y (i) += w (i);
+            }
+            return;
+        }
+#endif
+        packed_symmetric_prod_lines<MIR, TRI, L, FLIP, TV> (data, size, x, y, size_type (0), size);
+    }
+
+    // SYMV, HEMV: y += S x, or y += S^T x
+    template<class TV, class S, class V1, class V2>
+    BOOST_UBLAS_INLINE
+    void symmetric_prod (const S &s, const V1 &x, V2 &y, bool transposed) {
+        typedef packed_symmetric_operand<S> operand;
+        typedef typename operand::mirror_type mirror_type;
+        typedef typename operand::triangular_type triangular_type;
+        typedef typename operand::layout_type layout_type;
+        const bool row_major = packed_symmetric_lines<triangular_type, layout_type>::row_major;
+
+        BOOST_UBLAS_CHECK (operand::get (s).size2 () == x.size (), bad_size ());
+        BOOST_UBLAS_CHECK (operand::get (s).size1 () == y.size (), bad_size ());
+        if (row_major == transposed)
+            packed_symmetric_prod<mirror_type, triangular_type, layout_type, true, TV> (operand::get (s).data (), operand::get (s).size1 (), x, y);
+        else
+            packed_symmetric_prod<mirror_type, triangular_type, layout_type, false, TV> (operand::get (s).data (), operand::get (s).size1 (), x, y);
+    }
+
+    // r += S B (or S^T B when TRANS) for the columns [first, last) of B and r
+    template<class MIR, class TRI, class L, bool FLIP, class TV, class A, class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void packed_symmetric_prod_panel (const A &data, typename A::size_type size,
+                                      const E &b, R &r,
+                                      typename A::size_type first, typename A::size_type last) {
+        typedef typename A::size_type size_type;
+        typedef packed_symmetric_lines<TRI, L> lines;
+
+        for (size_type o = 0; o < size; ++ o) {
+            const TV d (data [lines::diagonal (o, size)]);
+            for (size_type c = first; c < last; ++ c)
+                r (o, c) += d * b (o, c);
+            size_type p (lines::first (o, size));
+            const size_type q_end (lines::end (o, size));
+            for (size_type q = lines::begin (o, size); q < q_end; ++ q, ++ p) {
+                const TV a (data [p]);
+                const TV f (FLIP ? MIR::apply (a) : a);
+                const TV g (FLIP ? a : MIR::apply (a));
+                for (size_type c = first; c < last; ++ c) {
+                    r (o, c) += f * b (q, c);
+                    r (q, c) += g * b (o, c);
+                }
+            }
+        }
+    }
+
+    // SYMM, HEMM: r += S B, or r += S^T B. The columns of B are processed in panels
+    // of BOOST_UBLAS_RANK_UPDATE_BLOCK, each reusing every stored element of S.
+    template<class TV, class S, class E, class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void symmetric_prod_matrix (const S &s, const E &b, R &r, bool transposed) {
+        typedef packed_symmetric_operand<S> operand;
+        typedef typename operand::mirror_type mirror_type;
+        typedef typename operand::triangular_type triangular_type;
+        typedef typename operand::layout_type layout_type;
+        typedef typename R::size_type size_type;
+        typedef typename R::difference_type difference_type;
+        const bool row_major = packed_symmetric_lines<triangular_type, layout_type>::row_major;
+
+        const size_type size (operand::get (s).size1 ());
+        const size_type size2 (b.size2 ());
+        BOOST_UBLAS_CHECK (size == b.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (size == r.size1 () && size2 == r.size2 (), bad_size ());
+        const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+        const difference_type panels ((size2 + block - 1) / block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (size * size / 2 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type k = 0; k < panels; ++ k) {
+            const size_type first (k * block), last ((std::min) (first + block, size2));
+            if (row_major == transposed)
+                packed_symmetric_prod_panel<mirror_type, triangular_type, layout_type, true, TV> (operand::get (s).data (), size, b, r, first, last);
+            else
+                packed_symmetric_prod_panel<mirror_type, triangular_type, layout_type, false, TV> (operand::get (s).data (), size, b, r, first, last);
+        }
+    }
+
+}
+
+    // Products with a symmetric_matrix or hermitian_matrix assigned to dense vectors,
+    // accumulated into the vector itself for = and +=
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const E &e, TV, detail::symmetric_operand_tag, detail::prod_left_tag) {
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_vector_assign_scalar<scalar_assign> (v, typename V::value_type/*zero*/());
+            detail::symmetric_prod<TV> (e.expression1 (), e.expression2 (), v, false);
+            return;
+        }
+        vector<TV> r (e.size (), TV/*zero*/());
+        detail::symmetric_prod<TV> (e.expression1 (), e.expression2 (), r, false);
+        indexing_vector_assign<F> (v, r);
+    }
+    template<template <class T1, class T2> class F, class V, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_vector_assign (V &v, const E &e, TV, detail::symmetric_operand_tag, detail::prod_right_tag) {
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (v.size () == e.size (), bad_size ());
+        // x^T S = (S^T x)^T
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_vector_assign_scalar<scalar_assign> (v, typename V::value_type/*zero*/());
+            detail::symmetric_prod<TV> (e.expression2 (), e.expression1 (), v, true);
+            return;
+        }
+        vector<TV> r (e.size (), TV/*zero*/());
+        detail::symmetric_prod<TV> (e.expression2 (), e.expression1 (), r, true);
+        indexing_vector_assign<F> (v, r);
+    }
+
+    // Products with a symmetric_matrix or hermitian_matrix assigned to dense matrices,
+    // accumulated into the matrix itself for = and +=
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::symmetric_operand_tag, detail::prod_left_tag) {
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_matrix_assign_scalar<scalar_assign> (m, typename M::value_type/*zero*/(), orientation_category ());
+            detail::symmetric_prod_matrix<TV> (e.expression1 (), e.expression2 (), m, false);
+            return;
+        }
+        matrix<TV, row_major> r (e.size1 (), e.size2 ());
+        r.clear ();
+        detail::symmetric_prod_matrix<TV> (e.expression1 (), e.expression2 (), r, false);
+        indexing_matrix_assign<F> (m, r, orientation_category ());
+    }
+    template<template <class T1, class T2> class F, class M, class E, class TV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::symmetric_operand_tag, detail::prod_right_tag) {
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        // B S = (S^T B^T)^T
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_matrix_assign_scalar<scalar_assign> (m, typename M::value_type/*zero*/(), orientation_category ());
+            matrix_unary2<M, scalar_identity<typename M::value_type> > mt (m);
+            detail::symmetric_prod_matrix<TV> (e.expression2 (), trans (e.expression1 ()), mt, true);
+            return;
+        }
+        matrix<TV, row_major> r (e.size2 (), e.size1 ());
+        r.clear ();
+        detail::symmetric_prod_matrix<TV> (e.expression2 (), trans (e.expression1 ()), r, true);
+        indexing_matrix_assign<F> (m, trans (r), orientation_category ());
+    }
+
+}}}
+
+#endif
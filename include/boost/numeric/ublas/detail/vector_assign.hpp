@@ -173,6 +173,9 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class T>
     BOOST_UBLAS_INLINE
     void vector_assign_scalar (V &v, const T &t) {
+        BOOST_UBLAS_PROFILE_SCOPE (vector_assign_kernel, v.size (),
+                                   (F<typename V::reference, T>::computed ? v.size () : 0),
+                                   ((F<typename V::reference, T>::computed ? 2 : 1) * v.size () * sizeof (typename V::value_type)));
         typedef typename V::storage_category storage_category;
         vector_assign_scalar<F> (v, t, storage_category ());
     }
@@ -442,12 +445,119 @@ namespace detail {
     template<template <class T1, class T2> class F, class V, class E>
     BOOST_UBLAS_INLINE
     void vector_assign (V &v, const vector_expression<E> &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (vector_assign_kernel, v.size (),
+                                   (profile::assign_flops<F> (v, e (), v.size ())),
+                                   (profile::assign_bytes<F> (v, e (), v.size ())));
         typedef typename vector_assign_traits<typename V::storage_category,
                                               F<typename V::reference, typename E::value_type>::computed,
                                               typename E::const_iterator::iterator_category>::storage_category storage_category;
         vector_assign<F> (v, e, storage_category ());
     }
 
+namespace detail {
+
+    // The product kernels of structured operands accumulate r += A B. Plain and
+    // additive assignments to a dense target run them on the target itself, the
+    // plain one clearing it first; the other assignments go through a temporary.
+    template<template <class T1, class T2> class F>
+    struct accumulate_assign_traits {
+        static const bool direct = false;
+        static const bool clear = false;
+    };
+    template<>
+    struct accumulate_assign_traits<scalar_assign> {
+        static const bool direct = true;
+        static const bool clear = true;
+    };
+    template<>
+    struct accumulate_assign_traits<scalar_plus_assign> {
+        static const bool direct = true;
+        static const bool clear = false;
+    };
+
+}
+
+    // Products of general operands take the usual path
+    template<template <class T1, class T2> class F, class V, class E, class TV, class S>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const E &e, TV, detail::general_operand_tag, S) {
+        typedef typename vector_assign_traits<typename V::storage_category,
+                                              F<typename V::reference, typename E::value_type>::computed,
+                                              typename E::const_iterator::iterator_category>::storage_category storage_category;
+        vector_assign<F> (v, e, storage_category ());
+    }
+
+    // Matrix-vector products assigned to dense vectors are routed to the kernels for
+    // structured (symmetric, hermitian) operands, see detail::prod_operand_traits.
+    // Products with implicit (identity, zero, scalar, unit) operands are rewritten for any target.
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary1<E1, E2, matrix_vector_prod1<M1, M2, TV> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (prod_kernel, v.size (),
+                                   2 * e ().expression1 ().size1 () * e ().expression1 ().size2 (),
+                                   (e ().expression1 ().size1 () * e ().expression1 ().size2 () +
+                                    e ().expression1 ().size2 () + v.size ()) * sizeof (typename V::value_type));
+        typedef detail::prod_assign_traits<E1, E2, boost::is_convertible<typename V::storage_category, dense_proxy_tag>::value> traits;
+        structured_vector_assign<F> (v, e (), TV (), typename traits::category (), typename traits::side ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class M1, class M2, class TV>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<matrix_vector_binary2<E1, E2, matrix_vector_prod2<M1, M2, TV> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (prod_kernel, v.size (),
+                                   2 * e ().expression2 ().size1 () * e ().expression2 ().size2 (),
+                                   (e ().expression2 ().size1 () * e ().expression2 ().size2 () +
+                                    e ().expression2 ().size1 () + v.size ()) * sizeof (typename V::value_type));
+        typedef detail::prod_assign_traits<E1, E2, boost::is_convertible<typename V::storage_category, dense_proxy_tag>::value> traits;
+        structured_vector_assign<F> (v, e (), TV (), typename traits::category (), typename traits::side ());
+    }
+
+    // Sums and differences with a zero_vector only assign the other operand, after
+    // checking the size of the zero_vector
+    template<template <class T1, class T2> class F, class V, class E, class S>
+    BOOST_UBLAS_INLINE
+    void sum_vector_assign (V &v, const E &e, detail::general_operand_tag, S) {
+        typedef typename vector_assign_traits<typename V::storage_category,
+                                              F<typename V::reference, typename E::value_type>::computed,
+                                              typename E::const_iterator::iterator_category>::storage_category storage_category;
+        vector_assign<F> (v, e, storage_category ());
+    }
+    template<template <class T1, class T2> class F, class V, class E>
+    BOOST_UBLAS_INLINE
+    void sum_vector_assign (V &v, const E &e, detail::zero_operand_tag, detail::prod_right_tag) {
+        BOOST_UBLAS_CHECK (e.expression2 ().size () == v.size (), bad_size ());
+        vector_assign<F> (v, e.expression1 ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void sum_vector_assign (V &v, const vector_binary<E1, E2, scalar_plus<T1, T2> > &e, detail::zero_operand_tag, detail::prod_left_tag) {
+        BOOST_UBLAS_CHECK (e.expression1 ().size () == v.size (), bad_size ());
+        vector_assign<F> (v, e.expression2 ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void sum_vector_assign (V &v, const vector_binary<E1, E2, scalar_minus<T1, T2> > &e, detail::zero_operand_tag, detail::prod_left_tag) {
+        BOOST_UBLAS_CHECK (e.expression1 ().size () == v.size (), bad_size ());
+        vector_assign<F> (v, - e.expression2 ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<vector_binary<E1, E2, scalar_plus<T1, T2> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (vector_assign_kernel, v.size (),
+                                   (profile::assign_flops<F> (v, e (), v.size ())),
+                                   (profile::assign_bytes<F> (v, e (), v.size ())));
+        typedef detail::sum_operand_traits<E1, E2> traits;
+        sum_vector_assign<F> (v, e (), typename traits::category (), typename traits::side ());
+    }
+    template<template <class T1, class T2> class F, class V, class E1, class E2, class T1, class T2>
+    BOOST_UBLAS_INLINE
+    void vector_assign (V &v, const vector_expression<vector_binary<E1, E2, scalar_minus<T1, T2> > > &e) {
+        BOOST_UBLAS_PROFILE_SCOPE (vector_assign_kernel, v.size (),
+                                   (profile::assign_flops<F> (v, e (), v.size ())),
+                                   (profile::assign_bytes<F> (v, e (), v.size ())));
+        typedef detail::sum_operand_traits<E1, E2> traits;
+        sum_vector_assign<F> (v, e (), typename traits::category (), typename traits::side ());
+    }
+
     template<class SC, class RI>
     struct vector_swap_traits {
         typedef SC storage_category;
@@ -0,0 +1,942 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_EIGEN_
+#define _BOOST_UBLAS_EIGEN_
+
+#include <boost/numeric/ublas/qr.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Eigenvalues and eigenvectors of real symmetric matrices in the spirit of LAPACK
+// (xSYTRD, xLATRD, xORMTR, xSTEDC, xSTERF, xSTEBZ, xSTEIN)
+//
+// A is first reduced to a tridiagonal T = Q^T A Q, T having the diagonal d and the
+// subdiagonal e. The reduction works in place on the lower triangle of A, referenced
+// through m (i, j) with i >= j, so m may be a dense matrix or a (packed)
+// symmetric_matrix. Q = H (0) ... H (n - 2), H (i) = I - tau (i) v (i) v (i)^T being
+// stored below the subdiagonal of column i with v (i) (i + 1) = 1 implicit.
+//
+// The eigenvalues of T are computed by implicit QL iteration, all eigenpairs by
+// divide and conquer and selected ones by bisection and inverse iteration.
+// Eigenvalues are in ascending order, eigenvectors are the columns of z.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // sqrt (a^2 + b^2) without destructive overflow or underflow
+    template<class R>
+    BOOST_UBLAS_INLINE
+    R eigen_pythag (R a, R b) {
+        a = type_traits<R>::type_abs (a);
+        b = type_traits<R>::type_abs (b);
+        const R p ((std::max) (a, b));
+        if (p == R/*zero*/())
+            return p;
+        const R q ((std::min) (a, b) / p);
+        return p * type_traits<R>::type_sqrt (R (1) + q * q);
+    }
+
+    // Reduces the columns k .. k + nb - 1 of m to tridiagonal form and computes w such
+    // that the rest of A is updated by A - V W^T - W V^T (xLATRD)
+    template<class M, class V, class W>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void tridiagonal_panel (M &m, V &e, V &tau, typename M::size_type k, typename M::size_type nb, W &w) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        vector<value_type> v (n), t1 (nb), t2 (nb);
+        for (size_type p = 0; p < nb; ++ p) {
+            const size_type i (k + p);
+            // Column i of A - V W^T - W V^T
+            for (size_type r = i; r < n; ++ r) {
+                value_type s (m (r, i));
+                for (size_type q = 0; q < p; ++ q)
+                    s -= m (r, k + q) * w (i, q) + w (r, q) * m (i, k + q);
+                m (r, i) = s;
+            }
+            if (i + 1 >= n)
+                continue;
+            tau (i) = qr_reflector (m, i + 1, i);
+            e (i) = m (i + 1, i);
+            m (i + 1, i) = value_type (1);
+            for (size_type r = i + 1; r < n; ++ r)
+                v (r) = m (r, i);
+
+            // y = A (i + 1:n, i + 1:n) v from the lower triangle, which is not updated yet
+            vector<value_type> y (n, value_type/*zero*/());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if ((n - i) * (n - i) / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            {
+                vector<value_type> yp (n, value_type/*zero*/());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for schedule (dynamic, 16)
+#endif
+                for (difference_type c = difference_type (i + 1); c < difference_type (n); ++ c) {
+                    const value_type vc (v (c));
+                    value_type s (m (c, c) * vc);
+                    for (size_type r = c + 1; r < n; ++ r) {
+                        const value_type a (m (r, c));
+                        yp (r) += a * vc;
+                        s += a * v (r);
+                    }
+                    yp (c) += s;
+                }
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp critical (boost_ublas_sytrd)
+#endif
+                y += yp;
+            }
+
+            // y -= V W^T v + W V^T v over the columns of the panel done so far
+            for (size_type q = 0; q < p; ++ q) {
+                value_type s1 = value_type/*zero*/(), s2 = value_type/*zero*/();
+                for (size_type r = i + 1; r < n; ++ r) {
+                    s1 += w (r, q) * v (r);
+                    s2 += m (r, k + q) * v (r);
+                }
+                t1 (q) = s1;
+                t2 (q) = s2;
+            }
+            const value_type ti (tau (i));
+            value_type dot = value_type/*zero*/();
+            for (size_type r = i + 1; r < n; ++ r) {
+                value_type s (y (r));
+                for (size_type q = 0; q < p; ++ q)
+                    s -= m (r, k + q) * t1 (q) + w (r, q) * t2 (q);
+                s *= ti;
+                w (r, p) = s;
+                dot += s * v (r);
+            }
+            const value_type alpha (- value_type (0.5) * ti * dot);
+            for (size_type r = i + 1; r < n; ++ r)
+                w (r, p) += alpha * v (r);
+        }
+    }
+
+    // Symmetric rank 2k update of the lower triangle of A (k + nb:n, k + nb:n) (xSYR2K)
+    template<class M, class W>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void tridiagonal_update (M &m, typename M::size_type k, typename M::size_type nb, const W &w) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        const size_type j0 (k + nb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 4) if ((n - j0) * (n - j0) * nb >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type c = difference_type (j0); c < difference_type (n); ++ c) {
+            for (size_type q = 0; q < nb; ++ q) {
+                const value_type wc (w (c, q)), vc (m (c, k + q));
+                for (size_type r = c; r < n; ++ r)
+                    m (r, c) -= m (r, k + q) * wc + w (r, q) * vc;
+            }
+        }
+    }
+
+    // Implicit QL iteration with Wilkinson shifts on the tridiagonal d, e, e (i) coupling
+    // i and i + 1 and e (n - 1) = 0. With vectors the rotations are applied to the
+    // columns of z. Returns 0 or the index plus one of an eigenvalue that did not converge.
+    template<class V, class MZ>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename V::size_type tridiagonal_ql (V &d, V &e, MZ &z, bool vectors) {
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ());
+        const real_type eps (std::numeric_limits<real_type>::epsilon ());
+        for (size_type l = 0; l < n; ++ l) {
+            size_type iter = 0;
+            size_type mm;
+            do {
+                for (mm = l; mm + 1 < n; ++ mm) {
+                    const real_type dd (type_traits<real_type>::type_abs (d (mm)) + type_traits<real_type>::type_abs (d (mm + 1)));
+                    if (type_traits<real_type>::type_abs (e (mm)) <= eps * dd)
+                        break;
+                }
+                if (mm != l) {
+                    if (iter ++ == 30)
+                        return l + 1;
+                    real_type g ((d (l + 1) - d (l)) / (real_type (2) * e (l)));
+                    real_type r (eigen_pythag (g, real_type (1)));
+                    g = d (mm) - d (l) + e (l) / (g + (g >= real_type/*zero*/() ? r : - r));
+                    real_type s (1), c (1), p = real_type/*zero*/();
+                    size_type i = mm;
+                    bool underflow = false;
+                    while (i -- > l) {
+                        const real_type f (s * e (i)), b (c * e (i));
+                        r = eigen_pythag (f, g);
+                        e (i + 1) = r;
+                        if (r == real_type/*zero*/()) {
+                            d (i + 1) -= p;
+                            e (mm) = real_type/*zero*/();
+                            underflow = true;
+                            break;
+                        }
+                        s = f / r;
+                        c = g / r;
+                        g = d (i + 1) - p;
+                        r = (d (i) - g) * s + real_type (2) * c * b;
+                        p = s * r;
+                        d (i + 1) = g + p;
+                        g = c * r - b;
+                        if (vectors) {
+                            for (size_type k = 0; k < z.size1 (); ++ k) {
+                                const real_type zf (z (k, i + 1));
+                                z (k, i + 1) = s * z (k, i) + c * zf;
+                                z (k, i) = c * z (k, i) - s * zf;
+                            }
+                        }
+                    }
+                    if (underflow)
+                        continue;
+                    d (l) -= p;
+                    e (l) = g;
+                    e (mm) = real_type/*zero*/();
+                }
+            } while (mm != l);
+        }
+        return 0;
+    }
+
+    // Root j of the secular equation 1 / rho + sum z_i^2 / (dk_i - lambda) = 0 for poles
+    // dk in ascending order. The root is returned as lambda = dk (origin) + tau, which
+    // keeps the differences lambda - dk_i accurate.
+    template<class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void secular_root (const vector<R> &dk, const vector<R> &zk, R rho, std::size_t j, std::size_t &origin, R &tau) {
+        const std::size_t k (dk.size ());
+        const R eps (std::numeric_limits<R>::epsilon ());
+        R lo, hi;
+        if (j + 1 < k) {
+            const R mid ((dk (j + 1) - dk (j)) / R (2));
+            R f (R (1) / rho);
+            for (std::size_t i = 0; i < k; ++ i)
+                f += zk (i) * zk (i) / ((dk (i) - dk (j)) - mid);
+            if (f >= R/*zero*/()) {
+                origin = j;
+                lo = R/*zero*/();
+                hi = mid;
+            } else {
+                origin = j + 1;
+                lo = - mid;
+                hi = R/*zero*/();
+            }
+        } else {
+            origin = j;
+            R zz = R/*zero*/();
+            for (std::size_t i = 0; i < k; ++ i)
+                zz += zk (i) * zk (i);
+            lo = R/*zero*/();
+            hi = rho * zz;
+        }
+        tau = (lo + hi) / R (2);
+        for (std::size_t iter = 0; iter < 200; ++ iter) {
+            // Terms of the poles left (psi) and right (phi) of the root
+            R psi = R/*zero*/(), dpsi = R/*zero*/(), phi = R/*zero*/(), dphi = R/*zero*/();
+            for (std::size_t i = 0; i < k; ++ i) {
+                const R delta ((dk (i) - dk (origin)) - tau);
+                const R t (zk (i) / delta);
+                if (i <= j) {
+                    psi += zk (i) * t;
+                    dpsi += t * t;
+                } else {
+                    phi += zk (i) * t;
+                    dphi += t * t;
+                }
+            }
+            const R w (R (1) / rho + psi + phi);
+            if (type_traits<R>::type_abs (w) <= R (8) * eps * R (k) * (R (1) / rho + type_traits<R>::type_abs (psi) + type_traits<R>::type_abs (phi)))
+                return;
+            if (w < R/*zero*/())
+                lo = tau;
+            else
+                hi = tau;
+            // Interpolate psi and phi by one pole each and solve the resulting quadratic
+            const R a ((dk (j) - dk (origin)) - tau);
+            R eta;
+            if (j + 1 < k) {
+                const R b ((dk (j + 1) - dk (origin)) - tau);
+                const R c (w - a * dpsi - b * dphi);
+                const R bb (c * (a + b) + a * a * dpsi + b * b * dphi);
+                const R cc (a * b * w);
+                if (c == R/*zero*/()) {
+                    eta = cc / bb;
+                } else {
+                    const R disc (type_traits<R>::type_sqrt ((std::max) (bb * bb - R (4) * c * cc, R/*zero*/())));
+                    const R s (bb >= R/*zero*/() ? bb + disc : bb - disc);
+                    const R r1 (s / (R (2) * c)), r2 (s != R/*zero*/() ? R (2) * cc / s : r1);
+                    eta = (r1 > a && r1 < b) ? r1 : r2;
+                }
+            } else {
+                const R c (w - a * dpsi);
+                eta = c > R/*zero*/() ? a + a * a * dpsi / c : R/*zero*/();
+            }
+            R next (tau + eta);
+            if (! (next > lo && next < hi))
+                next = (lo + hi) / R (2);
+            if (next == tau || hi - lo <= R (2) * eps * (std::max) (type_traits<R>::type_abs (lo), type_traits<R>::type_abs (hi)))
+                return;
+            tau = next;
+        }
+    }
+
+    // Merges the eigensystems of the blocks [lo, mid) and [mid, hi) of the tridiagonal,
+    // coupled by beta, into the eigensystem of [lo, hi) (xLAED1 - xLAED3): deflation,
+    // secular equation, Gu-Eisenstat eigenvectors and one matrix product
+    template<class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void tridiagonal_merge (vector<R> &d, matrix<R, column_major> &q, std::size_t lo, std::size_t mid, std::size_t hi, R beta) {
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        const size_type n (hi - lo), n1 (mid - lo);
+        const R eps (std::numeric_limits<R>::epsilon ());
+        const R sqrt2 (type_traits<R>::type_sqrt (R (2)));
+        R rho (R (2) * type_traits<R>::type_abs (beta));
+        vector<R> z (n);
+        for (size_type j = 0; j < n; ++ j)
+            z (j) = (j < n1 ? q (mid - 1, lo + j) : (beta < R/*zero*/() ? - q (mid, lo + j) : q (mid, lo + j))) / sqrt2;
+
+        // Poles in ascending order
+        std::vector<std::pair<R, size_type> > order (n);
+        for (size_type j = 0; j < n; ++ j)
+            order [j] = std::make_pair (d (lo + j), j);
+        std::stable_sort (order.begin (), order.end ());
+        vector<R> ds (n), zs (n);
+        std::vector<size_type> col (n);
+        R dmax = R/*zero*/(), zmax = R/*zero*/();
+        for (size_type i = 0; i < n; ++ i) {
+            ds (i) = order [i].first;
+            col [i] = lo + order [i].second;
+            zs (i) = z (order [i].second);
+            dmax = (std::max) (dmax, type_traits<R>::type_abs (ds (i)));
+            zmax = (std::max) (zmax, type_traits<R>::type_abs (zs (i)));
+        }
+
+        // Deflation of small components of z and of close poles
+        const R tol (R (8) * eps * (std::max) (dmax, zmax));
+        std::vector<size_type> keep, deflated;
+        const size_type none (n);
+        size_type p = none;
+        for (size_type i = 0; i < n; ++ i) {
+            if (rho * type_traits<R>::type_abs (zs (i)) <= tol) {
+                deflated.push_back (i);
+                continue;
+            }
+            if (p == none) {
+                p = i;
+                continue;
+            }
+            const R tau (eigen_pythag (zs (i), zs (p)));
+            const R c (zs (i) / tau), s (- zs (p) / tau);
+            const R t (ds (i) - ds (p));
+            if (type_traits<R>::type_abs (t * c * s) <= tol) {
+                zs (i) = tau;
+                zs (p) = R/*zero*/();
+                for (size_type r = lo; r < hi; ++ r) {
+                    const R x (q (r, col [p])), y (q (r, col [i]));
+                    q (r, col [p]) = c * x + s * y;
+                    q (r, col [i]) = c * y - s * x;
+                }
+                const R dp (ds (p) * c * c + ds (i) * s * s);
+                ds (i) = ds (p) * s * s + ds (i) * c * c;
+                ds (p) = dp;
+                deflated.push_back (p);
+            } else {
+                keep.push_back (p);
+            }
+            p = i;
+        }
+        if (p != none)
+            keep.push_back (p);
+
+        const size_type k (keep.size ());
+        std::vector<std::pair<R, size_type> > kept (k);
+        for (size_type i = 0; i < k; ++ i)
+            kept [i] = std::make_pair (ds (keep [i]), keep [i]);
+        std::stable_sort (kept.begin (), kept.end ());
+        vector<R> dk (k), zk (k);
+        for (size_type i = 0; i < k; ++ i) {
+            dk (i) = kept [i].first;
+            zk (i) = zs (kept [i].second);
+        }
+
+        // Roots of the secular equation
+        std::vector<size_type> origin (k);
+        vector<R> tau (k);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 8) if (k * k * 8 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type j = 0; j < difference_type (k); ++ j)
+            secular_root (dk, zk, rho, size_type (j), origin [j], tau (j));
+
+        // z with the computed roots as exact eigenvalues (Gu and Eisenstat), and the
+        // eigenvectors of the rank one modification
+        vector<R> zhat (k);
+        for (size_type i = 0; i < k; ++ i) {
+            R prod (((dk (origin [i]) - dk (i)) + tau (i)) / rho);
+            for (size_type j = 0; j < k; ++ j)
+                if (j != i)
+                    prod *= ((dk (origin [j]) - dk (i)) + tau (j)) / (dk (j) - dk (i));
+            const R zi (type_traits<R>::type_sqrt (type_traits<R>::type_abs (prod)));
+            zhat (i) = zk (i) < R/*zero*/() ? - zi : zi;
+        }
+        matrix<R, column_major> u (k, k);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (k * k >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type j = 0; j < difference_type (k); ++ j) {
+            R norm = R/*zero*/();
+            for (size_type i = 0; i < k; ++ i) {
+                u (i, j) = zhat (i) / ((dk (i) - dk (origin [j])) - tau (j));
+                norm += u (i, j) * u (i, j);
+            }
+            norm = type_traits<R>::type_sqrt (norm);
+            for (size_type i = 0; i < k; ++ i)
+                u (i, j) /= norm;
+        }
+
+        // Eigenvectors: Q (:, kept) U, threaded over the columns
+        matrix<R, column_major> qk (n, k), qn (n, k);
+        for (size_type i = 0; i < k; ++ i)
+            for (size_type r = 0; r < n; ++ r)
+                qk (r, i) = q (lo + r, col [kept [i].second]);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (n * k * k >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type j = 0; j < difference_type (k); ++ j) {
+            for (size_type r = 0; r < n; ++ r)
+                qn (r, j) = R/*zero*/();
+            for (size_type i = 0; i < k; ++ i) {
+                const R uij (u (i, j));
+                for (size_type r = 0; r < n; ++ r)
+                    qn (r, j) += qk (r, i) * uij;
+            }
+        }
+
+        // All eigenpairs of the block in ascending order
+        std::vector<std::pair<R, difference_type> > all;
+        all.reserve (n);
+        for (size_type j = 0; j < k; ++ j)
+            all.push_back (std::make_pair (dk (origin [j]) + tau (j), difference_type (j)));
+        for (size_type i = 0; i < deflated.size (); ++ i)
+            all.push_back (std::make_pair (ds (deflated [i]), - difference_type (col [deflated [i]]) - 1));
+        std::stable_sort (all.begin (), all.end ());
+        matrix<R, column_major> qb (n, n);
+        for (size_type j = 0; j < n; ++ j) {
+            const difference_type s (all [j].second);
+            for (size_type r = 0; r < n; ++ r)
+                qb (r, j) = s >= 0 ? qn (r, s) : q (lo + r, - s - 1);
+        }
+        for (size_type j = 0; j < n; ++ j) {
+            d (lo + j) = all [j].first;
+            for (size_type r = 0; r < n; ++ r)
+                q (lo + r, lo + j) = qb (r, j);
+        }
+    }
+
+    // Divide and conquer on the tridiagonal d, e (xSTEDC). The tree of splittings is
+    // built first; the leaves are solved by QL iteration and the merges are done level
+    // by level from the bottom, the blocks of a level in parallel.
+    template<class R>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    std::size_t tridiagonal_divide_conquer (vector<R> &d, const vector<R> &e, matrix<R, column_major> &q) {
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+        const size_type n (d.size ());
+        const size_type leaf_size (25);
+        std::vector<std::pair<size_type, size_type> > leaves;
+        std::vector<std::vector<size_type> > levels;          // lo, mid, hi triples
+        std::vector<std::pair<std::pair<size_type, size_type>, size_type> > stack;
+        stack.push_back (std::make_pair (std::make_pair (size_type (0), n), size_type (0)));
+        while (! stack.empty ()) {
+            const size_type lo (stack.back ().first.first), hi (stack.back ().first.second), depth (stack.back ().second);
+            stack.pop_back ();
+            if (hi - lo <= leaf_size) {
+                leaves.push_back (std::make_pair (lo, hi));
+                continue;
+            }
+            const size_type mid (lo + (hi - lo) / 2);
+            if (levels.size () <= depth)
+                levels.resize (depth + 1);
+            levels [depth].push_back (lo);
+            levels [depth].push_back (mid);
+            levels [depth].push_back (hi);
+            // T = diag (T1 - |beta| e_k e_k^T, T2 - |beta| e_1 e_1^T) + |beta| u u^T
+            const R rho (type_traits<R>::type_abs (e (mid - 1)));
+            d (mid - 1) -= rho;
+            d (mid) -= rho;
+            stack.push_back (std::make_pair (std::make_pair (lo, mid), depth + 1));
+            stack.push_back (std::make_pair (std::make_pair (mid, hi), depth + 1));
+        }
+
+        q.resize (n, n, false);
+        q.clear ();
+        size_type info = 0;
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (n * leaf_size * leaf_size >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type l = 0; l < difference_type (leaves.size ()); ++ l) {
+            const size_type lo (leaves [l].first), hi (leaves [l].second), m (hi - lo);
+            vector<R> dl (m), el (m);
+            matrix<R, column_major> zl (m, m);
+            zl.assign (identity_matrix<R> (m));
+            for (size_type i = 0; i < m; ++ i) {
+                dl (i) = d (lo + i);
+                el (i) = i + 1 < m ? e (lo + i) : R/*zero*/();
+            }
+            const size_type failed (tridiagonal_ql (dl, el, zl, true));
+            if (failed != 0) {
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp critical (boost_ublas_stedc)
+#endif
+                info = lo + failed;
+            }
+            for (size_type i = 0; i < m; ++ i) {
+                d (lo + i) = dl (i);
+                for (size_type r = 0; r < m; ++ r)
+                    q (lo + r, lo + i) = zl (r, i);
+            }
+        }
+        if (info != 0)
+            return info;
+        if (levels.empty ()) {
+            // A single leaf: sort its eigenpairs as a merge would have
+            std::vector<std::pair<R, size_type> > order (n);
+            for (size_type j = 0; j < n; ++ j)
+                order [j] = std::make_pair (d (j), j);
+            std::stable_sort (order.begin (), order.end ());
+            matrix<R, column_major> qs (n, n);
+            for (size_type j = 0; j < n; ++ j) {
+                d (j) = order [j].first;
+                column (qs, j) = column (q, order [j].second);
+            }
+            q.assign_temporary (qs);
+        }
+
+        for (size_type level = levels.size (); level -- > 0; ) {
+            const std::vector<size_type> &merges (levels [level]);
+            const size_type count (merges.size () / 3);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (count > 1 && n * n * n / count >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type c = 0; c < difference_type (count); ++ c) {
+                const size_type lo (merges [3 * c]), mid (merges [3 * c + 1]), hi (merges [3 * c + 2]);
+                tridiagonal_merge (d, q, lo, mid, hi, R (e (mid - 1)));
+            }
+        }
+        return 0;
+    }
+
+    // Number of eigenvalues of the tridiagonal d, e smaller than x (Sturm sequence)
+    template<class V>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename V::size_type sturm_count (const V &d, const V &e, typename V::value_type x, typename V::value_type pivmin) {
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ());
+        size_type count = 0;
+        real_type t = real_type/*zero*/();
+        for (size_type i = 0; i < n; ++ i) {
+            t = d (i) - x - (i > 0 ? e (i - 1) * e (i - 1) / t : real_type/*zero*/());
+            if (type_traits<real_type>::type_abs (t) < pivmin)
+                t = - pivmin;
+            if (t < real_type/*zero*/())
+                ++ count;
+        }
+        return count;
+    }
+
+    // z (1:n, :) := Q z (1:n, :) with the reflectors v of tridiagonal_reduce
+    template<class M, class V, class MZ>
+    BOOST_UBLAS_INLINE
+    void tridiagonal_apply_rows (const M &v, const V &tau, MZ &z, vector_tag) {
+        vector_range<MZ> zr (z, range (1, z.size ()));
+        qr_apply (v, tau, zr, false, vector_tag ());
+    }
+    template<class M, class V, class MZ>
+    BOOST_UBLAS_INLINE
+    void tridiagonal_apply_rows (const M &v, const V &tau, MZ &z, matrix_tag) {
+        matrix_range<MZ> zr (z, range (1, z.size1 ()), range (0, z.size2 ()));
+        qr_apply (v, tau, zr, false, matrix_tag ());
+    }
+
+    // Solves (T - lambda I) x = b in place by Gaussian elimination with partial pivoting
+    template<class V>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void shifted_tridiagonal_solve (const V &d, const V &e, typename V::value_type lambda, typename V::value_type tiny, V &b) {
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ());
+        vector<real_type> u0 (n), u1 (n), u2 (n), l (n);
+        std::vector<bool> swapped (n, false);
+        real_type r0 (d (0) - lambda), r1 (n > 1 ? e (0) : real_type/*zero*/());
+        for (size_type i = 0; i + 1 < n; ++ i) {
+            const real_type sub (e (i)), nd (d (i + 1) - lambda), nc (i + 2 < n ? e (i + 1) : real_type/*zero*/());
+            if (type_traits<real_type>::type_abs (r0) >= type_traits<real_type>::type_abs (sub)) {
+                if (r0 == real_type/*zero*/())
+                    r0 = tiny;
+                l (i) = sub / r0;
+                u0 (i) = r0; u1 (i) = r1; u2 (i) = real_type/*zero*/();
+                r0 = nd - l (i) * r1;
+                r1 = nc;
+            } else {
+                l (i) = r0 / sub;
+                u0 (i) = sub; u1 (i) = nd; u2 (i) = nc;
+                swapped [i] = true;
+                const real_type t (r1 - l (i) * nd);
+                r1 = - l (i) * nc;
+                r0 = t;
+            }
+        }
+        u0 (n - 1) = r0 == real_type/*zero*/() ? tiny : r0;
+        for (size_type i = 0; i + 1 < n; ++ i) {
+            if (swapped [i])
+                std::swap (b (i), b (i + 1));
+            b (i + 1) -= l (i) * b (i);
+        }
+        for (size_type i = n; i -- > 0; ) {
+            real_type s (b (i));
+            if (i + 1 < n)
+                s -= u1 (i) * b (i + 1);
+            if (i + 2 < n)
+                s -= u2 (i) * b (i + 2);
+            b (i) = s / u0 (i);
+        }
+    }
+
+}
+
+    /** \brief Blocked reduction of a real symmetric matrix to tridiagonal form
+     *  T = Q^T A Q (xSYTRD).
+     *
+     *  Panels of \c BOOST_UBLAS_FACTORIZATION_BLOCK columns are reduced with the
+     *  symmetric matrix vector products they need; the rest of the matrix is then
+     *  updated once per panel by a threaded symmetric rank 2k update, which carries
+     *  most of the flops.
+     *
+     *  \param m symmetric matrix, lower triangle referenced; overwritten by the reflectors
+     *  \param d receives the diagonal of T (size n)
+     *  \param e receives the subdiagonal of T (size n - 1)
+     *  \param tau receives the scalar factors of the reflectors (size n - 1)
+     */
+    template<class M, class V>
+    void tridiagonal_reduce (M &m, V &d, V &e, V &tau) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n, bad_size ());
+        BOOST_UBLAS_CHECK (d.size () == n, bad_size ());
+        BOOST_UBLAS_CHECK (e.size () + 1 == (std::max) (n, size_type (1)), bad_size ());
+        BOOST_UBLAS_CHECK (tau.size () == e.size (), bad_size ());
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        matrix<value_type, column_major> w (n, block);
+        size_type k = 0;
+        while (k < n) {
+            const size_type nb ((std::min) (block, n - k));
+            detail::tridiagonal_panel (m, e, tau, k, nb, w);
+            if (k + nb < n)
+                detail::tridiagonal_update (m, k, nb, w);
+            for (size_type j = k; j < k + nb; ++ j) {
+                if (j + 1 < n)
+                    m (j + 1, j) = e (j);
+                d (j) = m (j, j);
+            }
+            k += nb;
+        }
+    }
+
+    /** \brief Computes z := Q z from the reduction of \c tridiagonal_reduce (xORMTR),
+     *  e.g. the eigenvectors of A from those of T. \c z is a vector or a matrix with
+     *  n rows.
+     */
+    template<class M, class V, class MZ>
+    void tridiagonal_apply_q (const M &m, const V &tau, MZ &z) {
+        typedef typename M::size_type size_type;
+        typedef typename MZ::type_category type_category;
+
+        const size_type n (m.size1 ());
+        if (n < 2)
+            return;
+        // Q acts on the rows 1 .. n - 1 with the reflectors of m (1:n, 0:n - 1)
+        const matrix_range<const M> v (m, range (1, n), range (0, n - 1));
+        detail::tridiagonal_apply_rows (v, tau, z, type_category ());
+    }
+
+    /** \brief Eigenvalues of the symmetric tridiagonal matrix with diagonal \c d and
+     *  subdiagonal \c e by implicit QL iteration (xSTERF); \c d receives them in
+     *  ascending order, \c e is destroyed.
+     *
+     *  \return 0, or the index plus one of an eigenvalue that failed to converge
+     */
+    template<class V>
+    typename V::size_type tridiagonal_eigen (V &d, V &e) {
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ());
+        if (n == 0)
+            return 0;
+        vector<real_type> dl (n), el (n);
+        for (size_type i = 0; i < n; ++ i) {
+            dl (i) = d (i);
+            el (i) = i + 1 < n ? e (i) : real_type/*zero*/();
+        }
+        matrix<real_type> none (0, 0);
+        const size_type info (detail::tridiagonal_ql (dl, el, none, false));
+        std::sort (dl.begin (), dl.end ());
+        for (size_type i = 0; i < n; ++ i)
+            d (i) = dl (i);
+        return info;
+    }
+
+    /** \brief Eigenvalues and eigenvectors of the symmetric tridiagonal matrix with
+     *  diagonal \c d and subdiagonal \c e by divide and conquer (xSTEDC).
+     *
+     *  \c d receives the eigenvalues in ascending order and the columns of the n x n
+     *  matrix \c z the eigenvectors. The eigenvectors of the merged blocks are formed
+     *  by matrix products, threaded with \c BOOST_UBLAS_USE_OPENMP, as are the
+     *  independent blocks of each level.
+     *
+     *  \return 0, or the index plus one of an eigenvalue that failed to converge
+     */
+    template<class V, class MZ>
+    typename V::size_type tridiagonal_eigen (V &d, const V &e, MZ &z) {
+        typedef typename V::size_type size_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ());
+        BOOST_UBLAS_CHECK (z.size1 () == n && z.size2 () == n, bad_size ());
+        vector<real_type> dw (n), ew ((std::max) (n, size_type (1)) - 1);
+        std::copy (d.begin (), d.end (), dw.begin ());
+        for (size_type i = 0; i + 1 < n; ++ i)
+            ew (i) = e (i);
+        matrix<real_type, column_major> q;
+        const size_type info (detail::tridiagonal_divide_conquer (dw, ew, q));
+        std::copy (dw.begin (), dw.end (), d.begin ());
+        z.assign (q);
+        return info;
+    }
+
+    /** \brief Eigenvalues with the indices il .. iu - 1 (in ascending order) of the
+     *  symmetric tridiagonal matrix with diagonal \c d and subdiagonal \c e, by
+     *  bisection on Sturm sequences (xSTEBZ); the eigenvalues are independent and
+     *  threaded.
+     */
+    template<class V, class W>
+    void tridiagonal_eigen (const V &d, const V &e, typename V::size_type il, typename V::size_type iu, W &w) {
+        typedef typename V::size_type size_type;
+        typedef typename V::difference_type difference_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ());
+        BOOST_UBLAS_CHECK (il <= iu && iu <= n, bad_argument ());
+        BOOST_UBLAS_CHECK (w.size () == iu - il, bad_size ());
+        const real_type eps (std::numeric_limits<real_type>::epsilon ());
+        real_type emax = real_type/*zero*/();
+        real_type gl = real_type/*zero*/(), gu = real_type/*zero*/();
+        for (size_type i = 0; i < n; ++ i) {
+            const real_type r ((i > 0 ? type_traits<real_type>::type_abs (e (i - 1)) : real_type/*zero*/()) +
+                               (i + 1 < n ? type_traits<real_type>::type_abs (e (i)) : real_type/*zero*/()));
+            gl = i == 0 ? d (i) - r : (std::min) (gl, d (i) - r);
+            gu = i == 0 ? d (i) + r : (std::max) (gu, d (i) + r);
+            if (i + 1 < n)
+                emax = (std::max) (emax, e (i) * e (i));
+        }
+        const real_type pivmin (std::numeric_limits<real_type>::min () * (std::max) (real_type (1), emax));
+        const real_type bnorm ((std::max) (type_traits<real_type>::type_abs (gl), type_traits<real_type>::type_abs (gu)));
+        gl -= real_type (2) * eps * bnorm * real_type (n) + real_type (2) * pivmin;
+        gu += real_type (2) * eps * bnorm * real_type (n) + real_type (2) * pivmin;
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if ((iu - il) * n * 64 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type k = difference_type (il); k < difference_type (iu); ++ k) {
+            real_type lo (gl), hi (gu);
+            for (size_type iter = 0; iter < 256; ++ iter) {
+                const real_type mid ((lo + hi) / real_type (2));
+                if (mid == lo || mid == hi ||
+                    hi - lo <= real_type (2) * eps * (std::max) (type_traits<real_type>::type_abs (lo), type_traits<real_type>::type_abs (hi)) + pivmin)
+                    break;
+                if (detail::sturm_count (d, e, mid, pivmin) <= size_type (k))
+                    lo = mid;
+                else
+                    hi = mid;
+            }
+            w (k - il) = (lo + hi) / real_type (2);
+        }
+    }
+
+    /** \brief Eigenvectors of the symmetric tridiagonal matrix with diagonal \c d and
+     *  subdiagonal \c e for the eigenvalues \c w in ascending order, by inverse
+     *  iteration (xSTEIN). Vectors of close eigenvalues are orthogonalized against each
+     *  other; such clusters are independent and threaded.
+     */
+    template<class V, class W, class MZ>
+    void tridiagonal_eigenvectors (const V &d, const V &e, const W &w, MZ &z) {
+        typedef typename V::size_type size_type;
+        typedef typename V::difference_type difference_type;
+        typedef typename V::value_type real_type;
+
+        const size_type n (d.size ()), k (w.size ());
+        BOOST_UBLAS_CHECK (z.size1 () == n && z.size2 () == k, bad_size ());
+        if (n == 0 || k == 0)
+            return;
+        const real_type eps (std::numeric_limits<real_type>::epsilon ());
+        real_type onenrm = real_type/*zero*/();
+        for (size_type i = 0; i < n; ++ i)
+            onenrm = (std::max) (onenrm, type_traits<real_type>::type_abs (d (i)) +
+                                 (i > 0 ? type_traits<real_type>::type_abs (e (i - 1)) : real_type/*zero*/()) +
+                                 (i + 1 < n ? type_traits<real_type>::type_abs (e (i)) : real_type/*zero*/()));
+        onenrm = (std::max) (onenrm, std::numeric_limits<real_type>::min ());
+        const real_type ortol (real_type (1.0e-3) * onenrm);
+        const real_type eps1 (real_type (10) * eps * onenrm);
+        vector<real_type> dv (n), ev (n);
+        for (size_type i = 0; i < n; ++ i) {
+            dv (i) = d (i);
+            ev (i) = i + 1 < n ? e (i) : real_type/*zero*/();
+        }
+
+        // Clusters of eigenvalues closer than ortol
+        std::vector<size_type> first (1, 0);
+        for (size_type j = 1; j < k; ++ j)
+            if (w (j) - w (j - 1) > ortol)
+                first.push_back (j);
+        first.push_back (k);
+
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (k * n * 8 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type c = 0; c < difference_type (first.size () - 1); ++ c) {
+            matrix<real_type, column_major> zc (n, first [c + 1] - first [c]);
+            real_type xprev = real_type/*zero*/();
+            for (size_type j = first [c]; j < first [c + 1]; ++ j) {
+                const size_type jc (j - first [c]);
+                // Separate coincident eigenvalues
+                real_type x (w (j));
+                if (jc > 0 && x - xprev < eps1)
+                    x = xprev + eps1;
+                xprev = x;
+                vector<real_type> b (n);
+                for (size_type i = 0; i < n; ++ i)
+                    b (i) = real_type (1) + real_type ((i * 7919 + j * 104729) % 1000) / real_type (2000);
+                for (size_type iter = 0; iter < 5; ++ iter) {
+                    const real_type bn (norm_inf (b));
+                    b /= bn;
+                    detail::shifted_tridiagonal_solve (dv, ev, x, eps * onenrm, b);
+                    for (size_type p = 0; p < jc; ++ p)
+                        b -= inner_prod (b, column (zc, p)) * column (zc, p);
+                    // Converged once the growth shows that x is close to an eigenvalue
+                    if (iter > 0 && norm_inf (b) * eps1 * type_traits<real_type>::type_sqrt (real_type (n)) >= real_type (1))
+                        break;
+                }
+                b /= norm_2 (b);
+                column (zc, jc) = b;
+            }
+            for (size_type j = first [c]; j < first [c + 1]; ++ j)
+                for (size_type i = 0; i < n; ++ i)
+                    z (i, j) = zc (i, j - first [c]);
+        }
+    }
+
+    /** \brief Eigenvalues of a real symmetric matrix, in ascending order in \c w.
+     *
+     *  The fast mode: tridiagonal reduction followed by QL iteration without
+     *  eigenvectors. \c m (lower triangle referenced, dense or \c symmetric_matrix) is
+     *  destroyed.
+     *
+     *  \return 0, or the index plus one of an eigenvalue that failed to converge
+     */
+    template<class M, class W>
+    typename M::size_type symmetric_eigen (M &m, W &w) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (w.size () == n, bad_size ());
+        if (n == 0)
+            return 0;
+        vector<value_type> d (n), e (n - 1), tau (n - 1);
+        tridiagonal_reduce (m, d, e, tau);
+        const size_type info (tridiagonal_eigen (d, e));
+        std::copy (d.begin (), d.end (), w.begin ());
+        return info;
+    }
+
+    /** \brief Eigenvalues (ascending, in \c w) and eigenvectors (the columns of the
+     *  n x n matrix \c z) of a real symmetric matrix by tridiagonal reduction and
+     *  divide and conquer (xSYEVD). \c m is destroyed.
+     *
+     *  \return 0, or the index plus one of an eigenvalue that failed to converge
+     */
+    template<class M, class W, class MZ>
+    typename M::size_type symmetric_eigen (M &m, W &w, MZ &z) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (w.size () == n, bad_size ());
+        if (n == 0)
+            return 0;
+        vector<value_type> d (n), e (n - 1), tau (n - 1);
+        tridiagonal_reduce (m, d, e, tau);
+        const size_type info (tridiagonal_eigen (d, e, z));
+        tridiagonal_apply_q (m, tau, z);
+        std::copy (d.begin (), d.end (), w.begin ());
+        return info;
+    }
+
+    /** \brief The eigenvalues with the indices il .. iu - 1 in ascending order of a
+     *  real symmetric matrix, in \c w of size iu - il, by tridiagonal reduction and
+     *  bisection (xSYEVX). \c m is destroyed.
+     */
+    template<class M, class W>
+    void symmetric_eigen (M &m, typename M::size_type il, typename M::size_type iu, W &w) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        if (n == 0)
+            return;
+        vector<value_type> d (n), e (n - 1), tau (n - 1);
+        tridiagonal_reduce (m, d, e, tau);
+        tridiagonal_eigen (d, e, il, iu, w);
+    }
+
+    /** \brief The eigenvalues with the indices il .. iu - 1 in ascending order of a
+     *  real symmetric matrix, in \c w, and their eigenvectors, in the columns of the
+     *  n x (iu - il) matrix \c z, by tridiagonal reduction, bisection and inverse
+     *  iteration (xSYEVX). \c m is destroyed.
+     */
+    template<class M, class W, class MZ>
+    void symmetric_eigen (M &m, typename M::size_type il, typename M::size_type iu, W &w, MZ &z) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        if (n == 0)
+            return;
+        vector<value_type> d (n), e (n - 1), tau (n - 1);
+        tridiagonal_reduce (m, d, e, tau);
+        tridiagonal_eigen (d, e, il, iu, w);
+        tridiagonal_eigenvectors (d, e, w, z);
+        tridiagonal_apply_q (m, tau, z);
+    }
+
+}}}
+
+#endif
@@ -66,6 +66,11 @@ namespace boost { namespace numeric { namespace ublas {
     template<class E>
     class matrix_reference;
 
+    template<class E1, class E2, class F>
+    class matrix_vector_binary1;
+    template<class E1, class E2, class F>
+    class matrix_vector_binary2;
+
     template<class V>
     class vector_range;
     template<class V>
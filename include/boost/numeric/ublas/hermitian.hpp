@@ -16,6 +16,7 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/triangular.hpp>  // for resize_preserve
 #include <boost/numeric/ublas/detail/temporary.hpp>
+#include <boost/numeric/ublas/detail/symmetric_prod.hpp>
 
 // Iterators based on ideas of Jeremy Siek
 // Hermitian matrices are square. Thanks to Peter Schmitteckert for spotting this.
@@ -422,7 +423,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         hermitian_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -434,7 +437,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         hermitian_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -446,7 +451,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         hermitian_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
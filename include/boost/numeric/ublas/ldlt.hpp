@@ -0,0 +1,346 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_LDLT_
+#define _BOOST_UBLAS_LDLT_
+
+#include <boost/numeric/ublas/lu.hpp>
+
+// Symmetric indefinite factorization A = L D L^T with Bunch-Kaufman pivoting, in the
+// spirit of LAPACK (xSYTRF, xLASYF, xSYTRS)
+//
+// Only the lower triangle of A is referenced, through m (i, j) with i >= j, so m may be
+// a dense matrix or a (packed) symmetric_matrix of either storage triangle. D is block
+// diagonal with 1 x 1 and 2 x 2 blocks and overwrites the diagonal and the first
+// subdiagonal of those blocks; the multipliers of L are stored below it.
+//
+// The pivots are recorded in a vector piv of signed integers (e.g. vector<int>), as in
+// LAPACK but counted from 0:
+//  piv (k) >= 0                      1 x 1 block, rows and columns k and piv (k) were
+//                                    interchanged;
+//  piv (k) = piv (k + 1) = - p - 1   2 x 2 block in rows and columns k and k + 1, rows
+//                                    and columns k + 1 and p were interchanged.
+// As in LAPACK, L is the product of the interchanges and of the unit lower triangular
+// transformations of the blocks, in the order of the blocks.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Factors columns k0, k0 + 1, ... of the trailing matrix m (k0:n, k0:n) and updates
+    // the rest of it with the product of the factored columns and w (xLASYF). At most
+    // nb - 1 columns are factored unless nb exceeds the trailing size, which factors
+    // all of them. Returns the number of columns factored.
+    template<class M, class PV, class W>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename M::size_type ldlt_panel (M &m, PV &piv, typename M::size_type k0, typename M::size_type nb,
+                                      W &w, typename M::size_type &singular) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+        typedef typename PV::value_type pivot_type;
+
+        const size_type n (m.size1 ());
+        const real_type alpha ((real_type (1) + type_traits<real_type>::type_sqrt (real_type (17))) / real_type (8));
+        size_type k = k0;
+        while (k < n && ! (k - k0 + 1 >= nb && nb < n - k0)) {
+            const size_type jw (k - k0);
+            // Column k of w is the updated column k of A
+            for (size_type i = k; i < n; ++ i) {
+                value_type s (m (i, k));
+                for (size_type p = k0; p < k; ++ p)
+                    s -= m (i, p) * w (k, p - k0);
+                w (i, jw) = s;
+            }
+            size_type kstep = 1, kp = k;
+            const real_type absakk (type_traits<value_type>::type_abs (w (k, jw)));
+            size_type imax = k;
+            real_type colmax = real_type/*zero*/();
+            for (size_type i = k + 1; i < n; ++ i) {
+                const real_type a (type_traits<value_type>::type_abs (w (i, jw)));
+                if (a > colmax) {
+                    colmax = a;
+                    imax = i;
+                }
+            }
+            if ((std::max) (absakk, colmax) == real_type/*zero*/()) {
+                if (singular == 0)
+                    singular = k + 1;
+            } else if (absakk < alpha * colmax) {
+                // Column k + 1 of w is the updated column imax of A
+                for (size_type i = k; i < n; ++ i) {
+                    value_type s (i < imax ? m (imax, i) : m (i, imax));
+                    for (size_type p = k0; p < k; ++ p)
+                        s -= m (i, p) * w (imax, p - k0);
+                    w (i, jw + 1) = s;
+                }
+                real_type rowmax = real_type/*zero*/();
+                for (size_type i = k; i < n; ++ i)
+                    if (i != imax)
+                        rowmax = (std::max) (rowmax, real_type (type_traits<value_type>::type_abs (w (i, jw + 1))));
+                if (absakk >= alpha * colmax * (colmax / rowmax)) {
+                    // No interchange, 1 x 1 block
+                } else if (type_traits<value_type>::type_abs (w (imax, jw + 1)) >= alpha * rowmax) {
+                    // Interchange k and imax, 1 x 1 block
+                    kp = imax;
+                    for (size_type i = k; i < n; ++ i)
+                        w (i, jw) = w (i, jw + 1);
+                } else {
+                    // Interchange k + 1 and imax, 2 x 2 block
+                    kp = imax;
+                    kstep = 2;
+                }
+            }
+
+            const size_type kk (k + kstep - 1);
+            if (kp != kk) {
+                // The updated column kp is in column kk of w; the rest of the interchange
+                // moves the unfactored elements and the factored rows of the panel
+                m (kp, kp) = m (kk, kk);
+                for (size_type i = kk + 1; i < kp; ++ i)
+                    m (kp, i) = m (i, kk);
+                for (size_type i = kp + 1; i < n; ++ i)
+                    m (i, kp) = m (i, kk);
+                for (size_type p = k0; p < k; ++ p)
+                    std::swap (m (kk, p), m (kp, p));
+                for (size_type p = k0; p <= kk; ++ p)
+                    std::swap (w (kk, p - k0), w (kp, p - k0));
+            }
+
+            if (kstep == 1) {
+                // Column k of w is L (k) D (k)
+                for (size_type i = k; i < n; ++ i)
+                    m (i, k) = w (i, jw);
+                if (m (k, k) != value_type/*zero*/()) {
+                    const value_type r1 (value_type (1) / m (k, k));
+                    for (size_type i = k + 1; i < n; ++ i)
+                        m (i, k) *= r1;
+                }
+                piv (k) = pivot_type (kp);
+            } else {
+                // Columns k and k + 1 of w are (L (k) L (k + 1)) D (k)
+                if (k + 2 < n) {
+                    value_type d21 (w (k + 1, jw));
+                    const value_type d11 (w (k + 1, jw + 1) / d21);
+                    const value_type d22 (w (k, jw) / d21);
+                    const value_type t (value_type (1) / (d11 * d22 - value_type (1)));
+                    d21 = t / d21;
+                    for (size_type j = k + 2; j < n; ++ j) {
+                        m (j, k) = d21 * (d11 * w (j, jw) - w (j, jw + 1));
+                        m (j, k + 1) = d21 * (d22 * w (j, jw + 1) - w (j, jw));
+                    }
+                }
+                m (k, k) = w (k, jw);
+                m (k + 1, k) = w (k + 1, jw);
+                m (k + 1, k + 1) = w (k + 1, jw + 1);
+                piv (k) = piv (k + 1) = - pivot_type (kp) - 1;
+            }
+            k += kstep;
+        }
+
+        // Trailing matrix update A22 -= L21 W21^T, lower triangle only
+        if (k < n && k > k0) {
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if ((n - k) * (n - k) * (k - k0) / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type j = difference_type (k); j < difference_type (n); ++ j) {
+                for (size_type p = k0; p < k; ++ p) {
+                    const value_type t (w (j, p - k0));
+                    if (t != value_type/*zero*/())
+                        for (size_type i = j; i < n; ++ i)
+                            m (i, j) -= m (i, p) * t;
+                }
+            }
+        }
+
+        // Undo the interchanges of the factored rows of the panel that belong to later
+        // blocks, which leaves L in the same form as the unblocked factorization
+        size_type j (k - k0);
+        while (j >= 1) {
+            const size_type jj (k0 + j - 1);
+            size_type jp;
+            if (piv (jj) < 0) {
+                jp = size_type (- piv (jj) - 1);
+                -- j;
+            } else {
+                jp = size_type (piv (jj));
+            }
+            -- j;
+            if (jp != jj && j >= 1)
+                for (size_type p = k0; p < k0 + j; ++ p)
+                    std::swap (m (jp, p), m (jj, p));
+        }
+        return k - k0;
+    }
+
+    // Solves L D L^T x = mv in place
+    template<class M, class PV, class MV, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void ldlt_substitute (const M &m, const PV &piv, MV &mv, TAG) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type n (m.size1 ());
+        const size_type cols (rhs_columns (mv, TAG ()));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (n * n * cols >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type q = 0; q < difference_type (cols); ++ q) {
+            // L D y = b
+            size_type k = 0;
+            while (k < n) {
+                if (piv (k) >= 0) {
+                    const size_type kp (piv (k));
+                    if (kp != k)
+                        std::swap (rhs_element (mv, k, q, TAG ()), rhs_element (mv, kp, q, TAG ()));
+                    const value_type bk (rhs_element (mv, k, q, TAG ()));
+                    for (size_type i = k + 1; i < n; ++ i)
+                        rhs_element (mv, i, q, TAG ()) -= m (i, k) * bk;
+                    rhs_element (mv, k, q, TAG ()) /= m (k, k);
+                    k += 1;
+                } else {
+                    const size_type kp (- piv (k) - 1);
+                    if (kp != k + 1)
+                        std::swap (rhs_element (mv, k + 1, q, TAG ()), rhs_element (mv, kp, q, TAG ()));
+                    const value_type b1 (rhs_element (mv, k, q, TAG ()));
+                    const value_type b2 (rhs_element (mv, k + 1, q, TAG ()));
+                    for (size_type i = k + 2; i < n; ++ i)
+                        rhs_element (mv, i, q, TAG ()) -= m (i, k) * b1 + m (i, k + 1) * b2;
+                    const value_type d21 (m (k + 1, k));
+                    const value_type d11 (m (k, k) / d21);
+                    const value_type d22 (m (k + 1, k + 1) / d21);
+                    const value_type denom (d11 * d22 - value_type (1));
+                    rhs_element (mv, k, q, TAG ()) = (d22 * (b1 / d21) - b2 / d21) / denom;
+                    rhs_element (mv, k + 1, q, TAG ()) = (d11 * (b2 / d21) - b1 / d21) / denom;
+                    k += 2;
+                }
+            }
+            // L^T x = y
+            k = n;
+            while (k > 0) {
+                const size_type kl (k - 1);
+                value_type s = value_type/*zero*/();
+                for (size_type i = k; i < n; ++ i)
+                    s += m (i, kl) * rhs_element (mv, i, q, TAG ());
+                rhs_element (mv, kl, q, TAG ()) -= s;
+                if (piv (kl) >= 0) {
+                    const size_type kp (piv (kl));
+                    if (kp != kl)
+                        std::swap (rhs_element (mv, kl, q, TAG ()), rhs_element (mv, kp, q, TAG ()));
+                    k -= 1;
+                } else {
+                    value_type t = value_type/*zero*/();
+                    for (size_type i = k; i < n; ++ i)
+                        t += m (i, kl - 1) * rhs_element (mv, i, q, TAG ());
+                    rhs_element (mv, kl - 1, q, TAG ()) -= t;
+                    const size_type kp (- piv (kl) - 1);
+                    if (kp != kl)
+                        std::swap (rhs_element (mv, kl, q, TAG ()), rhs_element (mv, kp, q, TAG ()));
+                    k -= 2;
+                }
+            }
+        }
+    }
+
+}
+
+    /** \brief Blocked symmetric indefinite factorization P A P^T = L D L^T with
+     *  Bunch-Kaufman pivoting (xSYTRF).
+     *
+     *  Works in place on the lower triangle of a dense matrix or of a (packed)
+     *  \c symmetric_matrix, so A is neither copied nor expanded. Panels of
+     *  \c BOOST_UBLAS_FACTORIZATION_BLOCK columns are factored left looking; the
+     *  rest of the matrix is then updated once per panel by a threaded matrix product.
+     *  Complex matrices are treated as complex symmetric, not Hermitian.
+     *
+     *  \param m symmetric matrix, overwritten by D and L
+     *  \param piv signed integer vector of size \c m.size1 () receiving the pivots
+     *  \return 0 if D is nonsingular, otherwise the index plus one of the first
+     *  zero 1 x 1 block of D
+     */
+    template<class M, class PV>
+    typename M::size_type ldlt_factorize (M &m, PV &piv) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n, bad_size ());
+        BOOST_UBLAS_CHECK (piv.size () == n, bad_size ());
+        const size_type nb ((std::max) (size_type (BOOST_UBLAS_FACTORIZATION_BLOCK), size_type (2)));
+        matrix<value_type, column_major> w (n, nb + 1);
+        size_type singular = 0;
+        size_type k = 0;
+        while (k < n) {
+            // The last panel factors all remaining columns
+            const size_type kb (n - k > nb ? nb : n - k + 1);
+            k += detail::ldlt_panel (m, piv, k, kb, w, singular);
+        }
+        return singular;
+    }
+
+    /** \brief Solves A x = b in place from the factorization of \c ldlt_factorize
+     *  (xSYTRS); \c mv is a vector or a matrix of right hand sides.
+     */
+    template<class M, class PV, class MV>
+    void ldlt_substitute (const M &m, const PV &piv, MV &mv) {
+        BOOST_UBLAS_CHECK (piv.size () == m.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (detail::rhs_rows (mv, typename MV::type_category ()) == m.size1 (), bad_size ());
+        detail::ldlt_substitute (m, piv, mv, typename MV::type_category ());
+    }
+
+    /** \brief Inertia of a real symmetric matrix from its factorization: the numbers
+     *  of positive, negative and zero eigenvalues, which are those of D (Sylvester).
+     */
+    template<class M, class PV>
+    void ldlt_inertia (const M &m, const PV &piv, typename M::size_type &positive,
+                       typename M::size_type &negative, typename M::size_type &zero) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        positive = negative = zero = 0;
+        size_type k = 0;
+        while (k < n) {
+            if (piv (k) >= 0) {
+                const value_type d (m (k, k));
+                if (d > value_type/*zero*/())
+                    ++ positive;
+                else if (d < value_type/*zero*/())
+                    ++ negative;
+                else
+                    ++ zero;
+                k += 1;
+            } else {
+                // A 2 x 2 block with a negative determinant has one eigenvalue of each sign
+                const value_type a (m (k, k)), b (m (k + 1, k)), c (m (k + 1, k + 1));
+                const value_type det (a * c - b * b);
+                if (det < value_type/*zero*/()) {
+                    ++ positive;
+                    ++ negative;
+                } else if (det > value_type/*zero*/()) {
+                    if (a + c > value_type/*zero*/())
+                        positive += 2;
+                    else
+                        negative += 2;
+                } else {
+                    ++ zero;
+                    if (a + c > value_type/*zero*/())
+                        ++ positive;
+                    else if (a + c < value_type/*zero*/())
+                        ++ negative;
+                    else
+                        ++ zero;
+                }
+                k += 2;
+            }
+        }
+    }
+
+}}}
+
+#endif
@@ -18,6 +18,10 @@
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/triangular.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 // LU factorizations in the spirit of LAPACK and Golub & van Loan
 
@@ -59,28 +63,119 @@ namespace boost { namespace numeric { namespace ublas {
         }
     };
 
-    template<class PM, class MV>
-    BOOST_UBLAS_INLINE
-    void swap_rows (const PM &pm, MV &mv, vector_tag) {
-        typedef typename PM::size_type size_type;
+namespace detail {
 
-        size_type size = pm.size ();
-        for (size_type i = 0; i < size; ++ i) {
+    // The pivot swaps of a permutation_matrix in the manner of LAPACK xLASWP: the
+    // rows i and pm (i) are exchanged for i = 0, 1, ..., or in the reverse order for
+    // the inverse permutation. Dense matrices are processed in blocks of columns,
+    // each block passing through all the swaps while it is in cache, and the
+    // blocks are independent of each other; other storage swaps whole rows.
+    template<class PM, class M>
+    void swap_rows_block (const PM &pm, M &m, typename M::size_type j0, typename M::size_type j1, bool inverse) {
+        typedef typename M::size_type size_type;
+
+        const size_type size (pm.size ());
+        for (size_type k = 0; k < size; ++ k) {
+            const size_type i (inverse ? size - 1 - k : k);
+            const size_type p (pm (i));
+            if (i != p)
+                for (size_type j = j0; j < j1; ++ j)
+                    std::swap (m (i, j), m (p, j));
+        }
+    }
+    template<class PM, class M>
+    void swap_rows (const PM &pm, M &m, bool inverse, dense_proxy_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+
+        const size_type size2 (m.size2 ());
+        const size_type nb (BOOST_UBLAS_PERMUTATION_BLOCK);
+        const size_type blocks ((size2 + nb - 1) / nb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (pm.size () * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type b = 0; b < difference_type (blocks); ++ b)
+            swap_rows_block (pm, m, b * nb, (std::min) (size2, (b + 1) * nb), inverse);
+    }
+    template<class PM, class M>
+    void swap_rows (const PM &pm, M &m, bool inverse, unknown_storage_tag) {
+        typedef typename M::size_type size_type;
+
+        const size_type size (pm.size ());
+        for (size_type k = 0; k < size; ++ k) {
+            const size_type i (inverse ? size - 1 - k : k);
             if (i != pm (i))
-                std::swap (mv (i), mv (pm (i)));
+                row (m, i).swap (row (m, pm (i)));
         }
     }
-    template<class PM, class MV>
-    BOOST_UBLAS_INLINE
-    void swap_rows (const PM &pm, MV &mv, matrix_tag) {
+    template<class PM, class V>
+    void swap_rows (const PM &pm, V &v, bool inverse, vector_tag) {
         typedef typename PM::size_type size_type;
 
-        size_type size = pm.size ();
-        for (size_type i = 0; i < size; ++ i) {
+        const size_type size (pm.size ());
+        for (size_type k = 0; k < size; ++ k) {
+            const size_type i (inverse ? size - 1 - k : k);
             if (i != pm (i))
-                row (mv, i).swap (row (mv, pm (i)));
+                std::swap (v (i), v (pm (i)));
         }
     }
+    template<class PM, class M>
+    void swap_rows (const PM &pm, M &m, bool inverse, matrix_tag) {
+        swap_rows (pm, m, inverse, typename M::storage_category ());
+    }
+
+    // The same for the columns i and pm (i), in blocks of rows
+    template<class PM, class M>
+    void swap_columns_block (const PM &pm, M &m, typename M::size_type i0, typename M::size_type i1, bool inverse) {
+        typedef typename M::size_type size_type;
+
+        const size_type size (pm.size ());
+        for (size_type k = 0; k < size; ++ k) {
+            const size_type j (inverse ? size - 1 - k : k);
+            const size_type p (pm (j));
+            if (j != p)
+                for (size_type i = i0; i < i1; ++ i)
+                    std::swap (m (i, j), m (i, p));
+        }
+    }
+    template<class PM, class M>
+    void swap_columns (const PM &pm, M &m, bool inverse, dense_proxy_tag) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+
+        const size_type size1 (m.size1 ());
+        const size_type nb (BOOST_UBLAS_PERMUTATION_BLOCK);
+        const size_type blocks ((size1 + nb - 1) / nb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (pm.size () * size1 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type b = 0; b < difference_type (blocks); ++ b)
+            swap_columns_block (pm, m, b * nb, (std::min) (size1, (b + 1) * nb), inverse);
+    }
+    template<class PM, class M>
+    void swap_columns (const PM &pm, M &m, bool inverse, unknown_storage_tag) {
+        typedef typename M::size_type size_type;
+
+        const size_type size (pm.size ());
+        for (size_type k = 0; k < size; ++ k) {
+            const size_type j (inverse ? size - 1 - k : k);
+            if (j != pm (j))
+                column (m, j).swap (column (m, pm (j)));
+        }
+    }
+
+}
+
+    template<class PM, class MV>
+    BOOST_UBLAS_INLINE
+    void swap_rows (const PM &pm, MV &mv, vector_tag) {
+        detail::swap_rows (pm, mv, false, vector_tag ());
+    }
+    template<class PM, class MV>
+    BOOST_UBLAS_INLINE
+    void swap_rows (const PM &pm, MV &mv, matrix_tag) {
+        detail::swap_rows (pm, mv, false, matrix_tag ());
+    }
     // Dispatcher
     template<class PM, class MV>
     BOOST_UBLAS_INLINE
@@ -88,9 +183,324 @@ namespace boost { namespace numeric { namespace ublas {
         swap_rows (pm, mv, typename MV::type_category ());
     }
 
+    /** \brief Undoes \c swap_rows: the same swaps of rows in the reverse order, which
+     *  applies the inverse (the transpose) of the permutation.
+     */
+    template<class PM, class MV>
+    BOOST_UBLAS_INLINE
+    void swap_rows_inverse (const PM &pm, MV &mv) {
+        detail::swap_rows (pm, mv, true, typename MV::type_category ());
+    }
+
+    /** \brief Exchanges the columns i and pm (i) of a matrix for i = 0, 1, ..., the
+     *  pivot sequence applied from the right.
+     */
+    template<class PM, class M>
+    BOOST_UBLAS_INLINE
+    void swap_columns (const PM &pm, M &m) {
+        BOOST_UBLAS_CHECK (pm.size () <= m.size2 (), bad_size ());
+        detail::swap_columns (pm, m, false, typename M::storage_category ());
+    }
+    /** \brief Undoes \c swap_columns.
+     */
+    template<class PM, class M>
+    BOOST_UBLAS_INLINE
+    void swap_columns_inverse (const PM &pm, M &m) {
+        BOOST_UBLAS_CHECK (pm.size () <= m.size2 (), bad_size ());
+        detail::swap_columns (pm, m, true, typename M::storage_category ());
+    }
+
+namespace detail {
+
+    // Right hand sides are vectors or matrices, a vector being a single column
+    template<class MV>
+    BOOST_UBLAS_INLINE
+    typename MV::size_type rhs_rows (const MV &mv, vector_tag) {
+        return mv.size ();
+    }
+    template<class MV>
+    BOOST_UBLAS_INLINE
+    typename MV::size_type rhs_rows (const MV &mv, matrix_tag) {
+        return mv.size1 ();
+    }
+    template<class MV>
+    BOOST_UBLAS_INLINE
+    typename MV::size_type rhs_columns (const MV &/*mv*/, vector_tag) {
+        return 1;
+    }
+    template<class MV>
+    BOOST_UBLAS_INLINE
+    typename MV::size_type rhs_columns (const MV &mv, matrix_tag) {
+        return mv.size2 ();
+    }
+    template<class MV>
+    BOOST_UBLAS_INLINE
+    typename MV::reference rhs_element (MV &mv, typename MV::size_type i, typename MV::size_type /*j*/, vector_tag) {
+        return mv (i);
+    }
+    template<class MV>
+    BOOST_UBLAS_INLINE
+    typename MV::reference rhs_element (MV &mv, typename MV::size_type i, typename MV::size_type j, matrix_tag) {
+        return mv (i, j);
+    }
+
+}
+
+namespace detail {
+
+    // The cycles of a permutation vector, stored one after another, the cycle k in
+    // cycles [starts [k], starts [k + 1]), each element followed by its image under
+    // perm; fixed points are left out.
+    template<class PV, class S>
+    void permutation_cycles (const PV &perm, std::vector<S> &cycles, std::vector<S> &starts) {
+        const S size (perm.size ());
+        std::vector<bool> visited (size, false);
+        cycles.clear ();
+        starts.clear ();
+        for (S i = 0; i < size; ++ i) {
+            if (visited [i] || S (perm (i)) == i)
+                continue;
+            starts.push_back (S (cycles.size ()));
+            S j (i);
+            do {
+                visited [j] = true;
+                cycles.push_back (j);
+                j = perm (j);
+                BOOST_UBLAS_CHECK (j < size, bad_index ());
+            } while (j != i && ! visited [j]);
+            // a repeated index is not a permutation
+            BOOST_UBLAS_CHECK (j == i, bad_argument ());
+        }
+        starts.push_back (S (cycles.size ()));
+    }
+
+    // Row c [t] of the result is row c [t + 1] along each cycle (row perm (i) moves to
+    // row i), or row c [t] moves to row c [t + 1] for the inverse; columns [j0, j1)
+    template<class MV, class S>
+    void permute_rows_block (MV &mv, const std::vector<S> &cycles, const std::vector<S> &starts,
+                             S j0, S j1, bool inverse, typename MV::type_category) {
+        typedef typename MV::value_type value_type;
+        typedef typename MV::type_category type_category;
+
+        std::vector<value_type> first (j1 - j0);
+        for (S k = 0; k + 1 < S (starts.size ()); ++ k) {
+            const S a (starts [k]), e (starts [k + 1]);
+            const S head (inverse ? cycles [e - 1] : cycles [a]);
+            for (S j = j0; j < j1; ++ j)
+                first [j - j0] = rhs_element (mv, head, j, type_category ());
+            if (inverse) {
+                for (S t = e - 1; t > a; -- t)
+                    for (S j = j0; j < j1; ++ j)
+                        rhs_element (mv, cycles [t], j, type_category ()) = rhs_element (mv, cycles [t - 1], j, type_category ());
+            } else {
+                for (S t = a; t + 1 < e; ++ t)
+                    for (S j = j0; j < j1; ++ j)
+                        rhs_element (mv, cycles [t], j, type_category ()) = rhs_element (mv, cycles [t + 1], j, type_category ());
+            }
+            const S tail (inverse ? cycles [a] : cycles [e - 1]);
+            for (S j = j0; j < j1; ++ j)
+                rhs_element (mv, tail, j, type_category ()) = first [j - j0];
+        }
+    }
+    template<class M, class S>
+    void permute_rows (M &m, const std::vector<S> &cycles, const std::vector<S> &starts, bool inverse, dense_proxy_tag) {
+        typedef typename M::difference_type difference_type;
+
+        const S size2 (m.size2 ());
+        const S nb (BOOST_UBLAS_PERMUTATION_BLOCK);
+        const S blocks ((size2 + nb - 1) / nb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (cycles.size () * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type b = 0; b < difference_type (blocks); ++ b)
+            permute_rows_block (m, cycles, starts, S (b * nb), (std::min) (size2, S ((b + 1) * nb)), inverse, matrix_tag ());
+    }
+    template<class M, class S>
+    void permute_rows (M &m, const std::vector<S> &cycles, const std::vector<S> &starts, bool inverse, unknown_storage_tag) {
+        // swaps of whole rows along each cycle
+        for (S k = 0; k + 1 < S (starts.size ()); ++ k) {
+            const S a (starts [k]), e (starts [k + 1]);
+            if (inverse) {
+                for (S t = e - 1; t > a; -- t)
+                    row (m, cycles [t]).swap (row (m, cycles [t - 1]));
+            } else {
+                for (S t = a; t + 1 < e; ++ t)
+                    row (m, cycles [t]).swap (row (m, cycles [t + 1]));
+            }
+        }
+    }
+    template<class V, class S>
+    void permute_rows (V &v, const std::vector<S> &cycles, const std::vector<S> &starts, bool inverse, vector_tag) {
+        permute_rows_block (v, cycles, starts, S (0), S (1), inverse, vector_tag ());
+    }
+    template<class M, class S>
+    void permute_rows (M &m, const std::vector<S> &cycles, const std::vector<S> &starts, bool inverse, matrix_tag) {
+        permute_rows (m, cycles, starts, inverse, typename M::storage_category ());
+    }
+
+    // The same for the columns, rows [i0, i1)
+    template<class M, class S>
+    void permute_columns_block (M &m, const std::vector<S> &cycles, const std::vector<S> &starts,
+                                S i0, S i1, bool inverse) {
+        typedef typename M::value_type value_type;
+
+        std::vector<value_type> first (i1 - i0);
+        for (S k = 0; k + 1 < S (starts.size ()); ++ k) {
+            const S a (starts [k]), e (starts [k + 1]);
+            const S head (inverse ? cycles [e - 1] : cycles [a]);
+            for (S i = i0; i < i1; ++ i)
+                first [i - i0] = m (i, head);
+            if (inverse) {
+                for (S t = e - 1; t > a; -- t)
+                    for (S i = i0; i < i1; ++ i)
+                        m (i, cycles [t]) = m (i, cycles [t - 1]);
+            } else {
+                for (S t = a; t + 1 < e; ++ t)
+                    for (S i = i0; i < i1; ++ i)
+                        m (i, cycles [t]) = m (i, cycles [t + 1]);
+            }
+            const S tail (inverse ? cycles [a] : cycles [e - 1]);
+            for (S i = i0; i < i1; ++ i)
+                m (i, tail) = first [i - i0];
+        }
+    }
+    template<class M, class S>
+    void permute_columns (M &m, const std::vector<S> &cycles, const std::vector<S> &starts, bool inverse, dense_proxy_tag) {
+        typedef typename M::difference_type difference_type;
+
+        const S size1 (m.size1 ());
+        const S nb (BOOST_UBLAS_PERMUTATION_BLOCK);
+        const S blocks ((size1 + nb - 1) / nb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (cycles.size () * size1 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type b = 0; b < difference_type (blocks); ++ b)
+            permute_columns_block (m, cycles, starts, S (b * nb), (std::min) (size1, S ((b + 1) * nb)), inverse);
+    }
+    template<class M, class S>
+    void permute_columns (M &m, const std::vector<S> &cycles, const std::vector<S> &starts, bool inverse, unknown_storage_tag) {
+        // swaps of whole columns along each cycle
+        for (S k = 0; k + 1 < S (starts.size ()); ++ k) {
+            const S a (starts [k]), e (starts [k + 1]);
+            if (inverse) {
+                for (S t = e - 1; t > a; -- t)
+                    column (m, cycles [t]).swap (column (m, cycles [t - 1]));
+            } else {
+                for (S t = a; t + 1 < e; ++ t)
+                    column (m, cycles [t]).swap (column (m, cycles [t + 1]));
+            }
+        }
+    }
+
+}
+
+    /** \brief Converts the pivot sequence of a permutation_matrix, as used by
+     *  \c swap_rows, to a permutation vector: \c perm (i) is the row that \c swap_rows
+     *  moves to row i.
+     */
+    template<class PM, class PV>
+    BOOST_UBLAS_INLINE
+    void pivots_to_permutation (const PM &pm, PV &perm) {
+        typedef typename PV::size_type size_type;
+
+        BOOST_UBLAS_CHECK (perm.size () >= pm.size (), bad_size ());
+        for (size_type i = 0; i < perm.size (); ++ i)
+            perm (i) = i;
+        detail::swap_rows (pm, perm, false, vector_tag ());
+    }
+
+    /** \brief Converts a permutation vector to the pivot sequence with the same
+     *  effect, in O(n).
+     */
+    template<class PV, class PM>
+    void permutation_to_pivots (const PV &perm, PM &pm) {
+        typedef typename PM::size_type size_type;
+
+        const size_type size (perm.size ());
+        BOOST_UBLAS_CHECK (pm.size () == size, bad_size ());
+        // the original row at each position, and the position of each original row
+        std::vector<size_type> current (size), position (size);
+        for (size_type i = 0; i < size; ++ i)
+            current [i] = position [i] = i;
+        for (size_type i = 0; i < size; ++ i) {
+            BOOST_UBLAS_CHECK (size_type (perm (i)) < size, bad_index ());
+            const size_type p (position [perm (i)]);
+            BOOST_UBLAS_CHECK (p >= i, bad_argument ());
+            pm (i) = p;
+            position [current [i]] = p;
+            position [current [p]] = i;
+            std::swap (current [i], current [p]);
+        }
+    }
+
+    /** \brief Permutes the rows of a vector or matrix in place by the cycles of the
+     *  permutation vector \c perm: row \c perm (i) becomes row i.
+     */
+    template<class PV, class MV>
+    void permute_rows (const PV &perm, MV &mv) {
+        typedef typename MV::size_type size_type;
+        typedef typename MV::type_category type_category;
+
+        BOOST_UBLAS_CHECK (perm.size () == detail::rhs_rows (mv, type_category ()), bad_size ());
+        std::vector<size_type> cycles, starts;
+        detail::permutation_cycles (perm, cycles, starts);
+        detail::permute_rows (mv, cycles, starts, false, type_category ());
+    }
+    /** \brief Undoes \c permute_rows: row i becomes row \c perm (i).
+     */
+    template<class PV, class MV>
+    void permute_rows_inverse (const PV &perm, MV &mv) {
+        typedef typename MV::size_type size_type;
+        typedef typename MV::type_category type_category;
+
+        BOOST_UBLAS_CHECK (perm.size () == detail::rhs_rows (mv, type_category ()), bad_size ());
+        std::vector<size_type> cycles, starts;
+        detail::permutation_cycles (perm, cycles, starts);
+        detail::permute_rows (mv, cycles, starts, true, type_category ());
+    }
+
+    /** \brief Permutes the columns of a matrix in place: column \c perm (j) becomes
+     *  column j.
+     */
+    template<class PV, class M>
+    void permute_columns (const PV &perm, M &m) {
+        typedef typename M::size_type size_type;
+
+        BOOST_UBLAS_CHECK (perm.size () == m.size2 (), bad_size ());
+        std::vector<size_type> cycles, starts;
+        detail::permutation_cycles (perm, cycles, starts);
+        detail::permute_columns (m, cycles, starts, false, typename M::storage_category ());
+    }
+    /** \brief Undoes \c permute_columns: column j becomes column \c perm (j).
+     */
+    template<class PV, class M>
+    void permute_columns_inverse (const PV &perm, M &m) {
+        typedef typename M::size_type size_type;
+
+        BOOST_UBLAS_CHECK (perm.size () == m.size2 (), bad_size ());
+        std::vector<size_type> cycles, starts;
+        detail::permutation_cycles (perm, cycles, starts);
+        detail::permute_columns (m, cycles, starts, true, typename M::storage_category ());
+    }
+
+namespace detail {
+
+    // Floating point operations of the LU factorization of a size1 x size2 matrix,
+    // to leading order
+    template<class S>
+    S lu_flops (S size1, S size2) {
+        const S a ((std::max) (size1, size2)), b ((std::min) (size1, size2));
+        return b * b * a - b * b * b / 3;
+    }
+
+}
+
     // LU factorization without pivoting
     template<class M>
     typename M::size_type lu_factorize (M &m) {
+        BOOST_UBLAS_PROFILE_SCOPE (lu_factorize_kernel, m.size1 () * m.size2 (),
+                                   detail::lu_flops (m.size1 (), m.size2 ()),
+                                   2 * m.size1 () * m.size2 () * sizeof (typename M::value_type));
 
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
@@ -128,6 +538,9 @@ namespace boost { namespace numeric { namespace ublas {
     // LU factorization with partial pivoting
     template<class M, class PM>
     typename M::size_type lu_factorize (M &m, PM &pm) {
+        BOOST_UBLAS_PROFILE_SCOPE (lu_factorize_kernel, m.size1 () * m.size2 (),
+                                   detail::lu_flops (m.size1 (), m.size2 ()),
+                                   2 * m.size1 () * m.size2 () * sizeof (typename M::value_type));
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
 
@@ -171,6 +584,9 @@ namespace boost { namespace numeric { namespace ublas {
 
     template<class M, class PM>
     typename M::size_type axpy_lu_factorize (M &m, PM &pm) {
+        BOOST_UBLAS_PROFILE_SCOPE (lu_factorize_kernel, m.size1 () * m.size2 (),
+                                   detail::lu_flops (m.size1 (), m.size2 ()),
+                                   2 * m.size1 () * m.size2 () * sizeof (typename M::value_type));
         typedef M matrix_type;
         typedef typename M::size_type size_type;
         typedef typename M::value_type value_type;
@@ -188,8 +604,12 @@ namespace boost { namespace numeric { namespace ublas {
         mr.assign (zero_matrix<value_type> (size1, size2));
         vector_type v (size1);
         for (size_type i = 0; i < size; ++ i) {
+            // the row and column proxies are named, since project and swap need lvalues
+            matrix_column<matrix_type> mci (column (mr, i));
+            matrix_row<matrix_type> mri (row (m, i));
+            matrix_row<matrix_type> mrri (row (mr, i));
             matrix_range<matrix_type> lrr (project (mr, range (0, i), range (0, i)));
-            vector_range<matrix_column<matrix_type> > urr (project (column (mr, i), range (0, i)));
+            vector_range<matrix_column<matrix_type> > urr (project (mci, range (0, i)));
             urr.assign (solve (lrr, project (column (m, i), range (0, i)), unit_lower_tag ()));
             project (v, range (i, size1)).assign (
                 project (column (m, i), range (i, size1)) -
@@ -200,14 +620,18 @@ namespace boost { namespace numeric { namespace ublas {
                 if (i_norm_inf != i) {
                     pm (i) = i_norm_inf;
                     std::swap (v (i_norm_inf), v (i));
-                    project (row (m, i_norm_inf), range (i + 1, size2)).swap (project (row (m, i), range (i + 1, size2)));
+                    matrix_row<matrix_type> mrn (row (m, i_norm_inf));
+                    vector_range<matrix_row<matrix_type> > mrir (mri, range (i + 1, size2));
+                    project (mrn, range (i + 1, size2)).swap (mrir);
                 } else {
                     BOOST_UBLAS_CHECK (pm (i) == i_norm_inf, external_logic ());
                 }
-                project (column (mr, i), range (i + 1, size1)).assign (
+                project (mci, range (i + 1, size1)).assign (
                     project (v, range (i + 1, size1)) / v (i));
                 if (i_norm_inf != i) {
-                    project (row (mr, i_norm_inf), range (0, i)).swap (project (row (mr, i), range (0, i)));
+                    matrix_row<matrix_type> mrrn (row (mr, i_norm_inf));
+                    vector_range<matrix_row<matrix_type> > mrrir (mrri, range (0, i));
+                    project (mrrn, range (0, i)).swap (mrrir);
                 }
             } else if (singular == 0) {
                 singular = i + 1;
@@ -222,8 +646,12 @@ namespace boost { namespace numeric { namespace ublas {
         ur.assign (zero_matrix<value_type> (size1, size2));
         vector_type v (size1);
         for (size_type i = 0; i < size; ++ i) {
+            matrix_column<matrix_type> uci (column (ur, i));
+            matrix_column<matrix_type> lci (column (lr, i));
+            matrix_row<matrix_type> mri (row (m, i));
+            matrix_row<matrix_type> lri (row (lr, i));
             matrix_range<matrix_type> lrr (project (lr, range (0, i), range (0, i)));
-            vector_range<matrix_column<matrix_type> > urr (project (column (ur, i), range (0, i)));
+            vector_range<matrix_column<matrix_type> > urr (project (uci, range (0, i)));
             urr.assign (project (column (m, i), range (0, i)));
             inplace_solve (lrr, urr, unit_lower_tag ());
             project (v, range (i, size1)).assign (
@@ -235,14 +663,18 @@ namespace boost { namespace numeric { namespace ublas {
                 if (i_norm_inf != i) {
                     pm (i) = i_norm_inf;
                     std::swap (v (i_norm_inf), v (i));
-                    project (row (m, i_norm_inf), range (i + 1, size2)).swap (project (row (m, i), range (i + 1, size2)));
+                    matrix_row<matrix_type> mrn (row (m, i_norm_inf));
+                    vector_range<matrix_row<matrix_type> > mrir (mri, range (i + 1, size2));
+                    project (mrn, range (i + 1, size2)).swap (mrir);
                 } else {
                     BOOST_UBLAS_CHECK (pm (i) == i_norm_inf, external_logic ());
                 }
-                project (column (lr, i), range (i + 1, size1)).assign (
+                project (lci, range (i + 1, size1)).assign (
                     project (v, range (i + 1, size1)) / v (i));
                 if (i_norm_inf != i) {
-                    project (row (lr, i_norm_inf), range (0, i)).swap (project (row (lr, i), range (0, i)));
+                    matrix_row<matrix_type> lrn (row (lr, i_norm_inf));
+                    vector_range<matrix_row<matrix_type> > lrir (lri, range (0, i));
+                    project (lrn, range (0, i)).swap (lrir);
                 }
             } else if (singular == 0) {
                 singular = i + 1;
@@ -341,8 +773,727 @@ namespace boost { namespace numeric { namespace ublas {
     }
     template<class MV, class M, class PMT, class PMA>
     void lu_substitute (MV &mv, const M &m, const permutation_matrix<PMT, PMA> &pm) {
-        swap_rows (pm, mv);
+        // x^T P^T L U = b^T: the pivots apply to the solution of the triangular solves
         lu_substitute (mv, m);
+        swap_rows_inverse (pm, mv);
+    }
+
+namespace detail {
+
+    // L U := L U + x y^T without row interchanges (Bennett); x and y are destroyed
+    template<class M, class V>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename M::size_type lu_rank_update (M &m, V &x, V &y) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        for (size_type i = 0; i < n; ++ i) {
+            m (i, i) += x (i) * y (i);
+            if (m (i, i) == value_type/*zero*/())
+                return i + 1;
+            y (i) /= m (i, i);
+            for (size_type j = i + 1; j < n; ++ j) {
+                m (i, j) += x (i) * y (j);
+                x (j) -= x (i) * m (j, i);
+                m (j, i) += y (i) * x (j);
+                y (j) -= y (i) * m (i, j);
+            }
+        }
+        return 0;
+    }
+
+}
+
+    /** \brief Rank one update of an LU factorization: \c m and \c pm become the
+     *  factorization of A + u v^T, in O(n^2) (Bennett's algorithm).
+     *
+     *  The rows keep their pivoting order, P A + P u v^T = L U + (P u) v^T being
+     *  factored without interchanges. This is stable as long as the pivots of U do not
+     *  shrink much; when they do, A is better factored anew.
+     *
+     *  \return 0, or the index plus one of a pivot that became zero, the factors being
+     *  unusable then
+     */
+    template<class M, class PM, class U, class V>
+    typename M::size_type lu_update (M &m, const PM &pm, const U &u, const V &v) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n, bad_size ());
+        BOOST_UBLAS_CHECK (u.size () == n && v.size () == n, bad_size ());
+        vector<value_type> x (u), y (v);
+        swap_rows (pm, x);
+        return detail::lu_rank_update (m, x, y);
+    }
+
+    /** \brief Updates the factors of \c lu_factorize for A with its column \c j
+     *  replaced by \c x, by \c lu_update; the old column is recovered from the
+     *  factors.
+     */
+    template<class M, class PM, class V>
+    typename M::size_type lu_replace_column (M &m, const PM &pm, typename M::size_type j, const V &x) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (j < n, bad_index ());
+        // P x - L U e_j
+        vector<value_type> u (x);
+        swap_rows (pm, u);
+        for (size_type i = 0; i < n; ++ i) {
+            value_type s (i <= j ? m (i, j) : value_type/*zero*/());
+            for (size_type p = 0; p < i && p <= j; ++ p)
+                s += m (i, p) * m (p, j);
+            u (i) -= s;
+        }
+        vector<value_type> v (n, value_type/*zero*/());
+        v (j) = value_type (1);
+        return detail::lu_rank_update (m, u, v);
+    }
+
+    /** \brief Updates the factors of \c lu_factorize for A with its row \c i replaced
+     *  by \c x, by \c lu_update; the old row is recovered from the factors.
+     */
+    template<class M, class PM, class V>
+    typename M::size_type lu_replace_row (M &m, const PM &pm, typename M::size_type i, const V &x) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (i < n, bad_index ());
+        // Row k of L U is row i of A for P e_i = e_k
+        vector<value_type> u (n, value_type/*zero*/());
+        u (i) = value_type (1);
+        swap_rows (pm, u);
+        size_type k = 0;
+        while (u (k) == value_type/*zero*/())
+            ++ k;
+        vector<value_type> v (x);
+        for (size_type j = 0; j < n; ++ j) {
+            value_type s (k <= j ? m (k, j) : value_type/*zero*/());
+            for (size_type p = 0; p < k && p <= j; ++ p)
+                s += m (k, p) * m (p, j);
+            v (j) -= s;
+        }
+        return detail::lu_rank_update (m, u, v);
+    }
+
+    /** \brief Extends the factors of \c lu_factorize of the n x n matrix A to those of
+     *  the bordered matrix [A b; c^T d] in O(n^2).
+     *
+     *  \c column holds b and d (size n + 1), \c row holds c (size n). \c m and \c pm
+     *  grow by one; the new row is not pivoted.
+     *
+     *  \return 0, or n + 1 if the new pivot is zero
+     */
+    template<class M, class PM, class V1, class V2>
+    typename M::size_type lu_append (M &m, PM &pm, const V1 &column, const V2 &row) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n && pm.size () == n, bad_size ());
+        BOOST_UBLAS_CHECK (column.size () == n + 1 && row.size () == n, bad_size ());
+        m.resize (n + 1, n + 1, true);
+        pm.resize (n + 1, true);
+        pm (n) = n;
+        // L w = P b
+        vector<value_type> w (n);
+        for (size_type i = 0; i < n; ++ i)
+            w (i) = column (i);
+        for (size_type i = 0; i < n; ++ i)
+            if (pm (i) != i)
+                std::swap (w (i), w (pm (i)));
+        for (size_type i = 0; i < n; ++ i) {
+            value_type s (w (i));
+            for (size_type p = 0; p < i; ++ p)
+                s -= m (i, p) * w (p);
+            w (i) = s;
+            m (i, n) = s;
+        }
+        // l^T U = c^T
+        value_type d (column (n));
+        for (size_type j = 0; j < n; ++ j) {
+            value_type s (row (j));
+            for (size_type p = 0; p < j; ++ p)
+                s -= m (n, p) * m (p, j);
+            m (n, j) = s / m (j, j);
+            d -= m (n, j) * w (j);
+        }
+        m (n, n) = d;
+        return d == value_type/*zero*/() ? n + 1 : 0;
+    }
+
+namespace detail {
+
+    // U := U^-1 in place for the upper triangle of m, by blocks of columns from left to
+    // right (xTRTRI); the strict lower triangle is not referenced. The block is copied
+    // first, so that the rows, independent of each other, are split between the threads.
+    template<class M>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void upper_triangular_invert (M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        for (size_type j0 = 0; j0 < n; j0 += block) {
+            const size_type j1 ((std::min) (n, j0 + block));
+            const size_type jb (j1 - j0);
+            const matrix<value_type> u (project (m, range (0, j1), range (j0, j1)));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if (j1 * (j0 + 1) * jb >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            {
+                std::vector<value_type> s (jb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for schedule (dynamic, 16)
+#endif
+                for (difference_type r = 0; r < difference_type (j1); ++ r) {
+                    const size_type i (r);
+                    // X (i, i:j0) U (i:j0, j0:j1) from the columns already inverted
+                    std::fill (s.begin (), s.end (), value_type/*zero*/());
+                    for (size_type p = i; p < j0; ++ p) {
+                        const value_type x (m (i, p));
+                        for (size_type q = 0; q < jb; ++ q)
+                            s [q] += x * u (p, q);
+                    }
+                    // the block itself, left to right
+                    for (size_type q = i > j0 ? i - j0 : 0; q < jb; ++ q) {
+                        const size_type c (j0 + q);
+                        if (c == i) {
+                            m (i, i) = value_type (1) / u (i, q);
+                            continue;
+                        }
+                        value_type t (s [q]);
+                        for (size_type p = (std::max) (i, j0); p < c; ++ p)
+                            t += m (i, p) * u (p, q);
+                        m (i, c) = - t / u (c, q);
+                    }
+                }
+            }
+        }
+    }
+
+    // X := (L U)^-1 in place from U^-1 over the unit lower L, solving X L = U^-1 by
+    // blocks of columns from right to left (xGETRI). The product with the columns of X
+    // already known is a matrix product; the rows of X are split between the threads.
+    template<class M>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void lu_invert_lower (M &m) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        for (size_type b = (n + block - 1) / block; b-- > 0; ) {
+            const size_type j0 (b * block);
+            const size_type j1 ((std::min) (n, j0 + block));
+            const size_type jb (j1 - j0);
+            // the columns j0:j1 of L
+            matrix<value_type> l (n - j0, jb, value_type/*zero*/());
+            for (size_type q = 0; q < jb; ++ q)
+                for (size_type p = q + 1; p < n - j0; ++ p)
+                    l (p, q) = m (j0 + p, j0 + q);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if (n * (n - j0) * jb >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            {
+                std::vector<value_type> x (jb);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for
+#endif
+                for (difference_type r = 0; r < difference_type (n); ++ r) {
+                    const size_type i (r);
+                    // U^-1 (i, j0:j1) - X (i, j1:n) L (j1:n, j0:j1)
+                    for (size_type q = 0; q < jb; ++ q)
+                        x [q] = i <= j0 + q ? m (i, j0 + q) : value_type/*zero*/();
+                    for (size_type p = j1; p < n; ++ p) {
+                        const value_type y (m (i, p));
+                        for (size_type q = 0; q < jb; ++ q)
+                            x [q] -= y * l (p - j0, q);
+                    }
+                    // the unit lower diagonal block, right to left
+                    for (size_type q = jb; q-- > 0; ) {
+                        for (size_type p = q + 1; p < jb; ++ p)
+                            x [q] -= x [p] * l (p, q);
+                        m (i, j0 + q) = x [q];
+                    }
+                }
+            }
+        }
+    }
+
+}
+
+    /** \brief Inverse of A in place from the factors P A = L U of \c lu_factorize
+     *  (xGETRI).
+     *
+     *  U is inverted by blocks of columns, then A^-1 P^T L = U^-1 is solved by blocks of
+     *  columns with matrix products, and the columns are swapped back. The rows are
+     *  threaded in both steps. No identity matrix is formed and no right hand side is
+     *  solved for.
+     *
+     *  \return 0, or the index plus one of a zero pivot; \c m is then left unchanged
+     */
+    template<class M, class PM>
+    typename M::size_type lu_invert (M &m, const PM &pm) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n && pm.size () == n, bad_size ());
+        for (size_type i = 0; i < n; ++ i)
+            if (m (i, i) == value_type/*zero*/())
+                return i + 1;
+        detail::upper_triangular_invert (m);
+        detail::lu_invert_lower (m);
+        swap_columns_inverse (pm, m);
+        return 0;
+    }
+
+    /** \brief Inverts a square matrix in place by \c lu_factorize and \c lu_invert;
+     *  for a hermitian positive definite matrix \c spd_invert of cholesky.hpp takes half
+     *  the work.
+     *
+     *  \return 0, or the index plus one of a zero pivot; \c m then holds the factors
+     */
+    template<class M>
+    typename M::size_type invert (M &m) {
+        typedef typename M::size_type size_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        permutation_matrix<size_type> pm (m.size1 ());
+        const size_type singular (lu_factorize (m, pm));
+        if (singular != 0)
+            return singular;
+        return lu_invert (m, pm);
+    }
+
+    /** \brief log |det A| from the factors of \c lu_factorize, without the overflow or
+     *  underflow of the determinant itself.
+     *
+     *  \c sign receives det A / |det A|, +1 or -1 for real matrices and of modulus 1 for
+     *  complex ones, or 0 for a singular matrix, the result then being -infinity.
+     */
+    template<class M, class PM>
+    typename type_traits<typename M::value_type>::real_type lu_log_determinant (const M &m, const PM &pm, typename M::value_type &sign) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type n (m.size1 ());
+        BOOST_UBLAS_CHECK (m.size2 () == n && pm.size () == n, bad_size ());
+        real_type l = real_type/*zero*/();
+        sign = value_type (1);
+        for (size_type i = 0; i < n; ++ i) {
+            const real_type a (type_traits<value_type>::type_abs (m (i, i)));
+            if (a == real_type/*zero*/()) {
+                sign = value_type/*zero*/();
+                return - std::numeric_limits<real_type>::infinity ();
+            }
+            l += std::log (a);
+            sign *= m (i, i) / value_type (a);
+            if (pm (i) != i)
+                sign = - sign;
+        }
+        return l;
+    }
+
+    /** \brief LU factorization P A = L U of a square matrix with partial pivoting that
+     *  owns its factors and pivots.
+     *
+     *  Solves work in place on the right hand sides and allocate nothing; the rows are
+     *  permuted as part of the substitution, column by column, and the columns of
+     *  matrix right hand sides are threaded. \c refactor factors another matrix of the
+     *  same size into the storage of the object.
+     *
+     * \tparam M dense matrix type holding the factors, e.g. \c matrix<double>
+     */
+    template<class M>
+    class lu_factorization {
+    public:
+        typedef M matrix_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+        typedef permutation_matrix<size_type> pivots_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        lu_factorization ():
+            lu_ (0, 0), pm_ (0), singular_ (0), norm_ (0) {}
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        explicit lu_factorization (const matrix_expression<AE> &ae):
+            lu_ (0, 0), pm_ (0), singular_ (0), norm_ (0) {
+            factorize (ae);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size () const {
+            return lu_.size1 ();
+        }
+        /** \brief L (unit lower, below the diagonal) and U (upper) in one matrix */
+        BOOST_UBLAS_INLINE
+        const matrix_type &lu () const {
+            return lu_;
+        }
+        BOOST_UBLAS_INLINE
+        const pivots_type &pivots () const {
+            return pm_;
+        }
+        /** \brief 0, or the index plus one of the first zero pivot, as \c lu_factorize */
+        BOOST_UBLAS_INLINE
+        size_type singular () const {
+            return singular_;
+        }
+
+        /** \brief Factors \c ae, reallocating only when its size differs from the
+         *  current one.
+         */
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        size_type factorize (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_CHECK (ae ().size1 () == ae ().size2 (), bad_size ());
+            const size_type n (ae ().size1 ());
+            if (lu_.size1 () != n || lu_.size2 () != n)
+                lu_.resize (n, n, false);
+            if (pm_.size () != n)
+                pm_.resize (n, false);
+            return refactor (ae);
+        }
+
+        /** \brief Factors \c ae, of the size of the current factorization, reusing
+         *  all storage.
+         */
+        template<class AE>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        size_type refactor (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_CHECK (ae ().size1 () == size () && ae ().size2 () == size (), bad_size ());
+            lu_.assign (ae);
+            norm_ = norm_1 (lu_);
+            for (size_type i = 0; i < size (); ++ i)
+                pm_ (i) = i;
+            singular_ = lu_factorize (lu_, pm_);
+            return singular_;
+        }
+
+        /** \brief Solves A x = mv in place; \c mv is a vector or a matrix with size
+         *  () rows.
+         */
+        template<class MV>
+        BOOST_UBLAS_INLINE
+        void solve (MV &mv) const {
+            substitute (mv, false, typename MV::type_category ());
+        }
+
+        /** \brief Solves A^T x = mv in place (the transpose, not the conjugate
+         *  transpose, for complex matrices).
+         */
+        template<class MV>
+        BOOST_UBLAS_INLINE
+        void solve_transposed (MV &mv) const {
+            substitute (mv, true, typename MV::type_category ());
+        }
+
+        /** \brief Determinant of A, the product of the pivots with the sign of P */
+        BOOST_UBLAS_INLINE
+        value_type determinant () const {
+            value_type d (1);
+            for (size_type i = 0; i < size (); ++ i) {
+                d *= lu_ (i, i);
+                if (pm_ (i) != i)
+                    d = - d;
+            }
+            return d;
+        }
+
+        /** \brief log |det A| and the sign det A / |det A|, see \c lu_log_determinant */
+        BOOST_UBLAS_INLINE
+        real_type log_determinant (value_type &sign) const {
+            return lu_log_determinant (lu_, pm_, sign);
+        }
+
+        /** \brief Estimate of the reciprocal condition number 1 / (||A||_1 ||A^-1||_1)
+         *  (xGECON).
+         *
+         *  ||A^-1||_1 is estimated by the method of Hager as refined by Higham (xLACN2)
+         *  from a few solves with A and A^T, O(n^2) operations instead of the O(n^3)
+         *  of an inverse. The estimate is a lower bound of ||A^-1||_1, rarely off by
+         *  more than a factor of 3. Returns 0 for a singular matrix.
+         */
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        real_type rcond () const {
+            const size_type n (size ());
+            if (n == 0)
+                return real_type (1);
+            if (singular_ != 0 || norm_ == real_type/*zero*/())
+                return real_type/*zero*/();
+            vector<value_type> x (n, value_type (real_type (1) / real_type (n))), y (n);
+            real_type estimate = real_type/*zero*/();
+            size_type j = n;
+            for (size_type iter = 0; iter < 5; ++ iter) {
+                if (j < n) {
+                    x.clear ();
+                    x (j) = value_type (1);
+                }
+                solve (x);
+                const real_type norm (norm_1 (x));
+                if (iter > 0 && norm <= estimate)
+                    break;
+                estimate = norm;
+                // y = A^-T sign (x)
+                for (size_type i = 0; i < n; ++ i) {
+                    const real_type a (type_traits<value_type>::type_abs (x (i)));
+                    y (i) = a == real_type/*zero*/() ? value_type (1) : x (i) / value_type (a);
+                }
+                solve_transposed (y);
+                const size_type k (index_norm_inf (y));
+                if (iter > 0 && k == j)
+                    break;
+                j = k;
+            }
+            // Higham's alternating vector guards against the worst cases
+            for (size_type i = 0; i < n; ++ i)
+                x (i) = value_type ((i % 2 ? -1 : 1) * (real_type (1) + (n > 1 ? real_type (i) / real_type (n - 1) : real_type/*zero*/())));
+            solve (x);
+            estimate = (std::max) (estimate, real_type (2) * real_type (norm_1 (x)) / real_type (3 * n));
+            return real_type (1) / (norm_ * estimate);
+        }
+
+    private:
+        template<class MV>
+        BOOST_UBLAS_INLINE
+        void substitute (MV &mv, bool trans, vector_tag) const {
+            substitute_column (mv, 0, trans, vector_tag ());
+        }
+        template<class MV>
+        BOOST_UBLAS_INLINE
+        void substitute (MV &mv, bool trans, matrix_tag) const {
+            BOOST_UBLAS_CHECK (mv.size1 () == size (), bad_size ());
+            const size_type cols (mv.size2 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size () * size () * cols >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type q = 0; q < difference_type (cols); ++ q)
+                substitute_column (mv, q, trans, matrix_tag ());
+        }
+        // P A = L U: A x = b is L U x = P b, A^T x = b is U^T L^T (P x) = b
+        template<class MV, class TAG>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void substitute_column (MV &mv, size_type q, bool trans, TAG) const {
+            typedef typename MV::value_type rhs_value_type;
+
+            const size_type n (size ());
+            BOOST_UBLAS_CHECK (detail::rhs_rows (mv, TAG ()) == n, bad_size ());
+            if (! trans) {
+                for (size_type i = 0; i < n; ++ i)
+                    if (pm_ (i) != i)
+                        std::swap (detail::rhs_element (mv, i, q, TAG ()), detail::rhs_element (mv, pm_ (i), q, TAG ()));
+                for (size_type i = 0; i < n; ++ i) {
+                    rhs_value_type s (detail::rhs_element (mv, i, q, TAG ()));
+                    for (size_type p = 0; p < i; ++ p)
+                        s -= lu_ (i, p) * detail::rhs_element (mv, p, q, TAG ());
+                    detail::rhs_element (mv, i, q, TAG ()) = s;
+                }
+                for (size_type i = n; i-- > 0; ) {
+                    rhs_value_type s (detail::rhs_element (mv, i, q, TAG ()));
+                    for (size_type p = i + 1; p < n; ++ p)
+                        s -= lu_ (i, p) * detail::rhs_element (mv, p, q, TAG ());
+                    detail::rhs_element (mv, i, q, TAG ()) = s / lu_ (i, i);
+                }
+            } else {
+                for (size_type i = 0; i < n; ++ i) {
+                    rhs_value_type s (detail::rhs_element (mv, i, q, TAG ()));
+                    for (size_type p = 0; p < i; ++ p)
+                        s -= lu_ (p, i) * detail::rhs_element (mv, p, q, TAG ());
+                    detail::rhs_element (mv, i, q, TAG ()) = s / lu_ (i, i);
+                }
+                for (size_type i = n; i-- > 0; ) {
+                    rhs_value_type s (detail::rhs_element (mv, i, q, TAG ()));
+                    for (size_type p = i + 1; p < n; ++ p)
+                        s -= lu_ (p, i) * detail::rhs_element (mv, p, q, TAG ());
+                    detail::rhs_element (mv, i, q, TAG ()) = s;
+                }
+                for (size_type i = n; i-- > 0; )
+                    if (pm_ (i) != i)
+                        std::swap (detail::rhs_element (mv, i, q, TAG ()), detail::rhs_element (mv, pm_ (i), q, TAG ()));
+            }
+        }
+
+        matrix_type lu_;
+        pivots_type pm_;
+        size_type singular_;
+        real_type norm_;
+    };
+
+namespace detail {
+
+    // The type of the factors of mixed_precision_solve
+    template<class T>
+    struct mixed_precision_traits {
+        typedef T low_type;
+    };
+    template<>
+    struct mixed_precision_traits<double> {
+        typedef float low_type;
+    };
+    template<>
+    struct mixed_precision_traits<std::complex<double> > {
+        typedef std::complex<float> low_type;
+    };
+
+    // Largest norm_inf of the columns of mv
+    template<class MV, class TAG>
+    BOOST_UBLAS_INLINE
+    typename type_traits<typename MV::value_type>::real_type rhs_norms_inf (MV &mv, vector<typename type_traits<typename MV::value_type>::real_type> &norms, TAG) {
+        typedef typename MV::size_type size_type;
+        typedef typename MV::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        real_type largest = real_type/*zero*/();
+        for (size_type q = 0; q < rhs_columns (mv, TAG ()); ++ q) {
+            real_type n = real_type/*zero*/();
+            for (size_type i = 0; i < rhs_rows (mv, TAG ()); ++ i)
+                n = (std::max) (n, type_traits<value_type>::type_abs (rhs_element (mv, i, q, TAG ())));
+            norms (q) = n;
+            largest = (std::max) (largest, n);
+        }
+        return largest;
+    }
+
+    // Iterative refinement of the solutions x of A x = b with the low precision
+    // factors lu; r and rl are workspace. Returns the number of steps, or -1 when the
+    // residuals stop decreasing or max_iterations are exceeded.
+    template<class M, class L, class MV, class R, class RL, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    int mixed_precision_refine (const M &a, const L &lu, const MV &b, R &x, R &r, RL &rl,
+                                typename M::size_type max_iterations, TAG) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type cols (rhs_columns (b, TAG ()));
+        // Converged when ||r|| <= ||x|| ||A|| eps sqrt (n) for every column (xSGESV)
+        const real_type bound (real_type (norm_inf (a)) * std::numeric_limits<real_type>::epsilon () *
+                               type_traits<real_type>::type_sqrt (real_type (a.size1 ())));
+        vector<real_type> rnorm (cols), xnorm (cols);
+        rl.assign (b);
+        lu.solve (rl);
+        x.assign (rl);
+        real_type last = real_type/*zero*/();
+        for (size_type iter = 0; iter <= max_iterations; ++ iter) {
+            r.assign (b);
+            noalias (r) -= prod (a, x);
+            rhs_norms_inf (r, rnorm, TAG ());
+            rhs_norms_inf (x, xnorm, TAG ());
+            bool converged = true;
+            real_type ratio = real_type/*zero*/();
+            for (size_type q = 0; q < cols; ++ q) {
+                converged = converged && rnorm (q) <= xnorm (q) * bound;
+                if (xnorm (q) != real_type/*zero*/())
+                    ratio = (std::max) (ratio, rnorm (q) / xnorm (q));
+            }
+            if (converged)
+                return int (iter);
+            // A step has to halve the residuals at least
+            if (iter > 0 && ratio > last / real_type (2))
+                return -1;
+            last = ratio;
+            rl.assign (r);
+            lu.solve (rl);
+            x += rl;
+        }
+        return -1;
+    }
+
+    template<class M, class MV, class R, class RL, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename M::size_type mixed_precision_solve (const M &a, MV &mv, int &iterations, typename M::size_type max_iterations,
+                                                 R &x, R &r, RL &rl, TAG) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename mixed_precision_traits<value_type>::low_type low_type;
+        typedef typename type_traits<low_type>::real_type low_real_type;
+
+        const size_type size1 (a.size1 ()), size2 (a.size2 ());
+        BOOST_UBLAS_CHECK (size1 == size2, bad_size ());
+        BOOST_UBLAS_CHECK (rhs_rows (mv, TAG ()) == size1, bad_size ());
+        // Elements out of the range of the low precision go to the fallback
+        bool overflow = false;
+        for (size_type i = 0; i < size1 && ! overflow; ++ i)
+            for (size_type j = 0; j < size2 && ! overflow; ++ j)
+                overflow = type_traits<value_type>::type_abs (a (i, j)) > std::numeric_limits<low_real_type>::max ();
+        if (overflow) {
+            iterations = -1;
+        } else {
+            lu_factorization<matrix<low_type> > lu (a);
+            if (lu.singular () != 0) {
+                iterations = -2;
+            } else {
+                iterations = mixed_precision_refine (a, lu, mv, x, r, rl, max_iterations, TAG ());
+                if (iterations >= 0) {
+                    mv.assign (x);
+                    return 0;
+                }
+                iterations = -3;
+            }
+        }
+        // Working precision
+        lu_factorization<matrix<value_type> > lu (a);
+        if (lu.singular () == 0)
+            lu.solve (mv);
+        return lu.singular ();
+    }
+    template<class M, class MV>
+    BOOST_UBLAS_INLINE
+    typename M::size_type mixed_precision_solve (const M &a, MV &mv, int &iterations, typename M::size_type max_iterations, vector_tag) {
+        typedef typename M::value_type value_type;
+        typedef typename mixed_precision_traits<value_type>::low_type low_type;
+
+        vector<value_type> x (mv.size ()), r (mv.size ());
+        vector<low_type> rl (mv.size ());
+        return mixed_precision_solve (a, mv, iterations, max_iterations, x, r, rl, vector_tag ());
+    }
+    template<class M, class MV>
+    BOOST_UBLAS_INLINE
+    typename M::size_type mixed_precision_solve (const M &a, MV &mv, int &iterations, typename M::size_type max_iterations, matrix_tag) {
+        typedef typename M::value_type value_type;
+        typedef typename mixed_precision_traits<value_type>::low_type low_type;
+
+        matrix<value_type> x (mv.size1 (), mv.size2 ()), r (mv.size1 (), mv.size2 ());
+        matrix<low_type> rl (mv.size1 (), mv.size2 ());
+        return mixed_precision_solve (a, mv, iterations, max_iterations, x, r, rl, matrix_tag ());
+    }
+
+}
+
+    /** \brief Solves A x = mv in place by an LU factorization in low precision and
+     *  iterative refinement (xSGESV for double, xCGESV for std::complex<double>).
+     *
+     *  A is factored in float (std::complex<float>), which halves the memory traffic
+     *  of the factorization; the residuals b - A x are computed in double with \c prod
+     *  and corrected by solves with the float factors. For matrices with a condition
+     *  number well below 1 / eps (float) a few steps reach double accuracy. When they
+     *  do not, A is factored again in double.
+     *
+     *  \param iterations receives the path taken: the number of refinement steps
+     *  (>= 0) on success in low precision; -1 when A does not fit the low precision,
+     *  -2 when its low precision factors are singular and -3 when the refinement did
+     *  not converge, the solution coming from the double factorization
+     *  \return 0, or for the double factorization the index plus one of its first zero
+     *  pivot, \c mv being unchanged then
+     */
+    template<class M, class MV>
+    typename M::size_type mixed_precision_solve (const M &a, MV &mv, int &iterations, typename M::size_type max_iterations = 30) {
+        return detail::mixed_precision_solve (a, mv, iterations, max_iterations, typename MV::type_category ());
     }
 
 }}}
@@ -326,7 +326,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -338,7 +340,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -356,7 +360,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1410,7 +1416,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         fixed_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -1422,7 +1430,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         fixed_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1440,7 +1450,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         fixed_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -2485,7 +2497,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         vector_of_vector &operator = (const matrix_expression<AE> &ae) { 
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -2504,7 +2518,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         vector_of_vector& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -2522,7 +2538,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         vector_of_vector& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -5121,7 +5139,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         c_matrix &operator = (const matrix_expression<AE> &ae) { 
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -5133,7 +5153,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         c_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -5151,7 +5173,9 @@ namespace boost { namespace numeric {
         template<class AE>
         BOOST_UBLAS_INLINE
         c_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.size1 () * temporary.size2 ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -5985,4 +6009,6 @@ namespace boost { namespace numeric {
 
 }}}
 
+#include <boost/numeric/ublas/detail/implicit_prod.hpp>
+
 #endif
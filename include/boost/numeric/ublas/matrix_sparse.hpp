@@ -459,7 +459,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, detail::map_capacity (data ()));
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -471,7 +473,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, detail::map_capacity (data ()));
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -489,7 +493,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, detail::map_capacity (data ()));
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1630,7 +1636,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_vector_of_mapped_vector &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -1642,7 +1650,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_vector_of_mapped_vector& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1660,7 +1670,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_vector_of_mapped_vector& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -3159,7 +3171,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         compressed_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -3171,7 +3185,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         compressed_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -3189,7 +3205,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         compressed_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -4576,7 +4594,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -4588,7 +4608,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -4606,7 +4628,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -69,6 +69,8 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const compressed_matrix<T1, L1, 0, IA1, TA1> &e1,
                const vector_expression<E2> &e2,
                V &v, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, v.size (), 2 * e1.nnz (),
+                                   (e1.nnz () + e1.size1 () + e1.size2 ()) * sizeof (typename V::value_type));
         typedef typename V::value_type value_type;
         typedef typename L1::orientation_category orientation_category;
 
@@ -103,6 +105,8 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const coordinate_matrix<T1, L1, 0, IA1, TA1> &e1,
                const vector_expression<E2> &e2,
                V &v, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, v.size (), 2 * e1.nnz (),
+                                   (e1.nnz () + e1.size1 () + e1.size2 ()) * sizeof (typename V::value_type));
         typedef typename V::size_type size_type;
         typedef typename V::value_type value_type;
         typedef L1 layout_type;
@@ -197,17 +201,201 @@ namespace boost { namespace numeric { namespace ublas {
         return v;
     }
 
-    // Dispatcher
+    namespace detail {
+
+        // Blocked dense GEMV kernels computing v += A x over a range of rows
+        // or columns of A. Four rows (columns) are processed per pass so that
+        // each element of x (v) is loaded once for four multiply-adds, and the
+        // accumulators stay in registers. The inner loops are plain indexed
+        // loops the compiler can vectorise.
+
+        // v (i) += A (i, :) x for i in [first, last)
+        template<class V, class E1, class E2>
+        BOOST_UBLAS_INLINE
+        void gemv_rows (const E1 &e1, const E2 &e2, V &v,
+                        typename V::size_type first, typename V::size_type last) {
+            typedef typename V::size_type size_type;
+            typedef typename V::value_type value_type;
+
+            const size_type size2 (e1.size2 ());
+            size_type i (first);
+            for (; i + 4 <= last; i += 4) {
+                value_type t0 = value_type/*zero*/();
+                value_type t1 = value_type/*zero*/();
+                value_type t2 = value_type/*zero*/();
+                value_type t3 = value_type/*zero*/();
+                for (size_type j = 0; j < size2; ++ j) {
+                    const value_type x (e2 (j));
+                    t0 += e1 (i, j) * x;
+                    t1 += e1 (i + 1, j) * x;
+                    t2 += e1 (i + 2, j) * x;
+                    t3 += e1 (i + 3, j) * x;
+                }
+                v (i) += t0;
+                v (i + 1) += t1;
+                v (i + 2) += t2;
+                v (i + 3) += t3;
+            }
+            for (; i < last; ++ i) {
+                value_type t = value_type/*zero*/();
+                for (size_type j = 0; j < size2; ++ j)
+                    t += e1 (i, j) * e2 (j);
+                v (i) += t;
+            }
+        }
+
+        // v += A (:, j) x (j) for j in [first, last)
+        template<class V, class E1, class E2>
+        BOOST_UBLAS_INLINE
+        void gemv_columns (const E1 &e1, const E2 &e2, V &v,
+                           typename V::size_type first, typename V::size_type last) {
+            typedef typename V::size_type size_type;
+            typedef typename V::value_type value_type;
+
+            const size_type size1 (e1.size1 ());
+            size_type j (first);
+            for (; j + 4 <= last; j += 4) {
+                const value_type x0 (e2 (j));
+                const value_type x1 (e2 (j + 1));
+                const value_type x2 (e2 (j + 2));
+                const value_type x3 (e2 (j + 3));
+                for (size_type i = 0; i < size1; ++ i)
+                    v (i) += e1 (i, j) * x0 + e1 (i, j + 1) * x1
+                           + e1 (i, j + 2) * x2 + e1 (i, j + 3) * x3;
+            }
+            for (; j < last; ++ j) {
+                const value_type x (e2 (j));
+                for (size_type i = 0; i < size1; ++ i)
+                    v (i) += e1 (i, j) * x;
+            }
+        }
+
+        // Row-major (or unknown) orientation: rows are independent, so threads
+        // split the row range.
+        template<class V, class E1, class E2>
+        BOOST_UBLAS_INLINE
+        void gemv (const E1 &e1, const E2 &e2, V &v, row_major_tag) {
+            typedef typename V::size_type size_type;
+
+            const size_type size1 (e1.size1 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+            const std::ptrdiff_t blocks ((size1 + 3) / 4);
+#pragma omp parallel for if (size1 * e1.size2 () >= BOOST_UBLAS_OPENMP_THRESHOLD)
+            for (std::ptrdiff_t b = 0; b < blocks; ++ b)
+                gemv_rows (e1, e2, v, size_type (4 * b), (std::min) (size_type (4 * b + 4), size1));
+#else
+            gemv_rows (e1, e2, v, 0, size1);
+#endif
+        }
+        template<class V, class E1, class E2>
+        BOOST_UBLAS_INLINE
+        void gemv (const E1 &e1, const E2 &e2, V &v, unknown_orientation_tag) {
+            gemv (e1, e2, v, row_major_tag ());
+        }
+
+        // Column-major orientation: threads take blocks of columns, accumulate
+        // into a private vector and reduce into v.
+        template<class V, class E1, class E2>
+        BOOST_UBLAS_INLINE
+        void gemv (const E1 &e1, const E2 &e2, V &v, column_major_tag) {
+            typedef typename V::size_type size_type;
+
+            const size_type size2 (e1.size2 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+            typedef typename V::value_type value_type;
+
+            const size_type size1 (e1.size1 ());
+            if (size1 * size2 < BOOST_UBLAS_OPENMP_THRESHOLD) {
+                gemv_columns (e1, e2, v, 0, size2);
+                return;
+            }
+#pragma omp parallel
+            {
+                const size_type threads (omp_get_num_threads ());
+                const size_type thread (omp_get_thread_num ());
+                // Column blocks are multiples of four to keep the kernel blocked
+                const size_type chunk (((size2 + threads - 1) / threads + 3) / 4 * 4);
+                const size_type first ((std::min) (thread * chunk, size2));
+                const size_type last ((std::min) (first + chunk, size2));
+                if (first < last) {
+                    vector<value_type> w (size1, value_type/*zero*/());
+                    gemv_columns (e1, e2, w, first, last);
+#pragma omp critical (boost_ublas_gemv)
+                    for (size_type i = 0; i < size1; ++ i)
+                        v (i) += w (i);
+                }
+            }
+#else
+            gemv_columns (e1, e2, v, 0, size2);
+#endif
+        }
+
+    }
+
     template<class V, class E1, class E2>
     BOOST_UBLAS_INLINE
     V &
     axpy_prod (const matrix_expression<E1> &e1,
                const vector_expression<E2> &e2,
-               V &v, packed_random_access_iterator_tag) {
+               V &v, packed_random_access_iterator_tag, dense_proxy_tag) {
+        typedef typename E1::orientation_category orientation_category;
+        detail::gemv (e1 (), e2 (), v, orientation_category ());
+        return v;
+    }
+
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, packed_random_access_iterator_tag, unknown_storage_tag) {
         typedef typename E1::orientation_category orientation_category;
         return axpy_prod (e1, e2, v, packed_random_access_iterator_tag (), orientation_category ());
     }
 
+    // Dispatcher
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const matrix_expression<E1> &e1,
+               const vector_expression<E2> &e2,
+               V &v, packed_random_access_iterator_tag) {
+        typedef typename boost::mpl::if_<boost::is_convertible<typename E1::storage_category, dense_proxy_tag>,
+                                         dense_proxy_tag, unknown_storage_tag>::type storage_category;
+        return axpy_prod (e1, e2, v, packed_random_access_iterator_tag (), storage_category ());
+    }
+
+
+namespace detail {
+
+    // Structured operands (see prod_operand_traits) with a dense result use the kernels of prod
+    template<class R, class E1, class E2>
+    struct axpy_prod_operand {
+        typedef typename prod_operand_traits<E1>::category category1;
+        typedef typename prod_operand_traits<E2>::category category2;
+        typedef typename boost::mpl::if_<boost::is_same<category1, general_operand_tag>,
+                                         category2, category1>::type structured_category;
+        typedef typename boost::mpl::if_<boost::is_convertible<typename R::storage_category, dense_proxy_tag>,
+                                         structured_category, general_operand_tag>::type category;
+    };
+
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    void axpy_prod_structured (const matrix_expression<E1> &e1,
+                               const vector_expression<E2> &e2,
+                               V &v, general_operand_tag) {
+        typedef typename E2::const_iterator::iterator_category iterator_category;
+        axpy_prod (e1, e2, v, iterator_category ());
+    }
+    template<class V, class E1, class E2, class C>
+    BOOST_UBLAS_INLINE
+    void axpy_prod_structured (const matrix_expression<E1> &e1,
+                               const vector_expression<E2> &e2,
+                               V &v, C) {
+        v.plus_assign (prod (e1, e2));
+    }
+
+}
 
   /** \brief computes <tt>v += A x</tt> or <tt>v = A x</tt> in an
           optimized fashion.
@@ -224,6 +412,11 @@ namespace boost { namespace numeric { namespace ublas {
 
           Up to now there are some specialisation for compressed
           matrices that give a large speed up compared to prod.
+          Dense matrices (including \c trans and \c herm views) use
+          blocked kernels processing four rows or columns per pass,
+          threaded when \c BOOST_UBLAS_USE_OPENMP is defined.
+          Structured matrices (triangular, symmetric, hermitian, banded
+          or diagonal) use the same kernels as \c prod.
           
           \ingroup blas2
 
@@ -240,8 +433,9 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const matrix_expression<E1> &e1,
                const vector_expression<E2> &e2,
                V &v, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, v.size (), 2 * e1 ().size1 () * e1 ().size2 (),
+                                   (e1 ().size1 () * e1 ().size2 () + e1 ().size1 () + e1 ().size2 ()) * sizeof (typename V::value_type));
         typedef typename V::value_type value_type;
-        typedef typename E2::const_iterator::iterator_category iterator_category;
 
         if (init)
             v.assign (zero_vector<value_type> (e1 ().size1 ()));
@@ -251,7 +445,7 @@ namespace boost { namespace numeric { namespace ublas {
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
 #endif
-        axpy_prod (e1, e2, v, iterator_category ());
+        detail::axpy_prod_structured (e1, e2, v, typename detail::axpy_prod_operand<V, E1, E2>::category ());
 #if BOOST_UBLAS_TYPE_CHECK
         BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
 #endif
@@ -312,6 +506,8 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const vector_expression<E1> &e1,
                const compressed_matrix<T2, L2, 0, IA2, TA2> &e2,
                V &v, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, v.size (), 2 * e2.nnz (),
+                                   (e2.nnz () + e2.size1 () + e2.size2 ()) * sizeof (typename V::value_type));
         typedef typename V::value_type value_type;
         typedef typename L2::orientation_category orientation_category;
 
@@ -415,17 +611,61 @@ namespace boost { namespace numeric { namespace ublas {
         return v;
     }
 
-    // Dispatcher
+    // Dense matrices share the GEMV kernels through the transposed view
     template<class V, class E1, class E2>
     BOOST_UBLAS_INLINE
     V &
     axpy_prod (const vector_expression<E1> &e1,
                const matrix_expression<E2> &e2,
-               V &v, packed_random_access_iterator_tag) {
+               V &v, packed_random_access_iterator_tag, dense_proxy_tag) {
+        typedef typename matrix_unary2_traits<const E2, scalar_identity<typename E2::value_type> >::result_type transposed_type;
+        typedef typename transposed_type::orientation_category orientation_category;
+        detail::gemv (transposed_type (e2 ()), e1 (), v, orientation_category ());
+        return v;
+    }
+
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const vector_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               V &v, packed_random_access_iterator_tag, unknown_storage_tag) {
         typedef typename E2::orientation_category orientation_category;
         return axpy_prod (e1, e2, v, packed_random_access_iterator_tag (), orientation_category ());
     }
 
+    // Dispatcher
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    V &
+    axpy_prod (const vector_expression<E1> &e1,
+               const matrix_expression<E2> &e2,
+               V &v, packed_random_access_iterator_tag) {
+        typedef typename boost::mpl::if_<boost::is_convertible<typename E2::storage_category, dense_proxy_tag>,
+                                         dense_proxy_tag, unknown_storage_tag>::type storage_category;
+        return axpy_prod (e1, e2, v, packed_random_access_iterator_tag (), storage_category ());
+    }
+
+
+namespace detail {
+
+    template<class V, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    void axpy_prod_structured (const vector_expression<E1> &e1,
+                               const matrix_expression<E2> &e2,
+                               V &v, general_operand_tag) {
+        typedef typename E1::const_iterator::iterator_category iterator_category;
+        axpy_prod (e1, e2, v, iterator_category ());
+    }
+    template<class V, class E1, class E2, class C>
+    BOOST_UBLAS_INLINE
+    void axpy_prod_structured (const vector_expression<E1> &e1,
+                               const matrix_expression<E2> &e2,
+                               V &v, C) {
+        v.plus_assign (prod (e1, e2));
+    }
+
+}
 
   /** \brief computes <tt>v += A<sup>T</sup> x</tt> or <tt>v = A<sup>T</sup> x</tt> in an
           optimized fashion.
@@ -458,8 +698,9 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const vector_expression<E1> &e1,
                const matrix_expression<E2> &e2,
                V &v, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, v.size (), 2 * e2 ().size1 () * e2 ().size2 (),
+                                   (e2 ().size1 () * e2 ().size2 () + e2 ().size1 () + e2 ().size2 ()) * sizeof (typename V::value_type));
         typedef typename V::value_type value_type;
-        typedef typename E1::const_iterator::iterator_category iterator_category;
 
         if (init)
             v.assign (zero_vector<value_type> (e2 ().size2 ()));
@@ -469,7 +710,7 @@ namespace boost { namespace numeric { namespace ublas {
         real_type verrorbound (norm_1 (v) + norm_1 (e1) * norm_1 (e2));
         indexing_vector_assign<scalar_plus_assign> (cv, prod (e1, e2));
 #endif
-        axpy_prod (e1, e2, v, iterator_category ());
+        detail::axpy_prod_structured (e1, e2, v, typename detail::axpy_prod_operand<V, E1, E2>::category ());
 #if BOOST_UBLAS_TYPE_CHECK
         BOOST_UBLAS_CHECK (norm_1 (v - cv) <= 2 * std::numeric_limits<real_type>::epsilon () * verrorbound, internal_logic ());
 #endif
@@ -644,6 +885,10 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const matrix_expression<E1> &e1,
                const matrix_expression<E2> &e2,
                M &m, TRI, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, m.size1 () * m.size2 (),
+                                   2 * e1 ().size1 () * e1 ().size2 () * e2 ().size2 (),
+                                   (e1 ().size1 () * e1 ().size2 () + e2 ().size1 () * e2 ().size2 () +
+                                    m.size1 () * m.size2 ()) * sizeof (typename M::value_type));
         typedef typename M::value_type value_type;
         typedef typename M::storage_category storage_category;
         typedef typename M::orientation_category orientation_category;
@@ -666,6 +911,28 @@ namespace boost { namespace numeric { namespace ublas {
         return axpy_prod (e1, e2, m, triangular_restriction (), true);
     }
 
+namespace detail {
+
+    template<class M, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    M &axpy_prod_structured (const matrix_expression<E1> &e1,
+                             const matrix_expression<E2> &e2,
+                             M &m, general_operand_tag) {
+        typedef typename M::storage_category storage_category;
+        typedef typename M::orientation_category orientation_category;
+        return axpy_prod (e1, e2, m, full (), storage_category (), orientation_category ());
+    }
+    template<class M, class E1, class E2, class C>
+    BOOST_UBLAS_INLINE
+    M &axpy_prod_structured (const matrix_expression<E1> &e1,
+                             const matrix_expression<E2> &e2,
+                             M &m, C) {
+        m.plus_assign (prod (e1, e2));
+        return m;
+    }
+
+}
+
   /** \brief computes <tt>M += A X</tt> or <tt>M = A X</tt> in an
           optimized fashion.
 
@@ -679,7 +946,9 @@ namespace boost { namespace numeric { namespace ublas {
           <tt>M.clear()</tt> before <tt>axpy_prod</tt>. Currently \a init
           defaults to \c true, but this may change in the future.
 
-          Up to now there are no specialisations.
+          Products with a structured operand (triangular, symmetric,
+          hermitian, banded or diagonal matrices) and a dense result
+          use the same kernels as \c prod.
           
           \ingroup blas3
 
@@ -696,13 +965,15 @@ namespace boost { namespace numeric { namespace ublas {
     axpy_prod (const matrix_expression<E1> &e1,
                const matrix_expression<E2> &e2,
                M &m, bool init = true) {
+        BOOST_UBLAS_PROFILE_SCOPE (axpy_prod_kernel, m.size1 () * m.size2 (),
+                                   2 * e1 ().size1 () * e1 ().size2 () * e2 ().size2 (),
+                                   (e1 ().size1 () * e1 ().size2 () + e2 ().size1 () * e2 ().size2 () +
+                                    m.size1 () * m.size2 ()) * sizeof (typename M::value_type));
         typedef typename M::value_type value_type;
-        typedef typename M::storage_category storage_category;
-        typedef typename M::orientation_category orientation_category;
 
         if (init)
             m.assign (zero_matrix<value_type> (e1 ().size1 (), e2 ().size2 ()));
-        return axpy_prod (e1, e2, m, full (), storage_category (), orientation_category ());
+        return detail::axpy_prod_structured (e1, e2, m, typename detail::axpy_prod_operand<M, E1, E2>::category ());
     }
     template<class M, class E1, class E2>
     BOOST_UBLAS_INLINE
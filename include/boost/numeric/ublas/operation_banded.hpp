@@ -0,0 +1,471 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_BANDED_
+#define _BOOST_UBLAS_OPERATION_BANDED_
+
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+
+/** \file operation_banded.hpp
+ *  \brief Band storage kernels for \c banded_matrix: the product of two banded
+ *  matrices into band storage, the LU factorization with partial pivoting and
+ *  the solvers for tridiagonal systems.
+ *
+ *  Products of a \c banded_matrix with vectors and dense matrices use band
+ *  kernels through \c prod already; this header adds the operations whose result
+ *  has a band structure of its own.
+ *
+ *  The band LU factors are stored as in LAPACK's gbtrf, not in the layout of
+ *  \c lu_factorize, so they are only understood by \c banded_lu_substitute.
+ *  \c lu_factorize and \c lu_substitute on a \c banded_matrix keep the generic code.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_lu_substitute (const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm, MV &mv, vector_tag) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size (m.size1 ());
+        const size_type lower (m.lower ()), upper (m.upper ());
+        BOOST_UBLAS_CHECK (mv.size () == size, bad_size ());
+        // L, interleaved with the row interchanges
+        for (size_type j = 0; j < size; ++ j) {
+            if (pm (j) != j)
+                std::swap (mv (j), mv (pm (j)));
+            const value_type t (mv (j));
+            if (t != value_type/*zero*/()) {
+                const size_type last ((std::min) (size, j + lower + 1));
+                for (size_type i = j + 1; i < last; ++ i)
+                    mv (i) -= m (i, j) * t;
+            }
+        }
+        // U
+        for (size_type j = size; j-- > 0; ) {
+            mv (j) /= m (j, j);
+            const value_type t (mv (j));
+            if (t != value_type/*zero*/()) {
+                for (size_type i = j > upper ? j - upper : 0; i < j; ++ i)
+                    mv (i) -= m (i, j) * t;
+            }
+        }
+    }
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_lu_substitute (const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm, MV &mv, matrix_tag) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size (m.size1 ());
+        const size_type size2 (mv.size2 ());
+        const size_type lower (m.lower ()), upper (m.upper ());
+        BOOST_UBLAS_CHECK (mv.size1 () == size, bad_size ());
+        for (size_type j = 0; j < size; ++ j) {
+            if (pm (j) != j)
+                row (mv, j).swap (row (mv, pm (j)));
+            const size_type last ((std::min) (size, j + lower + 1));
+            for (size_type i = j + 1; i < last; ++ i) {
+                const value_type l (m (i, j));
+                if (l != value_type/*zero*/()) {
+                    for (size_type k = 0; k < size2; ++ k)
+                        mv (i, k) -= l * mv (j, k);
+                }
+            }
+        }
+        for (size_type j = size; j-- > 0; ) {
+            const value_type d (m (j, j));
+            for (size_type k = 0; k < size2; ++ k)
+                mv (j, k) /= d;
+            for (size_type i = j > upper ? j - upper : 0; i < j; ++ i) {
+                const value_type u (m (i, j));
+                if (u != value_type/*zero*/()) {
+                    for (size_type k = 0; k < size2; ++ k)
+                        mv (i, k) -= u * mv (j, k);
+                }
+            }
+        }
+    }
+
+    // x^T A = b^T: U^T first, then L^T with the row interchanges in reverse order
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_lu_substitute (MV &mv, const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm, vector_tag) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size (m.size1 ());
+        const size_type lower (m.lower ()), upper (m.upper ());
+        BOOST_UBLAS_CHECK (mv.size () == size, bad_size ());
+        for (size_type j = 0; j < size; ++ j) {
+            value_type t (mv (j));
+            for (size_type i = j > upper ? j - upper : 0; i < j; ++ i)
+                t -= m (i, j) * mv (i);
+            mv (j) = t / m (j, j);
+        }
+        for (size_type j = size; j-- > 0; ) {
+            const size_type last ((std::min) (size, j + lower + 1));
+            value_type t (mv (j));
+            for (size_type i = j + 1; i < last; ++ i)
+                t -= m (i, j) * mv (i);
+            mv (j) = t;
+            if (pm (j) != j)
+                std::swap (mv (j), mv (pm (j)));
+        }
+    }
+    // X A = B, every row of X as above
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void banded_lu_substitute (MV &mv, const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm, matrix_tag) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size (m.size1 ());
+        const size_type size1 (mv.size1 ());
+        const size_type lower (m.lower ()), upper (m.upper ());
+        BOOST_UBLAS_CHECK (mv.size2 () == size, bad_size ());
+        for (size_type j = 0; j < size; ++ j) {
+            for (size_type i = j > upper ? j - upper : 0; i < j; ++ i) {
+                const value_type u (m (i, j));
+                if (u != value_type/*zero*/()) {
+                    for (size_type k = 0; k < size1; ++ k)
+                        mv (k, j) -= u * mv (k, i);
+                }
+            }
+            const value_type d (m (j, j));
+            for (size_type k = 0; k < size1; ++ k)
+                mv (k, j) /= d;
+        }
+        for (size_type j = size; j-- > 0; ) {
+            const size_type last ((std::min) (size, j + lower + 1));
+            for (size_type i = j + 1; i < last; ++ i) {
+                const value_type l (m (i, j));
+                if (l != value_type/*zero*/()) {
+                    for (size_type k = 0; k < size1; ++ k)
+                        mv (k, j) -= l * mv (k, i);
+                }
+            }
+            if (pm (j) != j)
+                column (mv, j).swap (column (mv, pm (j)));
+        }
+    }
+
+    // Thomas algorithm, the right hand sides of a matrix are eliminated together
+    template<class T, class L, class A, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename banded_matrix<T, L, A>::size_type tridiagonal_solve (const banded_matrix<T, L, A> &m, MV &mv, vector_tag) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size (m.size1 ());
+        BOOST_UBLAS_CHECK (mv.size () == size, bad_size ());
+        if (size == 0)
+            return 0;
+        // Upper diagonal of the eliminated system
+        vector<value_type> w (size);
+        value_type d (m (0, 0));
+        for (size_type i = 0; ; ) {
+            if (d == value_type/*zero*/())
+                return i + 1;
+            const value_type d_inv (value_type (1) / d);
+            mv (i) *= d_inv;
+            if (++ i == size)
+                break;
+            w (i - 1) = m (i - 1, i) * d_inv;
+            const value_type l (m (i, i - 1));
+            d = m (i, i) - l * w (i - 1);
+            mv (i) -= l * mv (i - 1);
+        }
+        for (size_type i = size - 1; i > 0; -- i)
+            mv (i - 1) -= w (i - 1) * mv (i);
+        return 0;
+    }
+    template<class T, class L, class A, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename banded_matrix<T, L, A>::size_type tridiagonal_solve (const banded_matrix<T, L, A> &m, MV &mv, matrix_tag) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type size (m.size1 ());
+        const size_type size2 (mv.size2 ());
+        BOOST_UBLAS_CHECK (mv.size1 () == size, bad_size ());
+        if (size == 0)
+            return 0;
+        vector<value_type> w (size);
+        value_type d (m (0, 0));
+        for (size_type i = 0; ; ) {
+            if (d == value_type/*zero*/())
+                return i + 1;
+            const value_type d_inv (value_type (1) / d);
+            for (size_type k = 0; k < size2; ++ k)
+                mv (i, k) *= d_inv;
+            if (++ i == size)
+                break;
+            w (i - 1) = m (i - 1, i) * d_inv;
+            const value_type l (m (i, i - 1));
+            d = m (i, i) - l * w (i - 1);
+            for (size_type k = 0; k < size2; ++ k)
+                mv (i, k) -= l * mv (i - 1, k);
+        }
+        for (size_type i = size - 1; i > 0; -- i) {
+            const value_type u (w (i - 1));
+            for (size_type k = 0; k < size2; ++ k)
+                mv (i - 1, k) -= u * mv (i, k);
+        }
+        return 0;
+    }
+
+    // Parallel cyclic reduction on the right hand sides stored in the rows of d.
+    // Step s decouples every equation from its neighbours at distance s, after
+    // ceil (log2 (n)) steps the system is diagonal.
+    template<class T, class L, class A, class V>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename banded_matrix<T, L, A>::size_type cyclic_reduction_solve (const banded_matrix<T, L, A> &m, matrix<V> &d) {
+        typedef typename banded_matrix<T, L, A>::size_type size_type;
+        typedef typename banded_matrix<T, L, A>::difference_type difference_type;
+        typedef V value_type;
+
+        const size_type size (m.size1 ());
+        const size_type size2 (d.size2 ());
+        vector<value_type> a (size), b (size), c (size);
+        for (size_type i = 0; i < size; ++ i) {
+            a (i) = i > 0 ? value_type (m (i, i - 1)) : value_type/*zero*/();
+            b (i) = m (i, i);
+            c (i) = i + 1 < size ? value_type (m (i, i + 1)) : value_type/*zero*/();
+        }
+        vector<value_type> a2 (size), b2 (size), c2 (size);
+        matrix<value_type> d2 (size, size2);
+        for (size_type s = 1; ; s *= 2) {
+            for (size_type i = 0; i < size; ++ i)
+                if (b (i) == value_type/*zero*/())
+                    return i + 1;
+            if (s >= size)
+                break;
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (size * (size2 + 3) >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type o = 0; o < difference_type (size); ++ o) {
+                const size_type i (o);
+                const bool has_lower (i >= s), has_upper (i + s < size);
+                const value_type k1 (has_lower ? a (i) / b (i - s) : value_type/*zero*/());
+                const value_type k2 (has_upper ? c (i) / b (i + s) : value_type/*zero*/());
+                a2 (i) = has_lower ? - a (i - s) * k1 : value_type/*zero*/();
+                c2 (i) = has_upper ? - c (i + s) * k2 : value_type/*zero*/();
+                value_type t (b (i));
+                if (has_lower)
+                    t -= c (i - s) * k1;
+                if (has_upper)
+                    t -= a (i + s) * k2;
+                b2 (i) = t;
+                for (size_type k = 0; k < size2; ++ k) {
+                    value_type r (d (i, k));
+                    if (has_lower)
+                        r -= k1 * d (i - s, k);
+                    if (has_upper)
+                        r -= k2 * d (i + s, k);
+                    d2 (i, k) = r;
+                }
+            }
+            a.swap (a2);
+            b.swap (b2);
+            c.swap (c2);
+            d.swap (d2);
+        }
+        for (size_type i = 0; i < size; ++ i) {
+            const value_type b_inv (value_type (1) / b (i));
+            for (size_type k = 0; k < size2; ++ k)
+                d (i, k) *= b_inv;
+        }
+        return 0;
+    }
+    template<class T, class L, class A, class MV>
+    BOOST_UBLAS_INLINE
+    typename banded_matrix<T, L, A>::size_type cyclic_reduction_solve (const banded_matrix<T, L, A> &m, MV &mv, vector_tag) {
+        typedef typename MV::value_type value_type;
+        BOOST_UBLAS_CHECK (mv.size () == m.size1 (), bad_size ());
+        matrix<value_type> d (mv.size (), 1);
+        column (d, 0) = mv;
+        typename banded_matrix<T, L, A>::size_type singular = cyclic_reduction_solve (m, d);
+        if (singular == 0)
+            mv = column (d, 0);
+        return singular;
+    }
+    template<class T, class L, class A, class MV>
+    BOOST_UBLAS_INLINE
+    typename banded_matrix<T, L, A>::size_type cyclic_reduction_solve (const banded_matrix<T, L, A> &m, MV &mv, matrix_tag) {
+        typedef typename MV::value_type value_type;
+        BOOST_UBLAS_CHECK (mv.size1 () == m.size1 (), bad_size ());
+        matrix<value_type> d (mv);
+        typename banded_matrix<T, L, A>::size_type singular = cyclic_reduction_solve (m, d);
+        if (singular == 0)
+            mv = d;
+        return singular;
+    }
+
+}
+
+    /** \brief Product of two banded matrices in band storage.
+     *
+     * \c c is resized to the band of the product, with \c a.lower () + \c b.lower ()
+     * lower and \c a.upper () + \c b.upper () upper diagonals. Each stored element
+     * of \c a is combined with the band of one row of \c b only.
+     */
+    template<class T1, class L1, class A1, class T2, class L2, class A2, class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    banded_matrix<T, L, A> &banded_prod (const banded_matrix<T1, L1, A1> &a, const banded_matrix<T2, L2, A2> &b,
+                                         banded_matrix<T, L, A> &c) {
+        BOOST_UBLAS_CHECK (a.size2 () == b.size1 (), bad_size ());
+        c.resize (a.size1 (), b.size2 (), a.lower () + b.lower (), a.upper () + b.upper (), false);
+        c.clear ();
+#if !defined (BOOST_UBLAS_OWN_BANDED) && !(BOOST_UBLAS_LEGACY_BANDED)
+        detail::banded_prod_matrix<T> (a, b, c, false);
+#else
+        c.assign (prod (a, b));
+#endif
+        return c;
+    }
+
+    /** \brief LU factorization with partial pivoting of a square banded matrix.
+     *
+     * Row interchanges make U fill up to \c m.lower () + \c m.upper () diagonals
+     * above the main diagonal, so the upper band of \c m is widened by \c m.lower ()
+     * to hold them. On return the upper band holds U and the lower band holds the
+     * multipliers of L as in LAPACK's gbtrf: column \c j of L is stored as computed
+     * at step \c j, so later interchanges are not applied to it. Use
+     * \c banded_lu_substitute to solve with these factors; \c lu_substitute and
+     * \c swap_rows do not apply to them.
+     *
+     * The work is O(n kl (kl + ku)) for kl lower and ku upper diagonals.
+     * \return 0 if \c m is not singular, otherwise one plus the index of the first zero pivot
+     */
+    template<class T, class L, class A, class PM>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename banded_matrix<T, L, A>::size_type banded_lu_factorize (banded_matrix<T, L, A> &m, PM &pm) {
+        typedef banded_matrix<T, L, A> matrix_type;
+        typedef typename matrix_type::size_type size_type;
+        typedef typename matrix_type::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (pm.size () == m.size1 (), bad_size ());
+        const size_type size (m.size1 ());
+        const size_type lower (m.lower ()), upper (m.upper ());
+        // Widen the upper band for the fill
+        matrix_type f (size, size, lower, lower + upper);
+        f.clear ();
+        for (size_type i = 0; i < size; ++ i) {
+            const size_type last ((std::min) (size, i + upper + 1));
+            for (size_type j = i > lower ? i - lower : 0; j < last; ++ j)
+                f.at_element (i, j) = m (i, j);
+        }
+        m.assign_temporary (f);
+
+        size_type singular = 0;
+        // Columns [j + 1, fill) of the current row block may be non zero
+        size_type fill = 0;
+        for (size_type j = 0; j < size; ++ j) {
+            const size_type last ((std::min) (size, j + lower + 1));
+            size_type p = j;
+            real_type p_norm (type_traits<value_type>::norm_inf (m.at_element (j, j)));
+            for (size_type i = j + 1; i < last; ++ i) {
+                const real_type i_norm (type_traits<value_type>::norm_inf (m.at_element (i, j)));
+                if (i_norm > p_norm) {
+                    p = i;
+                    p_norm = i_norm;
+                }
+            }
+            if (m.at_element (p, j) != value_type/*zero*/()) {
+                fill = (std::max) (fill, (std::min) (size, p + upper + 1));
+                if (p != j) {
+                    pm (j) = p;
+                    for (size_type k = j; k < fill; ++ k)
+                        std::swap (m.at_element (j, k), m.at_element (p, k));
+                } else {
+                    BOOST_UBLAS_CHECK (pm (j) == p, external_logic ());
+                }
+                const value_type m_inv = value_type (1) / m.at_element (j, j);
+                for (size_type i = j + 1; i < last; ++ i) {
+                    value_type &l = m.at_element (i, j);
+                    l *= m_inv;
+                    if (l != value_type/*zero*/()) {
+                        for (size_type k = j + 1; k < fill; ++ k)
+                            m.at_element (i, k) -= l * m.at_element (j, k);
+                    }
+                }
+            } else if (singular == 0) {
+                singular = j + 1;
+            }
+        }
+        return singular;
+    }
+
+    /** \brief Solves <tt>A X = B</tt> in place from the factors computed by \c banded_lu_factorize.
+     *
+     * \c mv is a vector or a matrix of right hand sides.
+     */
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    BOOST_UBLAS_INLINE
+    void banded_lu_substitute (const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm, MV &mv) {
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (pm.size () == m.size1 (), bad_size ());
+        detail::banded_lu_substitute (m, pm, mv, typename MV::type_category ());
+    }
+
+    /** \brief Solves <tt>X A = B</tt> in place from the factors computed by \c banded_lu_factorize.
+     *
+     * \c mv is a vector (<tt>x<sup>T</sup> A = b<sup>T</sup></tt>) or a matrix of right hand
+     * sides in its rows.
+     */
+    template<class T, class L, class A, class PMT, class PMA, class MV>
+    BOOST_UBLAS_INLINE
+    void banded_lu_substitute (MV &mv, const banded_matrix<T, L, A> &m, const permutation_matrix<PMT, PMA> &pm) {
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (pm.size () == m.size1 (), bad_size ());
+        detail::banded_lu_substitute (mv, m, pm, typename MV::type_category ());
+    }
+
+    /** \brief Solves the tridiagonal system <tt>A X = B</tt> in place with the Thomas algorithm.
+     *
+     * \c m has at most one lower and one upper diagonal and is not modified. \c mv is a
+     * vector or a matrix of right hand sides; the rows of a matrix are eliminated
+     * together, so the innermost loops run across the right hand sides. There is no
+     * pivoting: the algorithm is stable for diagonally dominant or positive definite
+     * matrices. O(n) work per right hand side.
+     * \return 0 if no zero pivot occurred, otherwise one plus the index of the first zero pivot
+     * (\c mv is unspecified then)
+     */
+    template<class T, class L, class A, class MV>
+    BOOST_UBLAS_INLINE
+    typename banded_matrix<T, L, A>::size_type tridiagonal_solve (const banded_matrix<T, L, A> &m, MV &mv) {
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.lower () <= 1 && m.upper () <= 1, bad_argument ());
+        return detail::tridiagonal_solve (m, mv, typename MV::type_category ());
+    }
+
+    /** \brief Solves the tridiagonal system <tt>A X = B</tt> in place by parallel cyclic reduction.
+     *
+     * Every step updates all equations independently, they are threaded when
+     * \c BOOST_UBLAS_USE_OPENMP is defined. O(n log n) work per right hand side against O(n)
+     * for \c tridiagonal_solve, in exchange for log2 (n) parallel steps. Same conditions as
+     * \c tridiagonal_solve apply.
+     * \return 0 if no zero pivot occurred, otherwise one plus the index of a zero pivot
+     * (\c mv is unchanged then)
+     */
+    template<class T, class L, class A, class MV>
+    BOOST_UBLAS_INLINE
+    typename banded_matrix<T, L, A>::size_type cyclic_reduction_solve (const banded_matrix<T, L, A> &m, MV &mv) {
+        BOOST_UBLAS_CHECK (m.size1 () == m.size2 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.lower () <= 1 && m.upper () <= 1, bad_argument ());
+        return detail::cyclic_reduction_solve (m, mv, typename MV::type_category ());
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,868 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_FIXED_
+#define _BOOST_UBLAS_OPERATION_FIXED_
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+
+/** \file operation_fixed.hpp
+ *  \brief Size specialised kernels for \c fixed_matrix, \c bounded_matrix and \c c_matrix
+ *  (and the corresponding vectors).
+ *
+ *  The sizes of these containers are template arguments, so the kernels below are
+ *  instantiated per size: inner products are unrolled up to
+ *  \c BOOST_UBLAS_FIXED_UNROLL_LIMIT terms and all other loops have compile time
+ *  bounds. No expression templates, proxies or \c BOOST_UBLAS_SAME checks are
+ *  involved. Bounded and C-array containers may be resized below their maximum
+ *  size; their current size must equal the maximum size to use these kernels.
+ *
+ *  Including this header also routes \c lu_factorize (m, pm), \c lu_substitute (m, pm, v),
+ *  \c prod (m, m), \c prod (m, v), \c inner_prod (v, v) and \c inplace_solve (m, v, tag)
+ *  on these containers to the fixed kernels.
+ */
+
+#ifndef BOOST_UBLAS_FIXED_UNROLL_LIMIT
+#define BOOST_UBLAS_FIXED_UNROLL_LIMIT 8
+#endif
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Compile time sizes and raw element access of the fixed containers
+    template<class M>
+    struct fixed_matrix_traits {
+        static const bool is_fixed = false;
+    };
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T, std::size_t M, std::size_t N, class L, class A>
+    struct fixed_matrix_traits<fixed_matrix<T, M, N, L, A> > {
+        typedef fixed_matrix<T, M, N, L, A> matrix_type;
+        typedef T value_type;
+        static const bool is_fixed = true;
+        static const std::size_t size1 = M;
+        static const std::size_t size2 = N;
+
+        static BOOST_UBLAS_INLINE
+        bool has_fixed_size (const matrix_type &) {
+            return true;
+        }
+        static BOOST_UBLAS_INLINE
+        const value_type &element (const matrix_type &m, std::size_t i, std::size_t j) {
+            return m.data () [L::element (i, M, j, N)];
+        }
+        static BOOST_UBLAS_INLINE
+        value_type &element (matrix_type &m, std::size_t i, std::size_t j) {
+            return m.data () [L::element (i, M, j, N)];
+        }
+    };
+#endif
+
+    template<class T, std::size_t M, std::size_t N, class L>
+    struct fixed_matrix_traits<bounded_matrix<T, M, N, L> > {
+        typedef bounded_matrix<T, M, N, L> matrix_type;
+        typedef T value_type;
+        static const bool is_fixed = true;
+        static const std::size_t size1 = M;
+        static const std::size_t size2 = N;
+
+        static BOOST_UBLAS_INLINE
+        bool has_fixed_size (const matrix_type &m) {
+            return m.size1 () == M && m.size2 () == N;
+        }
+        static BOOST_UBLAS_INLINE
+        const value_type &element (const matrix_type &m, std::size_t i, std::size_t j) {
+            return m.data () [L::element (i, M, j, N)];
+        }
+        static BOOST_UBLAS_INLINE
+        value_type &element (matrix_type &m, std::size_t i, std::size_t j) {
+            return m.data () [L::element (i, M, j, N)];
+        }
+    };
+
+    template<class T, std::size_t M, std::size_t N>
+    struct fixed_matrix_traits<c_matrix<T, M, N> > {
+        typedef c_matrix<T, M, N> matrix_type;
+        typedef T value_type;
+        static const bool is_fixed = true;
+        static const std::size_t size1 = M;
+        static const std::size_t size2 = N;
+
+        static BOOST_UBLAS_INLINE
+        bool has_fixed_size (const matrix_type &m) {
+            return m.size1 () == M && m.size2 () == N;
+        }
+        static BOOST_UBLAS_INLINE
+        const value_type &element (const matrix_type &m, std::size_t i, std::size_t j) {
+            return m.data () [i * N + j];
+        }
+        static BOOST_UBLAS_INLINE
+        value_type &element (matrix_type &m, std::size_t i, std::size_t j) {
+            return m.data () [i * N + j];
+        }
+    };
+
+    template<class V>
+    struct fixed_vector_traits {
+        static const bool is_fixed = false;
+    };
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T, std::size_t N, class A>
+    struct fixed_vector_traits<fixed_vector<T, N, A> > {
+        typedef fixed_vector<T, N, A> vector_type;
+        typedef T value_type;
+        static const bool is_fixed = true;
+        static const std::size_t size = N;
+
+        static BOOST_UBLAS_INLINE
+        bool has_fixed_size (const vector_type &) {
+            return true;
+        }
+        static BOOST_UBLAS_INLINE
+        const value_type &element (const vector_type &v, std::size_t i) {
+            return v.data () [i];
+        }
+        static BOOST_UBLAS_INLINE
+        value_type &element (vector_type &v, std::size_t i) {
+            return v.data () [i];
+        }
+    };
+#endif
+
+    template<class T, std::size_t N>
+    struct fixed_vector_traits<bounded_vector<T, N> > {
+        typedef bounded_vector<T, N> vector_type;
+        typedef T value_type;
+        static const bool is_fixed = true;
+        static const std::size_t size = N;
+
+        static BOOST_UBLAS_INLINE
+        bool has_fixed_size (const vector_type &v) {
+            return v.size () == N;
+        }
+        static BOOST_UBLAS_INLINE
+        const value_type &element (const vector_type &v, std::size_t i) {
+            return v.data () [i];
+        }
+        static BOOST_UBLAS_INLINE
+        value_type &element (vector_type &v, std::size_t i) {
+            return v.data () [i];
+        }
+    };
+
+    template<class T, std::size_t N>
+    struct fixed_vector_traits<c_vector<T, N> > {
+        typedef c_vector<T, N> vector_type;
+        typedef T value_type;
+        static const bool is_fixed = true;
+        static const std::size_t size = N;
+
+        static BOOST_UBLAS_INLINE
+        bool has_fixed_size (const vector_type &v) {
+            return v.size () == N;
+        }
+        static BOOST_UBLAS_INLINE
+        const value_type &element (const vector_type &v, std::size_t i) {
+            return v.data () [i];
+        }
+        static BOOST_UBLAS_INLINE
+        value_type &element (vector_type &v, std::size_t i) {
+            return v.data () [i];
+        }
+    };
+
+    // Sum of f (0) + ... + f (K - 1), unrolled for short sums
+    template<std::size_t K, bool U = (K <= BOOST_UBLAS_FIXED_UNROLL_LIMIT)>
+    struct fixed_sum {
+        template<class R, class F>
+        static BOOST_UBLAS_INLINE
+        R apply (const F &f) {
+            return fixed_sum<K - 1>::template apply<R> (f) + f (K - 1);
+        }
+    };
+    template<>
+    struct fixed_sum<1, true> {
+        template<class R, class F>
+        static BOOST_UBLAS_INLINE
+        R apply (const F &f) {
+            return f (0);
+        }
+    };
+    template<>
+    struct fixed_sum<0, true> {
+        template<class R, class F>
+        static BOOST_UBLAS_INLINE
+        R apply (const F &) {
+            return R/*zero*/();
+        }
+    };
+    template<std::size_t K>
+    struct fixed_sum<K, false> {
+        template<class R, class F>
+        static BOOST_UBLAS_INLINE
+        R apply (const F &f) {
+            R t = f (0);
+            for (std::size_t k = 1; k < K; ++ k)
+                t += f (k);
+            return t;
+        }
+    };
+
+    // Terms of the unrolled sums
+    template<class M1, class M2, class R>
+    struct fixed_matrix_matrix_term {
+        typedef fixed_matrix_traits<M1> traits1;
+        typedef fixed_matrix_traits<M2> traits2;
+
+        BOOST_UBLAS_INLINE
+        fixed_matrix_matrix_term (const M1 &e1, const M2 &e2, std::size_t i, std::size_t j):
+            e1_ (e1), e2_ (e2), i_ (i), j_ (j) {}
+        BOOST_UBLAS_INLINE
+        R operator () (std::size_t k) const {
+            return traits1::element (e1_, i_, k) * traits2::element (e2_, k, j_);
+        }
+    private:
+        const M1 &e1_;
+        const M2 &e2_;
+        std::size_t i_, j_;
+    };
+
+    template<class M1, class V2, class R>
+    struct fixed_matrix_vector_term {
+        typedef fixed_matrix_traits<M1> traits1;
+        typedef fixed_vector_traits<V2> traits2;
+
+        BOOST_UBLAS_INLINE
+        fixed_matrix_vector_term (const M1 &e1, const V2 &e2, std::size_t i):
+            e1_ (e1), e2_ (e2), i_ (i) {}
+        BOOST_UBLAS_INLINE
+        R operator () (std::size_t k) const {
+            return traits1::element (e1_, i_, k) * traits2::element (e2_, k);
+        }
+    private:
+        const M1 &e1_;
+        const V2 &e2_;
+        std::size_t i_;
+    };
+
+    template<class V1, class V2, class R>
+    struct fixed_vector_vector_term {
+        typedef fixed_vector_traits<V1> traits1;
+        typedef fixed_vector_traits<V2> traits2;
+
+        BOOST_UBLAS_INLINE
+        fixed_vector_vector_term (const V1 &e1, const V2 &e2):
+            e1_ (e1), e2_ (e2) {}
+        BOOST_UBLAS_INLINE
+        R operator () (std::size_t k) const {
+            return traits1::element (e1_, k) * traits2::element (e2_, k);
+        }
+    private:
+        const V1 &e1_;
+        const V2 &e2_;
+    };
+
+    template<class M1, class M2, class M3>
+    BOOST_UBLAS_INLINE
+    M3 &fixed_prod (const M1 &e1, const M2 &e2, M3 &m, matrix_tag) {
+        typedef fixed_matrix_traits<M1> traits1;
+        typedef fixed_matrix_traits<M2> traits2;
+        typedef fixed_matrix_traits<M3> traits3;
+        typedef typename M3::value_type value_type;
+        BOOST_STATIC_ASSERT (traits1::is_fixed && traits2::is_fixed && traits3::is_fixed);
+        BOOST_STATIC_ASSERT (traits1::size2 == traits2::size1);
+        BOOST_STATIC_ASSERT (traits1::size1 == traits3::size1 && traits2::size2 == traits3::size2);
+        BOOST_UBLAS_CHECK (traits1::has_fixed_size (e1) && traits2::has_fixed_size (e2) &&
+                           traits3::has_fixed_size (m), bad_size ());
+
+        for (std::size_t i = 0; i < traits3::size1; ++ i)
+            for (std::size_t j = 0; j < traits3::size2; ++ j)
+                traits3::element (m, i, j) = fixed_sum<traits1::size2>::template apply<value_type> (
+                    fixed_matrix_matrix_term<M1, M2, value_type> (e1, e2, i, j));
+        return m;
+    }
+
+    template<class M1, class V2, class V3>
+    BOOST_UBLAS_INLINE
+    V3 &fixed_prod (const M1 &e1, const V2 &e2, V3 &v, vector_tag) {
+        typedef fixed_matrix_traits<M1> traits1;
+        typedef fixed_vector_traits<V2> traits2;
+        typedef fixed_vector_traits<V3> traits3;
+        typedef typename V3::value_type value_type;
+        BOOST_STATIC_ASSERT (traits1::is_fixed && traits2::is_fixed && traits3::is_fixed);
+        BOOST_STATIC_ASSERT (traits1::size2 == traits2::size && traits1::size1 == traits3::size);
+        BOOST_UBLAS_CHECK (traits1::has_fixed_size (e1) && traits2::has_fixed_size (e2) &&
+                           traits3::has_fixed_size (v), bad_size ());
+
+        for (std::size_t i = 0; i < traits3::size; ++ i)
+            traits3::element (v, i) = fixed_sum<traits1::size2>::template apply<value_type> (
+                fixed_matrix_vector_term<M1, V2, value_type> (e1, e2, i));
+        return v;
+    }
+
+    // Triangular solves with a single right hand side, L x = b or U x = b
+    template<std::size_t N, bool Unit, class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_lower_solve (const M &m, V &v) {
+        typedef fixed_matrix_traits<M> mtraits;
+        typedef fixed_vector_traits<V> vtraits;
+        typedef typename V::value_type value_type;
+
+        for (std::size_t i = 0; i < N; ++ i) {
+            value_type t = vtraits::element (v, i);
+            for (std::size_t k = 0; k < i; ++ k)
+                t -= mtraits::element (m, i, k) * vtraits::element (v, k);
+            if (! Unit) {
+                BOOST_UBLAS_CHECK (mtraits::element (m, i, i) != value_type/*zero*/(), singular ());
+                t /= mtraits::element (m, i, i);
+            }
+            vtraits::element (v, i) = t;
+        }
+    }
+    template<std::size_t N, bool Unit, class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_upper_solve (const M &m, V &v) {
+        typedef fixed_matrix_traits<M> mtraits;
+        typedef fixed_vector_traits<V> vtraits;
+        typedef typename V::value_type value_type;
+
+        for (std::size_t n = N; n > 0; -- n) {
+            const std::size_t i = n - 1;
+            value_type t = vtraits::element (v, i);
+            for (std::size_t k = i + 1; k < N; ++ k)
+                t -= mtraits::element (m, i, k) * vtraits::element (v, k);
+            if (! Unit) {
+                BOOST_UBLAS_CHECK (mtraits::element (m, i, i) != value_type/*zero*/(), singular ());
+                t /= mtraits::element (m, i, i);
+            }
+            vtraits::element (v, i) = t;
+        }
+    }
+
+    // LU factorization with partial pivoting, same pivot choice as lu_factorize (m, pm)
+    template<std::size_t N, class M, class PM>
+    BOOST_UBLAS_INLINE
+    std::size_t fixed_lu_factorize (M &m, PM &pm) {
+        typedef fixed_matrix_traits<M> traits;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        std::size_t singular = 0;
+        for (std::size_t i = 0; i < N; ++ i) {
+            std::size_t i_norm_inf = i;
+            real_type t = real_type ();
+            for (std::size_t k = i; k < N; ++ k) {
+                real_type u (type_traits<value_type>::norm_inf (traits::element (m, k, i)));
+                if (u > t) {
+                    i_norm_inf = k;
+                    t = u;
+                }
+            }
+            if (traits::element (m, i_norm_inf, i) != value_type/*zero*/()) {
+                if (i_norm_inf != i) {
+                    pm (i) = i_norm_inf;
+                    for (std::size_t j = 0; j < N; ++ j)
+                        std::swap (traits::element (m, i, j), traits::element (m, i_norm_inf, j));
+                } else {
+                    BOOST_UBLAS_CHECK (pm (i) == i_norm_inf, external_logic ());
+                }
+                value_type m_inv = value_type (1) / traits::element (m, i, i);
+                for (std::size_t k = i + 1; k < N; ++ k)
+                    traits::element (m, k, i) *= m_inv;
+            } else if (singular == 0) {
+                singular = i + 1;
+            }
+            for (std::size_t k = i + 1; k < N; ++ k) {
+                const value_type mki = traits::element (m, k, i);
+                for (std::size_t j = i + 1; j < N; ++ j)
+                    traits::element (m, k, j) -= mki * traits::element (m, i, j);
+            }
+        }
+        return singular;
+    }
+
+    template<std::size_t N, class PM, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_swap_rows (const PM &pm, V &v) {
+        typedef fixed_vector_traits<V> traits;
+
+        for (std::size_t i = 0; i < N; ++ i) {
+            if (i != pm (i))
+                std::swap (traits::element (v, i), traits::element (v, pm (i)));
+        }
+    }
+
+}
+
+    /** \brief Computes <tt>R = A B</tt> or <tt>r = A x</tt> for matrices and vectors of compile time size.
+     *
+     * The result must not alias the arguments.
+     * \param e1 the fixed size matrix \c A
+     * \param e2 the fixed size matrix \c B or vector \c x
+     * \param r the fixed size result
+     */
+    template<class E1, class E2, class R>
+    BOOST_UBLAS_INLINE
+    R &fixed_prod (const E1 &e1, const E2 &e2, R &r) {
+        return detail::fixed_prod (e1, e2, r, typename E2::type_category ());
+    }
+
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T1, std::size_t M, std::size_t K, class L1, class A1, class T2, std::size_t N, class L2, class A2>
+    BOOST_UBLAS_INLINE
+    fixed_matrix<typename promote_traits<T1, T2>::promote_type, M, N, L1>
+    fixed_prod (const fixed_matrix<T1, M, K, L1, A1> &e1, const fixed_matrix<T2, K, N, L2, A2> &e2) {
+        fixed_matrix<typename promote_traits<T1, T2>::promote_type, M, N, L1> m;
+        return fixed_prod (e1, e2, m);
+    }
+    template<class T1, std::size_t M, std::size_t N, class L1, class A1, class T2, class A2>
+    BOOST_UBLAS_INLINE
+    fixed_vector<typename promote_traits<T1, T2>::promote_type, M>
+    fixed_prod (const fixed_matrix<T1, M, N, L1, A1> &e1, const fixed_vector<T2, N, A2> &e2) {
+        fixed_vector<typename promote_traits<T1, T2>::promote_type, M> v;
+        return fixed_prod (e1, e2, v);
+    }
+#endif
+
+    /** \brief Inner product of two vectors of compile time size.
+     */
+    template<class V1, class V2>
+    BOOST_UBLAS_INLINE
+    typename promote_traits<typename V1::value_type, typename V2::value_type>::promote_type
+    fixed_inner_prod (const V1 &e1, const V2 &e2) {
+        typedef detail::fixed_vector_traits<V1> traits1;
+        typedef detail::fixed_vector_traits<V2> traits2;
+        typedef typename promote_traits<typename V1::value_type, typename V2::value_type>::promote_type value_type;
+        BOOST_STATIC_ASSERT (traits1::is_fixed && traits2::is_fixed);
+        BOOST_STATIC_ASSERT (traits1::size == traits2::size);
+        BOOST_UBLAS_CHECK (traits1::has_fixed_size (e1) && traits2::has_fixed_size (e2), bad_size ());
+
+        return detail::fixed_sum<traits1::size>::template apply<value_type> (
+            detail::fixed_vector_vector_term<V1, V2, value_type> (e1, e2));
+    }
+
+    /** \brief LU factorization with partial pivoting of a square matrix of compile time size.
+     *
+     * Produces the same factors and pivots as <tt>lu_factorize (m, pm)</tt>.
+     * \return 0 if \c m is not singular, otherwise one plus the index of the first zero pivot
+     */
+    template<class M, class PM>
+    BOOST_UBLAS_INLINE
+    typename M::size_type fixed_lu_factorize (M &m, PM &pm) {
+        typedef detail::fixed_matrix_traits<M> traits;
+        BOOST_STATIC_ASSERT (traits::is_fixed && traits::size1 == traits::size2);
+        BOOST_UBLAS_CHECK (traits::has_fixed_size (m), bad_size ());
+        BOOST_UBLAS_CHECK (pm.size () == traits::size1, bad_size ());
+
+        return detail::fixed_lu_factorize<traits::size1> (m, pm);
+    }
+
+    /** \brief Solves <tt>A x = b</tt> in place from the factors computed by \c fixed_lu_factorize.
+     */
+    template<class M, class PM, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_lu_substitute (const M &m, const PM &pm, V &v) {
+        typedef detail::fixed_matrix_traits<M> mtraits;
+        typedef detail::fixed_vector_traits<V> vtraits;
+        BOOST_STATIC_ASSERT (mtraits::is_fixed && vtraits::is_fixed);
+        BOOST_STATIC_ASSERT (mtraits::size1 == mtraits::size2 && mtraits::size2 == vtraits::size);
+        BOOST_UBLAS_CHECK (mtraits::has_fixed_size (m) && vtraits::has_fixed_size (v), bad_size ());
+
+        detail::fixed_swap_rows<vtraits::size> (pm, v);
+        detail::fixed_lower_solve<vtraits::size, true> (m, v);
+        detail::fixed_upper_solve<vtraits::size, false> (m, v);
+    }
+
+    /** \brief Solves a triangular system <tt>A x = b</tt> of compile time size in place.
+     */
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_inplace_solve (const M &m, V &v, lower_tag) {
+        typedef detail::fixed_matrix_traits<M> mtraits;
+        typedef detail::fixed_vector_traits<V> vtraits;
+        BOOST_STATIC_ASSERT (mtraits::is_fixed && vtraits::is_fixed);
+        BOOST_STATIC_ASSERT (mtraits::size1 == mtraits::size2 && mtraits::size2 == vtraits::size);
+        BOOST_UBLAS_CHECK (mtraits::has_fixed_size (m) && vtraits::has_fixed_size (v), bad_size ());
+        detail::fixed_lower_solve<vtraits::size, false> (m, v);
+    }
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_inplace_solve (const M &m, V &v, unit_lower_tag) {
+        typedef detail::fixed_matrix_traits<M> mtraits;
+        typedef detail::fixed_vector_traits<V> vtraits;
+        BOOST_STATIC_ASSERT (mtraits::is_fixed && vtraits::is_fixed);
+        BOOST_STATIC_ASSERT (mtraits::size1 == mtraits::size2 && mtraits::size2 == vtraits::size);
+        BOOST_UBLAS_CHECK (mtraits::has_fixed_size (m) && vtraits::has_fixed_size (v), bad_size ());
+        detail::fixed_lower_solve<vtraits::size, true> (m, v);
+    }
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_inplace_solve (const M &m, V &v, upper_tag) {
+        typedef detail::fixed_matrix_traits<M> mtraits;
+        typedef detail::fixed_vector_traits<V> vtraits;
+        BOOST_STATIC_ASSERT (mtraits::is_fixed && vtraits::is_fixed);
+        BOOST_STATIC_ASSERT (mtraits::size1 == mtraits::size2 && mtraits::size2 == vtraits::size);
+        BOOST_UBLAS_CHECK (mtraits::has_fixed_size (m) && vtraits::has_fixed_size (v), bad_size ());
+        detail::fixed_upper_solve<vtraits::size, false> (m, v);
+    }
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_inplace_solve (const M &m, V &v, unit_upper_tag) {
+        typedef detail::fixed_matrix_traits<M> mtraits;
+        typedef detail::fixed_vector_traits<V> vtraits;
+        BOOST_STATIC_ASSERT (mtraits::is_fixed && vtraits::is_fixed);
+        BOOST_STATIC_ASSERT (mtraits::size1 == mtraits::size2 && mtraits::size2 == vtraits::size);
+        BOOST_UBLAS_CHECK (mtraits::has_fixed_size (m) && vtraits::has_fixed_size (v), bad_size ());
+        detail::fixed_upper_solve<vtraits::size, true> (m, v);
+    }
+
+    /** \brief Cholesky factorization <tt>A = L L<sup>H</sup></tt> of a hermitian positive definite matrix of compile time size.
+     *
+     * Only the lower triangle of \c m is referenced and it is overwritten by \c L.
+     * The strict upper triangle is left untouched.
+     * \return 0 on success, otherwise one plus the index of the first non positive pivot
+     */
+    template<class M>
+    BOOST_UBLAS_INLINE
+    typename M::size_type fixed_cholesky_factorize (M &m) {
+        typedef detail::fixed_matrix_traits<M> traits;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+        BOOST_STATIC_ASSERT (traits::is_fixed && traits::size1 == traits::size2);
+        BOOST_UBLAS_CHECK (traits::has_fixed_size (m), bad_size ());
+        const std::size_t size = traits::size1;
+
+        for (std::size_t j = 0; j < size; ++ j) {
+            real_type d = type_traits<value_type>::real (traits::element (m, j, j));
+            for (std::size_t k = 0; k < j; ++ k) {
+                const value_type ljk = traits::element (m, j, k);
+                d -= type_traits<value_type>::real (ljk * type_traits<value_type>::conj (ljk));
+            }
+            if (! (d > real_type/*zero*/()))
+                return j + 1;
+            const real_type ljj = type_traits<real_type>::type_sqrt (d);
+            traits::element (m, j, j) = value_type (ljj);
+            for (std::size_t i = j + 1; i < size; ++ i) {
+                value_type t = traits::element (m, i, j);
+                for (std::size_t k = 0; k < j; ++ k)
+                    t -= traits::element (m, i, k) * type_traits<value_type>::conj (traits::element (m, j, k));
+                traits::element (m, i, j) = t / ljj;
+            }
+        }
+        return 0;
+    }
+
+    /** \brief Solves <tt>A x = b</tt> in place from the factor computed by \c fixed_cholesky_factorize.
+     */
+    template<class M, class V>
+    BOOST_UBLAS_INLINE
+    void fixed_cholesky_substitute (const M &m, V &v) {
+        typedef detail::fixed_matrix_traits<M> mtraits;
+        typedef detail::fixed_vector_traits<V> vtraits;
+        typedef typename V::value_type value_type;
+        BOOST_STATIC_ASSERT (mtraits::is_fixed && vtraits::is_fixed);
+        BOOST_STATIC_ASSERT (mtraits::size1 == mtraits::size2 && mtraits::size2 == vtraits::size);
+        BOOST_UBLAS_CHECK (mtraits::has_fixed_size (m) && vtraits::has_fixed_size (v), bad_size ());
+        const std::size_t size = vtraits::size;
+
+        detail::fixed_lower_solve<vtraits::size, false> (m, v);
+        // L^H x = y, L^H (i, k) = conj (L (k, i))
+        for (std::size_t n = size; n > 0; -- n) {
+            const std::size_t i = n - 1;
+            value_type t = vtraits::element (v, i);
+            for (std::size_t k = i + 1; k < size; ++ k)
+                t -= type_traits<value_type>::conj (mtraits::element (m, k, i)) * vtraits::element (v, k);
+            vtraits::element (v, i) = t / mtraits::element (m, i, i);
+        }
+    }
+
+    /** \brief Determinant of a square matrix of compile time size.
+     *
+     * Sizes up to 3 use the explicit formulas, larger sizes a pivoted LU factorization of a copy.
+     */
+    template<class M>
+    BOOST_UBLAS_INLINE
+    typename M::value_type fixed_determinant (const M &m) {
+        typedef detail::fixed_matrix_traits<M> traits;
+        typedef typename M::value_type value_type;
+        BOOST_STATIC_ASSERT (traits::is_fixed && traits::size1 == traits::size2);
+        BOOST_UBLAS_CHECK (traits::has_fixed_size (m), bad_size ());
+        const std::size_t size = traits::size1;
+
+        if (size == 1)
+            return traits::element (m, 0, 0);
+        if (size == 2)
+            return traits::element (m, 0, 0) * traits::element (m, 1, 1) -
+                   traits::element (m, 0, 1) * traits::element (m, 1, 0);
+        if (size == 3)
+            return traits::element (m, 0, 0) * (traits::element (m, 1, 1) * traits::element (m, 2, 2 % size) -
+                                                 traits::element (m, 1, 2 % size) * traits::element (m, 2, 1)) -
+                   traits::element (m, 0, 1) * (traits::element (m, 1, 0) * traits::element (m, 2, 2 % size) -
+                                                 traits::element (m, 1, 2 % size) * traits::element (m, 2, 0)) +
+                   traits::element (m, 0, 2 % size) * (traits::element (m, 1, 0) * traits::element (m, 2, 1) -
+                                                        traits::element (m, 1, 1) * traits::element (m, 2, 0));
+        M lu (m);
+        permutation_matrix<std::size_t, bounded_array<std::size_t, traits::size1> > pm (size);
+        if (detail::fixed_lu_factorize<traits::size1> (lu, pm) != 0)
+            return value_type/*zero*/();
+        value_type det (1);
+        for (std::size_t i = 0; i < size; ++ i) {
+            det *= traits::element (lu, i, i);
+            if (pm (i) != i)
+                det = -det;
+        }
+        return det;
+    }
+
+    /** \brief Inverse of a square matrix of compile time size.
+     *
+     * Sizes up to 3 use the adjugate, larger sizes a pivoted LU factorization of a copy.
+     * The result must not alias the argument.
+     * \return 0 if \c m is not singular, a non zero value otherwise (\c inverse is then unspecified)
+     */
+    template<class M1, class M2>
+    BOOST_UBLAS_INLINE
+    typename M1::size_type fixed_invert (const M1 &m, M2 &inverse) {
+        typedef detail::fixed_matrix_traits<M1> traits1;
+        typedef detail::fixed_matrix_traits<M2> traits2;
+        typedef typename M2::value_type value_type;
+        BOOST_STATIC_ASSERT (traits1::is_fixed && traits2::is_fixed);
+        BOOST_STATIC_ASSERT (traits1::size1 == traits1::size2 &&
+                             traits2::size1 == traits1::size1 && traits2::size2 == traits1::size2);
+        BOOST_UBLAS_CHECK (traits1::has_fixed_size (m) && traits2::has_fixed_size (inverse), bad_size ());
+        const std::size_t size = traits1::size1;
+
+        if (size <= 3) {
+            const value_type det = fixed_determinant (m);
+            if (det == value_type/*zero*/())
+                return 1;
+            const value_type det_inv = value_type (1) / det;
+            if (size == 1) {
+                traits2::element (inverse, 0, 0) = det_inv;
+            } else if (size == 2) {
+                traits2::element (inverse, 0, 0) = traits1::element (m, 1, 1) * det_inv;
+                traits2::element (inverse, 0, 1) = - traits1::element (m, 0, 1) * det_inv;
+                traits2::element (inverse, 1, 0) = - traits1::element (m, 1, 0) * det_inv;
+                traits2::element (inverse, 1, 1) = traits1::element (m, 0, 0) * det_inv;
+            } else {
+                // Cofactors, indices taken modulo 3
+                for (std::size_t i = 0; i < size; ++ i) {
+                    const std::size_t i1 = (i + 1) % size, i2 = (i + 2) % size;
+                    for (std::size_t j = 0; j < size; ++ j) {
+                        const std::size_t j1 = (j + 1) % size, j2 = (j + 2) % size;
+                        traits2::element (inverse, j, i) =
+                            (traits1::element (m, i1, j1) * traits1::element (m, i2, j2) -
+                             traits1::element (m, i1, j2) * traits1::element (m, i2, j1)) * det_inv;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        M1 lu (m);
+        permutation_matrix<std::size_t, bounded_array<std::size_t, traits1::size1> > pm (size);
+        typename M1::size_type singular = detail::fixed_lu_factorize<traits1::size1> (lu, pm);
+        if (singular != 0)
+            return singular;
+        bounded_vector<value_type, traits1::size1> e (size);
+        for (std::size_t j = 0; j < size; ++ j) {
+            for (std::size_t i = 0; i < size; ++ i)
+                e (i) = value_type (i == j ? 1 : 0);
+            detail::fixed_swap_rows<traits1::size1> (pm, e);
+            detail::fixed_lower_solve<traits1::size1, true> (lu, e);
+            detail::fixed_upper_solve<traits1::size1, false> (lu, e);
+            for (std::size_t i = 0; i < size; ++ i)
+                traits2::element (inverse, i, j) = e (i);
+        }
+        return 0;
+    }
+
+    // Route the generic LU interface to the fixed kernels
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T, std::size_t N, class L, class A, class PM>
+    BOOST_UBLAS_INLINE
+    typename fixed_matrix<T, N, N, L, A>::size_type lu_factorize (fixed_matrix<T, N, N, L, A> &m, PM &pm) {
+        return fixed_lu_factorize (m, pm);
+    }
+    template<class T1, std::size_t N, class L, class A1, class PMT, class PMA, class T2, class A2>
+    BOOST_UBLAS_INLINE
+    void lu_substitute (const fixed_matrix<T1, N, N, L, A1> &m, const permutation_matrix<PMT, PMA> &pm,
+                        fixed_vector<T2, N, A2> &v) {
+        fixed_lu_substitute (m, pm, v);
+    }
+#endif
+    template<class T, std::size_t N, class L, class PM>
+    BOOST_UBLAS_INLINE
+    typename bounded_matrix<T, N, N, L>::size_type lu_factorize (bounded_matrix<T, N, N, L> &m, PM &pm) {
+        if (detail::fixed_matrix_traits<bounded_matrix<T, N, N, L> >::has_fixed_size (m))
+            return fixed_lu_factorize (m, pm);
+        return lu_factorize<bounded_matrix<T, N, N, L>, PM> (m, pm);
+    }
+    template<class T1, std::size_t N, class L, class PMT, class PMA, class T2>
+    BOOST_UBLAS_INLINE
+    void lu_substitute (const bounded_matrix<T1, N, N, L> &m, const permutation_matrix<PMT, PMA> &pm,
+                        bounded_vector<T2, N> &v) {
+        if (detail::fixed_matrix_traits<bounded_matrix<T1, N, N, L> >::has_fixed_size (m) &&
+            detail::fixed_vector_traits<bounded_vector<T2, N> >::has_fixed_size (v)) {
+            fixed_lu_substitute (m, pm, v);
+        } else {
+            swap_rows (pm, v);
+            lu_substitute (m, v);
+        }
+    }
+    template<class T, std::size_t N, class PM>
+    BOOST_UBLAS_INLINE
+    typename c_matrix<T, N, N>::size_type lu_factorize (c_matrix<T, N, N> &m, PM &pm) {
+        if (detail::fixed_matrix_traits<c_matrix<T, N, N> >::has_fixed_size (m))
+            return fixed_lu_factorize (m, pm);
+        return lu_factorize<c_matrix<T, N, N>, PM> (m, pm);
+    }
+    template<class T1, std::size_t N, class PMT, class PMA, class T2>
+    BOOST_UBLAS_INLINE
+    void lu_substitute (const c_matrix<T1, N, N> &m, const permutation_matrix<PMT, PMA> &pm,
+                        c_vector<T2, N> &v) {
+        if (detail::fixed_matrix_traits<c_matrix<T1, N, N> >::has_fixed_size (m) &&
+            detail::fixed_vector_traits<c_vector<T2, N> >::has_fixed_size (v)) {
+            fixed_lu_substitute (m, pm, v);
+        } else {
+            swap_rows (pm, v);
+            lu_substitute (m, v);
+        }
+    }
+
+
+namespace detail {
+
+    // The fixed kernels when the operands have their maximum sizes, the generic code
+    // through references otherwise
+    template<class R, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    R routed_prod (const E1 &e1, const E2 &e2, matrix_tag) {
+        if (fixed_matrix_traits<E1>::has_fixed_size (e1) && fixed_matrix_traits<E2>::has_fixed_size (e2)) {
+            R r;
+            return fixed_prod (e1, e2, r, matrix_tag ());
+        }
+        return R (prod (matrix_reference<const E1> (e1), matrix_reference<const E2> (e2)));
+    }
+    template<class R, class E1, class E2>
+    BOOST_UBLAS_INLINE
+    R routed_prod (const E1 &e1, const E2 &e2, vector_tag) {
+        if (fixed_matrix_traits<E1>::has_fixed_size (e1) && fixed_vector_traits<E2>::has_fixed_size (e2)) {
+            R r;
+            return fixed_prod (e1, e2, r, vector_tag ());
+        }
+        return R (prod (matrix_reference<const E1> (e1), vector_reference<const E2> (e2)));
+    }
+
+    template<class E1, class E2>
+    BOOST_UBLAS_INLINE
+    typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type
+    routed_inner_prod (const E1 &e1, const E2 &e2) {
+        if (fixed_vector_traits<E1>::has_fixed_size (e1) && fixed_vector_traits<E2>::has_fixed_size (e2))
+            return fixed_inner_prod (e1, e2);
+        return inner_prod (vector_reference<const E1> (e1), vector_reference<const E2> (e2));
+    }
+
+    template<class E1, class E2, class TRI>
+    BOOST_UBLAS_INLINE
+    void routed_inplace_solve (const E1 &e1, E2 &e2, TRI) {
+        if (fixed_matrix_traits<E1>::has_fixed_size (e1) && fixed_vector_traits<E2>::has_fixed_size (e2)) {
+            fixed_inplace_solve (e1, e2, TRI ());
+        } else {
+            vector_reference<E2> v (e2);
+            inplace_solve (matrix_reference<const E1> (e1), v, TRI ());
+        }
+    }
+
+}
+
+    // Route prod (m, m), prod (m, v), inner_prod (v, v) and inplace_solve (m, v, tag)
+    // on these containers to the fixed kernels. The products are evaluated into a
+    // container of the result size instead of returning an expression.
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    template<class T1, std::size_t M, std::size_t K, class L1, class A1, class T2, std::size_t N, class L2, class A2>
+    BOOST_UBLAS_INLINE
+    fixed_matrix<typename promote_traits<T1, T2>::promote_type, M, N, L1>
+    prod (const fixed_matrix<T1, M, K, L1, A1> &e1, const fixed_matrix<T2, K, N, L2, A2> &e2) {
+        return fixed_prod (e1, e2);
+    }
+    template<class T1, std::size_t M, std::size_t N, class L1, class A1, class T2, class A2>
+    BOOST_UBLAS_INLINE
+    fixed_vector<typename promote_traits<T1, T2>::promote_type, M>
+    prod (const fixed_matrix<T1, M, N, L1, A1> &e1, const fixed_vector<T2, N, A2> &e2) {
+        return fixed_prod (e1, e2);
+    }
+    template<class T1, std::size_t N, class A1, class T2, class A2>
+    BOOST_UBLAS_INLINE
+    typename promote_traits<T1, T2>::promote_type
+    inner_prod (const fixed_vector<T1, N, A1> &e1, const fixed_vector<T2, N, A2> &e2) {
+        return fixed_inner_prod (e1, e2);
+    }
+    template<class T1, std::size_t N, class L, class A1, class T2, class A2, class TRI>
+    BOOST_UBLAS_INLINE
+    void inplace_solve (const fixed_matrix<T1, N, N, L, A1> &e1, fixed_vector<T2, N, A2> &e2, TRI) {
+        fixed_inplace_solve (e1, e2, TRI ());
+    }
+#endif
+    template<class T1, std::size_t M, std::size_t K, class L1, class T2, std::size_t N, class L2>
+    BOOST_UBLAS_INLINE
+    bounded_matrix<typename promote_traits<T1, T2>::promote_type, M, N, L1>
+    prod (const bounded_matrix<T1, M, K, L1> &e1, const bounded_matrix<T2, K, N, L2> &e2) {
+        typedef bounded_matrix<typename promote_traits<T1, T2>::promote_type, M, N, L1> result_type;
+        return detail::routed_prod<result_type> (e1, e2, matrix_tag ());
+    }
+    template<class T1, std::size_t M, std::size_t N, class L1, class T2>
+    BOOST_UBLAS_INLINE
+    bounded_vector<typename promote_traits<T1, T2>::promote_type, M>
+    prod (const bounded_matrix<T1, M, N, L1> &e1, const bounded_vector<T2, N> &e2) {
+        typedef bounded_vector<typename promote_traits<T1, T2>::promote_type, M> result_type;
+        return detail::routed_prod<result_type> (e1, e2, vector_tag ());
+    }
+    template<class T1, std::size_t N, class T2>
+    BOOST_UBLAS_INLINE
+    typename promote_traits<T1, T2>::promote_type
+    inner_prod (const bounded_vector<T1, N> &e1, const bounded_vector<T2, N> &e2) {
+        return detail::routed_inner_prod (e1, e2);
+    }
+    template<class T1, std::size_t N, class L, class T2, class TRI>
+    BOOST_UBLAS_INLINE
+    void inplace_solve (const bounded_matrix<T1, N, N, L> &e1, bounded_vector<T2, N> &e2, TRI) {
+        detail::routed_inplace_solve (e1, e2, TRI ());
+    }
+    template<class T1, std::size_t M, std::size_t K, class T2, std::size_t N>
+    BOOST_UBLAS_INLINE
+    c_matrix<typename promote_traits<T1, T2>::promote_type, M, N>
+    prod (const c_matrix<T1, M, K> &e1, const c_matrix<T2, K, N> &e2) {
+        typedef c_matrix<typename promote_traits<T1, T2>::promote_type, M, N> result_type;
+        return detail::routed_prod<result_type> (e1, e2, matrix_tag ());
+    }
+    template<class T1, std::size_t M, std::size_t N, class T2>
+    BOOST_UBLAS_INLINE
+    c_vector<typename promote_traits<T1, T2>::promote_type, M>
+    prod (const c_matrix<T1, M, N> &e1, const c_vector<T2, N> &e2) {
+        typedef c_vector<typename promote_traits<T1, T2>::promote_type, M> result_type;
+        return detail::routed_prod<result_type> (e1, e2, vector_tag ());
+    }
+    template<class T1, std::size_t N, class T2>
+    BOOST_UBLAS_INLINE
+    typename promote_traits<T1, T2>::promote_type
+    inner_prod (const c_vector<T1, N> &e1, const c_vector<T2, N> &e2) {
+        return detail::routed_inner_prod (e1, e2);
+    }
+    template<class T1, std::size_t N, class T2, class TRI>
+    BOOST_UBLAS_INLINE
+    void inplace_solve (const c_matrix<T1, N, N> &e1, c_vector<T2, N> &e2, TRI) {
+        detail::routed_inplace_solve (e1, e2, TRI ());
+    }
+
+}}}
+
+#endif
@@ -27,6 +27,7 @@ namespace boost { namespace numeric { namespace ublas {
                  const matrix_expression<E2> &e2,
                  M &m, TRI,
                  row_major_tag) {
+        BOOST_UBLAS_PROFILE_SCOPE (sparse_prod_kernel, 0, 0, 0);
         typedef M matrix_type;
         typedef TRI triangular_restriction;
         typedef const E1 expression1_type;
@@ -57,6 +58,7 @@ namespace boost { namespace numeric { namespace ublas {
                 while (itr != itr_end) {
                     size_type j (itr.index ());
                     temporary (j) += *it2 * *itr;
+                    BOOST_UBLAS_PROFILE_ADD (0, 2, 2 * sizeof (value_type));
                     jb = (std::min) (jb, j);
                     je = (std::max) (je, j);
                     ++ itr;
@@ -69,8 +71,10 @@ namespace boost { namespace numeric { namespace ublas {
                     // m.push_back (it1.index1 (), j, temporary (j));
                     // FIXME What to do with adaptors?
                     // m.insert (it1.index1 (), j, temporary (j));
-                    if (triangular_restriction::other (it1.index1 (), j))
+                    if (triangular_restriction::other (it1.index1 (), j)) {
                         m (it1.index1 (), j) = temporary (j);
+                        BOOST_UBLAS_PROFILE_ADD (1, 0, sizeof (value_type));
+                    }
                     temporary (j) = value_type/*zero*/();
                 }
             }
@@ -86,6 +90,7 @@ namespace boost { namespace numeric { namespace ublas {
                  const matrix_expression<E2> &e2,
                  M &m, TRI,
                  column_major_tag) {
+        BOOST_UBLAS_PROFILE_SCOPE (sparse_prod_kernel, 0, 0, 0);
         typedef M matrix_type;
         typedef TRI triangular_restriction;
         typedef const E1 expression1_type;
@@ -116,6 +121,7 @@ namespace boost { namespace numeric { namespace ublas {
                 while (itc != itc_end) {
                     size_type i (itc.index ());
                     temporary (i) += *it1 * *itc;
+                    BOOST_UBLAS_PROFILE_ADD (0, 2, 2 * sizeof (value_type));
                     ib = (std::min) (ib, i);
                     ie = (std::max) (ie, i);
                     ++ itc;
@@ -128,8 +134,10 @@ namespace boost { namespace numeric { namespace ublas {
                     // m.push_back (i, it2.index2 (), temporary (i));
                     // FIXME What to do with adaptors?
                     // m.insert (i, it2.index2 (), temporary (i));
-                    if (triangular_restriction::other (i, it2.index2 ()))
+                    if (triangular_restriction::other (i, it2.index2 ())) {
                         m (i, it2.index2 ()) = temporary (i);
+                        BOOST_UBLAS_PROFILE_ADD (1, 0, sizeof (value_type));
+                    }
                     temporary (i) = value_type/*zero*/();
                 }
             }
@@ -0,0 +1,132 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_OPERATION_TRANSPOSE_
+#define _BOOST_UBLAS_OPERATION_TRANSPOSE_
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <vector>
+
+/** \file operation_transpose.hpp
+ *  \brief In place transpose of a \c matrix and the in place change of its
+ *  storage orientation.
+ *
+ *  Assignments of \c trans (A) to a dense matrix of the orientation of \c A
+ *  use a blocked kernel through \c matrix_assign already; the functions of
+ *  this header permute the storage of a \c matrix without a second copy of it.
+ */
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Transposes the size x size array d in place, one pair of tiles at a time
+    template<class I>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void inplace_transpose_square (I d, std::size_t size) {
+        typedef std::ptrdiff_t difference_type;
+        const std::size_t block (BOOST_UBLAS_TRANSPOSE_BLOCK);
+        const std::size_t blocks ((size + block - 1) / block);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (size * size / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type ib = 0; ib < difference_type (blocks); ++ ib) {
+            const std::size_t i0 (ib * block), i1 ((std::min) (i0 + block, size));
+            for (std::size_t j0 = i0; j0 < size; j0 += block) {
+                const std::size_t j1 ((std::min) (j0 + block, size));
+                for (std::size_t i = i0; i < i1; ++ i)
+                    for (std::size_t j = (j0 == i0 ? i + 1 : j0); j < j1; ++ j)
+                        std::swap (d [i * size + j], d [j * size + i]);
+            }
+        }
+    }
+
+    // Transposes the rows x cols row major array d in place into a cols x rows row
+    // major array. The element at p moves to (p mod cols) rows + p / cols; the cycles
+    // of this permutation are found first, then followed independently.
+    template<class I>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void inplace_transpose (I d, std::size_t rows, std::size_t cols) {
+        typedef std::ptrdiff_t difference_type;
+        if (rows == cols) {
+            inplace_transpose_square (d, rows);
+            return;
+        }
+        const std::size_t size (rows * cols);
+        if (rows <= 1 || cols <= 1)
+            return;
+        std::vector<bool> visited (size, false);
+        std::vector<std::size_t> leaders;
+        // The first and the last element stay in place
+        for (std::size_t s = 1; s + 1 < size; ++ s) {
+            if (visited [s])
+                continue;
+            std::size_t p (s);
+            do {
+                visited [p] = true;
+                p = (p % cols) * rows + p / cols;
+            } while (p != s);
+            leaders.push_back (s);
+        }
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic, 16) if (size >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type c = 0; c < difference_type (leaders.size ()); ++ c) {
+            const std::size_t s (leaders [c]);
+            typename std::iterator_traits<I>::value_type t (d [s]);
+            std::size_t p (s);
+            do {
+                p = (p % cols) * rows + p / cols;
+                std::swap (t, d [p]);
+            } while (p != s);
+        }
+    }
+
+}
+
+    /** \brief Transposes the matrix \c m in place: afterwards \c m holds \c trans (m),
+     *  with \c size1 and \c size2 exchanged, in the same storage orientation.
+     *
+     *  Square matrices are transposed tile by tile, rectangular ones by following
+     *  the cycles of the permutation of their storage, with one bit of workspace
+     *  per element. Both are threaded with \c BOOST_UBLAS_USE_OPENMP.
+     */
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    void inplace_transpose (matrix<T, L, A> &m) {
+        typedef typename matrix<T, L, A>::size_type size_type;
+        const size_type size1 (m.size1 ()), size2 (m.size2 ());
+        if (boost::is_same<typename L::orientation_category, row_major_tag>::value)
+            detail::inplace_transpose (m.data ().begin (), size1, size2);
+        else
+            detail::inplace_transpose (m.data ().begin (), size2, size1);
+        // The storage size is unchanged, so resize does not touch the elements
+        m.resize (size2, size1, false);
+    }
+
+    /** \brief Moves the elements of \c m into \c r, which has the other storage
+     *  orientation, without a second copy of them; \c m is left empty.
+     *
+     *  Afterwards \c r equals the former \c m. The storage of \c m is permuted in
+     *  place, see \c inplace_transpose, and then handed over to \c r.
+     */
+    template<class T, class L, class A>
+    BOOST_UBLAS_INLINE
+    void inplace_change_orientation (matrix<T, L, A> &m, matrix<T, typename L::transposed_layout, A> &r) {
+        typedef typename matrix<T, L, A>::size_type size_type;
+        const size_type size1 (m.size1 ()), size2 (m.size2 ());
+        if (boost::is_same<typename L::orientation_category, row_major_tag>::value)
+            detail::inplace_transpose (m.data ().begin (), size1, size2);
+        else
+            detail::inplace_transpose (m.data ().begin (), size2, size1);
+        r.data ().swap (m.data ());
+        r.resize (size1, size2, false);
+        m.resize (0, 0, false);
+    }
+
+}}}
+
+#endif
@@ -0,0 +1,333 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_PROFILE_
+#define _BOOST_UBLAS_PROFILE_
+
+#include <boost/config.hpp>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+
+// Counters of the kernels of uBLAS: calls, elements, estimated floating point
+// operations and memory traffic, and wall time, plus the temporaries created by the
+// assignments without noalias. Define BOOST_UBLAS_PROFILE before including any uBLAS
+// header to enable them (C++11 is needed then). Otherwise the hooks in the kernels
+// expand to nothing, and the report below stays empty.
+//
+// Every thread counts into its own counters, which collect () adds up. A kernel that
+// calls itself (e.g. an assignment forwarding to another assignment) is counted once,
+// for its outermost call; different kernels nest, so the time of a kernel includes the
+// time of the kernels it calls, e.g. the assignment of the initial zero in axpy_prod.
+
+#ifdef BOOST_UBLAS_PROFILE
+#if defined (BOOST_NO_CXX11_THREAD_LOCAL) || defined (BOOST_NO_CXX11_HDR_ATOMIC) || \
+    defined (BOOST_NO_CXX11_HDR_MUTEX) || defined (BOOST_NO_CXX11_HDR_CHRONO)
+#error BOOST_UBLAS_PROFILE needs thread_local, <atomic>, <mutex> and <chrono> (C++11)
+#endif
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace boost { namespace numeric { namespace ublas { namespace profile {
+
+    /** \brief The instrumented kernels
+     *
+     * The estimates count the operations and the elements read and written as if the
+     * operands were dense, except for the sparse products and the products with
+     * compressed or coordinate matrices, which count their nonzeros. The operations
+     * of the assigned expression itself (e.g. the sum of A + B) are not counted.
+     */
+    enum kernel_id {
+        matrix_assign_kernel,   // matrix_assign, matrix_assign_scalar
+        vector_assign_kernel,   // vector_assign, vector_assign_scalar
+        prod_kernel,            // assignments of prod (A, B), prod (A, x) and prod (x, A)
+        axpy_prod_kernel,
+        lu_factorize_kernel,    // lu_factorize, axpy_lu_factorize
+        sparse_prod_kernel,
+        matrix_temporary,       // temporaries of matrix assignments without noalias
+        vector_temporary,       // temporaries of vector assignments without noalias
+        kernel_count
+    };
+
+    inline const char *kernel_name (kernel_id k) {
+        static const char *const names [kernel_count] = {
+            "matrix_assign", "vector_assign", "prod", "axpy_prod", "lu_factorize",
+            "sparse_prod", "matrix_temporary", "vector_temporary"
+        };
+        return names [k];
+    }
+
+    /** \brief Totals of a kernel; for the temporaries, calls counts the temporaries */
+    struct counters {
+        counters ():
+            calls (0), elements (0), flops (0), bytes (0), nanoseconds (0) {}
+
+        counters &operator += (const counters &c) {
+            calls += c.calls;
+            elements += c.elements;
+            flops += c.flops;
+            bytes += c.bytes;
+            nanoseconds += c.nanoseconds;
+            return *this;
+        }
+
+        unsigned long long calls;
+        unsigned long long elements;
+        unsigned long long flops;
+        unsigned long long bytes;
+        unsigned long long nanoseconds;
+    };
+
+    /** \brief Totals of all threads, see collect () */
+    struct report {
+        const counters &operator [] (kernel_id k) const {
+            return kernels [k];
+        }
+
+        counters kernels [kernel_count];
+    };
+
+#ifdef BOOST_UBLAS_PROFILE
+
+namespace detail {
+
+    typedef std::atomic<unsigned long long> counter;
+
+    // Counters of a thread, written by this thread only: loads and stores are enough
+    inline void add (counter &c, unsigned long long n) {
+        c.store (c.load (std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    struct kernel_counters {
+        kernel_counters ():
+            calls (0), elements (0), flops (0), bytes (0), nanoseconds (0) {}
+
+        void add (const counters &c) {
+            detail::add (calls, c.calls);
+            detail::add (elements, c.elements);
+            detail::add (flops, c.flops);
+            detail::add (bytes, c.bytes);
+            detail::add (nanoseconds, c.nanoseconds);
+        }
+        counters load () const {
+            counters c;
+            c.calls = calls.load (std::memory_order_relaxed);
+            c.elements = elements.load (std::memory_order_relaxed);
+            c.flops = flops.load (std::memory_order_relaxed);
+            c.bytes = bytes.load (std::memory_order_relaxed);
+            c.nanoseconds = nanoseconds.load (std::memory_order_relaxed);
+            return c;
+        }
+        void clear () {
+            calls.store (0, std::memory_order_relaxed);
+            elements.store (0, std::memory_order_relaxed);
+            flops.store (0, std::memory_order_relaxed);
+            bytes.store (0, std::memory_order_relaxed);
+            nanoseconds.store (0, std::memory_order_relaxed);
+        }
+
+        counter calls, elements, flops, bytes, nanoseconds;
+    };
+
+    struct thread_counters {
+        thread_counters () {
+            std::fill (depth, depth + kernel_count, 0u);
+        }
+
+        kernel_counters kernels [kernel_count];
+        // active calls of each kernel, only the outermost one is counted
+        unsigned depth [kernel_count];
+    };
+
+    // The counters of the running threads, and the totals of the finished ones
+    struct registry {
+        std::mutex mutex;
+        std::vector<thread_counters *> threads;
+        counters finished [kernel_count];
+    };
+
+    inline registry &threads () {
+        static registry r;
+        return r;
+    }
+
+    // Registers the counters of a thread for its lifetime
+    class thread_entry {
+    public:
+        thread_entry () {
+            registry &r (threads ());
+            std::lock_guard<std::mutex> lock (r.mutex);
+            r.threads.push_back (&counters_);
+        }
+        ~thread_entry () {
+            registry &r (threads ());
+            std::lock_guard<std::mutex> lock (r.mutex);
+            for (std::size_t k = 0; k < kernel_count; ++ k)
+                r.finished [k] += counters_.kernels [k].load ();
+            r.threads.erase (std::find (r.threads.begin (), r.threads.end (), &counters_));
+        }
+
+        thread_counters counters_;
+
+    private:
+        thread_entry (const thread_entry &);
+        thread_entry &operator = (const thread_entry &);
+    };
+
+    inline thread_counters &local () {
+        static thread_local thread_entry entry;
+        return entry.counters_;
+    }
+
+}
+
+    /** \brief Counts a call of a kernel, from its construction to its destruction */
+    class scope {
+    public:
+        typedef std::chrono::steady_clock clock;
+
+        scope (kernel_id k, unsigned long long elements, unsigned long long flops, unsigned long long bytes):
+            local_ (detail::local ()), kernel_ (k), outermost_ (local_.depth [k] ++ == 0) {
+            if (outermost_) {
+                totals_.calls = 1;
+                add (elements, flops, bytes);
+                start_ = clock::now ();
+            }
+        }
+        ~scope () {
+            if (outermost_) {
+                totals_.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds> (clock::now () - start_).count ();
+                local_.kernels [kernel_].add (totals_);
+            }
+            -- local_.depth [kernel_];
+        }
+
+        /** \brief Adds work known during the call only, e.g. the operations of a sparse product */
+        void add (unsigned long long elements, unsigned long long flops, unsigned long long bytes) {
+            totals_.elements += elements;
+            totals_.flops += flops;
+            totals_.bytes += bytes;
+        }
+
+    private:
+        scope (const scope &);
+        scope &operator = (const scope &);
+
+        detail::thread_counters &local_;
+        kernel_id kernel_;
+        bool outermost_;
+        counters totals_;
+        clock::time_point start_;
+    };
+
+    /** \brief Counts a temporary of the given number of elements */
+    inline void temporary (kernel_id k, unsigned long long elements, std::size_t value_size) {
+        counters c;
+        c.calls = 1;
+        c.elements = elements;
+        c.bytes = elements * value_size;
+        detail::local ().kernels [k].add (c);
+    }
+
+    // Estimates of x op= e for n elements: one operation per element if op computes
+    template<template <class T1, class T2> class F, class X, class E>
+    unsigned long long assign_flops (const X &, const E &, unsigned long long n) {
+        return F<typename X::reference, typename E::value_type>::computed ? n : 0;
+    }
+    // e is read, x is written and read if op computes
+    template<template <class T1, class T2> class F, class X, class E>
+    unsigned long long assign_bytes (const X &, const E &, unsigned long long n) {
+        return n * ((F<typename X::reference, typename E::value_type>::computed ? 2 : 1) * sizeof (typename X::value_type) +
+                    sizeof (typename E::value_type));
+    }
+
+    /** \brief The totals of all threads since the start or the last reset ()
+     *
+     * The counts of a kernel running in another thread are added when it returns.
+     */
+    inline report collect () {
+        detail::registry &r (detail::threads ());
+        std::lock_guard<std::mutex> lock (r.mutex);
+        report totals;
+        for (std::size_t k = 0; k < kernel_count; ++ k) {
+            totals.kernels [k] = r.finished [k];
+            for (std::size_t t = 0; t < r.threads.size (); ++ t)
+                totals.kernels [k] += r.threads [t]->kernels [k].load ();
+        }
+        return totals;
+    }
+
+    /** \brief Clears the counters of all threads; kernels running meanwhile may be lost */
+    inline void reset () {
+        detail::registry &r (detail::threads ());
+        std::lock_guard<std::mutex> lock (r.mutex);
+        for (std::size_t k = 0; k < kernel_count; ++ k) {
+            r.finished [k] = counters ();
+            for (std::size_t t = 0; t < r.threads.size (); ++ t)
+                r.threads [t]->kernels [k].clear ();
+        }
+    }
+
+#else
+
+    inline report collect () {
+        return report ();
+    }
+
+    inline void reset () {}
+
+#endif
+
+    /** \brief Writes a table of the kernels called, with their rates */
+    inline void dump (std::ostream &out, const report &r) {
+#ifndef BOOST_UBLAS_PROFILE
+        out << "uBLAS profiling is disabled, define BOOST_UBLAS_PROFILE to enable it" << std::endl;
+#endif
+        const std::ios_base::fmtflags flags (out.flags ());
+        const std::streamsize precision (out.precision ());
+        out << std::left << std::setw (18) << "kernel" << std::right
+            << std::setw (12) << "calls" << std::setw (14) << "elements"
+            << std::setw (14) << "flops" << std::setw (14) << "bytes"
+            << std::setw (12) << "seconds" << std::setw (10) << "GFLOP/s" << std::setw (10) << "GB/s" << std::endl;
+        out << std::setprecision (4);
+        for (std::size_t k = 0; k < kernel_count; ++ k) {
+            const counters &c (r.kernels [k]);
+            if (c.calls == 0)
+                continue;
+            const double seconds (c.nanoseconds * 1.0e-9);
+            out << std::left << std::setw (18) << kernel_name (kernel_id (k)) << std::right
+                << std::setw (12) << c.calls << std::setw (14) << c.elements
+                << std::setw (14) << c.flops << std::setw (14) << c.bytes
+                << std::setw (12) << seconds;
+            if (c.nanoseconds > 0)
+                out << std::setw (10) << c.flops / double (c.nanoseconds) << std::setw (10) << c.bytes / double (c.nanoseconds);
+            out << std::endl;
+        }
+        out.flags (flags);
+        out.precision (precision);
+    }
+    inline void dump (std::ostream &out) {
+        dump (out, collect ());
+    }
+
+}}}}
+
+#ifdef BOOST_UBLAS_PROFILE
+// Hooks of the kernels; BOOST_UBLAS_PROFILE_ADD adds to the scope of the enclosing
+// function, BOOST_UBLAS_PROFILE_TEMPORARY uses the value_type of the enclosing class.
+#define BOOST_UBLAS_PROFILE_SCOPE(kernel, elements, flops, bytes) \
+    boost::numeric::ublas::profile::scope boost_ublas_profile_scope (boost::numeric::ublas::profile::kernel, (elements), (flops), (bytes))
+#define BOOST_UBLAS_PROFILE_ADD(elements, flops, bytes) \
+    boost_ublas_profile_scope.add ((elements), (flops), (bytes))
+#define BOOST_UBLAS_PROFILE_TEMPORARY(kind, elements) \
+    boost::numeric::ublas::profile::temporary (boost::numeric::ublas::profile::kind##_temporary, (elements), sizeof (value_type))
+#endif
+
+#endif
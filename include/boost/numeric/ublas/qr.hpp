@@ -0,0 +1,606 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_QR_
+#define _BOOST_UBLAS_QR_
+
+#include <boost/numeric/ublas/lu.hpp>
+#include <limits>
+
+// Householder QR factorizations in the spirit of LAPACK (xGEQRF, xGEQPF, xORMQR, xGELS)
+//
+// A = Q R is stored in place: R in the upper triangle of m, the Householder vectors
+// v (i) below the diagonal with v (i) (i) = 1 implicit, and Q = H (0) ... H (k - 1),
+// H (i) = I - tau (i) v (i) v (i)^H, k = min (size1, size2). For complex matrices the
+// transposes below are conjugate transposes.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Generates H with H^H (alpha, x) = (beta, 0), beta real, from column j of m at and
+    // below row i (xLARFG); v overwrites x, beta alpha. Returns tau.
+    template<class M>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename M::value_type qr_reflector (M &m, typename M::size_type i, typename M::size_type j) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size1 (m.size1 ());
+        const value_type alpha (m (i, j));
+        real_type xnorm2 = real_type/*zero*/();
+        for (size_type r = i + 1; r < size1; ++ r) {
+            const real_type a (type_traits<value_type>::type_abs (m (r, j)));
+            xnorm2 += a * a;
+        }
+        if (xnorm2 == real_type/*zero*/() && type_traits<value_type>::imag (alpha) == real_type/*zero*/())
+            return value_type/*zero*/();
+        const real_type aalpha (type_traits<value_type>::type_abs (alpha));
+        real_type beta (type_traits<real_type>::type_sqrt (aalpha * aalpha + xnorm2));
+        if (type_traits<value_type>::real (alpha) >= real_type/*zero*/())
+            beta = - beta;
+        const value_type tau ((value_type (beta) - alpha) / value_type (beta));
+        const value_type scale (value_type (1) / (alpha - value_type (beta)));
+        for (size_type r = i + 1; r < size1; ++ r)
+            m (r, j) *= scale;
+        m (i, j) = value_type (beta);
+        return tau;
+    }
+
+    // c := (I - t v v^H) c for the columns [c0, c1) of c, v being column j of m from row i
+    template<class M, class MV, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void qr_reflect (const M &m, typename M::size_type i, typename M::size_type j, typename M::value_type t,
+                     MV &c, typename M::size_type c0, typename M::size_type c1, TAG) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        if (t == value_type/*zero*/())
+            return;
+        const size_type size1 (m.size1 ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if ((size1 - i) * (c1 - c0) >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type q = difference_type (c0); q < difference_type (c1); ++ q) {
+            value_type w (rhs_element (c, i, q, TAG ()));
+            for (size_type r = i + 1; r < size1; ++ r)
+                w += type_traits<value_type>::conj (m (r, j)) * rhs_element (c, r, q, TAG ());
+            w *= t;
+            rhs_element (c, i, q, TAG ()) -= w;
+            for (size_type r = i + 1; r < size1; ++ r)
+                rhs_element (c, r, q, TAG ()) -= m (r, j) * w;
+        }
+    }
+
+    // Triangular factor T of H (k) ... H (k + nb - 1) = I - V T V^H (xLARFT)
+    template<class M, class V>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    matrix<typename M::value_type> qr_block_factor (const M &m, const V &tau, typename M::size_type k, typename M::size_type nb) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type size1 (m.size1 ());
+        matrix<value_type> t (nb, nb, value_type/*zero*/());
+        for (size_type i = 0; i < nb; ++ i) {
+            const value_type ti (tau (k + i));
+            // t (0:i, i) = - tau (i) V (:, 0:i)^H v (i)
+            for (size_type q = 0; q < i; ++ q) {
+                value_type z (type_traits<value_type>::conj (m (k + i, k + q)));
+                for (size_type r = k + i + 1; r < size1; ++ r)
+                    z += type_traits<value_type>::conj (m (r, k + q)) * m (r, k + i);
+                t (q, i) = - ti * z;
+            }
+            // t (0:i, i) = T (0:i, 0:i) t (0:i, i)
+            for (size_type q = 0; q < i; ++ q) {
+                value_type s = value_type/*zero*/();
+                for (size_type p = q; p < i; ++ p)
+                    s += t (q, p) * t (p, i);
+                t (q, i) = s;
+            }
+            t (i, i) = ti;
+        }
+        return t;
+    }
+
+    // c := (I - V T V^H) c, or (I - V T V^H)^H c when herm, for rows k.. and the columns
+    // [c0, c1) of c (xLARFB). V is taken from the columns k.. of m. The rows are split
+    // between the threads, so tall matrices are threaded however few columns c has.
+    template<class M, class MV, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void qr_block_reflect (const M &m, typename M::size_type k, const matrix<typename M::value_type> &t, bool herm,
+                           MV &c, typename M::size_type c0, typename M::size_type c1, TAG) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+
+        const size_type size1 (m.size1 ());
+        const size_type nb (t.size1 ());
+        const size_type cols (c1 - c0);
+        if (k >= size1 || nb == 0 || cols == 0)
+            return;
+        // W = V^H c
+        matrix<value_type> w (nb, cols, value_type/*zero*/());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel if ((size1 - k) * nb * cols >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        {
+            matrix<value_type> wp (nb, cols, value_type/*zero*/());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp for
+#endif
+            for (difference_type r = difference_type (k); r < difference_type (size1); ++ r) {
+                const size_type pe ((std::min) (size_type (r) - k + 1, nb));
+                for (size_type p = 0; p < pe; ++ p) {
+                    const value_type v (size_type (r) == k + p ? value_type (1) : type_traits<value_type>::conj (m (r, k + p)));
+                    for (size_type q = 0; q < cols; ++ q)
+                        wp (p, q) += v * rhs_element (c, r, c0 + q, TAG ());
+                }
+            }
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp critical (boost_ublas_larfb)
+#endif
+            w += wp;
+        }
+        // W = T^H W or W = T W
+        for (size_type q = 0; q < cols; ++ q) {
+            if (herm) {
+                for (size_type p = nb; p-- > 0; ) {
+                    value_type s = value_type/*zero*/();
+                    for (size_type o = 0; o <= p; ++ o)
+                        s += type_traits<value_type>::conj (t (o, p)) * w (o, q);
+                    w (p, q) = s;
+                }
+            } else {
+                for (size_type p = 0; p < nb; ++ p) {
+                    value_type s = value_type/*zero*/();
+                    for (size_type o = p; o < nb; ++ o)
+                        s += t (p, o) * w (o, q);
+                    w (p, q) = s;
+                }
+            }
+        }
+        // c -= V W
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if ((size1 - k) * nb * cols >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type r = difference_type (k); r < difference_type (size1); ++ r) {
+            const size_type pe ((std::min) (size_type (r) - k + 1, nb));
+            for (size_type p = 0; p < pe; ++ p) {
+                const value_type v (size_type (r) == k + p ? value_type (1) : m (r, k + p));
+                for (size_type q = 0; q < cols; ++ q)
+                    rhs_element (c, r, c0 + q, TAG ()) -= v * w (p, q);
+            }
+        }
+    }
+
+    // mv := Q^H mv (herm) or Q mv, one block reflector at a time (xORMQR)
+    template<class M, class V, class MV, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void qr_apply (const M &m, const V &tau, MV &mv, bool herm, TAG) {
+        typedef typename M::size_type size_type;
+
+        const size_type size1 (m.size1 ());
+        const size_type k (tau.size ());
+        BOOST_UBLAS_CHECK (k <= (std::min) (size1, m.size2 ()), bad_size ());
+        BOOST_UBLAS_CHECK (rhs_rows (mv, TAG ()) == size1, bad_size ());
+        const size_type cols (rhs_columns (mv, TAG ()));
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        const size_type blocks ((k + block - 1) / block);
+        for (size_type b = 0; b < blocks; ++ b) {
+            // Q^H applies the blocks first to last, Q last to first
+            const size_type j0 ((herm ? b : blocks - 1 - b) * block);
+            const size_type nb ((std::min) (block, k - j0));
+            detail::qr_block_reflect (m, j0, qr_block_factor (m, tau, j0, nb), herm, mv, 0, cols, TAG ());
+        }
+    }
+
+    // Solves R (0:n, 0:n) x = mv (0:n) in place
+    template<class M, class MV, class TAG>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void qr_back_substitute (const M &m, typename M::size_type n, MV &mv, TAG) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename MV::value_type value_type;
+
+        const size_type cols (rhs_columns (mv, TAG ()));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (n * n * cols / 2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+        for (difference_type q = 0; q < difference_type (cols); ++ q) {
+            for (size_type i = n; i-- > 0; ) {
+                value_type s (rhs_element (mv, i, q, TAG ()));
+                for (size_type p = i + 1; p < n; ++ p)
+                    s -= m (i, p) * rhs_element (mv, p, q, TAG ());
+                rhs_element (mv, i, q, TAG ()) = s / m (i, i);
+            }
+        }
+    }
+
+    // Plane rotation G = [c s; -conj (s) c] with G (a, b)^T = (r, 0), c real (xLARTG)
+    template<class T>
+    BOOST_UBLAS_INLINE
+    void qr_givens (const T &a, const T &b, typename type_traits<T>::real_type &c, T &s) {
+        typedef typename type_traits<T>::real_type real_type;
+
+        const real_type aa (type_traits<T>::type_abs (a)), ab (type_traits<T>::type_abs (b));
+        if (ab == real_type/*zero*/()) {
+            c = real_type (1);
+            s = T/*zero*/();
+        } else if (aa == real_type/*zero*/()) {
+            c = real_type/*zero*/();
+            s = type_traits<T>::conj (b) / T (ab);
+        } else {
+            const real_type scale (aa + ab);
+            const real_type rho (scale * type_traits<real_type>::type_sqrt ((aa / scale) * (aa / scale) + (ab / scale) * (ab / scale)));
+            c = aa / rho;
+            s = (a / T (aa)) * type_traits<T>::conj (b) / T (rho);
+        }
+    }
+
+    // Rotates the rows p and q of r, from column c0 on, by G and the columns p and q of
+    // q by G^H, so that Q R is unchanged
+    template<class MQ, class MR>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void qr_rotate (MQ &q, MR &r, typename MR::size_type p, typename MR::size_type pq,
+                    typename type_traits<typename MR::value_type>::real_type c, typename MR::value_type s,
+                    typename MR::size_type c0) {
+        typedef typename MR::size_type size_type;
+        typedef typename MR::value_type value_type;
+
+        for (size_type j = c0; j < r.size2 (); ++ j) {
+            const value_type a (r (p, j)), b (r (pq, j));
+            r (p, j) = c * a + s * b;
+            r (pq, j) = c * b - type_traits<value_type>::conj (s) * a;
+        }
+        for (size_type i = 0; i < q.size1 (); ++ i) {
+            const value_type a (q (i, p)), b (q (i, pq));
+            q (i, p) = c * a + type_traits<value_type>::conj (s) * b;
+            q (i, pq) = c * b - s * a;
+        }
+    }
+
+}
+
+    /** \brief Blocked Householder QR factorization A = Q R (xGEQRF).
+     *
+     *  On return \c m holds R in its upper triangle and the Householder vectors below
+     *  it, \c tau (of size min (size1, size2)) the scalar factors of the reflectors.
+     *  Panels of \c BOOST_UBLAS_FACTORIZATION_BLOCK columns are factored one column at
+     *  a time; the rest of the matrix is then updated with the block reflector of the
+     *  panel (compact WY representation) as two matrix products.
+     *
+     *  \return 0 if R has a nonzero diagonal, otherwise the index plus one of its
+     *  first zero diagonal element
+     */
+    template<class M, class V>
+    typename M::size_type qr_factorize (M &m, V &tau) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type size1 (m.size1 ());
+        const size_type size2 (m.size2 ());
+        const size_type size ((std::min) (size1, size2));
+        BOOST_UBLAS_CHECK (tau.size () == size, bad_size ());
+        const size_type block (BOOST_UBLAS_FACTORIZATION_BLOCK);
+        size_type singular = 0;
+        for (size_type j0 = 0; j0 < size; j0 += block) {
+            const size_type nb ((std::min) (block, size - j0));
+            // Panel
+            for (size_type j = j0; j < j0 + nb; ++ j) {
+                tau (j) = detail::qr_reflector (m, j, j);
+                if (m (j, j) == value_type/*zero*/() && singular == 0)
+                    singular = j + 1;
+                detail::qr_reflect (m, j, j, type_traits<value_type>::conj (tau (j)), m, j + 1, j0 + nb, matrix_tag ());
+            }
+            // Trailing matrix
+            if (j0 + nb < size2)
+                detail::qr_block_reflect (m, j0, detail::qr_block_factor (m, tau, j0, nb), true, m, j0 + nb, size2, matrix_tag ());
+        }
+        return singular;
+    }
+
+    /** \brief Householder QR factorization with column pivoting A P = Q R (xGEQPF).
+     *
+     *  At step \c j the remaining column of largest norm is exchanged with column \c j
+     *  and \c pm (j) records it, as \c lu_factorize does for rows. The column norms are
+     *  downdated rather than recomputed. The diagonal of R then decreases in magnitude,
+     *  which reveals the numerical rank, see \c qr_rank. The reflectors are applied one
+     *  at a time, threaded over the columns.
+     *
+     *  \return 0 if R has a nonzero diagonal, otherwise the index plus one of its
+     *  first zero diagonal element; all later diagonal elements are zero as well
+     */
+    template<class M, class V, class PM>
+    typename M::size_type qr_factorize (M &m, V &tau, PM &pm) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size1 (m.size1 ());
+        const size_type size2 (m.size2 ());
+        const size_type size ((std::min) (size1, size2));
+        BOOST_UBLAS_CHECK (tau.size () == size, bad_size ());
+        BOOST_UBLAS_CHECK (pm.size () == size2, bad_size ());
+        const real_type tol (type_traits<real_type>::type_sqrt (std::numeric_limits<real_type>::epsilon ()));
+        // Partial (vn1) and exact (vn2) column norms
+        vector<real_type> vn1 (size2), vn2 (size2);
+        for (size_type j = 0; j < size2; ++ j) {
+            vn1 (j) = norm_2 (column (m, j));
+            vn2 (j) = vn1 (j);
+            pm (j) = j;
+        }
+        size_type singular = 0;
+        for (size_type j = 0; j < size; ++ j) {
+            const size_type p (j + index_norm_inf (project (vn1, range (j, size2))));
+            if (p != j) {
+                column (m, p).swap (column (m, j));
+                std::swap (vn1 (p), vn1 (j));
+                std::swap (vn2 (p), vn2 (j));
+            }
+            pm (j) = p;
+            tau (j) = detail::qr_reflector (m, j, j);
+            if (m (j, j) == value_type/*zero*/() && singular == 0)
+                singular = j + 1;
+            const value_type t (type_traits<value_type>::conj (tau (j)));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if ((size1 - j) * (size2 - j) >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type q = difference_type (j + 1); q < difference_type (size2); ++ q) {
+                if (t != value_type/*zero*/()) {
+                    value_type w (m (j, q));
+                    for (size_type r = j + 1; r < size1; ++ r)
+                        w += type_traits<value_type>::conj (m (r, j)) * m (r, q);
+                    w *= t;
+                    m (j, q) -= w;
+                    for (size_type r = j + 1; r < size1; ++ r)
+                        m (r, q) -= m (r, j) * w;
+                }
+                // Downdate the norm of the rest of column q
+                if (vn1 (q) != real_type/*zero*/()) {
+                    const real_type a (type_traits<value_type>::type_abs (m (j, q)) / vn1 (q));
+                    const real_type f ((std::max) (real_type/*zero*/(), real_type (1) - a * a));
+                    const real_type g (f * (vn1 (q) / vn2 (q)) * (vn1 (q) / vn2 (q)));
+                    if (g <= tol) {
+                        real_type s = real_type/*zero*/();
+                        for (size_type r = j + 1; r < size1; ++ r) {
+                            const real_type e (type_traits<value_type>::type_abs (m (r, q)));
+                            s += e * e;
+                        }
+                        vn1 (q) = type_traits<real_type>::type_sqrt (s);
+                        vn2 (q) = vn1 (q);
+                    } else {
+                        vn1 (q) *= type_traits<real_type>::type_sqrt (f);
+                    }
+                }
+            }
+        }
+        return singular;
+    }
+
+    /** \brief Numerical rank of a QR factorization with column pivoting: the number
+     *  of diagonal elements of R larger than \c tol times the first one. A negative
+     *  \c tol selects max (size1, size2) times the machine epsilon.
+     */
+    template<class M>
+    typename M::size_type qr_rank (const M &m, typename type_traits<typename M::value_type>::real_type tol = -1) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size ((std::min) (m.size1 (), m.size2 ()));
+        if (size == 0)
+            return 0;
+        if (tol < real_type/*zero*/())
+            tol = real_type ((std::max) (m.size1 (), m.size2 ())) * std::numeric_limits<real_type>::epsilon ();
+        const real_type bound (tol * type_traits<value_type>::type_abs (m (0, 0)));
+        size_type rank = 0;
+        while (rank < size && type_traits<value_type>::type_abs (m (rank, rank)) > bound)
+            ++ rank;
+        return rank;
+    }
+
+    /** \brief Computes Q^T mv (Q^H mv for complex matrices) from a QR factorization,
+     *  without forming Q. \c mv is a vector or a matrix with \c size1 rows.
+     */
+    template<class M, class V, class MV>
+    void qr_apply_qt (const M &m, const V &tau, MV &mv) {
+        detail::qr_apply (m, tau, mv, true, typename MV::type_category ());
+    }
+
+    /** \brief Computes Q mv from a QR factorization, without forming Q. \c mv is a
+     *  vector or a matrix with \c size1 rows.
+     */
+    template<class M, class V, class MV>
+    void qr_apply_q (const M &m, const V &tau, MV &mv) {
+        detail::qr_apply (m, tau, mv, false, typename MV::type_category ());
+    }
+
+    /** \brief Forms the first \c q.size2 () columns of Q from a QR factorization (xORGQR).
+     */
+    template<class M, class V, class MQ>
+    void qr_form_q (const M &m, const V &tau, MQ &q) {
+        typedef typename MQ::value_type value_type;
+
+        BOOST_UBLAS_CHECK (q.size1 () == m.size1 (), bad_size ());
+        q.assign (identity_matrix<value_type> (q.size1 (), q.size2 ()));
+        qr_apply_q (m, tau, q);
+    }
+
+    /** \brief Least squares solution of A x = mv for a QR factorization of A with
+     *  size1 >= size2 and full column rank (xGELS).
+     *
+     *  \c mv is a vector or a matrix of right hand sides with \c size1 rows; on return
+     *  its first \c size2 rows hold the solutions and the remaining rows the residuals
+     *  in the basis of Q.
+     */
+    template<class M, class V, class MV>
+    void qr_solve (const M &m, const V &tau, MV &mv) {
+        BOOST_UBLAS_CHECK (m.size1 () >= m.size2 (), bad_size ());
+        qr_apply_qt (m, tau, mv);
+        detail::qr_back_substitute (m, m.size2 (), mv, typename MV::type_category ());
+    }
+
+    /** \brief Least squares solution of A x = mv for a QR factorization of A with
+     *  column pivoting and size1 >= size2.
+     *
+     *  Only the first \c qr_rank (m) columns of the pivoted A are used; the other
+     *  components of the solution are zero (basic solution). On return the first
+     *  \c size2 rows of \c mv hold the solutions.
+     */
+    template<class M, class V, class PMT, class PMA, class MV>
+    void qr_solve (const M &m, const V &tau, const permutation_matrix<PMT, PMA> &pm, MV &mv) {
+        typedef typename M::size_type size_type;
+        typedef typename MV::value_type value_type;
+        typedef typename MV::type_category type_category;
+
+        const size_type size2 (m.size2 ());
+        BOOST_UBLAS_CHECK (m.size1 () >= size2, bad_size ());
+        BOOST_UBLAS_CHECK (pm.size () == size2, bad_size ());
+        qr_apply_qt (m, tau, mv);
+        const size_type rank (qr_rank (m));
+        detail::qr_back_substitute (m, rank, mv, type_category ());
+        const size_type cols (detail::rhs_columns (mv, type_category ()));
+        for (size_type q = 0; q < cols; ++ q) {
+            for (size_type i = rank; i < size2; ++ i)
+                detail::rhs_element (mv, i, q, type_category ()) = value_type/*zero*/();
+            for (size_type i = size2; i-- > 0; )
+                if (pm (i) != i)
+                    std::swap (detail::rhs_element (mv, i, q, type_category ()),
+                               detail::rhs_element (mv, pm (i), q, type_category ()));
+        }
+    }
+
+    /** \brief Rank one update of a QR factorization with explicit factors: Q R
+     *  becomes the factorization of A + u v^T, in O(size1^2 + size1 size2) (xQR1UP).
+     *
+     *  \c q is the size1 x size1 orthogonal (unitary) factor, as formed by \c
+     *  qr_form_q, and \c r the size1 x size2 upper triangular one. Rotations fold Q^H u
+     *  into its first element, which turns R into an upper Hessenberg matrix that takes
+     *  the rank one term in its first row; further rotations make it triangular again.
+     */
+    template<class MQ, class MR, class U, class V>
+    void qr_update (MQ &q, MR &r, const U &u, const V &v) {
+        typedef typename MR::size_type size_type;
+        typedef typename MR::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size1 (r.size1 ()), size2 (r.size2 ());
+        BOOST_UBLAS_CHECK (q.size1 () == size1 && q.size2 () == size1, bad_size ());
+        BOOST_UBLAS_CHECK (u.size () == size1 && v.size () == size2, bad_size ());
+        if (size1 == 0)
+            return;
+        vector<value_type> w (prod (herm (q), u));
+        real_type c;
+        value_type s;
+        for (size_type k = size1 - 1; k > 0; -- k) {
+            detail::qr_givens (w (k - 1), w (k), c, s);
+            w (k - 1) = c * w (k - 1) + s * w (k);
+            w (k) = value_type/*zero*/();
+            detail::qr_rotate (q, r, k - 1, k, c, s, k - 1 < size2 ? k - 1 : size2);
+        }
+        for (size_type j = 0; j < size2; ++ j)
+            r (0, j) += w (0) * v (j);
+        for (size_type k = 0; k + 1 < size1 && k < size2; ++ k) {
+            detail::qr_givens (r (k, k), r (k + 1, k), c, s);
+            detail::qr_rotate (q, r, k, k + 1, c, s, k);
+            r (k + 1, k) = value_type/*zero*/();
+        }
+    }
+
+    /** \brief Updates the explicit factors of \c qr_update for A with its column \c j
+     *  replaced by \c x, as a rank one update.
+     */
+    template<class MQ, class MR, class V>
+    void qr_replace_column (MQ &q, MR &r, typename MR::size_type j, const V &x) {
+        typedef typename MR::size_type size_type;
+        typedef typename MR::value_type value_type;
+
+        const size_type size1 (r.size1 ()), size2 (r.size2 ());
+        BOOST_UBLAS_CHECK (j < size2, bad_index ());
+        // u = x - Q R e_j, R (:, j) having j + 1 nonzero elements
+        vector<value_type> u (x);
+        const size_type top ((std::min) (j + 1, size1));
+        u -= prod (project (q, range (0, size1), range (0, top)), project (column (r, j), range (0, top)));
+        vector<value_type> v (size2, value_type/*zero*/());
+        v (j) = value_type (1);
+        qr_update (q, r, u, v);
+    }
+
+    /** \brief Updates the explicit factors of \c qr_update for A with its row \c i
+     *  replaced by \c x, as a rank one update.
+     */
+    template<class MQ, class MR, class V>
+    void qr_replace_row (MQ &q, MR &r, typename MR::size_type i, const V &x) {
+        typedef typename MR::size_type size_type;
+        typedef typename MR::value_type value_type;
+
+        const size_type size1 (r.size1 ());
+        BOOST_UBLAS_CHECK (i < size1, bad_index ());
+        BOOST_UBLAS_CHECK (x.size () == r.size2 (), bad_size ());
+        // v = x - R^T Q (i, :)^T
+        vector<value_type> v (x);
+        v -= prod (row (q, i), r);
+        vector<value_type> u (size1, value_type/*zero*/());
+        u (i) = value_type (1);
+        qr_update (q, r, u, v);
+    }
+
+    /** \brief Updates the explicit factors of \c qr_update for A with the column \c x
+     *  appended; \c r gains a column.
+     */
+    template<class MQ, class MR, class V>
+    void qr_append_column (MQ &q, MR &r, const V &x) {
+        typedef typename MR::size_type size_type;
+        typedef typename MR::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size1 (r.size1 ()), size2 (r.size2 ());
+        BOOST_UBLAS_CHECK (x.size () == size1, bad_size ());
+        r.resize (size1, size2 + 1, true);
+        column (r, size2) = prod (herm (q), x);
+        // Zero the new column below the diagonal from the bottom
+        real_type c;
+        value_type s;
+        for (size_type k = size1; k-- > size2 + 1; ) {
+            detail::qr_givens (r (k - 1, size2), r (k, size2), c, s);
+            detail::qr_rotate (q, r, k - 1, k, c, s, size2);
+            r (k, size2) = value_type/*zero*/();
+        }
+    }
+
+    /** \brief Updates the explicit factors of \c qr_update for A with the row \c x
+     *  appended; \c q and \c r gain a row, \c q a column as well.
+     */
+    template<class MQ, class MR, class V>
+    void qr_append_row (MQ &q, MR &r, const V &x) {
+        typedef typename MR::size_type size_type;
+        typedef typename MR::value_type value_type;
+        typedef typename type_traits<value_type>::real_type real_type;
+
+        const size_type size1 (r.size1 ()), size2 (r.size2 ());
+        BOOST_UBLAS_CHECK (x.size () == size2, bad_size ());
+        q.resize (size1 + 1, size1 + 1, true);
+        for (size_type i = 0; i < size1; ++ i)
+            q (i, size1) = q (size1, i) = value_type/*zero*/();
+        q (size1, size1) = value_type (1);
+        r.resize (size1 + 1, size2, true);
+        row (r, size1) = x;
+        // Fold the new row into R
+        real_type c;
+        value_type s;
+        for (size_type k = 0; k < (std::min) (size1, size2); ++ k) {
+            detail::qr_givens (r (k, k), r (size1, k), c, s);
+            detail::qr_rotate (q, r, k, size1, c, s, k);
+            r (size1, k) = value_type/*zero*/();
+        }
+    }
+
+}}}
+
+#endif
@@ -66,6 +66,7 @@ namespace boost { namespace numeric { namespace ublas {
             alloc_(a), size_ (size) {
           if (size_) {
               data_ = alloc_.allocate (size_);
+              BOOST_UBLAS_ALLOCATED (construction, size_ * sizeof (value_type));
               if (! detail::has_trivial_constructor<T>::value) {
                   for (pointer d = data_; d != data_ + size_; ++d)
                       alloc_.construct(d, value_type());
@@ -80,6 +81,7 @@ namespace boost { namespace numeric { namespace ublas {
             alloc_ (a), size_ (size) {
             if (size_) {
                 data_ = alloc_.allocate (size_);
+                BOOST_UBLAS_ALLOCATED (construction, size_ * sizeof (value_type));
                 std::uninitialized_fill (begin(), end(), init);
             }
             else
@@ -91,6 +93,7 @@ namespace boost { namespace numeric { namespace ublas {
             alloc_ (c.alloc_), size_ (c.size_) {
             if (size_) {
                 data_ = alloc_.allocate (size_);
+                BOOST_UBLAS_ALLOCATED (copy, size_ * sizeof (value_type));
                 std::uninitialized_copy (c.begin(), c.end(), begin());
             }
             else
@@ -107,6 +110,7 @@ namespace boost { namespace numeric { namespace ublas {
                     }
                 }
                 alloc_.deallocate (data_, size_);
+                BOOST_UBLAS_DEALLOCATED (size_ * sizeof (value_type));
             }
         }
 
@@ -118,6 +122,7 @@ namespace boost { namespace numeric { namespace ublas {
                 pointer p_data = data_;
                 if (size) {
                     data_ = alloc_.allocate (size);
+                    BOOST_UBLAS_ALLOCATED (resize, size * sizeof (value_type));
                     if (preserve) {
                         pointer si = p_data;
                         pointer di = data_;
@@ -151,6 +156,7 @@ namespace boost { namespace numeric { namespace ublas {
                             alloc_.destroy (si);
                     }
                     alloc_.deallocate (p_data, size_);
+                    BOOST_UBLAS_DEALLOCATED (size_ * sizeof (value_type));
                 }
 
                 if (!size)
@@ -200,6 +206,7 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         unbounded_array &operator = (const unbounded_array &a) {
             if (this != &a) {
+                BOOST_UBLAS_ALLOCATION_SCOPE (copy);
                 resize (a.size_);
                 std::copy (a.data_, a.data_ + a.size_, data_);
             }
@@ -246,6 +246,7 @@ namespace boost { namespace numeric { namespace ublas {
             alloc_ (c.alloc_), capacity_ (c.size_), size_ (c.size_) {
             if (capacity_) {
                 data_ = alloc_.allocate (capacity_);
+                BOOST_UBLAS_ALLOCATED (copy, capacity_ * sizeof (value_type));
                 std::uninitialized_copy (data_, data_ + capacity_, c.data_);
                 // capacity != size_ requires uninitialized_fill (size_ to capacity_)
             }
@@ -257,6 +258,7 @@ namespace boost { namespace numeric { namespace ublas {
             if (capacity_) {
                 std::for_each (data_, data_ + capacity_, static_destroy);
                 alloc_.deallocate (data_, capacity_);
+                BOOST_UBLAS_DEALLOCATED (capacity_ * sizeof (value_type));
             }
         }
 
@@ -269,12 +271,14 @@ namespace boost { namespace numeric { namespace ublas {
                 const size_type capacity = size << 1;
                 BOOST_UBLAS_CHECK (capacity, internal_logic ());
                 pointer data = alloc_.allocate (capacity);
+                BOOST_UBLAS_ALLOCATED (resize, capacity * sizeof (value_type));
                 std::uninitialized_copy (data_, data_ + (std::min) (size, size_), data);
                 std::uninitialized_fill (data + (std::min) (size, size_), data + capacity, value_type ());
 
                 if (capacity_) {
                     std::for_each (data_, data_ + capacity_, static_destroy);
                     alloc_.deallocate (data_, capacity_);
+                    BOOST_UBLAS_DEALLOCATED (capacity_ * sizeof (value_type));
                 }
                 capacity_ = capacity;
                 data_ = data;
@@ -293,6 +297,7 @@ namespace boost { namespace numeric { namespace ublas {
             pointer data;
             if (capacity) {
                 data = alloc_.allocate (capacity);
+                BOOST_UBLAS_ALLOCATED (resize, capacity * sizeof (value_type));
                 std::uninitialized_copy (data_, data_ + size_, data);
                 std::uninitialized_fill (data + size_, data + capacity, value_type ());
             }
@@ -302,6 +307,7 @@ namespace boost { namespace numeric { namespace ublas {
             if (capacity_) {
                 std::for_each (data_, data_ + capacity_, static_destroy);
                 alloc_.deallocate (data_, capacity_);
+                BOOST_UBLAS_DEALLOCATED (capacity_ * sizeof (value_type));
             }
             capacity_ = capacity;
             data_ = data;
@@ -345,6 +351,7 @@ namespace boost { namespace numeric { namespace ublas {
         BOOST_UBLAS_INLINE
         map_array &operator = (const map_array &a) {
             if (this != &a) {
+                BOOST_UBLAS_ALLOCATION_SCOPE (copy);
                 resize (a.size_);
                 std::copy (a.data_, a.data_ + a.size_, data_);
             }
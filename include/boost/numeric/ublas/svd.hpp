@@ -0,0 +1,327 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_SVD_
+#define _BOOST_UBLAS_SVD_
+
+#include <boost/numeric/ublas/qr.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+// Singular value decomposition A = U S V^T of real matrices
+//
+// svd_jacobi is the one-sided Jacobi method (xGESVJ): rotations of pairs of columns
+// of A make all columns orthogonal, A V = U S. The pairs of a sweep are ordered as a
+// round robin tournament, so the n / 2 rotations of a round touch disjoint columns and
+// are done in parallel.
+//
+// thin_svd factors tall matrices, m >= n, by a QR factorization first and then applies
+// Jacobi to R^T, which converges in few sweeps (Drmac and Veselic). U (m x n) comes
+// out of the Householder reflectors of the QR factorization.
+//
+// randomized_svd approximates the k largest singular triplets of large matrices from
+// the projection of A on the range of A Omega, Omega random (Halko, Martinsson and
+// Tropp).
+//
+// Singular values are returned in decreasing order.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // Rotates the columns p and q of m (and of v) to make them orthogonal. Returns
+    // whether they were not orthogonal to the tolerance tol yet.
+    template<class M, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    bool svd_rotate (M &m, MV &v, bool vectors, typename M::size_type p, typename M::size_type q, typename M::value_type tol) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type real_type;
+
+        const size_type size1 (m.size1 ());
+        real_type alpha = real_type/*zero*/(), beta = real_type/*zero*/(), gamma = real_type/*zero*/();
+        for (size_type r = 0; r < size1; ++ r) {
+            const real_type mp (m (r, p)), mq (m (r, q));
+            alpha += mp * mp;
+            beta += mq * mq;
+            gamma += mp * mq;
+        }
+        if (type_traits<real_type>::type_abs (gamma) <= tol * type_traits<real_type>::type_sqrt (alpha * beta))
+            return false;
+        const real_type zeta ((beta - alpha) / (real_type (2) * gamma));
+        const real_type t ((zeta >= real_type/*zero*/() ? real_type (1) : real_type (-1)) /
+                           (type_traits<real_type>::type_abs (zeta) + type_traits<real_type>::type_sqrt (real_type (1) + zeta * zeta)));
+        const real_type c (real_type (1) / type_traits<real_type>::type_sqrt (real_type (1) + t * t));
+        const real_type s (c * t);
+        for (size_type r = 0; r < size1; ++ r) {
+            const real_type mp (m (r, p)), mq (m (r, q));
+            m (r, p) = c * mp - s * mq;
+            m (r, q) = s * mp + c * mq;
+        }
+        if (vectors) {
+            for (size_type r = 0; r < v.size1 (); ++ r) {
+                const real_type vp (v (r, p)), vq (v (r, q));
+                v (r, p) = c * vp - s * vq;
+                v (r, q) = s * vp + c * vq;
+            }
+        }
+        return true;
+    }
+
+    // Jacobi sweeps over all pairs of columns of m until they are orthogonal, then
+    // s := column norms, m := normalized columns, in decreasing order of s. v, when
+    // vectors is set, accumulates the rotations. Returns 0 or the number of sweeps done
+    // without convergence.
+    template<class M, class S, class MV>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    typename M::size_type svd_jacobi_sweeps (M &m, S &s, MV &v, bool vectors) {
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type real_type;
+
+        const size_type size1 (m.size1 ()), size2 (m.size2 ());
+        BOOST_UBLAS_CHECK (s.size () == size2, bad_size ());
+        const real_type tol (type_traits<real_type>::type_sqrt (real_type ((std::max) (size1, size_type (1)))) *
+                             std::numeric_limits<real_type>::epsilon ());
+        const size_type max_sweeps (30);
+        // Round robin with an extra player when the number of columns is odd
+        const size_type players (size2 + size2 % 2);
+        size_type info = max_sweeps;
+        for (size_type sweep = 0; sweep < max_sweeps && players > 1; ++ sweep) {
+            bool rotated = false;
+            for (size_type round = 0; round + 1 < players; ++ round) {
+                bool round_rotated = false;
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for reduction (|| : round_rotated) if (size1 * players >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+                for (difference_type k = 0; k < difference_type (players / 2); ++ k) {
+                    size_type p, q;
+                    if (k == 0) {
+                        p = round;
+                        q = players - 1;
+                    } else {
+                        p = (round + k) % (players - 1);
+                        q = (round + players - 1 - k) % (players - 1);
+                    }
+                    if (p < size2 && q < size2 && svd_rotate (m, v, vectors, (std::min) (p, q), (std::max) (p, q), tol))
+                        round_rotated = true;
+                }
+                rotated = rotated || round_rotated;
+            }
+            if (! rotated) {
+                info = 0;
+                break;
+            }
+        }
+        if (players <= 1)
+            info = 0;
+
+        // Singular values and left singular vectors, sorted
+        std::vector<std::pair<real_type, size_type> > order (size2);
+        for (size_type j = 0; j < size2; ++ j) {
+            real_type norm = real_type/*zero*/();
+            for (size_type r = 0; r < size1; ++ r)
+                norm += m (r, j) * m (r, j);
+            norm = type_traits<real_type>::type_sqrt (norm);
+            if (norm != real_type/*zero*/())
+                for (size_type r = 0; r < size1; ++ r)
+                    m (r, j) /= norm;
+            order [j] = std::make_pair (- norm, j);
+        }
+        std::stable_sort (order.begin (), order.end ());
+        for (size_type j = 0; j < size2; ++ j)
+            s (j) = - order [j].first;
+        // Permute the columns in place by following the cycles
+        std::vector<bool> done (size2, false);
+        for (size_type j = 0; j < size2; ++ j) {
+            if (done [j])
+                continue;
+            size_type c = j;
+            while (order [c].second != j) {
+                const size_type from (order [c].second);
+                for (size_type r = 0; r < size1; ++ r)
+                    std::swap (m (r, c), m (r, from));
+                if (vectors)
+                    for (size_type r = 0; r < v.size1 (); ++ r)
+                        std::swap (v (r, c), v (r, from));
+                done [c] = true;
+                c = from;
+            }
+            done [c] = true;
+        }
+        return info;
+    }
+
+    // Uniform pseudo random numbers in [-1, 1) for the test matrices of randomized_svd
+    // (the linear congruential generator of Numerical Recipes)
+    class svd_random {
+    public:
+        BOOST_UBLAS_INLINE
+        explicit svd_random (unsigned long seed): state_ (seed & 0xffffffffUL) {}
+        BOOST_UBLAS_INLINE
+        double operator () () {
+            state_ = (1664525UL * state_ + 1013904223UL) & 0xffffffffUL;
+            return double (state_ >> 8) / double (1UL << 23) - 1.0;
+        }
+    private:
+        unsigned long state_;
+    };
+
+    // Replaces the columns of y by an orthonormal basis of their span
+    template<class M>
+    BOOST_UBLAS_INLINE
+    void svd_orthonormalize (M &y) {
+        typedef typename M::value_type value_type;
+
+        vector<value_type> tau ((std::min) (y.size1 (), y.size2 ()));
+        M f (y);
+        qr_factorize (f, tau);
+        qr_form_q (f, tau, y);
+    }
+
+}
+
+    /** \brief Singular value decomposition A V = U S of a real matrix with size1 >=
+     *  size2 by one-sided Jacobi (xGESVJ).
+     *
+     *  On return \c m holds U, \c s the singular values in decreasing order and the
+     *  size2 x size2 matrix \c v the right singular vectors. Columns of U for zero
+     *  singular values are zero. The rotations of a round of each sweep work on
+     *  disjoint pairs of columns and are threaded; column major storage makes them
+     *  contiguous.
+     *
+     *  \return 0, or the number of sweeps done when the columns did not converge
+     */
+    template<class M, class S, class MV>
+    typename M::size_type svd_jacobi (M &m, S &s, MV &v) {
+        typedef typename M::value_type value_type;
+
+        BOOST_UBLAS_CHECK (v.size1 () == m.size2 () && v.size2 () == m.size2 (), bad_size ());
+        v.assign (identity_matrix<value_type> (m.size2 ()));
+        return detail::svd_jacobi_sweeps (m, s, v, true);
+    }
+
+    /** \brief Singular values of a real matrix by one-sided Jacobi, without the
+     *  singular vectors; \c m is overwritten.
+     */
+    template<class M, class S>
+    typename M::size_type svd_jacobi (M &m, S &s) {
+        typedef typename M::value_type value_type;
+
+        matrix<value_type> none (0, 0);
+        return detail::svd_jacobi_sweeps (m, s, none, false);
+    }
+
+    /** \brief Thin singular value decomposition A = U S V^T of a real matrix with
+     *  size1 >= size2, for size1 much larger than size2.
+     *
+     *  A is first reduced by the blocked QR factorization A = Q R; one-sided Jacobi
+     *  on R^T then gives R = V_R S U_R^T, so U = Q V_R (size1 x size2) and V = U_R
+     *  (size2 x size2). Only the QR factorization and the application of Q touch the
+     *  size1 rows.
+     *
+     *  \return 0, or the number of Jacobi sweeps done without convergence
+     */
+    template<class M, class MU, class S, class MV>
+    typename M::size_type thin_svd (const M &a, MU &u, S &s, MV &v) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type size1 (a.size1 ()), size2 (a.size2 ());
+        BOOST_UBLAS_CHECK (size1 >= size2, bad_size ());
+        BOOST_UBLAS_CHECK (u.size1 () == size1 && u.size2 () == size2, bad_size ());
+        BOOST_UBLAS_CHECK (v.size1 () == size2 && v.size2 () == size2, bad_size ());
+        matrix<value_type, column_major> f (a);
+        vector<value_type> tau (size2);
+        qr_factorize (f, tau);
+        // Jacobi on R^T: R^T V_R = U_R S, so R = V_R S U_R^T
+        matrix<value_type, column_major> rt (size2, size2), vr (size2, size2);
+        for (size_type j = 0; j < size2; ++ j)
+            for (size_type i = 0; i < size2; ++ i)
+                rt (i, j) = i >= j ? f (j, i) : value_type/*zero*/();
+        const size_type info (svd_jacobi (rt, s, vr));
+        v.assign (rt);
+        // U = Q [V_R; 0]
+        matrix<value_type, column_major> uq (size1, size2, value_type/*zero*/());
+        project (uq, range (0, size2), range (0, size2)).assign (vr);
+        qr_apply_q (f, tau, uq);
+        u.assign (uq);
+        return info;
+    }
+
+    /** \brief Singular values of a real matrix with size1 >= size2, in decreasing
+     *  order, by a QR factorization and one-sided Jacobi on R^T.
+     */
+    template<class M, class S>
+    typename M::size_type thin_svd (const M &a, S &s) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type size2 (a.size2 ());
+        BOOST_UBLAS_CHECK (a.size1 () >= size2, bad_size ());
+        matrix<value_type, column_major> f (a);
+        vector<value_type> tau (size2);
+        qr_factorize (f, tau);
+        matrix<value_type, column_major> rt (size2, size2);
+        for (size_type j = 0; j < size2; ++ j)
+            for (size_type i = 0; i < size2; ++ i)
+                rt (i, j) = i >= j ? f (j, i) : value_type/*zero*/();
+        return svd_jacobi (rt, s);
+    }
+
+    /** \brief Randomized truncated singular value decomposition A ~ U S V^T of a real
+     *  matrix: the k = s.size () largest singular values, \c u (size1 x k) and \c v
+     *  (size2 x k).
+     *
+     *  The range of A is sampled by Y = A Omega with k + \c oversample random columns,
+     *  sharpened by \c power iterations with (A A^T) and orthonormalized to Q. The thin
+     *  SVD of the small B^T = A^T Q then gives the approximation. Besides QR
+     *  factorizations of the samples the cost is 2 (power + 1) products with A or A^T.
+     *  The random numbers come from \c seed, so results are reproducible.
+     */
+    template<class M, class MU, class S, class MV>
+    void randomized_svd (const M &a, MU &u, S &s, MV &v,
+                         typename M::size_type oversample = 10, typename M::size_type power = 2,
+                         unsigned long seed = 1) {
+        typedef typename M::size_type size_type;
+        typedef typename M::value_type value_type;
+
+        const size_type size1 (a.size1 ()), size2 (a.size2 ());
+        const size_type k (s.size ());
+        BOOST_UBLAS_CHECK (k <= (std::min) (size1, size2), bad_size ());
+        BOOST_UBLAS_CHECK (u.size1 () == size1 && u.size2 () == k, bad_size ());
+        BOOST_UBLAS_CHECK (v.size1 () == size2 && v.size2 () == k, bad_size ());
+        const size_type l ((std::min) (k + oversample, (std::min) (size1, size2)));
+
+        matrix<value_type, column_major> omega (size2, l);
+        detail::svd_random random (seed);
+        for (size_type j = 0; j < l; ++ j)
+            for (size_type i = 0; i < size2; ++ i)
+                omega (i, j) = value_type (random ());
+        matrix<value_type, column_major> q (size1, l), z (size2, l);
+        noalias (q) = prod (a, omega);
+        detail::svd_orthonormalize (q);
+        for (size_type i = 0; i < power; ++ i) {
+            noalias (z) = prod (trans (a), q);
+            detail::svd_orthonormalize (z);
+            noalias (q) = prod (a, z);
+            detail::svd_orthonormalize (q);
+        }
+
+        // B^T = A^T Q = U_B S V_B^T, so A ~ Q B = (Q V_B) S U_B^T
+        noalias (z) = prod (trans (a), q);
+        matrix<value_type, column_major> ub (size2, l), vb (l, l);
+        vector<value_type> sb (l);
+        thin_svd (z, ub, sb, vb);
+        for (size_type j = 0; j < k; ++ j)
+            s (j) = sb (j);
+        u.assign (prod (q, project (vb, range (0, l), range (0, k))));
+        v.assign (project (ub, range (0, size2), range (0, k)));
+    }
+
+}}}
+
+#endif
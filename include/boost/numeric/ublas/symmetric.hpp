@@ -16,6 +16,7 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/triangular.hpp>
 #include <boost/numeric/ublas/detail/temporary.hpp>
+#include <boost/numeric/ublas/detail/symmetric_prod.hpp>
 
 // Iterators based on ideas of Jeremy Siek
 // Symmetric matrices are square. Thanks to Peter Schmitteckert for spotting this.
@@ -197,7 +198,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         symmetric_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -209,7 +212,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         symmetric_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -221,7 +226,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         symmetric_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -614,6 +614,86 @@ namespace boost { namespace numeric { namespace ublas {
         template<typename FLT>
         struct has_trivial_destructor<std::complex<FLT> > : public has_trivial_destructor<FLT> {};
 
+        // Structure of the operands of matrix products. Headers providing product
+        // kernels for structured matrices specialise prod_operand_traits.
+        struct general_operand_tag {};
+        struct triangular_operand_tag {};
+        struct symmetric_operand_tag {};
+        struct banded_operand_tag {};
+
+        template<class E>
+        struct prod_operand_traits {
+            typedef general_operand_tag category;
+        };
+        template<class E>
+        struct prod_operand_traits<matrix_reference<E> >:
+            public prod_operand_traits<typename boost::remove_const<E>::type> {};
+
+        // Side of the structured operand in a product
+        struct prod_left_tag {};
+        struct prod_right_tag {};
+
+        // Implicit matrices and vectors reduce products and sums with them to
+        // copies or scalings of the other operand, see detail/implicit_prod.hpp
+        struct implicit_operand_tag {};
+        struct identity_operand_tag: public implicit_operand_tag {};
+        struct zero_operand_tag: public implicit_operand_tag {};
+        struct scalar_operand_tag: public implicit_operand_tag {};
+        struct unit_operand_tag: public implicit_operand_tag {};
+
+        template<class T, class ALLOC>
+        struct prod_operand_traits<identity_matrix<T, ALLOC> > {
+            typedef identity_operand_tag category;
+        };
+        template<class T, class ALLOC>
+        struct prod_operand_traits<zero_matrix<T, ALLOC> > {
+            typedef zero_operand_tag category;
+        };
+        template<class T, class ALLOC>
+        struct prod_operand_traits<scalar_matrix<T, ALLOC> > {
+            typedef scalar_operand_tag category;
+        };
+        template<class T, class ALLOC>
+        struct prod_operand_traits<zero_vector<T, ALLOC> > {
+            typedef zero_operand_tag category;
+        };
+        template<class T, class ALLOC>
+        struct prod_operand_traits<scalar_vector<T, ALLOC> > {
+            typedef scalar_operand_tag category;
+        };
+        template<class T, class ALLOC>
+        struct prod_operand_traits<unit_vector<T, ALLOC> > {
+            typedef unit_operand_tag category;
+        };
+
+        // Sums and differences with a zero operand, and its side
+        template<class E1, class E2>
+        struct sum_operand_traits {
+            typedef typename prod_operand_traits<E1>::category category1;
+            typedef typename prod_operand_traits<E2>::category category2;
+            typedef typename boost::mpl::if_<boost::is_same<category2, zero_operand_tag>,
+                                             prod_right_tag, prod_left_tag>::type side;
+            typedef typename boost::mpl::if_c<boost::is_same<category1, zero_operand_tag>::value ||
+                                              boost::is_same<category2, zero_operand_tag>::value,
+                                              zero_operand_tag, general_operand_tag>::type category;
+        };
+
+        // Category and side of a product: implicit operands take precedence over
+        // structured ones, which only pay off for dense targets (DENSE)
+        template<class E1, class E2, bool DENSE>
+        struct prod_assign_traits {
+            typedef typename prod_operand_traits<E1>::category category1;
+            typedef typename prod_operand_traits<E2>::category category2;
+            static const bool implicit1 = boost::is_convertible<category1, implicit_operand_tag>::value;
+            static const bool implicit2 = boost::is_convertible<category2, implicit_operand_tag>::value;
+            typedef typename boost::mpl::if_c<implicit1 || (! implicit2 && ! boost::is_same<category1, general_operand_tag>::value),
+                                              prod_left_tag, prod_right_tag>::type side;
+            typedef typename boost::mpl::if_<boost::is_same<side, prod_left_tag>,
+                                             category1, category2>::type side_category;
+            typedef typename boost::mpl::if_c<DENSE || boost::is_convertible<side_category, implicit_operand_tag>::value,
+                                              side_category, general_operand_tag>::type category;
+        };
+
     }
 
 
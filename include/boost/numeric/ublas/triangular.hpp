@@ -229,7 +229,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         triangular_matrix &operator = (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -241,7 +243,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         triangular_matrix& operator += (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -253,7 +257,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         triangular_matrix& operator -= (const matrix_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae);
+            BOOST_UBLAS_PROFILE_TEMPORARY (matrix, temporary.data ().size ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -2021,6 +2027,408 @@ namespace boost { namespace numeric { namespace ublas {
     : matrix_temporary_traits< typename boost::remove_const<M>::type > {};
 
 
+    namespace detail {
+
+        // Stored element access for triangular operands of a product, without the
+        // per element zero/one tests of the general element access.
+        template<class E>
+        struct triangular_operand;
+        template<class M, class TRI>
+        struct triangular_operand<triangular_adaptor<M, TRI> > {
+            typedef triangular_adaptor<M, TRI> expression_type;
+            typedef TRI triangular_type;
+            typedef typename expression_type::size_type size_type;
+            typedef typename expression_type::const_reference const_reference;
+
+            static
+            BOOST_UBLAS_INLINE
+            const_reference element (const expression_type &e, size_type i, size_type j) {
+                return e.data () (i, j);
+            }
+        };
+        template<class T, class TRI, class L, class A>
+        struct triangular_operand<triangular_matrix<T, TRI, L, A> > {
+            typedef triangular_matrix<T, TRI, L, A> expression_type;
+            typedef TRI triangular_type;
+            typedef typename expression_type::size_type size_type;
+            typedef typename expression_type::const_reference const_reference;
+
+            static
+            BOOST_UBLAS_INLINE
+            const_reference element (const expression_type &e, size_type i, size_type j) {
+                return e.data () [triangular_type::element (L (), i, e.size1 (), j, e.size2 ())];
+            }
+        };
+
+        // Container operands appear as references in the product expression
+        template<class E>
+        struct triangular_operand<matrix_reference<E> >:
+            public triangular_operand<typename boost::remove_const<E>::type> {
+            typedef triangular_operand<typename boost::remove_const<E>::type> operand_type;
+
+            template<class S>
+            static
+            BOOST_UBLAS_INLINE
+            typename operand_type::const_reference element (const matrix_reference<E> &e, S i, S j) {
+                return operand_type::element (e.expression (), i, j);
+            }
+        };
+
+        // Index ranges of the strictly triangular part of row i and column j
+        template<class Z>
+        struct triangular_bounds {
+            typedef Z size_type;
+
+            static
+            BOOST_UBLAS_INLINE
+            size_type row_begin (lower_tag, size_type, size_type) {
+                return 0;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type row_end (lower_tag, size_type i, size_type size2) {
+                return (std::min) (i, size2);
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type column_begin (lower_tag, size_type j, size_type size1) {
+                return (std::min) (j + 1, size1);
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type column_end (lower_tag, size_type, size_type size1) {
+                return size1;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type row_begin (upper_tag, size_type i, size_type size2) {
+                return (std::min) (i + 1, size2);
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type row_end (upper_tag, size_type, size_type size2) {
+                return size2;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type column_begin (upper_tag, size_type, size_type) {
+                return 0;
+            }
+            static
+            BOOST_UBLAS_INLINE
+            size_type column_end (upper_tag, size_type j, size_type size1) {
+                return (std::min) (j, size1);
+            }
+        };
+
+        // Triangular matrix multiply (TRMM): r += A B with triangular A, or r += B A.
+        // The triangular dimension of A is split into diagonal blocks of
+        // BOOST_UBLAS_RANK_UPDATE_BLOCK. The rectangle of A beside a diagonal block
+        // holds no structural zero and goes to the dense block product (GEMM). In the
+        // diagonal block only the stored triangle is visited; the diagonal is taken
+        // from storage, as one for unit or skipped for strict triangular types.
+
+        // Stored elements of a triangular operand, indexed like the operand
+        template<class TO, class E>
+        class triangular_stored {
+        public:
+            typedef typename TO::size_type size_type;
+            typedef typename TO::const_reference const_reference;
+
+            BOOST_UBLAS_INLINE
+            explicit triangular_stored (const E &e):
+                e_ (e) {}
+
+            BOOST_UBLAS_INLINE
+            const_reference operator () (size_type i, size_type j) const {
+                return TO::element (e_, i, j);
+            }
+
+        private:
+            const E &e_;
+        };
+
+        // r (i, j) += A (i, k) B (k, j) for i in [i0, i1), j in [j0, j1), k in [k0, k1).
+        // r row major: tiles of BOOST_UBLAS_RANK_UPDATE_BLOCK in k and j keep a panel
+        // of B in cache for every row of A
+        template<class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void gemm_block (R &r, const E1 &e1, const E2 &e2,
+                         typename R::size_type i0, typename R::size_type i1,
+                         typename R::size_type j0, typename R::size_type j1,
+                         typename R::size_type k0, typename R::size_type k1, row_major_tag) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+
+            const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+            for (size_type kb = k0; kb < k1; kb += block) {
+                const size_type ke ((std::min) (kb + block, k1));
+                for (size_type jb = j0; jb < j1; jb += block) {
+                    const size_type je ((std::min) (jb + block, j1));
+                    for (size_type i = i0; i < i1; ++ i) {
+                        for (size_type k = kb; k < ke; ++ k) {
+                            const value_type a (e1 (i, k));
+                            for (size_type j = jb; j < je; ++ j)
+                                r (i, j) += a * e2 (k, j);
+                        }
+                    }
+                }
+            }
+        }
+        // r column major: tiles in k and i keep a panel of A in cache for every column of B
+        template<class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void gemm_block (R &r, const E1 &e1, const E2 &e2,
+                         typename R::size_type i0, typename R::size_type i1,
+                         typename R::size_type j0, typename R::size_type j1,
+                         typename R::size_type k0, typename R::size_type k1, column_major_tag) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+
+            const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+            for (size_type kb = k0; kb < k1; kb += block) {
+                const size_type ke ((std::min) (kb + block, k1));
+                for (size_type ib = i0; ib < i1; ib += block) {
+                    const size_type ie ((std::min) (ib + block, i1));
+                    for (size_type j = j0; j < j1; ++ j) {
+                        for (size_type k = kb; k < ke; ++ k) {
+                            const value_type b (e2 (k, j));
+                            for (size_type i = ib; i < ie; ++ i)
+                                r (i, j) += e1 (i, k) * b;
+                        }
+                    }
+                }
+            }
+        }
+
+        // r += A B for the rows [first, last) of A and r, the diagonal block of A only.
+        // r row major: B is streamed in panels of BOOST_UBLAS_RANK_UPDATE_BLOCK columns
+        template<class TO, class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void triangular_prod_left (R &r, const E1 &e1, const E2 &e2,
+                                   typename R::size_type first, typename R::size_type last, row_major_tag) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+            typedef typename TO::triangular_type triangular_type;
+            typedef typename triangular_type::triangular_type category;
+            typedef triangular_bounds<size_type> bounds;
+
+            const size_type size2 (r.size2 ()), inner (e1.size2 ());
+            const size_type diagonal ((std::min) (e1.size1 (), inner));
+            const size_type k_first ((std::min) (first, inner)), k_last ((std::min) (last, inner));
+            const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+            for (size_type jb = 0; jb < size2; jb += block) {
+                const size_type je ((std::min) (jb + block, size2));
+                for (size_type i = first; i < last; ++ i) {
+                    const size_type k_end ((std::min) (bounds::row_end (category (), i, inner), k_last));
+                    for (size_type k = (std::max) (bounds::row_begin (category (), i, inner), k_first); k < k_end; ++ k) {
+                        const value_type a (TO::element (e1, i, k));
+                        for (size_type j = jb; j < je; ++ j)
+                            r (i, j) += a * e2 (k, j);
+                    }
+                    if (i < diagonal) {
+                        if (triangular_type::other (i, i)) {
+                            const value_type a (TO::element (e1, i, i));
+                            for (size_type j = jb; j < je; ++ j)
+                                r (i, j) += a * e2 (i, j);
+                        } else if (triangular_type::one (i, i)) {
+                            for (size_type j = jb; j < je; ++ j)
+                                r (i, j) += e2 (i, j);
+                        }
+                    }
+                }
+            }
+        }
+        // r column major: one pass over the stored columns of the block per column of r
+        template<class TO, class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void triangular_prod_left (R &r, const E1 &e1, const E2 &e2,
+                                   typename R::size_type first, typename R::size_type last, column_major_tag) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+            typedef typename TO::triangular_type triangular_type;
+            typedef typename triangular_type::triangular_type category;
+            typedef triangular_bounds<size_type> bounds;
+
+            const size_type size1 (e1.size1 ()), size2 (r.size2 ()), inner (e1.size2 ());
+            const size_type diagonal ((std::min) (size1, inner));
+            const size_type k_first ((std::min) (first, inner)), k_last ((std::min) (last, inner));
+            for (size_type j = 0; j < size2; ++ j) {
+                for (size_type k = k_first; k < k_last; ++ k) {
+                    const value_type b (e2 (k, j));
+                    const size_type i_end ((std::min) (bounds::column_end (category (), k, size1), last));
+                    for (size_type i = (std::max) (bounds::column_begin (category (), k, size1), first); i < i_end; ++ i)
+                        r (i, j) += TO::element (e1, i, k) * b;
+                    if (k < diagonal) {
+                        if (triangular_type::other (k, k))
+                            r (k, j) += TO::element (e1, k, k) * b;
+                        else if (triangular_type::one (k, k))
+                            r (k, j) += b;
+                    }
+                }
+            }
+        }
+
+        // r += B A for the columns [first, last) of A and r, the diagonal block of A only.
+        // r row major: each row of B is scattered along the stored rows of the block
+        template<class TO, class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void triangular_prod_right (R &r, const E1 &e1, const E2 &e2,
+                                    typename R::size_type first, typename R::size_type last, row_major_tag) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+            typedef typename TO::triangular_type triangular_type;
+            typedef typename triangular_type::triangular_type category;
+            typedef triangular_bounds<size_type> bounds;
+
+            const size_type size1 (r.size1 ()), size2 (e2.size2 ()), inner (e2.size1 ());
+            const size_type diagonal ((std::min) (inner, size2));
+            const size_type k_first ((std::min) (first, inner)), k_last ((std::min) (last, inner));
+            for (size_type i = 0; i < size1; ++ i) {
+                for (size_type k = k_first; k < k_last; ++ k) {
+                    const value_type b (e1 (i, k));
+                    const size_type j_end ((std::min) (bounds::row_end (category (), k, size2), last));
+                    for (size_type j = (std::max) (bounds::row_begin (category (), k, size2), first); j < j_end; ++ j)
+                        r (i, j) += b * TO::element (e2, k, j);
+                    if (k < diagonal) {
+                        if (triangular_type::other (k, k))
+                            r (i, k) += b * TO::element (e2, k, k);
+                        else if (triangular_type::one (k, k))
+                            r (i, k) += b;
+                    }
+                }
+            }
+        }
+        // r column major: column j of r combines the stored part of column j of the block
+        template<class TO, class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void triangular_prod_right (R &r, const E1 &e1, const E2 &e2,
+                                    typename R::size_type first, typename R::size_type last, column_major_tag) {
+            typedef typename R::size_type size_type;
+            typedef typename R::value_type value_type;
+            typedef typename TO::triangular_type triangular_type;
+            typedef typename triangular_type::triangular_type category;
+            typedef triangular_bounds<size_type> bounds;
+
+            const size_type size1 (r.size1 ()), size2 (e2.size2 ()), inner (e2.size1 ());
+            const size_type diagonal ((std::min) (inner, size2));
+            const size_type k_first ((std::min) (first, inner)), k_last ((std::min) (last, inner));
+            for (size_type j = first; j < last; ++ j) {
+                const size_type k_end ((std::min) (bounds::column_end (category (), j, inner), k_last));
+                for (size_type k = (std::max) (bounds::column_begin (category (), j, inner), k_first); k < k_end; ++ k) {
+                    const value_type a (TO::element (e2, k, j));
+                    for (size_type i = 0; i < size1; ++ i)
+                        r (i, j) += e1 (i, k) * a;
+                }
+                if (j < diagonal) {
+                    if (triangular_type::other (j, j)) {
+                        const value_type a (TO::element (e2, j, j));
+                        for (size_type i = 0; i < size1; ++ i)
+                            r (i, j) += e1 (i, j) * a;
+                    } else if (triangular_type::one (j, j)) {
+                        for (size_type i = 0; i < size1; ++ i)
+                            r (i, j) += e1 (i, j);
+                    }
+                }
+            }
+        }
+
+        // r += A B: block rows of r are independent, each takes the rectangle of A left
+        // (lower) or right (upper) of its diagonal block
+        template<class O, class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void triangular_prod (R &r, const E1 &e1, const E2 &e2, prod_left_tag) {
+            typedef triangular_operand<E1> operand_type;
+            typedef typename R::size_type size_type;
+            typedef typename R::difference_type difference_type;
+            const bool lower = boost::is_convertible<typename operand_type::triangular_type::triangular_type, lower_tag>::value;
+
+            const size_type size1 (e1.size1 ()), size2 (r.size2 ()), inner (e1.size2 ());
+            const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+            const size_type blocks ((size1 + block - 1) / block);
+            const triangular_stored<operand_type, E1> a (e1);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (size1 * inner / 2 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type b = 0; b < difference_type (blocks); ++ b) {
+                const size_type first (b * block), last ((std::min) (first + block, size1));
+                const size_type k_first ((std::min) (first, inner)), k_last ((std::min) (last, inner));
+                if (lower)
+                    gemm_block (r, a, e2, first, last, 0, size2, 0, k_first, O ());
+                else
+                    gemm_block (r, a, e2, first, last, 0, size2, k_last, inner, O ());
+                triangular_prod_left<operand_type> (r, e1, e2, first, last, O ());
+            }
+        }
+        // r += B A: block columns of r are independent, each takes the rectangle of A
+        // below (lower) or above (upper) its diagonal block
+        template<class O, class R, class E1, class E2>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void triangular_prod (R &r, const E1 &e1, const E2 &e2, prod_right_tag) {
+            typedef triangular_operand<E2> operand_type;
+            typedef typename R::size_type size_type;
+            typedef typename R::difference_type difference_type;
+            const bool lower = boost::is_convertible<typename operand_type::triangular_type::triangular_type, lower_tag>::value;
+
+            const size_type size1 (r.size1 ()), size2 (e2.size2 ()), inner (e2.size1 ());
+            const size_type block (BOOST_UBLAS_RANK_UPDATE_BLOCK);
+            const size_type blocks ((size2 + block - 1) / block);
+            const triangular_stored<operand_type, E2> a (e2);
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for schedule (dynamic) if (size1 * inner / 2 * size2 >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type b = 0; b < difference_type (blocks); ++ b) {
+                const size_type first (b * block), last ((std::min) (first + block, size2));
+                const size_type k_first ((std::min) (first, inner)), k_last ((std::min) (last, inner));
+                if (lower)
+                    gemm_block (r, e1, a, 0, size1, first, last, k_last, inner, O ());
+                else
+                    gemm_block (r, e1, a, 0, size1, first, last, 0, k_first, O ());
+                triangular_prod_right<operand_type> (r, e1, e2, first, last, O ());
+            }
+        }
+
+        template<class M, class TRI>
+        struct prod_operand_traits<triangular_adaptor<M, TRI> > {
+            typedef triangular_operand_tag category;
+        };
+        template<class T, class TRI, class L, class A>
+        struct prod_operand_traits<triangular_matrix<T, TRI, L, A> > {
+            typedef triangular_operand_tag category;
+        };
+
+    }
+
+    // Products with a triangular_adaptor or triangular_matrix assigned to a dense
+    // matrix use the TRMM kernels, accumulating into the matrix itself for = and +=
+    template<template <class T1, class T2> class F, class M, class E, class TV, class S>
+    // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+    void structured_matrix_assign (M &m, const E &e, TV, detail::triangular_operand_tag, S) {
+        typedef typename boost::mpl::if_<boost::is_same<typename M::orientation_category, column_major_tag>,
+                                         column_major_tag, row_major_tag>::type orientation_category;
+        typedef typename boost::mpl::if_<boost::is_same<orientation_category, column_major_tag>,
+                                         column_major, row_major>::type layout_type;
+        typedef detail::accumulate_assign_traits<F> accumulate_traits;
+        BOOST_UBLAS_CHECK (m.size1 () == e.size1 (), bad_size ());
+        BOOST_UBLAS_CHECK (m.size2 () == e.size2 (), bad_size ());
+        if (accumulate_traits::direct) {
+            if (accumulate_traits::clear)
+                indexing_matrix_assign_scalar<scalar_assign> (m, typename M::value_type/*zero*/(), orientation_category ());
+            detail::triangular_prod<orientation_category> (m, e.expression1 (), e.expression2 (), S ());
+            return;
+        }
+        matrix<TV, layout_type> r (e.size1 (), e.size2 ());
+        r.clear ();
+        detail::triangular_prod<orientation_category> (r, e.expression1 (), e.expression2 (), S ());
+        indexing_matrix_assign<F> (m, r, orientation_category ());
+    }
+    // Triangular matrix vector products keep the generic evaluation
+    template<template <class T1, class T2> class F, class V, class E, class TV, class S>
+    BOOST_UBLAS_INLINE
+    void structured_vector_assign (V &v, const E &e, TV, detail::triangular_operand_tag, S) {
+        structured_vector_assign<F> (v, e, TV (), detail::general_operand_tag (), S ());
+    }
+
     template<class E1, class E2>
     struct matrix_vector_solve_traits {
         typedef typename promote_traits<typename E1::value_type, typename E2::value_type>::promote_type promote_type;
@@ -0,0 +1,276 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _BOOST_UBLAS_TSQR_
+#define _BOOST_UBLAS_TSQR_
+
+#include <boost/numeric/ublas/qr.hpp>
+#include <vector>
+
+// Tall skinny QR (TSQR) of matrices with many more rows than columns
+//
+// The rows are split into blocks (leaves) that are factored independently with
+// qr_factorize. The R factors of neighbouring blocks are then stacked and factored
+// again, pairwise in a binary reduction tree, until one R remains. Q is kept
+// implicitly as the Householder vectors of the leaves and of the tree nodes.
+
+namespace boost { namespace numeric { namespace ublas {
+
+namespace detail {
+
+    // mv (o:o + m.size1 (), :) := Q^H mv (...) or Q mv (...) for a QR factorization m, tau
+    template<class M, class V, class MV>
+    BOOST_UBLAS_INLINE
+    void tsqr_apply_block (const M &m, const V &tau, MV &mv, typename M::size_type o, bool herm, vector_tag) {
+        vector_range<MV> c (mv, range (o, o + m.size1 ()));
+        qr_apply (m, tau, c, herm, vector_tag ());
+    }
+    template<class M, class V, class MV>
+    BOOST_UBLAS_INLINE
+    void tsqr_apply_block (const M &m, const V &tau, MV &mv, typename M::size_type o, bool herm, matrix_tag) {
+        matrix_range<MV> c (mv, range (o, o + m.size1 ()), range (0, mv.size2 ()));
+        qr_apply (m, tau, c, herm, matrix_tag ());
+    }
+
+}
+
+    /** \brief TSQR factorization A = Q R of a dense matrix with size1 >= size2.
+     *
+     *  \c factorize splits the rows of A into leaves of at least size2 rows each,
+     *  factors them in parallel (one leaf per thread with \c BOOST_UBLAS_USE_OPENMP)
+     *  and combines their R factors in a binary tree; each level of the tree is
+     *  parallel as well. Only the size2 x size2 R factors travel between the leaves,
+     *  so the tall matrix is read once, by one thread per block of rows.
+     *
+     *  Q is applied without forming it: \c apply_qt leaves the components of a right
+     *  hand side along the columns of A in its first size2 rows, as \c qr_apply_qt
+     *  does, and \c solve computes least squares solutions from them.
+     *
+     *  \tparam M dense matrix type of the leaves and of R, e.g. \c matrix<double, column_major>
+     */
+    template<class M>
+    class tsqr_factorization {
+    public:
+        typedef M matrix_type;
+        typedef typename M::size_type size_type;
+        typedef typename M::difference_type difference_type;
+        typedef typename M::value_type value_type;
+        typedef vector<value_type> tau_type;
+
+        // Construction and destruction
+        BOOST_UBLAS_INLINE
+        tsqr_factorization ():
+            size1_ (0), size2_ (0) {}
+        template<class AE>
+        BOOST_UBLAS_INLINE
+        explicit tsqr_factorization (const matrix_expression<AE> &ae, size_type leaves = 0):
+            size1_ (0), size2_ (0) {
+            factorize (ae, leaves);
+        }
+
+        // Accessors
+        BOOST_UBLAS_INLINE
+        size_type size1 () const {
+            return size1_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type size2 () const {
+            return size2_;
+        }
+        BOOST_UBLAS_INLINE
+        size_type leaves () const {
+            return leaf_.size ();
+        }
+        /** \brief The upper triangular size2 x size2 factor R */
+        BOOST_UBLAS_INLINE
+        const matrix_type &r () const {
+            return r_;
+        }
+
+        /** \brief Factors \c ae into \c leaves blocks of rows; 0 selects one block per
+         *  thread. The count is reduced so that every block has at least size2 rows.
+         *
+         *  \return 0 if R has a nonzero diagonal, otherwise the index plus one of its
+         *  first zero diagonal element, as \c qr_factorize
+         */
+        template<class AE>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        size_type factorize (const matrix_expression<AE> &ae, size_type leaves = 0) {
+            const AE &a (ae ());
+            size1_ = a.size1 ();
+            size2_ = a.size2 ();
+            BOOST_UBLAS_CHECK (size1_ >= size2_, bad_size ());
+            if (leaves == 0) {
+#ifdef BOOST_UBLAS_USE_OPENMP
+                leaves = omp_get_max_threads ();
+#else
+                leaves = 1;
+#endif
+            }
+            if (size2_ > 0)
+                leaves = (std::min) (leaves, size1_ / size2_);
+            leaves = (std::max) (leaves, size_type (1));
+
+            // Leaves
+            offset_.resize (leaves + 1);
+            for (size_type b = 0; b <= leaves; ++ b)
+                offset_ [b] = b * (size1_ / leaves) + (std::min) (b, size1_ % leaves);
+            leaf_.assign (leaves, matrix_type ());
+            leaf_tau_.assign (leaves, tau_type (size2_));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (leaves > 1 && size1_ * size2_ * size2_ >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type b = 0; b < difference_type (leaves); ++ b) {
+                leaf_ [b] = project (a, range (offset_ [b], offset_ [b + 1]), range (0, size2_));
+                qr_factorize (leaf_ [b], leaf_tau_ [b]);
+            }
+
+            // Reduction tree; node n stacks the R factors of the leaves left_ [n] and
+            // right_ [n] and leaves the combined R with the left one
+            node_.clear ();
+            node_tau_.clear ();
+            left_.clear ();
+            right_.clear ();
+            for (size_type stride = 1; stride < leaves; stride *= 2) {
+                const size_type first (node_.size ());
+                for (size_type b = 0; b + stride < leaves; b += 2 * stride) {
+                    left_.push_back (b);
+                    right_.push_back (b + stride);
+                }
+                const size_type count (left_.size () - first);
+                node_.resize (first + count, matrix_type (2 * size2_, size2_));
+                node_tau_.resize (first + count, tau_type (size2_));
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (count > 1 && count * size2_ * size2_ * size2_ >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+                for (difference_type c = 0; c < difference_type (count); ++ c) {
+                    const size_type n (first + c);
+                    matrix_type &s (node_ [n]);
+                    s.clear ();
+                    const matrix_type &rl (top (left_ [n], stride));
+                    const matrix_type &rr (top (right_ [n], stride));
+                    for (size_type i = 0; i < size2_; ++ i)
+                        for (size_type j = i; j < size2_; ++ j) {
+                            s (i, j) = rl (i, j);
+                            s (size2_ + i, j) = rr (i, j);
+                        }
+                    qr_factorize (s, node_tau_ [n]);
+                }
+            }
+
+            const matrix_type &root (node_.empty () ? leaf_ [0] : node_.back ());
+            r_.resize (size2_, size2_, false);
+            r_.clear ();
+            size_type singular = 0;
+            for (size_type i = 0; i < size2_; ++ i) {
+                for (size_type j = i; j < size2_; ++ j)
+                    r_ (i, j) = root (i, j);
+                if (r_ (i, i) == value_type/*zero*/() && singular == 0)
+                    singular = i + 1;
+            }
+            return singular;
+        }
+
+        /** \brief Computes Q^T mv (Q^H mv for complex matrices); \c mv is a vector or a
+         *  matrix with size1 rows. Afterwards its first size2 rows are the components
+         *  of \c mv in the column space of A.
+         */
+        template<class MV>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void apply_qt (MV &mv) const {
+            typedef typename MV::type_category type_category;
+            BOOST_UBLAS_CHECK (detail::rhs_rows (mv, type_category ()) == size1_, bad_size ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (leaf_.size () > 1 && size1_ * size2_ >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type b = 0; b < difference_type (leaf_.size ()); ++ b)
+                detail::tsqr_apply_block (leaf_ [b], leaf_tau_ [b], mv, offset_ [b], true, type_category ());
+            for (size_type n = 0; n < node_.size (); ++ n)
+                apply_node (n, mv, true, type_category ());
+        }
+
+        /** \brief Computes Q mv; \c mv is a vector or a matrix with size1 rows. */
+        template<class MV>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void apply_q (MV &mv) const {
+            typedef typename MV::type_category type_category;
+            BOOST_UBLAS_CHECK (detail::rhs_rows (mv, type_category ()) == size1_, bad_size ());
+            for (size_type n = node_.size (); n-- > 0; )
+                apply_node (n, mv, false, type_category ());
+#ifdef BOOST_UBLAS_USE_OPENMP
+#pragma omp parallel for if (leaf_.size () > 1 && size1_ * size2_ >= BOOST_UBLAS_OPENMP_THRESHOLD)
+#endif
+            for (difference_type b = 0; b < difference_type (leaf_.size ()); ++ b)
+                detail::tsqr_apply_block (leaf_ [b], leaf_tau_ [b], mv, offset_ [b], false, type_category ());
+        }
+
+        /** \brief Forms the first \c q.size2 () columns of Q, e.g. the thin Q with size2 columns. */
+        template<class MQ>
+        BOOST_UBLAS_INLINE
+        void form_q (MQ &q) const {
+            BOOST_UBLAS_CHECK (q.size1 () == size1_, bad_size ());
+            q.assign (identity_matrix<typename MQ::value_type> (q.size1 (), q.size2 ()));
+            apply_q (q);
+        }
+
+        /** \brief Least squares solution of A x = mv for A of full column rank; on
+         *  return the first size2 rows of \c mv hold the solutions, as \c qr_solve.
+         */
+        template<class MV>
+        BOOST_UBLAS_INLINE
+        void solve (MV &mv) const {
+            apply_qt (mv);
+            detail::qr_back_substitute (r_, size2_, mv, typename MV::type_category ());
+        }
+
+    private:
+        // The current R factor of leaf b, stride being the tree level under construction
+        BOOST_UBLAS_INLINE
+        const matrix_type &top (size_type b, size_type stride) const {
+            if (stride == 1)
+                return leaf_ [b];
+            // The last node that combined into leaf b
+            for (size_type n = node_.size (); n-- > 0; )
+                if (left_ [n] == b && right_ [n] < b + stride)
+                    return node_ [n];
+            return leaf_ [b];
+        }
+
+        // Applies the reflectors of node n to the top size2 rows of its two leaves
+        template<class MV, class TAG>
+        // BOOST_UBLAS_INLINE This function seems to be big. So we do not let the compiler inline it.
+        void apply_node (size_type n, MV &mv, bool herm, TAG) const {
+            const size_type cols (detail::rhs_columns (mv, TAG ()));
+            const size_type ol (offset_ [left_ [n]]), or_ (offset_ [right_ [n]]);
+            matrix<value_type> s (2 * size2_, cols);
+            for (size_type i = 0; i < size2_; ++ i)
+                for (size_type q = 0; q < cols; ++ q) {
+                    s (i, q) = detail::rhs_element (mv, ol + i, q, TAG ());
+                    s (size2_ + i, q) = detail::rhs_element (mv, or_ + i, q, TAG ());
+                }
+            detail::qr_apply (node_ [n], node_tau_ [n], s, herm, matrix_tag ());
+            for (size_type i = 0; i < size2_; ++ i)
+                for (size_type q = 0; q < cols; ++ q) {
+                    detail::rhs_element (mv, ol + i, q, TAG ()) = s (i, q);
+                    detail::rhs_element (mv, or_ + i, q, TAG ()) = s (size2_ + i, q);
+                }
+        }
+
+        size_type size1_;
+        size_type size2_;
+        std::vector<size_type> offset_;
+        std::vector<matrix_type> leaf_;
+        std::vector<tau_type> leaf_tau_;
+        std::vector<matrix_type> node_;
+        std::vector<tau_type> node_tau_;
+        std::vector<size_type> left_;
+        std::vector<size_type> right_;
+        matrix_type r_;
+    };
+
+}}}
+
+#endif
@@ -327,7 +327,9 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     vector &operator = (const vector_expression<AE> &ae) {
+	         BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
 	         self_type temporary (ae);
+	         BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
 	         return assign_temporary (temporary);
 	     }
 
@@ -356,7 +358,9 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     vector &operator += (const vector_expression<AE> &ae) {
+	         BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
 	         self_type temporary (*this + ae);
+	         BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
 	         return assign_temporary (temporary);
 	     }
 
@@ -394,7 +398,9 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     vector &operator -= (const vector_expression<AE> &ae) {
+	         BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
 	         self_type temporary (*this - ae);
+	         BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
 	         return assign_temporary (temporary);
 	     }
 
@@ -1105,7 +1111,9 @@ namespace boost { namespace numeric { namespace ublas {
          template<class AE>
          BOOST_UBLAS_INLINE
          fixed_vector &operator = (const vector_expression<AE> &ae) {
+             BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
              self_type temporary (ae);
+             BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
              return assign_temporary (temporary);
          }
 
@@ -1134,7 +1142,9 @@ namespace boost { namespace numeric { namespace ublas {
          template<class AE>
          BOOST_UBLAS_INLINE
          fixed_vector &operator += (const vector_expression<AE> &ae) {
+             BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
              self_type temporary (*this + ae);
+             BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
              return assign_temporary (temporary);
          }
 
@@ -1172,7 +1182,9 @@ namespace boost { namespace numeric { namespace ublas {
          template<class AE>
          BOOST_UBLAS_INLINE
          fixed_vector &operator -= (const vector_expression<AE> &ae) {
+             BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
              self_type temporary (*this - ae);
+             BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
              return assign_temporary (temporary);
          }
 
@@ -2579,7 +2591,9 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     c_vector &operator = (const vector_expression<AE> &ae) {
+	         BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
 	         self_type temporary (ae);
+	         BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
 	         return assign_temporary (temporary);
 	     }
 	     template<class AE>
@@ -2593,7 +2607,9 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     c_vector &operator += (const vector_expression<AE> &ae) {
+	         BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
 	         self_type temporary (*this + ae);
+	         BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
 	         return assign_temporary (temporary);
 	     }
 	     template<class C>          // Container assignment without temporary
@@ -2611,7 +2627,9 @@ namespace boost { namespace numeric { namespace ublas {
 	     template<class AE>
 	     BOOST_UBLAS_INLINE
 	     c_vector &operator -= (const vector_expression<AE> &ae) {
+	         BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
 	         self_type temporary (*this - ae);
+	         BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.size ());
 	         return assign_temporary (temporary);
 	     }
 	     template<class C>          // Container assignment without temporary
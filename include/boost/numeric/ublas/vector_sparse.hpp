@@ -474,7 +474,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_vector &operator = (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, detail::map_capacity (data()));
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -488,7 +490,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_vector &operator += (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, detail::map_capacity (data()));
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -506,7 +510,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         mapped_vector &operator -= (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, detail::map_capacity (data()));
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1080,7 +1086,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         compressed_vector &operator = (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -1094,7 +1102,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         compressed_vector &operator += (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1112,7 +1122,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         compressed_vector &operator -= (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1754,7 +1766,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_vector &operator = (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class AE>
@@ -1768,7 +1782,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_vector &operator += (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this + ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
@@ -1786,7 +1802,9 @@ namespace boost { namespace numeric { namespace ublas {
         template<class AE>
         BOOST_UBLAS_INLINE
         coordinate_vector &operator -= (const vector_expression<AE> &ae) {
+            BOOST_UBLAS_ALLOCATION_SCOPE (temporary);
             self_type temporary (*this - ae, capacity_);
+            BOOST_UBLAS_PROFILE_TEMPORARY (vector, temporary.nnz ());
             return assign_temporary (temporary);
         }
         template<class C>          // Container assignment without temporary
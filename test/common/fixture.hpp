@@ -0,0 +1,49 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef _HPP_FIXTURE_
+#define _HPP_FIXTURE_
+
+#include <complex>
+#include <cstddef>
+
+// Tolerance of the checks, relative to the size of the compared results
+static const double TOL (1.0e-10);
+
+// Assigns the real part only to real types
+template<class T>
+inline void set (T &x, double re, double /*im*/) {
+    x = T (re);
+}
+template<class T>
+inline void set (std::complex<T> &x, double re, double im) {
+    x = std::complex<T> (T (re), T (im));
+}
+
+// Deterministic dense matrix, different for every seed; the diagonal is shifted so that
+// the square matrices are well conditioned, complex types get imaginary parts
+template<class M>
+void fill (M &m, std::size_t seed) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            set (m (i, j), ((i * 7 + j * 3 + i * j + seed) % 13) / 4.0 - 1.5 + (i == j ? 3.0 + i % 4 : 0.0), ((i + 2 * j + seed) % 5) / 8.0);
+}
+
+template<class V>
+void fill_vector (V &v, std::size_t seed) {
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        set (v (i), ((i * 5 + seed) % 7) / 3.0 - 1.0, ((i + seed) % 3) / 4.0);
+}
+
+// Small integers, so that the products of real matrices are exact
+template<class M>
+void fill_matrix (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type ((i * 7 + j * 3) % 11 - 5.0);
+}
+
+#endif
@@ -0,0 +1,171 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_UBLAS_TRACK_ALLOCATIONS
+#define BOOST_UBLAS_TRACK_ALLOCATIONS
+#endif
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/banded.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/allocation.hpp>
+#include <sstream>
+#include "utils.hpp"
+
+namespace ublas = boost::numeric::ublas;
+namespace allocation = boost::numeric::ublas::allocation;
+
+BOOST_UBLAS_TEST_DEF ( test_categories )
+{
+    allocation::reset ();
+    {
+        ublas::vector<double> u (10, 1.0);
+        ublas::vector<double> v (u);
+        allocation::statistics s (allocation::collect ());
+        BOOST_UBLAS_TEST_CHECK_EQ (s.allocations [allocation::construction], 1u);
+        BOOST_UBLAS_TEST_CHECK_EQ (s.allocations [allocation::copy], 1u);
+        BOOST_UBLAS_TEST_CHECK_EQ (s.bytes [allocation::copy], 10u * sizeof (double));
+        BOOST_UBLAS_TEST_CHECK_EQ (s.live_bytes, 20u * sizeof (double));
+
+        v.resize (20);
+        ublas::vector<double> w;
+        w = u + u;
+        s = allocation::collect ();
+        BOOST_UBLAS_TEST_CHECK_EQ (s.allocations [allocation::resize], 1u);
+        BOOST_UBLAS_TEST_CHECK_EQ (s.allocations [allocation::temporary], 1u);
+        BOOST_UBLAS_TEST_CHECK_EQ (s.deallocations, 1u);
+        BOOST_UBLAS_TEST_CHECK_EQ (s.peak_bytes, 40u * sizeof (double));
+    }
+    allocation::statistics s (allocation::collect ());
+    BOOST_UBLAS_TEST_CHECK_EQ (s.live_bytes, 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (s.deallocations, s.total_allocations ());
+
+    // the growth of a compressed matrix is a resize
+    ublas::compressed_matrix<double> c (100, 100);
+    allocation::reset ();
+    for (std::size_t i = 0; i < 100; ++ i)
+        for (std::size_t j = i; j < (std::min) (i + 3, std::size_t (100)); ++ j)
+            c.push_back (i, j, 1.0);
+    s = allocation::collect ();
+    BOOST_UBLAS_TEST_CHECK (s.allocations [allocation::resize] > 0);
+    BOOST_UBLAS_TEST_CHECK_EQ (s.total_allocations (), s.allocations [allocation::resize]);
+}
+
+// A loop assigning with noalias does not allocate once its operands exist
+BOOST_UBLAS_TEST_DEF ( test_steady_state )
+{
+    ublas::matrix<double> a (8, 8, 1.0), b (8, 8, 2.0), c (8, 8);
+    ublas::vector<double> x (8, 1.0), y (8);
+    allocation::reset ();
+    for (int i = 0; i < 10; ++ i) {
+        ublas::noalias (c) = ublas::prod (a, b);
+        ublas::noalias (y) = ublas::prod (a, x);
+        ublas::noalias (x) += 0.5 * y;
+    }
+    BOOST_UBLAS_TEST_CHECK_EQ (allocation::collect ().total_allocations (), 0u);
+
+    for (int i = 0; i < 10; ++ i)
+        c = ublas::prod (a, b);
+    BOOST_UBLAS_TEST_CHECK_EQ (allocation::collect ().allocations [allocation::temporary], 10u);
+}
+
+// The rank-1 updates of lu_factorize read their operands in place, so refactoring
+// reuses all storage; only the copy kept by the type checks is allocated
+BOOST_UBLAS_TEST_DEF ( test_refactor )
+{
+    const std::size_t n (40);
+    ublas::matrix<double> a (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            a (i, j) = i == j ? 10.0 : 1.0 / (1.0 + i + j);
+    ublas::lu_factorization<ublas::matrix<double> > lu (a);
+    allocation::reset ();
+    for (int i = 0; i < 3; ++ i)
+        lu.refactor (a);
+    const unsigned long long checked (BOOST_UBLAS_TYPE_CHECK ? 3 : 0);
+    BOOST_UBLAS_TEST_CHECK_EQ (allocation::collect ().total_allocations (), checked);
+}
+
+// Products with structured operands accumulate into the target for = and +=,
+// other assignments evaluate the product into one temporary
+BOOST_UBLAS_TEST_DEF ( test_structured_prod )
+{
+    const std::size_t n (40);
+    ublas::matrix<double> a (n, n, 1.0), b (n, 7, 2.0), c (n, 7), d (7, n);
+    ublas::symmetric_matrix<double> s (n, n);
+    ublas::banded_matrix<double> g (n, n, 2, 3);
+    ublas::vector<double> x (n, 1.0), y (n);
+    s = a;
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = i > 2 ? i - 2 : 0; j < (std::min) (i + 4, n); ++ j)
+            g (i, j) = 1.0;
+    ublas::triangular_adaptor<ublas::matrix<double>, ublas::lower> t (a);
+    allocation::reset ();
+    ublas::noalias (c) = ublas::prod (t, b);
+    ublas::noalias (d) += ublas::prod (ublas::trans (b), t);
+    ublas::noalias (c) = ublas::prod (s, b);
+    ublas::noalias (d) = ublas::prod (ublas::trans (b), s);
+    ublas::noalias (y) = ublas::prod (s, x);
+    ublas::noalias (c) += ublas::prod (g, b);
+    ublas::noalias (d) = ublas::prod (ublas::trans (b), g);
+    ublas::noalias (y) += ublas::prod (x, g);
+    BOOST_UBLAS_TEST_CHECK_EQ (allocation::collect ().total_allocations (), 0u);
+
+    ublas::noalias (c) -= ublas::prod (t, b);
+    BOOST_UBLAS_TEST_CHECK_EQ (allocation::collect ().total_allocations (), 1u);
+}
+
+namespace {
+    struct recorder: allocation::observer {
+        recorder (): allocations (0), deallocations (0), bytes (0) {}
+
+        virtual void allocated (allocation::category, std::size_t n) {
+            ++ allocations;
+            bytes += n;
+        }
+        virtual void deallocated (std::size_t) {
+            ++ deallocations;
+        }
+
+        std::size_t allocations, deallocations, bytes;
+    };
+}
+
+BOOST_UBLAS_TEST_DEF ( test_observers )
+{
+    recorder r;
+    allocation::add_observer (r);
+    {
+        ublas::mapped_vector<double, ublas::map_array<std::size_t, double> > m (10);
+        m (2) = 3.0;
+        ublas::vector<float> v (4);
+    }
+    allocation::remove_observer (r);
+    ublas::vector<float> v (4);
+    BOOST_UBLAS_TEST_CHECK_EQ (r.allocations, 2u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r.deallocations, 2u);
+
+    std::ostringstream out;
+    allocation::dump (out);
+    BOOST_UBLAS_TEST_CHECK (out.str ().find ("peak bytes") != std::string::npos);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_categories );
+    BOOST_UBLAS_TEST_DO( test_steady_state );
+    BOOST_UBLAS_TEST_DO( test_refactor );
+    BOOST_UBLAS_TEST_DO( test_structured_prod );
+    BOOST_UBLAS_TEST_DO( test_observers );
+
+    BOOST_UBLAS_TEST_END();
+}
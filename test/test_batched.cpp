@@ -0,0 +1,215 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/batched.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include <vector>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+static const std::size_t BATCH (13); // not a multiple of the lane count
+
+// Different for every matrix of a batch; the singular case of test_batched_lu relies on these values
+template<class M>
+void fill_batch (M &m, std::size_t b) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (((i * 7 + j * 3 + b * 5) % 11) / 3.0 + (i == j ? b % 3 : 0));
+}
+
+template<class T, std::size_t N>
+BOOST_UBLAS_TEST_DEF ( test_batched_conversion_prod )
+{
+    typedef ublas::bounded_matrix<T, N, N> matrix_type;
+    typedef ublas::bounded_matrix<T, N, 2> rhs_type;
+    std::vector<matrix_type> a (BATCH);
+    std::vector<rhs_type> b (BATCH);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        fill_batch (a [k], k);
+        fill_batch (b [k], k + 1);
+    }
+
+    ublas::batched_matrix<T, N, N> ba (a.begin (), a.end ());
+    ublas::batched_matrix<T, N, 2> bb (b.begin (), b.end ());
+    BOOST_UBLAS_TEST_CHECK_EQ (ba.size (), BATCH);
+    BOOST_UBLAS_TEST_CHECK_EQ (ba.packs (), (BATCH + BOOST_UBLAS_BATCH_LANES - 1) / BOOST_UBLAS_BATCH_LANES);
+
+    std::vector<matrix_type> back (BATCH);
+    ba.copy_to (back.begin ());
+    for (std::size_t k = 0; k < BATCH; ++ k)
+        BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (back [k], a [k], N, N);
+
+    ublas::batched_matrix<T, N, 2> bc;
+    ublas::batched_prod (ba, bb, bc);
+    BOOST_UBLAS_TEST_CHECK_EQ (bc.size (), BATCH);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        rhs_type c (N, 2), r (ublas::prod (a [k], b [k]));
+        bc.get (k, c);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (c - r) <= TOL);
+    }
+}
+
+template<class T, std::size_t N>
+BOOST_UBLAS_TEST_DEF ( test_batched_lu )
+{
+    typedef ublas::bounded_matrix<T, N, N> matrix_type;
+    typedef ublas::bounded_matrix<T, N, 1> rhs_type;
+    std::vector<matrix_type> a (BATCH);
+    std::vector<rhs_type> b (BATCH);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        fill_batch (a [k], k);
+        a [k] (k % N, (k + 1) % N) += T (N);
+        fill_batch (b [k], k + 2);
+    }
+    // One singular matrix in the batch
+    row (a [4], 1) = row (a [4], 0);
+
+    ublas::batched_matrix<T, N, N> ba (a.begin (), a.end ());
+    ublas::batched_matrix<T, N, 1> bb (b.begin (), b.end ());
+    ublas::batched_matrix<std::size_t, N, 1> pm;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::batched_lu_factorize (ba, pm), 1u);
+
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        ublas::matrix<T> lu (a [k]);
+        ublas::permutation_matrix<> p (N);
+        ublas::lu_factorize (lu, p);
+        matrix_type f (N, N);
+        ba.get (k, f);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (f - lu) <= TOL);
+        for (std::size_t i = 0; i < N; ++ i)
+            BOOST_UBLAS_TEST_CHECK_EQ (pm (k, i, 0), p (i));
+    }
+
+    a.erase (a.begin () + 4);
+    b.erase (b.begin () + 4);
+    ba = ublas::batched_matrix<T, N, N> (a.begin (), a.end ());
+    bb = ublas::batched_matrix<T, N, 1> (b.begin (), b.end ());
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::batched_lu_factorize (ba, pm), 0u);
+    ublas::batched_lu_substitute (ba, pm, bb);
+    for (std::size_t k = 0; k < a.size (); ++ k) {
+        rhs_type x (N, 1);
+        bb.get (k, x);
+        rhs_type r (ublas::prod (a [k], x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - b [k]) <= TOL * ublas::norm_inf (b [k]));
+    }
+}
+
+template<class T, std::size_t N>
+BOOST_UBLAS_TEST_DEF ( test_batched_cholesky )
+{
+    typedef ublas::bounded_matrix<T, N, N> matrix_type;
+    typedef ublas::bounded_matrix<T, N, 3> rhs_type;
+    std::vector<matrix_type> a (BATCH);
+    std::vector<rhs_type> b (BATCH);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        matrix_type g (N, N);
+        fill_batch (g, k);
+        a [k] = ublas::prod (ublas::herm (g), g) + ublas::identity_matrix<T> (N);
+        fill_batch (b [k], k + 3);
+    }
+
+    ublas::batched_matrix<T, N, N> ba (a.begin (), a.end ());
+    ublas::batched_matrix<T, N, 3> bb (b.begin (), b.end ());
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::batched_cholesky_factorize (ba), 0u);
+    ublas::batched_cholesky_substitute (ba, bb);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        rhs_type x (N, 3);
+        bb.get (k, x);
+        rhs_type r (ublas::prod (a [k], x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - b [k]) <= TOL * ublas::norm_inf (b [k]));
+    }
+
+    ublas::batched_matrix<T, N, N> bn (a.begin (), a.end ());
+    bn (2, 0, 0) = T (-1);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::batched_cholesky_factorize (bn), 1u);
+}
+
+template<class T, std::size_t N>
+BOOST_UBLAS_TEST_DEF ( test_batched_triangular )
+{
+    typedef ublas::bounded_matrix<T, N, N> matrix_type;
+    typedef ublas::bounded_matrix<T, N, 2> rhs_type;
+    std::vector<matrix_type> a (BATCH);
+    std::vector<rhs_type> b (BATCH);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        fill_batch (a [k], k);
+        for (std::size_t i = 0; i < N; ++ i)
+            a [k] (i, i) += T (N);
+        fill_batch (b [k], k + 1);
+    }
+    ublas::batched_matrix<T, N, N> ba (a.begin (), a.end ());
+
+    ublas::batched_matrix<T, N, 2> bl (b.begin (), b.end ());
+    ublas::batched_inplace_solve (ba, bl, ublas::lower_tag ());
+    ublas::batched_matrix<T, N, 2> bu (b.begin (), b.end ());
+    ublas::batched_inplace_solve (ba, bu, ublas::unit_upper_tag ());
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        rhs_type x (N, 2);
+        bl.get (k, x);
+        rhs_type r (ublas::prod (ublas::triangular_adaptor<matrix_type, ublas::lower> (a [k]), x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - b [k]) <= TOL * ublas::norm_inf (b [k]));
+        bu.get (k, x);
+        r = ublas::prod (ublas::triangular_adaptor<matrix_type, ublas::unit_upper> (a [k]), x);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - b [k]) <= TOL * ublas::norm_inf (b [k]));
+    }
+}
+
+template<class T, std::size_t N>
+BOOST_UBLAS_TEST_DEF ( test_batched_tridiagonal )
+{
+    typedef ublas::bounded_matrix<T, N, 3> band_type;
+    typedef ublas::bounded_matrix<T, N, 2> rhs_type;
+    std::vector<band_type> a (BATCH);
+    std::vector<rhs_type> b (BATCH);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        fill_batch (a [k], k);
+        for (std::size_t i = 0; i < N; ++ i)
+            a [k] (i, 1) = T (8.0 + k % 3);
+        fill_batch (b [k], k + 1);
+    }
+
+    ublas::batched_matrix<T, N, 3> ba (a.begin (), a.end ());
+    ublas::batched_matrix<T, N, 2> bb (b.begin (), b.end ());
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::batched_tridiagonal_solve (ba, bb), 0u);
+    for (std::size_t k = 0; k < BATCH; ++ k) {
+        ublas::matrix<T> dense (N, N);
+        dense.clear ();
+        for (std::size_t i = 0; i < N; ++ i) {
+            if (i > 0)
+                dense (i, i - 1) = a [k] (i, 0);
+            dense (i, i) = a [k] (i, 1);
+            if (i + 1 < N)
+                dense (i, i + 1) = a [k] (i, 2);
+        }
+        rhs_type x (N, 2);
+        bb.get (k, x);
+        rhs_type r (ublas::prod (dense, x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - b [k]) <= TOL * ublas::norm_inf (b [k]));
+    }
+
+    ba (3, 0, 1) = T (0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::batched_tridiagonal_solve (ba, bb), 1u);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_batched_conversion_prod<double, 4>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_conversion_prod<float, 6>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_lu<double, 6>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_lu<std::complex<double>, 5>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_cholesky<double, 6>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_cholesky<std::complex<double>, 4>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_triangular<double, 12>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_tridiagonal<double, 17>) );
+    BOOST_UBLAS_TEST_DO( (test_batched_tridiagonal<std::complex<double>, 5>) );
+
+    BOOST_UBLAS_TEST_END();
+}
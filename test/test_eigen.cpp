@@ -0,0 +1,150 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/eigen.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class M>
+void fill_symmetric (M &m) {
+    const std::size_t n (m.size1 ());
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            m (i, j) = ((i * 7 + j * 3 + i * j) % 13) / 4.0 - 1.5 + (i == j ? i % 5 : 0.0);
+}
+
+template<class M>
+ublas::matrix<double> dense_symmetric (const M &m) {
+    const std::size_t n (m.size1 ());
+    ublas::matrix<double> d (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            d (i, j) = d (j, i) = m (i, j);
+    return d;
+}
+
+// A Z = Z diag (w), Z^T Z = I and w ascending
+template<class MZ>
+bool check_eigen (const ublas::matrix<double> &a, const ublas::vector<double> &w, const MZ &z) {
+    const std::size_t n (a.size1 ()), k (w.size ());
+    const double scale ((std::max) (double (ublas::norm_inf (a)), 1.0) * n);
+    ublas::matrix<double> az (ublas::prod (a, z));
+    for (std::size_t j = 0; j < k; ++ j) {
+        if (j > 0 && w (j) < w (j - 1))
+            return false;
+        for (std::size_t i = 0; i < n; ++ i)
+            if (std::abs (az (i, j) - z (i, j) * w (j)) > TOL * scale)
+                return false;
+    }
+    ublas::matrix<double> ztz (ublas::prod (ublas::trans (z), z));
+    return ublas::norm_inf (ztz - ublas::identity_matrix<double> (k)) <= TOL * n;
+}
+
+// Dense matrices below and above the panel width and the divide and conquer leaf size
+template<class L>
+BOOST_UBLAS_TEST_DEF ( test_eigen_dense )
+{
+    const std::size_t sizes [] = { 1, 2, 5, 25, 33, 100, 150 };
+    for (std::size_t s = 0; s < 7; ++ s) {
+        const std::size_t n (sizes [s]);
+        ublas::matrix<double, L> m (n, n);
+        fill_symmetric (m);
+        ublas::matrix<double> a (dense_symmetric (m));
+        ublas::matrix<double, L> mv (m);
+        ublas::vector<double> w (n), wv (n);
+        ublas::matrix<double> z (n, n);
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::symmetric_eigen (m, w, z), 0u);
+        BOOST_UBLAS_TEST_CHECK (check_eigen (a, w, z));
+        // eigenvalues only
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::symmetric_eigen (mv, wv), 0u);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (w - wv) <= TOL * n * ublas::norm_inf (a));
+    }
+}
+
+// Packed storage, and a part of the spectrum by bisection and inverse iteration
+BOOST_UBLAS_TEST_DEF ( test_eigen_range )
+{
+    const std::size_t n (90);
+    ublas::symmetric_matrix<double, ublas::lower> m (n, n);
+    fill_symmetric (m);
+    ublas::matrix<double> a (dense_symmetric (m));
+    ublas::symmetric_matrix<double, ublas::lower> mr (m), mw (m);
+    ublas::vector<double> w (n);
+    ublas::matrix<double> z (n, n);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::symmetric_eigen (m, w, z), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_eigen (a, w, z));
+
+    const std::size_t il (10), iu (30);
+    ublas::vector<double> wr (iu - il);
+    ublas::matrix<double, ublas::column_major> zr (n, iu - il);
+    ublas::symmetric_eigen (mr, il, iu, wr, zr);
+    BOOST_UBLAS_TEST_CHECK (check_eigen (a, wr, zr));
+    ublas::vector<double> ws (iu - il);
+    ublas::symmetric_eigen (mw, il, iu, ws);
+    for (std::size_t j = il; j < iu; ++ j) {
+        BOOST_UBLAS_TEST_CHECK (std::abs (wr (j - il) - w (j)) <= TOL * n * ublas::norm_inf (a));
+        BOOST_UBLAS_TEST_CHECK (std::abs (ws (j - il) - w (j)) <= TOL * n * ublas::norm_inf (a));
+    }
+}
+
+// Known spectra with many deflations: tridiag (-1, 2, -1), a matrix with a repeated
+// eigenvalue, and the identity
+BOOST_UBLAS_TEST_DEF ( test_eigen_deflation )
+{
+    const std::size_t n (120);
+    const double pi (3.14159265358979323846);
+    ublas::vector<double> d (n, 2.0), e (n - 1, -1.0);
+    ublas::vector<double> dv (d), ev (e);
+    ublas::matrix<double> z (n, n);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::tridiagonal_eigen (d, e, z), 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::tridiagonal_eigen (dv, ev), 0u);
+    for (std::size_t j = 0; j < n; ++ j) {
+        const double exact (2.0 - 2.0 * std::cos ((j + 1) * pi / (n + 1)));
+        BOOST_UBLAS_TEST_CHECK (std::abs (d (j) - exact) <= TOL);
+        BOOST_UBLAS_TEST_CHECK (std::abs (dv (j) - exact) <= TOL);
+    }
+
+    // I + u u^T: eigenvalue 1 of multiplicity n - 1
+    ublas::matrix<double> a (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            a (i, j) = (i == j ? 1.0 : 0.0) + ((i % 4) + 1.0) * ((j % 4) + 1.0) / n;
+    ublas::matrix<double> m (a);
+    ublas::vector<double> w (n);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::symmetric_eigen (m, w, z), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_eigen (a, w, z));
+    BOOST_UBLAS_TEST_CHECK (std::abs (w (n - 2) - 1.0) <= TOL);
+
+    ublas::matrix<double> id (n, n);
+    id.assign (ublas::identity_matrix<double> (n));
+    m = id;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::symmetric_eigen (m, w, z), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_eigen (id, w, z));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (w - ublas::scalar_vector<double> (n, 1.0)) <= TOL);
+
+    // the eigenvectors of a tight cluster by inverse iteration
+    ublas::matrix<double> mc (a);
+    ublas::vector<double> wc (n - 1);
+    ublas::matrix<double> zc (n, n - 1);
+    ublas::symmetric_eigen (mc, 0, n - 1, wc, zc);
+    BOOST_UBLAS_TEST_CHECK (check_eigen (a, wc, zc));
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_eigen_dense<ublas::row_major> );
+    BOOST_UBLAS_TEST_DO( test_eigen_dense<ublas::column_major> );
+    BOOST_UBLAS_TEST_DO( test_eigen_range );
+    BOOST_UBLAS_TEST_DO( test_eigen_deflation );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,214 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/cholesky.hpp>
+#include <boost/numeric/ublas/qr.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Hermitian positive definite B B^H + n I
+template<class T>
+ublas::matrix<T> spd (std::size_t n) {
+    ublas::matrix<T> b (n, n);
+    fill (b, 1);
+    ublas::matrix<T> a (ublas::prod (b, ublas::herm (b)));
+    for (std::size_t i = 0; i < n; ++ i)
+        a (i, i) += T (double (n));
+    return a;
+}
+
+template<class T>
+ublas::matrix<T> lower_part (const ublas::matrix<T> &m) {
+    ublas::matrix<T> l (m.size1 (), m.size2 (), T/*zero*/());
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            l (i, j) = m (i, j);
+    return l;
+}
+
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_cholesky_update )
+{
+    const std::size_t n (40);
+    const ublas::matrix<T> a (spd<T> (n));
+    ublas::matrix<T> l (a);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::cholesky_factorize (l), 0u);
+    l = lower_part (l);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (l, ublas::herm (l)) - a) <= TOL * ublas::norm_inf (a));
+
+    // solves with vectors and matrices
+    ublas::matrix<T> b (n, 2), x;
+    fill (b, 2);
+    x = b;
+    ublas::cholesky_substitute (l, x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (a, x) - b) <= TOL * ublas::norm_inf (b));
+    ublas::vector<T> xv (ublas::column (b, 0));
+    ublas::cholesky_substitute (l, xv);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (xv - ublas::column (x, 0)) <= TOL);
+
+    // packed lower storage gives the same factor
+    ublas::symmetric_matrix<T, ublas::lower> p (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            p (i, j) = a (i, j);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::cholesky_factorize (p), 0u);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            BOOST_UBLAS_TEST_CHECK (std::abs (p (i, j) - l (i, j)) <= TOL);
+
+    // update, compared with the factor of A + v v^H, and downdate back
+    ublas::vector<T> v (n), w;
+    fill_vector (v, 3);
+    ublas::matrix<T> au (a + ublas::outer_prod (v, ublas::conj (v))), lu (au);
+    ublas::cholesky_factorize (lu);
+    lu = lower_part (lu);
+    ublas::matrix<T> l2 (l);
+    w = v;
+    ublas::cholesky_update (l2, w);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (l2 - lu) <= TOL * ublas::norm_inf (lu));
+    w = v;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::cholesky_downdate (l2, w), 0u);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (l2 - l) <= TOL * ublas::norm_inf (l));
+
+    // A - w w^H is indefinite for a large w
+    w = v * T (100.0);
+    BOOST_UBLAS_TEST_CHECK (ublas::cholesky_downdate (l2, w) != 0u);
+    ublas::matrix<T> indefinite (a);
+    indefinite (5, 5) = T (-1.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::cholesky_factorize (indefinite), 6u);
+}
+
+// Q orthogonal, R upper triangular and Q R = A
+template<class T>
+bool check_qr (const ublas::matrix<T> &q, const ublas::matrix<T> &r, const ublas::matrix<T> &a) {
+    for (std::size_t i = 0; i < r.size1 (); ++ i)
+        for (std::size_t j = 0; j < i && j < r.size2 (); ++ j)
+            if (r (i, j) != T/*zero*/())
+                return false;
+    const ublas::matrix<T> qhq (ublas::prod (ublas::herm (q), q));
+    return ublas::norm_inf (qhq - ublas::identity_matrix<T> (q.size1 ())) <= TOL * q.size1 () &&
+           ublas::norm_inf (ublas::prod (q, r) - a) <= TOL * ublas::norm_inf (a);
+}
+
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_qr_update )
+{
+    const std::size_t m (30), n (12);
+    ublas::matrix<T> a (m, n), f;
+    fill (a, 4);
+    f = a;
+    ublas::vector<T> tau (n);
+    ublas::qr_factorize (f, tau);
+    ublas::matrix<T> q (m, m), r (m, n, T/*zero*/());
+    ublas::qr_form_q (f, tau, q);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = i; j < n; ++ j)
+            r (i, j) = f (i, j);
+    BOOST_UBLAS_TEST_CHECK (check_qr (q, r, a));
+
+    ublas::vector<T> u (m), v (n);
+    fill_vector (u, 5);
+    fill_vector (v, 6);
+    ublas::qr_update (q, r, u, v);
+    a += ublas::outer_prod (u, v);
+    BOOST_UBLAS_TEST_CHECK (check_qr (q, r, a));
+
+    ublas::vector<T> c (m);
+    fill_vector (c, 7);
+    ublas::qr_replace_column (q, r, 4, c);
+    ublas::column (a, 4) = c;
+    BOOST_UBLAS_TEST_CHECK (check_qr (q, r, a));
+
+    ublas::vector<T> x (n);
+    fill_vector (x, 8);
+    ublas::qr_replace_row (q, r, 17, x);
+    ublas::row (a, 17) = x;
+    BOOST_UBLAS_TEST_CHECK (check_qr (q, r, a));
+
+    ublas::qr_append_column (q, r, c + u);
+    a.resize (m, n + 1, true);
+    ublas::column (a, n) = c + u;
+    BOOST_UBLAS_TEST_CHECK (check_qr (q, r, a));
+
+    ublas::vector<T> y (n + 1);
+    fill_vector (y, 9);
+    ublas::qr_append_row (q, r, y);
+    a.resize (m + 1, n + 1, true);
+    ublas::row (a, m) = y;
+    BOOST_UBLAS_TEST_CHECK (check_qr (q, r, a));
+}
+
+// P^T L U = A, checked by solving with the factors
+template<class T>
+bool check_lu (const ublas::matrix<T> &f, const ublas::permutation_matrix<std::size_t> &pm, const ublas::matrix<T> &a) {
+    ublas::matrix<T> b (a.size1 (), 2), x;
+    fill (b, 10);
+    x = b;
+    ublas::lu_substitute (f, pm, x);
+    return ublas::norm_inf (ublas::prod (a, x) - b) <= TOL * ublas::norm_inf (a) * ublas::norm_inf (x);
+}
+
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_lu_update )
+{
+    const std::size_t n (30);
+    ublas::matrix<T> a (n, n), f;
+    fill (a, 11);
+    f = a;
+    ublas::permutation_matrix<std::size_t> pm (n);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_factorize (f, pm), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_lu (f, pm, a));
+
+    ublas::vector<T> u (n), v (n);
+    fill_vector (u, 12);
+    fill_vector (v, 13);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_update (f, pm, u, v), 0u);
+    a += ublas::outer_prod (u, v);
+    BOOST_UBLAS_TEST_CHECK (check_lu (f, pm, a));
+
+    ublas::vector<T> c (n);
+    fill_vector (c, 14);
+    c (7) += T (5.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_replace_column (f, pm, 7, c), 0u);
+    ublas::column (a, 7) = c;
+    BOOST_UBLAS_TEST_CHECK (check_lu (f, pm, a));
+
+    ublas::vector<T> x (n);
+    fill_vector (x, 15);
+    x (20) += T (5.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_replace_row (f, pm, 20, x), 0u);
+    ublas::row (a, 20) = x;
+    BOOST_UBLAS_TEST_CHECK (check_lu (f, pm, a));
+
+    ublas::vector<T> b (n + 1), r (n);
+    fill_vector (b, 16);
+    fill_vector (r, 17);
+    b (n) += T (5.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_append (f, pm, b, r), 0u);
+    a.resize (n + 1, n + 1, true);
+    ublas::column (a, n) = b;
+    for (std::size_t j = 0; j < n; ++ j)
+        a (n, j) = r (j);
+    BOOST_UBLAS_TEST_CHECK (check_lu (f, pm, a));
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_cholesky_update<double> );
+    BOOST_UBLAS_TEST_DO( test_cholesky_update<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_qr_update<double> );
+    BOOST_UBLAS_TEST_DO( test_qr_update<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_lu_update<double> );
+    BOOST_UBLAS_TEST_DO( test_lu_update<std::complex<double> > );
+
+    BOOST_UBLAS_TEST_END();
+}
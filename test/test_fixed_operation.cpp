@@ -0,0 +1,260 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/operation_fixed.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Diagonally dominant for every fixed size
+template<class M>
+void fill_dominant (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (1.0 / (i + j + 1) + (i == j ? m.size1 () : 0) + (i + 2 * j) % 3);
+}
+
+// No zero entries, for the relative comparisons of the solutions
+template<class V>
+void fill_nonzero (V &v) {
+    for (std::size_t i = 0; i < v.size (); ++ i)
+        v (i) = typename V::value_type (i + 1.5);
+}
+
+template<class M, class V>
+BOOST_UBLAS_TEST_DEF ( test_fixed_prod_impl )
+{
+    typedef typename M::value_type value_type;
+    M a, b, c;
+    V x, y;
+    fill_dominant (a);
+    fill_dominant (b);
+    b *= value_type (0.5);
+    fill_nonzero (x);
+
+    // References from the generic code on dense copies
+    const ublas::matrix<value_type> da (a), db (b);
+    const ublas::vector<value_type> dx (x);
+
+    ublas::fixed_prod (a, b, c);
+    ublas::matrix<value_type> r (ublas::prod (da, db));
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE (c, r, a.size1 (), a.size2 (), TOL);
+    M p (ublas::prod (a, b));
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE (p, r, a.size1 (), a.size2 (), TOL);
+
+    ublas::fixed_prod (a, x, y);
+    ublas::vector<value_type> s (ublas::prod (da, dx));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (y, s, x.size (), TOL);
+    V q (ublas::prod (a, x));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (q, s, x.size (), TOL);
+
+    const value_type d (ublas::inner_prod (dx, s));
+    BOOST_UBLAS_TEST_CHECK_CLOSE (ublas::fixed_inner_prod (x, y), d, TOL);
+    BOOST_UBLAS_TEST_CHECK_CLOSE (ublas::inner_prod (x, y), d, TOL);
+}
+
+template<class M, class V>
+BOOST_UBLAS_TEST_DEF ( test_fixed_lu_impl )
+{
+    typedef typename M::value_type value_type;
+    M a, lu, generic;
+    V b, x, gx;
+    fill_dominant (a);
+    fill_nonzero (b);
+    lu = a;
+    ublas::matrix<value_type> gm (a);
+
+    typedef ublas::matrix<value_type> generic_matrix_type;
+    typedef ublas::permutation_matrix<> pmatrix_type;
+    pmatrix_type pm (a.size1 ()), gpm (a.size1 ());
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::fixed_lu_factorize (lu, pm), 0u);
+    // explicit arguments select the generic algorithm
+    std::size_t generic_singular = ublas::lu_factorize<generic_matrix_type, pmatrix_type> (gm, gpm);
+    BOOST_UBLAS_TEST_CHECK_EQ (generic_singular, 0u);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE (lu, gm, a.size1 (), a.size2 (), TOL);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (pm, gpm, a.size1 ());
+
+    x = b;
+    ublas::fixed_lu_substitute (lu, pm, x);
+    gx = ublas::prod (a, x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (gx, b, b.size (), TOL);
+
+    // The generic interface is routed to the fixed kernels
+    generic = a;
+    ublas::permutation_matrix<> rpm (a.size1 ());
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_factorize (generic, rpm), 0u);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE (generic, lu, a.size1 (), a.size2 (), TOL);
+    gx = b;
+    ublas::lu_substitute (generic, rpm, gx);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (gx, x, x.size (), TOL);
+}
+
+template<class M, class V>
+BOOST_UBLAS_TEST_DEF ( test_fixed_inverse_impl )
+{
+    typedef typename M::value_type value_type;
+    M a, inv, p;
+    fill_dominant (a);
+
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::fixed_invert (a, inv), 0u);
+    ublas::fixed_prod (a, inv, p);
+    ublas::identity_matrix<value_type> id (a.size1 ());
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (p - id) <= TOL);
+
+    // det (A) det (A^-1) == 1
+    BOOST_UBLAS_TEST_CHECK_CLOSE (ublas::fixed_determinant (a) * ublas::fixed_determinant (inv), value_type (1), TOL);
+
+    M s;
+    s.clear ();
+    BOOST_UBLAS_TEST_CHECK (ublas::fixed_invert (s, inv) != 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::fixed_determinant (s), value_type (0));
+}
+
+template<class M, class V>
+BOOST_UBLAS_TEST_DEF ( test_fixed_cholesky_impl )
+{
+    typedef typename M::value_type value_type;
+    M a, spd, l;
+    V b, x, r;
+    fill_dominant (a);
+    fill_nonzero (b);
+    // A^H A is hermitian positive definite
+    spd = ublas::prod (ublas::herm (a), a);
+    l = spd;
+
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::fixed_cholesky_factorize (l), 0u);
+    x = b;
+    ublas::fixed_cholesky_substitute (l, x);
+    ublas::fixed_prod (spd, x, r);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (r, b, b.size (), TOL);
+
+    M n (spd);
+    n *= value_type (-1);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::fixed_cholesky_factorize (n), 1u);
+}
+
+template<class M, class V>
+BOOST_UBLAS_TEST_DEF ( test_fixed_triangular_impl )
+{
+    M a;
+    V b, x, r;
+    fill_dominant (a);
+    fill_nonzero (b);
+
+    x = b;
+    ublas::fixed_inplace_solve (a, x, ublas::lower_tag ());
+    r = ublas::prod (ublas::triangular_adaptor<M, ublas::lower> (a), x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (r, b, b.size (), TOL);
+
+    x = b;
+    ublas::fixed_inplace_solve (a, x, ublas::unit_upper_tag ());
+    r = ublas::prod (ublas::triangular_adaptor<M, ublas::unit_upper> (a), x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (r, b, b.size (), TOL);
+
+    // The generic interface is routed to the fixed kernels
+    x = b;
+    ublas::inplace_solve (a, x, ublas::upper_tag ());
+    r = ublas::prod (ublas::triangular_adaptor<M, ublas::upper> (a), x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (r, b, b.size (), TOL);
+
+    x = b;
+    ublas::inplace_solve (a, x, ublas::unit_lower_tag ());
+    r = ublas::prod (ublas::triangular_adaptor<M, ublas::unit_lower> (a), x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (r, b, b.size (), TOL);
+}
+
+// Bounded containers below their maximum size take the generic path
+BOOST_UBLAS_TEST_DEF ( test_fixed_resized )
+{
+    typedef ublas::bounded_matrix<double, 4, 4> matrix_type;
+    typedef ublas::bounded_vector<double, 4> vector_type;
+    matrix_type a (3, 3), b (3, 3);
+    vector_type x (3);
+    fill_dominant (a);
+    fill_dominant (b);
+    fill_nonzero (x);
+    const ublas::matrix<double> da (a), db (b);
+    const ublas::vector<double> dx (x);
+
+    matrix_type c (ublas::prod (a, b));
+    const ublas::matrix<double> r (ublas::prod (da, db));
+    BOOST_UBLAS_TEST_CHECK_EQ (c.size1 (), 3u);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_CLOSE (c, r, 3, 3, TOL);
+    vector_type y (ublas::prod (a, x));
+    const ublas::vector<double> s (ublas::prod (da, dx));
+    BOOST_UBLAS_TEST_CHECK_EQ (y.size (), 3u);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (y, s, 3, TOL);
+    BOOST_UBLAS_TEST_CHECK_CLOSE (ublas::inner_prod (x, y), ublas::inner_prod (dx, s), TOL);
+
+    vector_type z (x);
+    ublas::inplace_solve (a, z, ublas::lower_tag ());
+    y = ublas::prod (ublas::triangular_adaptor<matrix_type, ublas::lower> (a), z);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_CLOSE (y, x, 3, TOL);
+}
+
+#define FIXED_TEST_TYPES(test, M, V) \
+    static void test ## _ ## M (std::size_t &test_fails__) { test ## _impl<M, V> (test_fails__); }
+
+typedef ublas::bounded_matrix<double, 4, 4> bounded_4;
+typedef ublas::bounded_vector<double, 4> bounded_vector_4;
+typedef ublas::bounded_matrix<double, 7, 7, ublas::column_major> bounded_7;
+typedef ublas::bounded_vector<double, 7> bounded_vector_7;
+typedef ublas::c_matrix<double, 3, 3> c_3;
+typedef ublas::c_vector<double, 3> c_vector_3;
+typedef ublas::bounded_matrix<std::complex<double>, 5, 5> complex_5;
+typedef ublas::bounded_vector<std::complex<double>, 5> complex_vector_5;
+#ifdef BOOST_UBLAS_CPP_GE_2011
+typedef ublas::fixed_matrix<double, 2, 2> fixed_2;
+typedef ublas::fixed_vector<double, 2> fixed_vector_2;
+typedef ublas::fixed_matrix<double, 3, 3, ublas::column_major> fixed_3;
+typedef ublas::fixed_vector<double, 3> fixed_vector_3;
+typedef ublas::fixed_matrix<double, 12, 12> fixed_12;
+typedef ublas::fixed_vector<double, 12> fixed_vector_12;
+#endif
+
+#define FIXED_TEST_ALL(M, V) \
+    FIXED_TEST_TYPES (test_fixed_prod, M, V) \
+    FIXED_TEST_TYPES (test_fixed_lu, M, V) \
+    FIXED_TEST_TYPES (test_fixed_inverse, M, V) \
+    FIXED_TEST_TYPES (test_fixed_cholesky, M, V) \
+    FIXED_TEST_TYPES (test_fixed_triangular, M, V)
+
+FIXED_TEST_ALL (bounded_4, bounded_vector_4)
+FIXED_TEST_ALL (bounded_7, bounded_vector_7)
+FIXED_TEST_ALL (c_3, c_vector_3)
+FIXED_TEST_ALL (complex_5, complex_vector_5)
+#ifdef BOOST_UBLAS_CPP_GE_2011
+FIXED_TEST_ALL (fixed_2, fixed_vector_2)
+FIXED_TEST_ALL (fixed_3, fixed_vector_3)
+FIXED_TEST_ALL (fixed_12, fixed_vector_12)
+#endif
+
+#define FIXED_TEST_DO_ALL(M) \
+    BOOST_UBLAS_TEST_DO (test_fixed_prod_ ## M); \
+    BOOST_UBLAS_TEST_DO (test_fixed_lu_ ## M); \
+    BOOST_UBLAS_TEST_DO (test_fixed_inverse_ ## M); \
+    BOOST_UBLAS_TEST_DO (test_fixed_cholesky_ ## M); \
+    BOOST_UBLAS_TEST_DO (test_fixed_triangular_ ## M)
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    FIXED_TEST_DO_ALL (bounded_4);
+    FIXED_TEST_DO_ALL (bounded_7);
+    FIXED_TEST_DO_ALL (c_3);
+    FIXED_TEST_DO_ALL (complex_5);
+#ifdef BOOST_UBLAS_CPP_GE_2011
+    FIXED_TEST_DO_ALL (fixed_2);
+    FIXED_TEST_DO_ALL (fixed_3);
+    FIXED_TEST_DO_ALL (fixed_12);
+#endif
+    BOOST_UBLAS_TEST_DO( test_fixed_resized );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,123 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Compare the blocked kernels against prod for every view of a matrix
+template<class M, class V>
+void check_gemv (const M &a, std::size_t &test_fails__) {
+    V x (a.size2 ()), xt (a.size1 ());
+    fill_vector (x, 0);
+    fill_vector (xt, 1);
+
+    V y (a.size1 ()), r (ublas::prod (a, x));
+    ublas::axpy_prod (a, x, y, true);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - r) <= TOL * ublas::norm_inf (r));
+
+    // init == false accumulates
+    ublas::axpy_prod (a, x, y, false);
+    r *= 2;
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - r) <= TOL * ublas::norm_inf (r));
+
+    V yt (a.size2 ()), rt (ublas::prod (ublas::trans (a), xt));
+    ublas::axpy_prod (ublas::trans (a), xt, yt, true);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (yt - rt) <= TOL * ublas::norm_inf (rt));
+
+    rt = ublas::prod (ublas::herm (a), xt);
+    ublas::axpy_prod (ublas::herm (a), xt, yt, true);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (yt - rt) <= TOL * ublas::norm_inf (rt));
+
+    // x^T A
+    rt = ublas::prod (xt, a);
+    ublas::axpy_prod (xt, a, yt, true);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (yt - rt) <= TOL * ublas::norm_inf (rt));
+
+    r = ublas::prod (x, ublas::herm (a));
+    ublas::axpy_prod (x, ublas::herm (a), y, true);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - r) <= TOL * ublas::norm_inf (r));
+}
+
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_gemv_complex )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    typedef ublas::vector<T> vector_type;
+
+    // Sizes around the block width
+    static const std::size_t sizes [] = { 1, 3, 4, 5, 8, 13, 37 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        matrix_type a (sizes [k], sizes [(k + 3) % 7]);
+        fill (a, 0);
+        check_gemv<matrix_type, vector_type> (a, test_fails__);
+    }
+
+    matrix_type big (41, 29);
+    fill (big, 0);
+    ublas::matrix_range<matrix_type> sub (big, ublas::range (3, 38), ublas::range (2, 25));
+    check_gemv<ublas::matrix_range<matrix_type>, vector_type> (sub, test_fails__);
+}
+
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_gemv_real )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    typedef ublas::vector<T> vector_type;
+
+    static const std::size_t sizes [] = { 2, 7, 16, 33 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        matrix_type a (sizes [k], sizes [3 - k]);
+        fill_matrix (a);
+        check_gemv<matrix_type, vector_type> (a, test_fails__);
+    }
+
+    // Result written into a proxy
+    matrix_type a (9, 6);
+    fill_matrix (a);
+    vector_type x (6), y (12);
+    fill_vector (x, 0);
+    y.clear ();
+    ublas::vector_range<vector_type> yr (y, ublas::range (2, 11));
+    ublas::axpy_prod (a, x, yr, true);
+    vector_type r (ublas::prod (a, x));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (yr - r) <= TOL * ublas::norm_inf (r));
+    BOOST_UBLAS_TEST_CHECK_EQ (y (0), T (0));
+    BOOST_UBLAS_TEST_CHECK_EQ (y (11), T (0));
+}
+
+// Large enough to cross BOOST_UBLAS_OPENMP_THRESHOLD
+template<class L>
+BOOST_UBLAS_TEST_DEF ( test_gemv_large )
+{
+    typedef ublas::matrix<double, L> matrix_type;
+    typedef ublas::vector<double> vector_type;
+
+    matrix_type a (301, 259);
+    fill_matrix (a);
+    check_gemv<matrix_type, vector_type> (a, test_fails__);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_gemv_real<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_gemv_real<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_gemv_complex<std::complex<double>, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_gemv_complex<std::complex<double>, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_gemv_large<ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_gemv_large<ublas::column_major>) );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,260 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Products with implicit matrices agree with the dense products
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_implicit_matrix_prod )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    typedef ublas::matrix<T> dense_type;
+    const std::size_t n (9), k (5);
+    const T s (2.5);
+    matrix_type a (n, k), r (n, k), expected (n, k);
+    fill_matrix (a);
+
+    ublas::identity_matrix<T> id (n);
+    ublas::zero_matrix<T> zero (k, k);
+    ublas::scalar_matrix<T> sn (n, n, s), sk (k, k, s);
+
+    noalias (r) = ublas::prod (id, a);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, a, n, k);
+    r = ublas::prod (a, ublas::identity_matrix<T> (k));
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, a, n, k);
+    noalias (r) += ublas::prod (id, a);
+    expected = T (2) * a;
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+
+    noalias (r) = ublas::prod (a, zero);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (r), 0.0);
+    r = a;
+    noalias (r) -= ublas::prod (ublas::zero_matrix<T> (n, n), a);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, a, n, k);
+
+    expected = ublas::prod (dense_type (sn), a);
+    noalias (r) = ublas::prod (sn, a);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+    expected = ublas::prod (a, dense_type (sk));
+    noalias (r) = ublas::prod (a, sk);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+
+    // sparse targets take the rewritten path as well
+    ublas::compressed_matrix<T> c (n, k);
+    c = ublas::prod (id, a);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (matrix_type (c), a, n, k);
+    c = ublas::prod (ublas::zero_matrix<T> (n, n), a);
+    BOOST_UBLAS_TEST_CHECK_EQ (c.nnz (), 0u);
+}
+
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_implicit_vector_prod )
+{
+    typedef ublas::matrix<T> matrix_type;
+    typedef ublas::vector<T> vector_type;
+    const std::size_t n (8), k (6);
+    const T s (-1.5);
+    matrix_type a (n, k);
+    vector_type x (k), y (n), r (n), q (k), expected (n), qexpected (k);
+    fill_matrix (a);
+    fill_vector (x, 0);
+    fill_vector (y, 1);
+
+    noalias (q) = ublas::prod (ublas::identity_matrix<T> (k), x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (q, x, k);
+    noalias (q) = ublas::prod (x, ublas::identity_matrix<T> (k));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (q, x, k);
+
+    noalias (r) = ublas::prod (a, ublas::zero_vector<T> (k));
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (r), 0.0);
+    noalias (q) = ublas::prod (ublas::zero_matrix<T> (k, k), x);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (q), 0.0);
+
+    ublas::scalar_matrix<T> snk (n, k, s), skk (k, k, s);
+    expected = ublas::prod (matrix_type (snk), x);
+    noalias (r) = ublas::prod (snk, x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+    qexpected = ublas::prod (x, matrix_type (skk));
+    noalias (q) = ublas::prod (x, skk);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (q - qexpected) <= TOL * ublas::norm_inf (qexpected));
+
+    ublas::scalar_vector<T> sx (k, s), sy (n, s);
+    expected = ublas::prod (a, vector_type (sx));
+    noalias (r) = ublas::prod (a, sx);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+    qexpected = ublas::prod (vector_type (sy), a);
+    noalias (q) = ublas::prod (sy, a);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (q - qexpected) <= TOL * ublas::norm_inf (qexpected));
+
+    noalias (r) = ublas::prod (a, ublas::unit_vector<T> (k, 3));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (r, ublas::column (a, 3), n);
+    noalias (q) = ublas::prod (ublas::unit_vector<T> (n, 5), a);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (q, ublas::row (a, 5), k);
+    noalias (q) += ublas::prod (ublas::unit_vector<T> (n, 5), a);
+    qexpected = T (2) * ublas::row (a, 5);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (q, qexpected, k);
+}
+
+// Rectangular identities pick the leading rows or columns, padded with zeros
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_rectangular_identity )
+{
+    typedef ublas::matrix<T> matrix_type;
+    typedef ublas::vector<T> vector_type;
+    const std::size_t n (3), k (4);
+    matrix_type a (n, k), tall (5, 3), wide (2, 3), expected;
+    fill_matrix (a);
+    for (std::size_t i = 0; i < 5; ++ i)
+        for (std::size_t j = 0; j < 3; ++ j)
+            tall (i, j) = T (i == j ? 1 : 0);
+    for (std::size_t i = 0; i < 2; ++ i)
+        for (std::size_t j = 0; j < 3; ++ j)
+            wide (i, j) = T (i == j ? 1 : 0);
+
+    matrix_type r (5, k);
+    noalias (r) = ublas::prod (ublas::identity_matrix<T> (5, 3), a);
+    expected = ublas::prod (tall, a);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, expected, 5, k);
+    r = ublas::prod (ublas::identity_matrix<T> (2, 3), a);
+    expected = ublas::prod (wide, a);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, expected, 2, k);
+    matrix_type c (k, 5);
+    noalias (c) = ublas::prod (ublas::trans (a), ublas::identity_matrix<T> (3, 5));
+    for (std::size_t i = 0; i < k; ++ i)
+        for (std::size_t j = 0; j < 5; ++ j)
+            BOOST_UBLAS_TEST_CHECK_EQ (c (i, j), j < 3 ? a (j, i) : T (0));
+    ublas::compressed_matrix<T> sc (5, k);
+    sc = ublas::prod (ublas::identity_matrix<T> (5, 3), a);
+    expected = ublas::prod (tall, a);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (matrix_type (sc), expected, 5, k);
+
+    vector_type x (3), y (5), z (2), q;
+    fill_vector (x, 0);
+    noalias (y) = ublas::prod (ublas::identity_matrix<T> (5, 3), x);
+    for (std::size_t i = 0; i < 5; ++ i)
+        BOOST_UBLAS_TEST_CHECK_EQ (y (i), i < 3 ? x (i) : T (0));
+    noalias (z) = ublas::prod (ublas::identity_matrix<T> (2, 3), x);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (z, x, 2);
+    noalias (y) += ublas::prod (x, ublas::identity_matrix<T> (3, 5));
+    for (std::size_t i = 0; i < 5; ++ i)
+        BOOST_UBLAS_TEST_CHECK_EQ (y (i), i < 3 ? T (2) * x (i) : T (0));
+    q = ublas::prod (x, ublas::identity_matrix<T> (3, 2));
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (q, x, 2);
+}
+
+// Sums and differences with zero only assign the other operand
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_implicit_sum )
+{
+    typedef ublas::matrix<T> matrix_type;
+    typedef ublas::vector<T> vector_type;
+    const std::size_t n (7), k (4);
+    matrix_type a (n, k), r (n, k), expected (n, k);
+    vector_type x (n), y (n), yexpected (n);
+    fill_matrix (a);
+    fill_vector (x, 0);
+
+    r = a + ublas::zero_matrix<T> (n, k);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, a, n, k);
+    r = ublas::zero_matrix<T> (n, k) + a;
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, a, n, k);
+    r = a - ublas::zero_matrix<T> (n, k);
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, a, n, k);
+    noalias (r) = ublas::zero_matrix<T> (n, k) - a;
+    expected = - a;
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (r, expected, n, k);
+    r += a + ublas::zero_matrix<T> (n, k);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (r), 0.0);
+
+    y = x + ublas::zero_vector<T> (n);
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (y, x, n);
+    y = ublas::zero_vector<T> (n) - x;
+    yexpected = - x;
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (y, yexpected, n);
+    y -= ublas::zero_vector<T> (n) - x;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (y), 0.0);
+
+    // other sums are unaffected
+    y = x + x;
+    yexpected = T (2) * x;
+    BOOST_UBLAS_TEST_CHECK_VECTOR_EQ (y, yexpected, n);
+}
+
+// A zero operand of the wrong size is rejected like any other operand
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_implicit_sum_size )
+{
+#if BOOST_UBLAS_CHECK_ENABLE && ! defined (BOOST_NO_EXCEPTIONS)
+    typedef ublas::matrix<T> matrix_type;
+    typedef ublas::vector<T> vector_type;
+    const std::size_t n (7), k (4);
+    matrix_type a (n, k), r (n, k);
+    vector_type x (n), y (n);
+    fill_matrix (a);
+    fill_vector (x, 0);
+
+    bool thrown (false);
+    try {
+        noalias (r) = a + ublas::zero_matrix<T> (n, k + 1);
+    } catch (ublas::bad_size &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK (thrown);
+    thrown = false;
+    try {
+        noalias (r) = ublas::zero_matrix<T> (n + 1, k) - a;
+    } catch (ublas::bad_size &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK (thrown);
+    thrown = false;
+    try {
+        noalias (r) += ublas::zero_matrix<T> (k, n) + a;
+    } catch (ublas::bad_size &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK (thrown);
+
+    thrown = false;
+    try {
+        noalias (y) = x - ublas::zero_vector<T> (n - 1);
+    } catch (ublas::bad_size &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK (thrown);
+    thrown = false;
+    try {
+        noalias (y) += ublas::zero_vector<T> (n + 1) + x;
+    } catch (ublas::bad_size &) {
+        thrown = true;
+    }
+    BOOST_UBLAS_TEST_CHECK (thrown);
+#endif
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_implicit_matrix_prod<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_implicit_matrix_prod<std::complex<double>, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( test_implicit_vector_prod<double> );
+    BOOST_UBLAS_TEST_DO( test_implicit_vector_prod<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_rectangular_identity<double> );
+    BOOST_UBLAS_TEST_DO( test_rectangular_identity<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_implicit_sum<double> );
+    BOOST_UBLAS_TEST_DO( test_implicit_sum<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_implicit_sum_size<double> );
+
+    BOOST_UBLAS_TEST_END();
+}
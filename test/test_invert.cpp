@@ -0,0 +1,143 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/cholesky.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include <cmath>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class M1, class M2>
+bool check_inverse (const M1 &a, const M2 &inverse) {
+    const std::size_t n (a.size1 ());
+    const ublas::matrix<typename M1::value_type> p (ublas::prod (a, inverse));
+    return ublas::norm_inf (p - ublas::identity_matrix<typename M1::value_type> (n)) <= TOL * n;
+}
+
+// Sizes below, at and across the block width
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_lu_invert )
+{
+    const std::size_t sizes [] = { 1, 2, 7, 32, 33, 100 };
+    for (std::size_t t = 0; t < 6; ++ t) {
+        const std::size_t n (sizes [t]);
+        ublas::matrix<T, L> a (n, n), f;
+        fill (a, t);
+        f = a;
+        ublas::permutation_matrix<std::size_t> pm (n);
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_factorize (f, pm), 0u);
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_invert (f, pm), 0u);
+        BOOST_UBLAS_TEST_CHECK (check_inverse (a, f));
+
+        ublas::matrix<T, L> g (a);
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::invert (g), 0u);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (g - f) <= TOL * ublas::norm_inf (f));
+    }
+
+    // a zero pivot leaves the factors unchanged
+    ublas::matrix<T, L> s (3, 3, T (1.0)), f;
+    f = s;
+    ublas::permutation_matrix<std::size_t> pm (3);
+    ublas::lu_factorize (f, pm);
+    const ublas::matrix<T, L> factors (f);
+    BOOST_UBLAS_TEST_CHECK (ublas::lu_invert (f, pm) != 0u);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (f - factors) == 0.0);
+    BOOST_UBLAS_TEST_CHECK (ublas::invert (s) != 0u);
+}
+
+// Hermitian positive definite B B^H + n I through the Cholesky factor, dense and packed
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_spd_invert )
+{
+    const std::size_t n (70);
+    ublas::matrix<T> b (n, n);
+    fill (b, 1);
+    ublas::matrix<T> a (ublas::prod (b, ublas::herm (b))), inverse (a);
+    for (std::size_t i = 0; i < n; ++ i)
+        a (i, i) += T (double (n));
+    inverse = a;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::spd_invert (inverse), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_inverse (a, inverse));
+
+    ublas::symmetric_matrix<T, ublas::lower> p (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            p (i, j) = a (i, j);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::cholesky_factorize (p), 0u);
+    ublas::cholesky_invert (p);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            BOOST_UBLAS_TEST_CHECK (std::abs (p (i, j) - inverse (i, j)) <= TOL);
+
+    ublas::matrix<T> indefinite (a);
+    indefinite (40, 40) = T (-1.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::spd_invert (indefinite), 41u);
+}
+
+BOOST_UBLAS_TEST_DEF ( test_log_determinant )
+{
+    ublas::matrix<double> a (3, 3);
+    a (0, 0) = 1; a (0, 1) = 2; a (0, 2) = 2;
+    a (1, 0) = 2; a (1, 1) = 3; a (1, 2) = 3;
+    a (2, 0) = 3; a (2, 1) = 4; a (2, 2) = 6;
+    ublas::lu_factorization<ublas::matrix<double> > lu (a);
+    double sign (0.0);
+    BOOST_UBLAS_TEST_CHECK (std::abs (lu.log_determinant (sign) - std::log (2.0)) <= TOL);
+    BOOST_UBLAS_TEST_CHECK_EQ (sign, -1.0);
+
+    // det = 10^600 overflows, its logarithm does not
+    const std::size_t n (6);
+    ublas::matrix<double> big (n, n, 0.0);
+    for (std::size_t i = 0; i < n; ++ i)
+        big ((i + 1) % n, i) = 1.0e100;
+    lu.factorize (big);
+    BOOST_UBLAS_TEST_CHECK (std::abs (lu.log_determinant (sign) - 600.0 * std::log (10.0)) <= TOL * 1.0e3);
+    BOOST_UBLAS_TEST_CHECK_EQ (sign, -1.0);
+    BOOST_UBLAS_TEST_CHECK (! (std::abs (lu.determinant ()) < 1.0e300));
+
+    // complex: the sign has modulus 1 and the phase of the determinant
+    ublas::matrix<std::complex<double> > c (2, 2);
+    c (0, 0) = std::complex<double> (0.0, 2.0); c (0, 1) = 1.0;
+    c (1, 0) = 1.0;                             c (1, 1) = 1.0;
+    ublas::lu_factorization<ublas::matrix<std::complex<double> > > clu (c);
+    std::complex<double> csign;
+    const double cl (clu.log_determinant (csign));
+    BOOST_UBLAS_TEST_CHECK (std::abs (std::exp (cl) * csign - clu.determinant ()) <= TOL);
+    BOOST_UBLAS_TEST_CHECK (std::abs (std::abs (csign) - 1.0) <= TOL);
+
+    // positive definite, through the Cholesky factor
+    ublas::matrix<double> s (40, 40), l;
+    fill (s, 2);
+    ublas::matrix<double> spd (ublas::prod (s, ublas::trans (s)));
+    l = spd;
+    ublas::cholesky_factorize (l);
+    lu.factorize (spd);
+    BOOST_UBLAS_TEST_CHECK (std::abs (ublas::cholesky_log_determinant (l) - lu.log_determinant (sign)) <= TOL * 1.0e2);
+    BOOST_UBLAS_TEST_CHECK_EQ (sign, 1.0);
+
+    // singular
+    ublas::matrix<double> z (3, 3, 1.0);
+    lu.factorize (z);
+    BOOST_UBLAS_TEST_CHECK (lu.log_determinant (sign) < 0.0 && std::abs (lu.log_determinant (sign)) > 1.0e308);
+    BOOST_UBLAS_TEST_CHECK_EQ (sign, 0.0);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_lu_invert<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_lu_invert<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_lu_invert<std::complex<double>, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( test_spd_invert<double> );
+    BOOST_UBLAS_TEST_DO( test_spd_invert<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_log_determinant );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,147 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/ldlt.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Symmetric indefinite matrix with small diagonal elements, which forces both kinds of pivots
+template<class M>
+void fill_symmetric (M &m) {
+    const std::size_t n (m.size1 ());
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            m (i, j) = typename M::value_type (i == j ? ((i % 3) == 0 ? 0.0 : (i % 2 ? -0.5 : 0.25))
+                                                      : ((i * 7 + j * 3 + i * j) % 13) / 4.0 - 1.5);
+}
+
+template<class M, class T>
+ublas::matrix<T> dense_symmetric (const M &m) {
+    const std::size_t n (m.size1 ());
+    ublas::matrix<T> d (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            d (i, j) = d (j, i) = m (i, j);
+    return d;
+}
+
+// Solves with three right hand sides and with the second as a vector
+template<class M, class T>
+bool check_solve (const ublas::matrix<T> &a, const M &f, const ublas::vector<int> &piv) {
+    const std::size_t n (a.size1 ());
+    ublas::matrix<T> b (n, 3), x (n, 3);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < 3; ++ j)
+            b (i, j) = T ((i * (j + 2)) % 7 - 3.0);
+    x = b;
+    ublas::ldlt_substitute (f, piv, x);
+    ublas::vector<T> v (ublas::column (b, 1));
+    ublas::ldlt_substitute (f, piv, v);
+    return ublas::norm_inf (ublas::prod (a, x) - b) <= TOL * ublas::norm_inf (a) * ublas::norm_inf (x) &&
+           ublas::norm_inf (v - ublas::column (x, 1)) <= TOL * ublas::norm_inf (x);
+}
+
+// Dense lower triangle; sizes below and above the panel width
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_ldlt_dense )
+{
+    const std::size_t sizes [] = { 1, 2, 7, 31, 32, 33, 100 };
+    for (std::size_t s = 0; s < 7; ++ s) {
+        const std::size_t n (sizes [s]);
+        ublas::matrix<T, L> m (n, n);
+        m.clear ();
+        fill_symmetric (m);
+        if (n == 1)
+            m (0, 0) = T (2);
+        ublas::matrix<T> a (dense_symmetric<ublas::matrix<T, L>, T> (m));
+        ublas::vector<int> piv (n);
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::ldlt_factorize (m, piv), 0u);
+        BOOST_UBLAS_TEST_CHECK (check_solve (a, m, piv));
+    }
+}
+
+// Packed symmetric_matrix storage of either triangle
+template<class T, class TRI>
+BOOST_UBLAS_TEST_DEF ( test_ldlt_packed )
+{
+    const std::size_t n (70);
+    ublas::symmetric_matrix<T, TRI> m (n, n);
+    fill_symmetric (m);
+    ublas::matrix<T> a (dense_symmetric<ublas::symmetric_matrix<T, TRI>, T> (m));
+    ublas::vector<int> piv (n);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::ldlt_factorize (m, piv), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_solve (a, m, piv));
+
+    // the same factors as the dense lower triangle
+    ublas::matrix<T> d (a);
+    ublas::vector<int> dpiv (n);
+    ublas::ldlt_factorize (d, dpiv);
+    for (std::size_t i = 0; i < n; ++ i) {
+        BOOST_UBLAS_TEST_CHECK_EQ (piv (i), dpiv (i));
+        for (std::size_t j = 0; j <= i; ++ j)
+            BOOST_UBLAS_TEST_CHECK (std::abs (m (i, j) - d (i, j)) <= TOL * ublas::norm_inf (a));
+    }
+}
+
+// KKT matrix [0 B; B^T H] with H positive definite has inertia (n, k, 0); the zero
+// block in front forces 2 x 2 pivots
+BOOST_UBLAS_TEST_DEF ( test_ldlt_inertia )
+{
+    const std::size_t n (40), k (15);
+    ublas::symmetric_matrix<double, ublas::lower> m (n + k, n + k);
+    m.clear ();
+    for (std::size_t i = 0; i < n; ++ i) {
+        m (k + i, k + i) = 0.5 + (i % 3) / 4.0;
+        if (i > 0)
+            m (k + i, k + i - 1) = 0.125;
+    }
+    for (std::size_t i = 0; i < k; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            m (k + j, i) = ((i * 5 + j * 3) % 7) / 2.0 - 1.0 + (j == 2 * i ? 3.0 : 0.0);
+    ublas::vector<int> piv (n + k);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::ldlt_factorize (m, piv), 0u);
+    std::size_t positive, negative, zero;
+    ublas::ldlt_inertia (m, piv, positive, negative, zero);
+    BOOST_UBLAS_TEST_CHECK_EQ (positive, n);
+    BOOST_UBLAS_TEST_CHECK_EQ (negative, k);
+    BOOST_UBLAS_TEST_CHECK_EQ (zero, 0u);
+    bool two_by_two = false;
+    for (std::size_t i = 0; i < n + k; ++ i)
+        two_by_two = two_by_two || piv (i) < 0;
+    BOOST_UBLAS_TEST_CHECK (two_by_two);
+
+    // A singular matrix reports its zero pivot
+    ublas::symmetric_matrix<double, ublas::lower> s (4, 4);
+    s.clear ();
+    s (0, 0) = 1.0;
+    s (2, 2) = -2.0;
+    s (3, 3) = 3.0;
+    ublas::vector<int> spiv (4);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::ldlt_factorize (s, spiv), 2u);
+    ublas::ldlt_inertia (s, spiv, positive, negative, zero);
+    BOOST_UBLAS_TEST_CHECK_EQ (positive, 2u);
+    BOOST_UBLAS_TEST_CHECK_EQ (negative, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (zero, 1u);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_ldlt_dense<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_ldlt_dense<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_ldlt_dense<std::complex<double>, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_ldlt_packed<double, ublas::lower>) );
+    BOOST_UBLAS_TEST_DO( (test_ldlt_packed<double, ublas::upper>) );
+    BOOST_UBLAS_TEST_DO( (test_ldlt_packed<std::complex<double>, ublas::lower>) );
+    BOOST_UBLAS_TEST_DO( test_ldlt_inertia );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -66,5 +66,24 @@ int main () {
 
   assertTrue("inverse is correct: ", compare(B, INV));    
 
+  // the left-looking factorization gives the same factors
+  {
+    std::istringstream is(matrix_IN);
+    is >> A;
+  }
+  permutation_matrix<> apm(3);
+  result = axpy_lu_factorize<MATRIX, permutation_matrix<> >(A, apm);
+
+  assertTrue("axpy factorization completed: ", 0 == result);
+  assertTrue("axpy LU factors are correct: ", compare(A, LU));
+  assertTrue("axpy permutation is correct: ", compare(apm, PM));
+
+  // x^T A = e_i^T gives the row i of the inverse
+  for (std::size_t i = 0; i < A.size1(); ++i) {
+    vector<TYPE> x = unit_vector<TYPE>(A.size1(), i);
+    lu_substitute(x, A, apm);
+    assertTrue("transposed solve is correct: ", compare_to(x, row(INV, i), 1.0e-6));
+  }
+
   return (getResults().second > 0) ? boost::exit_failure : boost::exit_success;
 }
@@ -0,0 +1,126 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// The exact reciprocal condition number from the inverse
+template<class M>
+double exact_rcond (const M &a) {
+    M lu (a), inverse (ublas::identity_matrix<typename M::value_type> (a.size1 ()));
+    ublas::permutation_matrix<std::size_t> pm (a.size1 ());
+    ublas::lu_factorize (lu, pm);
+    ublas::lu_substitute (lu, pm, inverse);
+    return 1.0 / (ublas::norm_1 (a) * ublas::norm_1 (inverse));
+}
+
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_lu_factorization_solve )
+{
+    const std::size_t n (50);
+    ublas::matrix<T, L> a (n, n);
+    fill (a, 0);
+    ublas::lu_factorization<ublas::matrix<T, L> > lu (a);
+    BOOST_UBLAS_TEST_CHECK_EQ (lu.singular (), 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (lu.size (), n);
+
+    ublas::matrix<T> b (n, 3), x (n, 3);
+    fill (b, 1);
+    x = b;
+    lu.solve (x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (a, x) - b) <= TOL * ublas::norm_inf (b));
+    ublas::vector<T> v (ublas::column (b, 1));
+    lu.solve (v);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (v - ublas::column (x, 1)) <= TOL);
+
+    x = b;
+    lu.solve_transposed (x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (ublas::trans (a), x) - b) <= TOL * ublas::norm_inf (b));
+    v = ublas::column (b, 2);
+    lu.solve_transposed (v);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (v - ublas::column (x, 2)) <= TOL);
+
+    // the same factors as lu_factorize, and the storage is reused by refactor
+    ublas::matrix<T, L> f (a);
+    ublas::permutation_matrix<std::size_t> pm (n);
+    ublas::lu_factorize (f, pm);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (f - lu.lu ()) == 0.0);
+    const T *storage (&lu.lu ().data () [0]);
+    fill (a, 3);
+    BOOST_UBLAS_TEST_CHECK_EQ (lu.refactor (a), 0u);
+    BOOST_UBLAS_TEST_CHECK (&lu.lu ().data () [0] == storage);
+    x = b;
+    lu.solve (x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (a, x) - b) <= TOL * ublas::norm_inf (b));
+}
+
+BOOST_UBLAS_TEST_DEF ( test_lu_factorization_determinant )
+{
+    ublas::matrix<double> a (3, 3);
+    a (0, 0) = 1; a (0, 1) = 2; a (0, 2) = 2;
+    a (1, 0) = 2; a (1, 1) = 3; a (1, 2) = 3;
+    a (2, 0) = 3; a (2, 1) = 4; a (2, 2) = 6;
+    ublas::lu_factorization<ublas::matrix<double> > lu (a);
+    BOOST_UBLAS_TEST_CHECK (std::abs (lu.determinant () + 2.0) <= TOL);
+
+    // an odd permutation
+    ublas::matrix<double> p (4, 4, 0.0);
+    p (0, 1) = p (1, 0) = 1.0;
+    p (2, 2) = 2.0;
+    p (3, 3) = 3.0;
+    lu.factorize (p);
+    BOOST_UBLAS_TEST_CHECK (std::abs (lu.determinant () + 6.0) <= TOL);
+}
+
+// The estimate is never smaller than the true value and within a small factor of it
+BOOST_UBLAS_TEST_DEF ( test_lu_factorization_rcond )
+{
+    for (std::size_t n = 1; n <= 8; ++ n) {
+        ublas::matrix<double> h (n, n);
+        for (std::size_t i = 0; i < n; ++ i)
+            for (std::size_t j = 0; j < n; ++ j)
+                h (i, j) = 1.0 / (i + j + 1.0);
+        ublas::lu_factorization<ublas::matrix<double> > lu (h);
+        const double exact (exact_rcond (h));
+        BOOST_UBLAS_TEST_CHECK (lu.rcond () >= exact * (1.0 - 1.0e-6));
+        BOOST_UBLAS_TEST_CHECK (lu.rcond () <= 3.0 * exact);
+    }
+    ublas::matrix<double> a (60, 60);
+    fill (a, 5);
+    ublas::lu_factorization<ublas::matrix<double> > lu (a);
+    const double exact (exact_rcond (a));
+    BOOST_UBLAS_TEST_CHECK (lu.rcond () >= exact * (1.0 - 1.0e-6));
+    BOOST_UBLAS_TEST_CHECK (lu.rcond () <= 3.0 * exact);
+
+    ublas::matrix<std::complex<double> > c (30, 30);
+    fill (c, 2);
+    ublas::lu_factorization<ublas::matrix<std::complex<double> > > clu (c);
+    BOOST_UBLAS_TEST_CHECK (clu.rcond () > 0.0);
+    BOOST_UBLAS_TEST_CHECK (clu.rcond () <= 1.0);
+
+    // singular
+    ublas::matrix<double> s (3, 3, 1.0);
+    lu.factorize (s);
+    BOOST_UBLAS_TEST_CHECK (lu.singular () != 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (lu.rcond (), 0.0);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_lu_factorization_solve<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_lu_factorization_solve<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_lu_factorization_solve<std::complex<double>, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( test_lu_factorization_determinant );
+    BOOST_UBLAS_TEST_DO( test_lu_factorization_rcond );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,80 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Double accuracy from float factors for a well conditioned matrix, with vector and
+// matrix right hand sides
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_mixed_precision_refinement )
+{
+    const std::size_t n (100);
+    ublas::matrix<T> a (n, n), b (n, 3);
+    fill (a, 0);
+    fill (b, 1);
+    ublas::matrix<T> x (b), xd (b);
+    int iterations = -10;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::mixed_precision_solve (a, x, iterations), 0u);
+    BOOST_UBLAS_TEST_CHECK (iterations >= 1 && iterations <= 5);
+    ublas::lu_factorization<ublas::matrix<T> > lu (a);
+    lu.solve (xd);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (x - xd) <= 1.0e-13 * ublas::norm_inf (xd));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (b - ublas::prod (a, x)) <= 1.0e-13 * ublas::norm_inf (a) * ublas::norm_inf (x));
+
+    ublas::vector<T> v (ublas::column (b, 2));
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::mixed_precision_solve (a, v, iterations), 0u);
+    BOOST_UBLAS_TEST_CHECK (iterations >= 0);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (v - ublas::column (xd, 2)) <= 1.0e-13 * ublas::norm_inf (xd));
+}
+
+// The fallbacks to the double factorization
+BOOST_UBLAS_TEST_DEF ( test_mixed_precision_fallback )
+{
+    // Hilbert matrix: too ill conditioned for float factors
+    const std::size_t n (9);
+    ublas::matrix<double> h (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j < n; ++ j)
+            h (i, j) = 1.0 / (i + j + 1.0);
+    ublas::vector<double> ones (n, 1.0), b (ublas::prod (h, ones)), x (b);
+    int iterations = 0;
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::mixed_precision_solve (h, x, iterations), 0u);
+    BOOST_UBLAS_TEST_CHECK (iterations == -2 || iterations == -3);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (x - ones) <= 1.0e-3);
+
+    // out of the range of float
+    ublas::matrix<double> a (3, 3, 0.0);
+    a (0, 0) = 1.0e40;
+    a (1, 1) = 2.0;
+    a (2, 2) = 4.0;
+    ublas::vector<double> y (3, 1.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::mixed_precision_solve (a, y, iterations), 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (iterations, -1);
+    BOOST_UBLAS_TEST_CHECK (std::abs (y (0) - 1.0e-40) <= 1.0e-55 && y (1) == 0.5 && y (2) == 0.25);
+
+    // singular in double as well: mv is left unchanged
+    ublas::matrix<double> s (3, 3, 1.0);
+    ublas::vector<double> z (3, 2.0);
+    BOOST_UBLAS_TEST_CHECK (ublas::mixed_precision_solve (s, z, iterations) != 0u);
+    BOOST_UBLAS_TEST_CHECK_EQ (iterations, -2);
+    BOOST_UBLAS_TEST_CHECK (z (0) == 2.0 && z (1) == 2.0 && z (2) == 2.0);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_mixed_precision_refinement<double> );
+    BOOST_UBLAS_TEST_DO( test_mixed_precision_refinement<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_mixed_precision_fallback );
+
+    BOOST_UBLAS_TEST_END();
+}
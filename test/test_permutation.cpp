@@ -0,0 +1,149 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include "utils.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+typedef ublas::permutation_matrix<std::size_t> pmatrix;
+
+template<class M>
+void fill (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = double (i * 1000 + j);
+}
+
+// A pivot sequence pm (i) >= i as produced by lu_factorize
+void fill_pivots (pmatrix &pm) {
+    const std::size_t n (pm.size ());
+    for (std::size_t i = 0; i < n; ++ i)
+        pm (i) = (i * 37 + 11) % 3 == 0 ? i : i + (i * 53 + 7) % (n - i);
+}
+
+// The swaps one row at a time
+template<class M>
+void reference_swap_rows (const pmatrix &pm, M &m) {
+    for (std::size_t i = 0; i < pm.size (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            std::swap (m (i, j), m (pm (i), j));
+}
+
+template<class M1, class M2>
+bool equal (const M1 &m1, const M2 &m2) {
+    for (std::size_t i = 0; i < m1.size1 (); ++ i)
+        for (std::size_t j = 0; j < m1.size2 (); ++ j)
+            if (m1 (i, j) != m2 (i, j))
+                return false;
+    return true;
+}
+
+// Several column blocks and a partial last block
+template<class L>
+BOOST_UBLAS_TEST_DEF ( test_swap_rows_blocked )
+{
+    const std::size_t m (150), n (140);
+    pmatrix pm (m);
+    fill_pivots (pm);
+    ublas::matrix<double, L> a (m, n), b, c;
+    fill (a);
+    b = a;
+    c = a;
+    ublas::swap_rows (pm, b);
+    reference_swap_rows (pm, c);
+    BOOST_UBLAS_TEST_CHECK (equal (b, c));
+    ublas::swap_rows_inverse (pm, b);
+    BOOST_UBLAS_TEST_CHECK (equal (b, a));
+
+    // a vector is a single column
+    ublas::vector<double> v (ublas::column (a, 3)), w (v);
+    ublas::swap_rows (pm, v);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (v - ublas::column (c, 3)) == 0.0);
+    ublas::swap_rows_inverse (pm, v);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (v - w) == 0.0);
+
+    // a range of a dense matrix, and sparse storage swapping whole rows
+    b = a;
+    ublas::matrix_range<ublas::matrix<double, L> > r (b, ublas::range (0, m), ublas::range (5, 90));
+    ublas::swap_rows (pm, r);
+    BOOST_UBLAS_TEST_CHECK (equal (r, ublas::project (c, ublas::range (0, m), ublas::range (5, 90))));
+    ublas::compressed_matrix<double> s (m, 20);
+    for (std::size_t i = 0; i < m; i += 7)
+        s (i, i % 20) = double (i + 1);
+    ublas::matrix<double> sd (s);
+    ublas::swap_rows (pm, s);
+    reference_swap_rows (pm, sd);
+    BOOST_UBLAS_TEST_CHECK (equal (s, sd));
+
+    // columns: the transpose of the row swaps
+    ublas::matrix<double, L> t (ublas::trans (a));
+    ublas::swap_columns (pm, t);
+    BOOST_UBLAS_TEST_CHECK (equal (ublas::trans (t), c));
+    ublas::swap_columns_inverse (pm, t);
+    BOOST_UBLAS_TEST_CHECK (equal (ublas::trans (t), a));
+}
+
+template<class L>
+BOOST_UBLAS_TEST_DEF ( test_permutation_vectors )
+{
+    const std::size_t m (130), n (70);
+    pmatrix pm (m), back (m);
+    fill_pivots (pm);
+    ublas::vector<std::size_t> perm (m);
+    ublas::pivots_to_permutation (pm, perm);
+    ublas::matrix<double, L> a (m, n), b, c;
+    fill (a);
+    c = a;
+    ublas::swap_rows (pm, c);
+    for (std::size_t i = 0; i < m; ++ i)
+        BOOST_UBLAS_TEST_CHECK (c (i, 0) == a (perm (i), 0));
+
+    // the cycles give the same rows as the swaps, and the inverse undoes them
+    b = a;
+    ublas::permute_rows (perm, b);
+    BOOST_UBLAS_TEST_CHECK (equal (b, c));
+    ublas::permute_rows_inverse (perm, b);
+    BOOST_UBLAS_TEST_CHECK (equal (b, a));
+    ublas::vector<double> v (ublas::column (a, 1));
+    ublas::permute_rows (perm, v);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (v - ublas::column (c, 1)) == 0.0);
+
+    // back to an equivalent pivot sequence
+    ublas::permutation_to_pivots (perm, back);
+    for (std::size_t i = 0; i < m; ++ i)
+        BOOST_UBLAS_TEST_CHECK (back (i) >= i);
+    b = a;
+    ublas::swap_rows (back, b);
+    BOOST_UBLAS_TEST_CHECK (equal (b, c));
+
+    // columns, and sparse storage by swaps along the cycles
+    ublas::matrix<double, L> t (ublas::trans (a));
+    ublas::permute_columns (perm, t);
+    BOOST_UBLAS_TEST_CHECK (equal (ublas::trans (t), c));
+    ublas::permute_columns_inverse (perm, t);
+    BOOST_UBLAS_TEST_CHECK (equal (ublas::trans (t), a));
+    ublas::mapped_matrix<double> s (m, 10);
+    for (std::size_t i = 0; i < m; i += 3)
+        s (i, i % 10) = double (i + 1);
+    ublas::matrix<double> sd (s);
+    ublas::permute_rows (perm, s);
+    ublas::swap_rows (pm, sd);
+    BOOST_UBLAS_TEST_CHECK (equal (s, sd));
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_swap_rows_blocked<ublas::row_major> );
+    BOOST_UBLAS_TEST_DO( test_swap_rows_blocked<ublas::column_major> );
+    BOOST_UBLAS_TEST_DO( test_permutation_vectors<ublas::row_major> );
+    BOOST_UBLAS_TEST_DO( test_permutation_vectors<ublas::column_major> );
+
+    BOOST_UBLAS_TEST_END();
+}
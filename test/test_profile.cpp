@@ -0,0 +1,124 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_UBLAS_PROFILE
+#define BOOST_UBLAS_PROFILE
+#endif
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/operation.hpp>
+#include <boost/numeric/ublas/operation_sparse.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/profile.hpp>
+#include <sstream>
+#include <thread>
+#include "utils.hpp"
+
+namespace ublas = boost::numeric::ublas;
+namespace profile = boost::numeric::ublas::profile;
+
+BOOST_UBLAS_TEST_DEF ( test_products )
+{
+    ublas::matrix<double> a (4, 3, 1.0), b (3, 5, 2.0), c;
+    profile::reset ();
+    c = ublas::prod (a, b);
+    profile::report r (profile::collect ());
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::prod_kernel].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::prod_kernel].flops, 2u * 4 * 3 * 5);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::matrix_temporary].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::matrix_temporary].elements, 20u);
+
+    // noalias assigns in place
+    ublas::noalias (c) = ublas::prod (a, b);
+    r = profile::collect ();
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::prod_kernel].calls, 2u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::matrix_temporary].calls, 1u);
+
+    ublas::vector<double> x (3, 1.0), y (4);
+    ublas::axpy_prod (a, x, y, true);
+    r = profile::collect ();
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::axpy_prod_kernel].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::axpy_prod_kernel].flops, 2u * 4 * 3);
+
+    // the multiplications of a sparse product are counted as they happen
+    ublas::compressed_matrix<double> d (3, 3), s (3, 3);
+    d (0, 0) = 1.0; d (1, 1) = 2.0; d (2, 2) = 3.0; d (2, 0) = 4.0;
+    profile::reset ();
+    ublas::sparse_prod (d, d, s);
+    r = profile::collect ();
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::sparse_prod_kernel].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::sparse_prod_kernel].flops, 2u * 5);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::sparse_prod_kernel].elements, 4u);
+}
+
+BOOST_UBLAS_TEST_DEF ( test_assignments )
+{
+    ublas::vector<double> u (10, 1.0), v (10, 2.0), w;
+    profile::reset ();
+    w = u + v;
+    profile::report r (profile::collect ());
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_temporary].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_temporary].elements, 10u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_temporary].bytes, 10u * sizeof (double));
+
+    // an assignment forwarding to another one is counted once
+    profile::reset ();
+    ublas::noalias (w) += u - v;
+    r = profile::collect ();
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_assign_kernel].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_assign_kernel].elements, 10u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_assign_kernel].flops, 10u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_temporary].calls, 0u);
+
+    ublas::matrix<double> m (6, 6);
+    for (std::size_t i = 0; i < 6; ++ i)
+        for (std::size_t j = 0; j < 6; ++ j)
+            m (i, j) = i == j ? 10.0 : 1.0 / (1.0 + i + j);
+    ublas::permutation_matrix<std::size_t> pm (6);
+    profile::reset ();
+    ublas::lu_factorize (m, pm);
+    r = profile::collect ();
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::lu_factorize_kernel].calls, 1u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::lu_factorize_kernel].flops, 6u * 6 * 6 - 6 * 6 * 6 / 3);
+
+    profile::reset ();
+    r = profile::collect ();
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::lu_factorize_kernel].calls, 0u);
+}
+
+// The counters of other threads, running or finished, are added up
+BOOST_UBLAS_TEST_DEF ( test_threads )
+{
+    profile::reset ();
+    std::thread worker ([] () {
+        ublas::vector<double> a (100, 1.0), b;
+        for (int i = 0; i < 3; ++ i)
+            b = 2.0 * a;
+    });
+    worker.join ();
+    ublas::vector<double> a (100, 1.0), b;
+    b = 2.0 * a;
+    profile::report r (profile::collect ());
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_temporary].calls, 4u);
+    BOOST_UBLAS_TEST_CHECK_EQ (r [profile::vector_temporary].elements, 400u);
+
+    std::ostringstream out;
+    profile::dump (out, r);
+    BOOST_UBLAS_TEST_CHECK (out.str ().find ("vector_temporary") != std::string::npos);
+    BOOST_UBLAS_TEST_CHECK (out.str ().find ("lu_factorize") == std::string::npos);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_products );
+    BOOST_UBLAS_TEST_DO( test_assignments );
+    BOOST_UBLAS_TEST_DO( test_threads );
+
+    BOOST_UBLAS_TEST_END();
+}
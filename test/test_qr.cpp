@@ -0,0 +1,160 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/qr.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class M>
+M upper_part (const M &m) {
+    M r (m.size1 (), m.size2 ());
+    r.clear ();
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = i; j < m.size2 (); ++ j)
+            r (i, j) = m (i, j);
+    return r;
+}
+
+// Q R reproduces A and Q has orthonormal columns; sizes are not multiples of the panel width
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_qr_factorize )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    const std::size_t sizes [][2] = { { 100, 37 }, { 70, 70 }, { 5, 9 } };
+    for (std::size_t s = 0; s < 3; ++ s) {
+        const std::size_t m (sizes [s][0]), n (sizes [s][1]), k ((std::min) (m, n));
+        matrix_type a (m, n), qr (m, n), q (m, m);
+        ublas::vector<T> tau (k);
+        fill (a, 0);
+        qr = a;
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::qr_factorize (qr, tau), 0u);
+        ublas::qr_form_q (qr, tau, q);
+        matrix_type r (upper_part (qr));
+        matrix_type e (ublas::prod (q, r) - a);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (e) <= TOL * ublas::norm_inf (a));
+        e = ublas::prod (ublas::herm (q), q) - ublas::identity_matrix<T> (m);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (e) <= TOL);
+
+        // Q^H Q x = x without forming Q
+        ublas::vector<T> x (m), y (m);
+        for (std::size_t i = 0; i < m; ++ i)
+            x (i) = T (i % 5 - 2.0);
+        y = x;
+        ublas::qr_apply_qt (qr, tau, y);
+        ublas::vector<T> z (ublas::prod (ublas::herm (q), x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - z) <= TOL * ublas::norm_inf (x));
+        ublas::qr_apply_q (qr, tau, y);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - x) <= TOL * ublas::norm_inf (x));
+    }
+}
+
+// Least squares solutions satisfy the normal equations
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_qr_least_squares )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    const std::size_t m (83), n (35), nrhs (3);
+    matrix_type a (m, n), qr (m, n), b (m, nrhs), x (m, nrhs);
+    ublas::vector<T> tau (n);
+    fill (a, 0);
+    for (std::size_t i = 0; i < m; ++ i)
+        for (std::size_t j = 0; j < nrhs; ++ j)
+            b (i, j) = T ((i * (j + 2)) % 7 - 3.0);
+    qr = a;
+    ublas::qr_factorize (qr, tau);
+    x = b;
+    ublas::qr_solve (qr, tau, x);
+    matrix_type xs (ublas::subrange (x, 0, n, 0, nrhs));
+    matrix_type r (b - ublas::prod (a, xs));
+    matrix_type g (ublas::prod (ublas::herm (a), r));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (g) <= TOL * ublas::norm_inf (a) * ublas::norm_inf (b) * m);
+
+    // A vector right hand side gives the first column
+    ublas::vector<T> v (ublas::column (b, 0));
+    ublas::qr_solve (qr, tau, v);
+    for (std::size_t i = 0; i < n; ++ i)
+        BOOST_UBLAS_TEST_CHECK (std::abs (v (i) - xs (i, 0)) <= TOL * ublas::norm_inf (xs));
+
+    // A square nonsingular system is solved exactly
+    matrix_type s (40, 40), sq (40, 40);
+    ublas::vector<T> stau (40), sb (40), sx (40);
+    fill (s, 1);
+    for (std::size_t i = 0; i < 40; ++ i)
+        sb (i) = T (i % 3 + 1.0);
+    sq = s;
+    ublas::qr_factorize (sq, stau);
+    sx = sb;
+    ublas::qr_solve (sq, stau, sx);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (s, sx) - sb) <= TOL * ublas::norm_inf (s) * ublas::norm_inf (sx));
+}
+
+// Pivoting reveals the rank of a rank deficient matrix
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_qr_pivoted )
+{
+    typedef ublas::matrix<T> matrix_type;
+    const std::size_t m (60), n (20), rank (12);
+    matrix_type u (m, rank), w (rank, n);
+    fill (u, 0);
+    fill (w, 1);
+    matrix_type a (ublas::prod (u, w)), qr (a);
+    ublas::vector<T> tau (n);
+    ublas::permutation_matrix<> pm (n);
+    ublas::qr_factorize (qr, tau, pm);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::qr_rank (qr), rank);
+    for (std::size_t i = 1; i < n; ++ i)
+        BOOST_UBLAS_TEST_CHECK (std::abs (qr (i, i)) <= std::abs (qr (i - 1, i - 1)) * (1 + TOL));
+
+    // A P = Q R
+    matrix_type q (m, n), ap (a);
+    ublas::qr_form_q (qr, tau, q);
+    for (std::size_t j = 0; j < n; ++ j)
+        if (pm (j) != j)
+            ublas::column (ap, j).swap (ublas::column (ap, pm (j)));
+    matrix_type e (ublas::prod (q, ublas::subrange (upper_part (qr), 0, n, 0, n)) - ap);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (e) <= TOL * ublas::norm_inf (a));
+
+    // A consistent system is solved exactly by the basic solution
+    ublas::vector<T> x0 (n), b (m), x (m);
+    for (std::size_t i = 0; i < n; ++ i)
+        x0 (i) = T (i % 4 - 1.5);
+    b = ublas::prod (a, x0);
+    x = b;
+    ublas::qr_solve (qr, tau, pm, x);
+    ublas::vector<T> xs (ublas::subrange (x, 0, n));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::prod (a, xs) - b) <= TOL * ublas::norm_inf (b) * n);
+}
+
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_qr_singular )
+{
+    typedef ublas::matrix<T> matrix_type;
+    matrix_type a (6, 4);
+    fill (a, 0);
+    ublas::column (a, 2) = ublas::zero_vector<T> (6);
+    ublas::column (a, 3) = ublas::zero_vector<T> (6);
+    ublas::vector<T> tau (4);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::qr_factorize (a, tau), 3u);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_qr_factorize<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_qr_factorize<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_qr_factorize<std::complex<double>, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_qr_least_squares<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_qr_least_squares<std::complex<double>, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( test_qr_pivoted<double> );
+    BOOST_UBLAS_TEST_DO( test_qr_pivoted<std::complex<double> > );
+    BOOST_UBLAS_TEST_DO( test_qr_singular<double> );
+
+    BOOST_UBLAS_TEST_END();
+}
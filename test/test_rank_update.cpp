@@ -0,0 +1,208 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/vector_sparse.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/lu.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class L>
+BOOST_UBLAS_TEST_DEF ( test_ger )
+{
+    typedef ublas::matrix<double, L> matrix_type;
+    typedef ublas::vector<double> vector_type;
+
+    matrix_type a (9, 7), r (9, 7);
+    vector_type x (9), y (7);
+    fill_matrix (a);
+    fill_vector (x, 0);
+    fill_vector (y, 1);
+
+    r = a;
+    for (std::size_t i = 0; i < 9; ++ i)
+        for (std::size_t j = 0; j < 7; ++ j)
+            r (i, j) += x (i) * y (j);
+    noalias (a) += ublas::outer_prod (x, y);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (a - r) <= TOL * ublas::norm_inf (r));
+
+    noalias (a) -= ublas::outer_prod (x, y);
+    r -= ublas::outer_prod (x, y);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (a - r) <= TOL * ublas::norm_inf (r));
+
+    a = ublas::outer_prod (x, y);
+    for (std::size_t i = 0; i < 9; ++ i)
+        for (std::size_t j = 0; j < 7; ++ j)
+            BOOST_UBLAS_TEST_CHECK_EQ (a (i, j), x (i) * y (j));
+
+    // Proxy target and operands aliasing the target
+    fill_matrix (a);
+    r = a;
+    ublas::matrix_range<matrix_type> sub (a, ublas::range (1, 9), ublas::range (1, 7));
+    const vector_type c (ublas::subrange (ublas::column (a, 0), 1, 9));
+    const vector_type d (ublas::subrange (ublas::row (a, 0), 1, 7));
+    sub.minus_assign (ublas::outer_prod (ublas::subrange (ublas::column (a, 0), 1, 9),
+                                         ublas::subrange (ublas::row (a, 0), 1, 7)));
+    ublas::subrange (r, 1, 9, 1, 7) -= ublas::outer_prod (c, d);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (a - r) <= TOL * ublas::norm_inf (r));
+
+    // Slices are read in place, general expressions evaluated first
+    const vector_type x2 (x + x), y3 (ublas::project (y, ublas::slice (0, 2, 3)));
+    noalias (a) += ublas::outer_prod (x + x, 2.0 * y);
+    r += ublas::outer_prod (x2, 2.0 * y);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (a - r) <= TOL * ublas::norm_inf (r));
+    ublas::subrange (a, 0, 9, 0, 3).plus_assign (ublas::outer_prod (x, ublas::project (y, ublas::slice (0, 2, 3))));
+    ublas::subrange (r, 0, 9, 0, 3) += ublas::outer_prod (x, y3);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (a - r) <= TOL * ublas::norm_inf (r));
+}
+
+template<class TRI>
+BOOST_UBLAS_TEST_DEF ( test_syr )
+{
+    typedef ublas::symmetric_matrix<double, TRI> symmetric_type;
+    typedef ublas::matrix<double> matrix_type;
+    typedef ublas::vector<double> vector_type;
+
+    vector_type x (11);
+    fill_vector (x, 2);
+    symmetric_type s (11, 11);
+    s = ublas::outer_prod (x, x);
+    matrix_type r (ublas::outer_prod (x, x));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s - r) <= TOL * ublas::norm_inf (r));
+
+    noalias (s) += ublas::outer_prod (x, x);
+    r *= 2;
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s - r) <= TOL * ublas::norm_inf (r));
+}
+
+template<class TRI>
+BOOST_UBLAS_TEST_DEF ( test_her )
+{
+    typedef std::complex<double> value_type;
+    typedef ublas::hermitian_matrix<value_type, TRI> hermitian_type;
+    typedef ublas::matrix<value_type> matrix_type;
+    typedef ublas::vector<value_type> vector_type;
+
+    vector_type x (10);
+    for (std::size_t i = 0; i < x.size (); ++ i)
+        x (i) = value_type (i % 4 - 1.5, i % 3);
+    hermitian_type h (10, 10);
+    h = ublas::outer_prod (x, ublas::conj (x));
+    matrix_type r (ublas::outer_prod (x, ublas::conj (x)));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (h - r) <= TOL * ublas::norm_inf (r));
+}
+
+template<class TRI, class L>
+BOOST_UBLAS_TEST_DEF ( test_syrk )
+{
+    typedef ublas::symmetric_matrix<double, TRI> symmetric_type;
+    typedef ublas::matrix<double, L> matrix_type;
+
+    // Sizes crossing the tile size of the blocked kernel
+    static const std::size_t sizes [] = { 1, 5, 32, 45, 70 };
+    for (std::size_t k = 0; k < sizeof (sizes) / sizeof (sizes [0]); ++ k) {
+        matrix_type x (sizes [k] + 3, sizes [k]);
+        fill_matrix (x);
+        matrix_type r (ublas::prod (ublas::trans (x), x));
+        symmetric_type s (ublas::prod (ublas::trans (x), x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s - r) <= TOL * ublas::norm_inf (r));
+
+        noalias (s) += ublas::prod (ublas::trans (x), x);
+        r *= 2;
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s - r) <= TOL * ublas::norm_inf (r));
+
+        // X X^T
+        symmetric_type t (x.size1 (), x.size1 ());
+        noalias (t) = ublas::prod (x, ublas::trans (x));
+        matrix_type rt (ublas::prod (x, ublas::trans (x)));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (t - rt) <= TOL * ublas::norm_inf (rt));
+    }
+}
+
+template<class TRI>
+BOOST_UBLAS_TEST_DEF ( test_herk )
+{
+    typedef std::complex<double> value_type;
+    typedef ublas::hermitian_matrix<value_type, TRI> hermitian_type;
+    typedef ublas::matrix<value_type> matrix_type;
+
+    matrix_type x (40, 37);
+    for (std::size_t i = 0; i < x.size1 (); ++ i)
+        for (std::size_t j = 0; j < x.size2 (); ++ j)
+            x (i, j) = value_type ((i * 3 + j) % 7 - 3.0, (i + 2 * j) % 5 - 2.0);
+    hermitian_type h (ublas::prod (ublas::herm (x), x));
+    matrix_type r (ublas::prod (ublas::herm (x), x));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (h - r) <= TOL * ublas::norm_inf (r));
+}
+
+BOOST_UBLAS_TEST_DEF ( test_lu_trailing_update )
+{
+    typedef ublas::matrix<double> matrix_type;
+
+    matrix_type a (23, 23), lu (23, 23);
+    fill_matrix (a);
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        a (i, i) += 30.0;
+    lu = a;
+    ublas::permutation_matrix<> pm (23);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::lu_factorize (lu, pm), 0u);
+    typedef ublas::triangular_adaptor<matrix_type, ublas::unit_lower> lower_type;
+    typedef ublas::triangular_adaptor<matrix_type, ublas::upper> upper_type;
+    lower_type l (lu);
+    upper_type u (lu);
+    matrix_type r (ublas::prod (l, u));
+    ublas::swap_rows (pm, a);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - a) <= TOL * ublas::norm_inf (a));
+}
+
+template<class E>
+bool read_in_place () {
+    return ! boost::is_same<typename ublas::detail::outer_operand<E, double>::type, const ublas::vector<double> >::value;
+}
+
+// Dense vectors and their proxies are read in place, general expressions evaluated first
+BOOST_UBLAS_TEST_DEF ( test_outer_operands )
+{
+    typedef ublas::vector<double> vector_type;
+    typedef ublas::matrix<double> matrix_type;
+
+    BOOST_UBLAS_TEST_CHECK (read_in_place<const vector_type> ());
+    BOOST_UBLAS_TEST_CHECK (read_in_place<ublas::vector_reference<const vector_type> > ());
+    BOOST_UBLAS_TEST_CHECK (read_in_place<ublas::vector_range<vector_type> > ());
+    BOOST_UBLAS_TEST_CHECK (read_in_place<ublas::vector_slice<const vector_type> > ());
+    BOOST_UBLAS_TEST_CHECK (read_in_place<ublas::matrix_row<matrix_type> > ());
+    BOOST_UBLAS_TEST_CHECK (read_in_place<ublas::matrix_column<const matrix_type> > ());
+    BOOST_UBLAS_TEST_CHECK (! read_in_place<ublas::compressed_vector<double> > ());
+    BOOST_UBLAS_TEST_CHECK (! (read_in_place<ublas::vector_binary<vector_type, vector_type, ublas::scalar_plus<double, double> > > ()));
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_ger<ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_ger<ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_syr<ublas::lower>) );
+    BOOST_UBLAS_TEST_DO( (test_syr<ublas::upper>) );
+    BOOST_UBLAS_TEST_DO( (test_her<ublas::lower>) );
+    BOOST_UBLAS_TEST_DO( (test_her<ublas::upper>) );
+    BOOST_UBLAS_TEST_DO( (test_syrk<ublas::lower, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_syrk<ublas::upper, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_herk<ublas::lower>) );
+    BOOST_UBLAS_TEST_DO( (test_herk<ublas::upper>) );
+    BOOST_UBLAS_TEST_DO( test_lu_trailing_update );
+    BOOST_UBLAS_TEST_DO( test_outer_operands );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,118 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/svd.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class M>
+bool check_orthonormal (const M &q) {
+    const ublas::matrix<double> qtq (ublas::prod (ublas::trans (q), q));
+    return ublas::norm_inf (qtq - ublas::identity_matrix<double> (q.size2 ())) <= TOL * q.size1 ();
+}
+
+// A = U S V^T with orthonormal U and V and s decreasing
+template<class M, class MU, class MV>
+bool check_svd (const M &a, const MU &u, const ublas::vector<double> &s, const MV &v) {
+    for (std::size_t j = 1; j < s.size (); ++ j)
+        if (s (j) > s (j - 1))
+            return false;
+    ublas::matrix<double> us (u);
+    for (std::size_t j = 0; j < s.size (); ++ j)
+        ublas::column (us, j) *= s (j);
+    const double error (ublas::norm_inf (ublas::matrix<double> (a) - ublas::prod (us, ublas::trans (v))));
+    return error <= TOL * a.size1 () * ublas::norm_inf (a) && check_orthonormal (u) && check_orthonormal (v);
+}
+
+// Tall matrices below and above the QR panel width, and square ones
+template<class L>
+BOOST_UBLAS_TEST_DEF ( test_thin_svd )
+{
+    const std::size_t rows [] = { 1, 10, 200, 500, 40 };
+    const std::size_t columns [] = { 1, 3, 30, 45, 40 };
+    for (std::size_t t = 0; t < 5; ++ t) {
+        const std::size_t m (rows [t]), n (columns [t]);
+        ublas::matrix<double, L> a (m, n), u (m, n), v (n, n);
+        fill (a, 0);
+        ublas::vector<double> s (n), sv (n);
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::thin_svd (a, u, s, v), 0u);
+        BOOST_UBLAS_TEST_CHECK (check_svd (a, u, s, v));
+        // singular values only
+        BOOST_UBLAS_TEST_CHECK_EQ (ublas::thin_svd (a, sv), 0u);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s - sv) <= TOL * ublas::norm_inf (a));
+    }
+}
+
+// Jacobi directly on a square matrix with an odd number of columns, and a rank
+// deficient matrix
+BOOST_UBLAS_TEST_DEF ( test_svd_jacobi )
+{
+    const std::size_t n (25);
+    ublas::matrix<double, ublas::column_major> a (n, n), u (n, n), v (n, n);
+    fill (a, 0);
+    u = a;
+    ublas::vector<double> s (n);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::svd_jacobi (u, s, v), 0u);
+    BOOST_UBLAS_TEST_CHECK (check_svd (a, u, s, v));
+
+    // rank 7: two rank one terms and a term periodic in i + j of period 5
+    ublas::matrix<double> r (100, 20, 0.0), ru (100, 20), rv (20, 20);
+    for (std::size_t i = 0; i < 100; ++ i)
+        for (std::size_t j = 0; j < 20; ++ j)
+            r (i, j) = std::sin (i + 1.0) * std::cos (j * 0.3) + 2.0 * std::cos (i * 0.7) * std::sin (j + 2.0) + 3.0 * ((i + j) % 5);
+    ublas::vector<double> rs (20);
+    ublas::thin_svd (r, ru, rs, rv);
+    BOOST_UBLAS_TEST_CHECK (rs (6) > TOL * rs (0));
+    for (std::size_t j = 7; j < 20; ++ j)
+        BOOST_UBLAS_TEST_CHECK (rs (j) <= TOL * rs (0));
+}
+
+// A = X diag (2^-j) Y^T with orthonormal X and Y: the leading singular triplets
+BOOST_UBLAS_TEST_DEF ( test_randomized_svd )
+{
+    const std::size_t m (300), n (80), k (8);
+    ublas::matrix<double> x (m, n), y (n, n), xu (m, n), xv (n, n), yu (n, n), yv (n, n);
+    fill (x, 0);
+    fill (y, 1);
+    ublas::vector<double> sx (n), sy (n);
+    ublas::thin_svd (x, xu, sx, xv);
+    ublas::thin_svd (y, yu, sy, yv);
+    ublas::matrix<double> xs (xu);
+    for (std::size_t j = 0; j < n; ++ j)
+        ublas::column (xs, j) *= std::pow (0.5, double (j));
+    const ublas::matrix<double> a (ublas::prod (xs, ublas::trans (yu)));
+
+    ublas::matrix<double> u (m, k), v (n, k);
+    ublas::vector<double> s (k);
+    ublas::randomized_svd (a, u, s, v);
+    for (std::size_t j = 0; j < k; ++ j)
+        BOOST_UBLAS_TEST_CHECK (std::abs (s (j) - std::pow (0.5, double (j))) <= 1.0e-8);
+    BOOST_UBLAS_TEST_CHECK (check_orthonormal (u));
+    BOOST_UBLAS_TEST_CHECK (check_orthonormal (v));
+    // the best rank k approximation, up to the first neglected singular value
+    ublas::matrix<double> us (u);
+    for (std::size_t j = 0; j < k; ++ j)
+        ublas::column (us, j) *= s (j);
+    ublas::matrix<double> e (a - ublas::prod (us, ublas::trans (v)));
+    ublas::vector<double> es (n);
+    ublas::thin_svd (e, es);
+    BOOST_UBLAS_TEST_CHECK (std::abs (es (0) - std::pow (0.5, double (k))) <= 1.0e-8);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_thin_svd<ublas::row_major> );
+    BOOST_UBLAS_TEST_DO( test_thin_svd<ublas::column_major> );
+    BOOST_UBLAS_TEST_DO( test_svd_jacobi );
+    BOOST_UBLAS_TEST_DO( test_randomized_svd );
+
+    BOOST_UBLAS_TEST_END();
+}
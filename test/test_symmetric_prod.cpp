@@ -0,0 +1,125 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/symmetric.hpp>
+#include <boost/numeric/ublas/hermitian.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class T>
+T make_element (std::size_t i, std::size_t j, T*) {
+    return T ((i * 5 + j * 2) % 7 - 3.0);
+}
+template<class T>
+std::complex<T> make_element (std::size_t i, std::size_t j, std::complex<T>*) {
+    return std::complex<T> ((i * 5 + j * 2) % 7 - 3.0, i == j ? 0.0 : (i * 3 + j) % 5 - 2.0);
+}
+
+// Reference products through an explicit dense copy of the packed operand
+template<class S>
+void check_symmetric_prod (std::size_t n, std::size_t k, std::size_t &test_fails__) {
+    typedef typename S::value_type value_type;
+    typedef ublas::matrix<value_type> matrix_type;
+    typedef ublas::matrix<value_type, ublas::column_major> column_matrix_type;
+    typedef ublas::vector<value_type> vector_type;
+
+    S s (n, n);
+    for (std::size_t i = 0; i < n; ++ i)
+        for (std::size_t j = 0; j <= i; ++ j)
+            s (i, j) = make_element (i, j, (value_type*) 0);
+    const matrix_type dense (s);
+
+    vector_type x (n), y (n), expected (n);
+    for (std::size_t i = 0; i < n; ++ i)
+        x (i) = value_type (i % 4 + 0.5);
+    expected = ublas::prod (dense, x);
+    y = ublas::prod (s, x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - expected) <= TOL * ublas::norm_inf (expected));
+    noalias (y) += ublas::prod (s, x);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - 2. * expected) <= TOL * ublas::norm_inf (expected));
+    expected = ublas::prod (x, dense);
+    noalias (y) = ublas::prod (x, s);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - expected) <= TOL * ublas::norm_inf (expected));
+
+    matrix_type b (n, k), r (n, k), rexpected (n, k);
+    fill_matrix (b);
+    rexpected = ublas::prod (dense, b);
+    r = ublas::prod (s, b);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - rexpected) <= TOL * ublas::norm_inf (rexpected));
+    noalias (r) -= ublas::prod (s, b);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r) <= TOL * ublas::norm_inf (rexpected));
+
+    matrix_type c (k, n);
+    column_matrix_type t (k, n), texpected (k, n);
+    fill_matrix (c);
+    texpected = ublas::prod (c, dense);
+    noalias (t) = ublas::prod (c, s);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (t - texpected) <= TOL * ublas::norm_inf (texpected));
+
+    // Assigned and added in place into ranges, the rest of the target untouched
+    matrix_type big (n + 2, k + 2);
+    big.clear ();
+    ublas::matrix_range<matrix_type> rr (big, ublas::range (1, n + 1), ublas::range (1, k + 1));
+    noalias (rr) = ublas::prod (s, b);
+    noalias (rr) += ublas::prod (s, b);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (rr - 2. * rexpected) <= TOL * ublas::norm_inf (rexpected));
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (ublas::row (big, 0)), 0.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (ublas::column (big, k + 1)), 0.0);
+    column_matrix_type tbig (k + 2, n + 2);
+    tbig.clear ();
+    ublas::matrix_range<column_matrix_type> tr (tbig, ublas::range (1, k + 1), ublas::range (1, n + 1));
+    noalias (tr) = ublas::prod (c, s);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (tr - texpected) <= TOL * ublas::norm_inf (texpected));
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (ublas::column (tbig, 0)), 0.0);
+    vector_type ybig (n + 2, value_type (1));
+    ublas::vector_range<vector_type> yr (ybig, ublas::range (1, n + 1));
+    noalias (yr) = ublas::prod (x, s);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (yr - expected) <= TOL * ublas::norm_inf (expected));
+    BOOST_UBLAS_TEST_CHECK_EQ (ybig (0), value_type (1));
+    BOOST_UBLAS_TEST_CHECK_EQ (ybig (n + 1), value_type (1));
+}
+
+template<class T, class TRI, class L>
+BOOST_UBLAS_TEST_DEF ( test_symmetric_prod )
+{
+    typedef ublas::symmetric_matrix<T, TRI, L> symmetric_type;
+    check_symmetric_prod<symmetric_type> (1, 1, test_fails__);
+    check_symmetric_prod<symmetric_type> (7, 3, test_fails__);
+    // more columns than one panel
+    check_symmetric_prod<symmetric_type> (45, BOOST_UBLAS_RANK_UPDATE_BLOCK + 5, test_fails__);
+}
+
+template<class T, class TRI, class L>
+BOOST_UBLAS_TEST_DEF ( test_hermitian_prod )
+{
+    typedef ublas::hermitian_matrix<T, TRI, L> hermitian_type;
+    check_symmetric_prod<hermitian_type> (1, 1, test_fails__);
+    check_symmetric_prod<hermitian_type> (7, 3, test_fails__);
+    check_symmetric_prod<hermitian_type> (45, BOOST_UBLAS_RANK_UPDATE_BLOCK + 5, test_fails__);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_symmetric_prod<double, ublas::lower, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_symmetric_prod<double, ublas::upper, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_symmetric_prod<double, ublas::lower, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_symmetric_prod<double, ublas::upper, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_hermitian_prod<std::complex<double>, ublas::lower, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_hermitian_prod<std::complex<double>, ublas::upper, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_hermitian_prod<std::complex<double>, ublas::lower, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_hermitian_prod<std::complex<double>, ublas::upper, ublas::column_major>) );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,103 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/operation_transpose.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+template<class M>
+void fill_matrix (M &m) {
+    for (std::size_t i = 0; i < m.size1 (); ++ i)
+        for (std::size_t j = 0; j < m.size2 (); ++ j)
+            m (i, j) = typename M::value_type (i * 1000.0 + j);
+}
+
+template<class M1, class M2>
+bool is_transpose (const M1 &a, const M2 &b) {
+    if (a.size1 () != b.size2 () || a.size2 () != b.size1 ())
+        return false;
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        for (std::size_t j = 0; j < a.size2 (); ++ j)
+            if (a (i, j) != b (j, i))
+                return false;
+    return true;
+}
+
+// Transposed assignments, blocked where both sides share their orientation
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_transpose_assign )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    typedef ublas::matrix<T, typename L::transposed_layout> other_type;
+    const std::size_t sizes [] = { 1, 5, 32, 67 };
+    for (std::size_t s1 = 0; s1 < 4; ++ s1) {
+        for (std::size_t s2 = 0; s2 < 4; ++ s2) {
+            matrix_type a (sizes [s1], sizes [s2]);
+            fill_matrix (a);
+            matrix_type b (sizes [s2], sizes [s1]);
+            noalias (b) = ublas::trans (a);
+            BOOST_UBLAS_TEST_CHECK (is_transpose (a, b));
+            noalias (b) += ublas::trans (a);
+            matrix_type c (T (2) * ublas::trans (a));
+            BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (b, c, b.size1 (), b.size2 ());
+            other_type o (ublas::trans (a));
+            BOOST_UBLAS_TEST_CHECK (is_transpose (a, o));
+        }
+    }
+
+    matrix_type a (40, 70);
+    fill_matrix (a);
+    matrix_type b (ublas::herm (a));
+    matrix_type c (ublas::trans (ublas::conj (a)));
+    BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (b, c, b.size1 (), b.size2 ());
+
+    // proxies of dense matrices
+    matrix_type r (20, 35);
+    noalias (r) = ublas::trans (ublas::subrange (a, 3, 38, 10, 30));
+    BOOST_UBLAS_TEST_CHECK (is_transpose (ublas::subrange (a, 3, 38, 10, 30), r));
+    noalias (ublas::subrange (b, 0, 35, 0, 20)) = ublas::trans (r);
+    BOOST_UBLAS_TEST_CHECK (is_transpose (r, ublas::subrange (b, 0, 35, 0, 20)));
+}
+
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_inplace_transpose )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    typedef ublas::matrix<T, typename L::transposed_layout> other_type;
+    const std::size_t sizes [] = { 0, 1, 2, 7, 33, 100 };
+    for (std::size_t s1 = 0; s1 < 6; ++ s1) {
+        for (std::size_t s2 = 0; s2 < 6; ++ s2) {
+            matrix_type a (sizes [s1], sizes [s2]);
+            fill_matrix (a);
+            matrix_type b (a);
+            ublas::inplace_transpose (b);
+            BOOST_UBLAS_TEST_CHECK (is_transpose (a, b));
+
+            matrix_type c (a);
+            other_type o;
+            ublas::inplace_change_orientation (c, o);
+            BOOST_UBLAS_TEST_CHECK_EQ (c.size1 (), 0u);
+            BOOST_UBLAS_TEST_CHECK_EQ (o.size1 (), a.size1 ());
+            BOOST_UBLAS_TEST_CHECK_EQ (o.size2 (), a.size2 ());
+            BOOST_UBLAS_TEST_CHECK_MATRIX_EQ (o, a, a.size1 (), a.size2 ());
+        }
+    }
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_transpose_assign<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_transpose_assign<std::complex<double>, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_inplace_transpose<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_inplace_transpose<float, ublas::column_major>) );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,143 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+#include <boost/numeric/ublas/triangular.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Reference product through an explicit dense copy of the triangular operand
+template<class TRI, class L, class LR>
+void check_trmm (std::size_t n, std::size_t k, std::size_t &test_fails__) {
+    typedef ublas::matrix<double, L> matrix_type;
+    typedef ublas::matrix<double, LR> result_type;
+    typedef ublas::triangular_adaptor<matrix_type, TRI> adaptor_type;
+    typedef ublas::triangular_matrix<double, TRI, L> triangular_type;
+
+    matrix_type a (n, n), b (n, k), c (k, n);
+    fill_matrix (a);
+    fill_matrix (b);
+    fill_matrix (c);
+    adaptor_type ta (a);
+    triangular_type tm (ta);
+    const matrix_type dense (ta);
+
+    result_type r (n, k), expected (n, k);
+    // Reference computed by the generic assignment of dense operands
+    expected = ublas::prod (dense, b);
+    noalias (r) = ublas::prod (ta, b);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+    r = ublas::prod (tm, b);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+    noalias (r) += ublas::prod (tm, b);
+    expected *= 2;
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+
+    result_type s (k, n), sexpected (k, n);
+    sexpected = ublas::prod (c, dense);
+    noalias (s) = ublas::prod (c, ta);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s - sexpected) <= TOL * ublas::norm_inf (sexpected));
+    noalias (s) -= ublas::prod (c, tm);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (s) <= TOL * ublas::norm_inf (sexpected));
+}
+
+template<class TRI>
+BOOST_UBLAS_TEST_DEF ( test_trmm )
+{
+    static const std::size_t sizes [] = { 1, 4, 9, 33, 70 };
+    for (std::size_t i = 0; i < sizeof (sizes) / sizeof (sizes [0]); ++ i) {
+        check_trmm<TRI, ublas::row_major, ublas::row_major> (sizes [i], sizes [(i + 2) % 5], test_fails__);
+        check_trmm<TRI, ublas::column_major, ublas::column_major> (sizes [i], sizes [(i + 1) % 5], test_fails__);
+        check_trmm<TRI, ublas::row_major, ublas::column_major> (sizes [i], sizes [(i + 3) % 5], test_fails__);
+    }
+}
+
+// Rectangular triangular operands span several diagonal blocks and rectangles
+template<class TRI, class L>
+BOOST_UBLAS_TEST_DEF ( test_trmm_rectangular )
+{
+    typedef ublas::matrix<double, L> matrix_type;
+    typedef ublas::triangular_adaptor<matrix_type, TRI> adaptor_type;
+
+    static const std::size_t shapes [][2] = { { 70, 45 }, { 45, 70 } };
+    for (std::size_t s = 0; s < 2; ++ s) {
+        const std::size_t n (shapes [s][0]), k (shapes [s][1]);
+        matrix_type a (n, k), b (k, 37), c (37, n);
+        fill_matrix (a);
+        fill_matrix (b);
+        fill_matrix (c);
+        const adaptor_type ta (a);
+        // The iterators of a rectangular adaptor reach past its sizes, copy by element
+        matrix_type dense (n, k);
+        for (std::size_t i = 0; i < n; ++ i)
+            for (std::size_t j = 0; j < k; ++ j)
+                dense (i, j) = ta (i, j);
+
+        const matrix_type expected (ublas::prod (dense, b));
+        matrix_type r (n, 37);
+        noalias (r) = ublas::prod (ta, b);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+        const matrix_type sexpected (ublas::prod (c, dense));
+        matrix_type t (37, k);
+        noalias (t) = ublas::prod (c, ta);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (t - sexpected) <= TOL * ublas::norm_inf (sexpected));
+    }
+}
+
+BOOST_UBLAS_TEST_DEF ( test_trmm_proxy_complex )
+{
+    typedef std::complex<double> value_type;
+    typedef ublas::matrix<value_type> matrix_type;
+
+    matrix_type a (12, 12), b (12, 5), big (20, 20);
+    fill_matrix (a);
+    fill_matrix (b);
+    for (std::size_t i = 0; i < a.size1 (); ++ i)
+        a (i, i) = value_type (1.0, i);
+    big.clear ();
+    ublas::matrix_range<matrix_type> r (big, ublas::range (3, 15), ublas::range (2, 7));
+    r = ublas::prod (ublas::triangular_adaptor<matrix_type, ublas::upper> (a), b);
+    matrix_type expected (ublas::prod (matrix_type (ublas::triangular_adaptor<matrix_type, ublas::upper> (a)), b));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (r - expected) <= TOL * ublas::norm_inf (expected));
+    BOOST_UBLAS_TEST_CHECK_EQ (big (0, 0), value_type (0));
+
+    // Assigned and added in place into a range spanning several diagonal blocks
+    matrix_type c (40, 40), d (40, 9), wide (50, 12);
+    fill_matrix (c);
+    fill_matrix (d);
+    wide.clear ();
+    ublas::matrix_range<matrix_type> w (wide, ublas::range (5, 45), ublas::range (1, 10));
+    noalias (w) = ublas::prod (ublas::triangular_adaptor<matrix_type, ublas::lower> (c), d);
+    noalias (w) += ublas::prod (ublas::triangular_adaptor<matrix_type, ublas::lower> (c), d);
+    expected = 2.0 * ublas::prod (matrix_type (ublas::triangular_adaptor<matrix_type, ublas::lower> (c)), d);
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (w - expected) <= TOL * ublas::norm_inf (expected));
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (ublas::subrange (wide, 0, 5, 0, 12)), 0.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (ublas::column (wide, 0)), 0.0);
+    BOOST_UBLAS_TEST_CHECK_EQ (ublas::norm_inf (ublas::column (wide, 10)), 0.0);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( test_trmm<ublas::lower> );
+    BOOST_UBLAS_TEST_DO( test_trmm<ublas::upper> );
+    BOOST_UBLAS_TEST_DO( test_trmm<ublas::unit_lower> );
+    BOOST_UBLAS_TEST_DO( test_trmm<ublas::unit_upper> );
+    BOOST_UBLAS_TEST_DO( test_trmm<ublas::strict_lower> );
+    BOOST_UBLAS_TEST_DO( test_trmm<ublas::strict_upper> );
+    BOOST_UBLAS_TEST_DO( (test_trmm_rectangular<ublas::lower, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_trmm_rectangular<ublas::upper, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_trmm_rectangular<ublas::upper, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_trmm_rectangular<ublas::lower, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( test_trmm_proxy_complex );
+
+    BOOST_UBLAS_TEST_END();
+}
@@ -0,0 +1,96 @@
+//
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/numeric/ublas/tsqr.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <complex>
+#include "utils.hpp"
+#include "common/fixture.hpp"
+
+namespace ublas = boost::numeric::ublas;
+
+// Q R reproduces A for any number of leaves, including counts that are not powers of two
+template<class T, class L>
+BOOST_UBLAS_TEST_DEF ( test_tsqr_factorize )
+{
+    typedef ublas::matrix<T, L> matrix_type;
+    const std::size_t m (403), n (7);
+    matrix_type a (m, n), q (m, n);
+    fill (a, 0);
+    const std::size_t leaves [] = { 1, 2, 5, 8, 100 };
+    for (std::size_t l = 0; l < 5; ++ l) {
+        ublas::tsqr_factorization<matrix_type> f (a, leaves [l]);
+        BOOST_UBLAS_TEST_CHECK_EQ (f.leaves (), (std::min) (leaves [l], m / n));
+        BOOST_UBLAS_TEST_CHECK_EQ (f.size1 (), m);
+        BOOST_UBLAS_TEST_CHECK_EQ (f.size2 (), n);
+        f.form_q (q);
+        matrix_type e (ublas::prod (q, f.r ()) - a);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (e) <= TOL * ublas::norm_inf (a));
+        matrix_type i (ublas::prod (ublas::herm (q), q) - ublas::identity_matrix<T> (n));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (i) <= TOL);
+        for (std::size_t r = 1; r < n; ++ r)
+            for (std::size_t c = 0; c < r; ++ c)
+                BOOST_UBLAS_TEST_CHECK_EQ (f.r () (r, c), T (0));
+
+        // Q^H Q x = x, and the projection onto the columns of A is Q (Q^H x)(0:n)
+        ublas::vector<T> x (m), y (m), p (m);
+        for (std::size_t r = 0; r < m; ++ r)
+            x (r) = T (r % 5 - 2.0);
+        y = x;
+        f.apply_qt (y);
+        ublas::vector<T> c (ublas::prod (ublas::herm (q), x));
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (ublas::subrange (y, 0, n) - c) <= TOL * ublas::norm_inf (x));
+        p = ublas::prod (q, c);
+        f.apply_q (y);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - x) <= TOL * ublas::norm_inf (x));
+        y = x;
+        f.apply_qt (y);
+        ublas::subrange (y, n, m) = ublas::zero_vector<T> (m - n);
+        f.apply_q (y);
+        BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (y - p) <= TOL * ublas::norm_inf (x));
+    }
+}
+
+// Least squares solutions agree with qr_solve
+template<class T>
+BOOST_UBLAS_TEST_DEF ( test_tsqr_solve )
+{
+    typedef ublas::matrix<T, ublas::column_major> matrix_type;
+    const std::size_t m (250), n (9), nrhs (2);
+    matrix_type a (m, n), qr (m, n), b (m, nrhs), x (m, nrhs), y (m, nrhs);
+    fill (a, 0);
+    for (std::size_t i = 0; i < m; ++ i)
+        for (std::size_t j = 0; j < nrhs; ++ j)
+            b (i, j) = T ((i * (j + 2)) % 7 - 3.0);
+
+    qr = a;
+    ublas::vector<T> tau (n);
+    ublas::qr_factorize (qr, tau);
+    y = b;
+    ublas::qr_solve (qr, tau, y);
+
+    ublas::tsqr_factorization<matrix_type> f (a, 6);
+    x = b;
+    f.solve (x);
+    matrix_type e (ublas::subrange (x, 0, n, 0, nrhs) - ublas::subrange (y, 0, n, 0, nrhs));
+    BOOST_UBLAS_TEST_CHECK (ublas::norm_inf (e) <= TOL * ublas::norm_inf (y));
+
+    // Singular R
+    ublas::column (a, 4) = ublas::zero_vector<T> (m);
+    BOOST_UBLAS_TEST_CHECK_EQ (f.factorize (a, 4), 5u);
+}
+
+int main () {
+    BOOST_UBLAS_TEST_BEGIN();
+
+    BOOST_UBLAS_TEST_DO( (test_tsqr_factorize<double, ublas::row_major>) );
+    BOOST_UBLAS_TEST_DO( (test_tsqr_factorize<double, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( (test_tsqr_factorize<std::complex<double>, ublas::column_major>) );
+    BOOST_UBLAS_TEST_DO( test_tsqr_solve<double> );
+    BOOST_UBLAS_TEST_DO( test_tsqr_solve<std::complex<double> > );
+
+    BOOST_UBLAS_TEST_END();
+}